@@ -45,6 +45,7 @@
  *    mpp_buffer_group_limit_get
  *    mpp_buffer_group_put
  *    mpp_buffer_group_limit_config
+ *    mpp_buffer_group_trim_config
  *
  * 3. buffer allocator management
  *    this part is for allocator on different os, it does not have user interface
@@ -347,6 +348,13 @@ MppBufferType mpp_buffer_group_type(MppBufferGroup group);
  */
 MPP_RET mpp_buffer_group_limit_config(MppBufferGroup group, size_t size, RK_S32 count);
 
+/*
+ * size  : 0 - release unused buffer smaller than request on get miss
+ *         other - keep unused buffer for reuse and release the oldest ones
+ *                 when total unused size exceeds size
+ */
+MPP_RET mpp_buffer_group_trim_config(MppBufferGroup group, size_t size);
+
 RK_U32 mpp_buffer_total_now();
 RK_U32 mpp_buffer_total_max();
 
@@ -55,6 +55,11 @@
  *
  * encode_get_packet: get encoded video packet from encoder only, async interface
  *
+ * decode_put_packets / decode_get_frames / encode_put_frames / encode_get_packets:
+ *            batch version of the async interface above. Multiple packets or
+ *            frames are moved with one lock and one notify for small packet
+ *            streams like high frame rate MJPEG.
+ *
  * (1.2) advanced task api set:
  *
  * poll     : poll port for dequeue
@@ -206,10 +211,61 @@ typedef struct MppApi_t {
      */
     MPP_RET (*control)(MppCtx ctx, MpiCmd cmd, MppParam param);
 
+    // batch data flow interface
+    /**
+     * @brief send multiple video stream packets to decoder, async interface
+     * @param[in] ctx The context of mpp, created by mpp_create() and initiated
+     *                by mpp_init().
+     * @param[in] packets The input video stream packet array.
+     * @param[in] count The number of packets in the array.
+     * @param[out] done The number of packets taken by decoder. The packets
+     *                  after it should be sent again later.
+     * @return 0 and positive for success, negative for failure. The return
+     *         value is an error code. For details, please refer mpp_err.h.
+     * @note The batch functions take the space of the reserved words. Older
+     *       library leaves them NULL so check the pointer before use.
+     */
+    MPP_RET (*decode_put_packets)(MppCtx ctx, MppPacket *packets, RK_S32 count, RK_S32 *done);
+    /**
+     * @brief get multiple video frames from decoder, async interface
+     * @param[in] ctx The context of mpp, created by mpp_create() and initiated
+     *                by mpp_init().
+     * @param[out] frames The output picture array.
+     * @param[in] count The max number of frames to get.
+     * @param[out] done The number of frames returned in the array.
+     * @return 0 and positive for success, negative for failure. The return
+     *         value is an error code. For details, please refer mpp_err.h.
+     */
+    MPP_RET (*decode_get_frames)(MppCtx ctx, MppFrame *frames, RK_S32 count, RK_S32 *done);
+    /**
+     * @brief send multiple video frames to encoder, async interface
+     * @param[in] ctx The context of mpp, created by mpp_create() and initiated
+     *                by mpp_init().
+     * @param[in] frames The input video frame array.
+     * @param[in] count The number of frames in the array.
+     * @param[out] done The number of frames taken by encoder.
+     * @return 0 and positive for success, negative for failure. The return
+     *         value is an error code. For details, please refer mpp_err.h.
+     */
+    MPP_RET (*encode_put_frames)(MppCtx ctx, MppFrame *frames, RK_S32 count, RK_S32 *done);
+    /**
+     * @brief get multiple encoded video packets from encoder, async interface
+     * @param[in] ctx The context of mpp, created by mpp_create() and initiated
+     *                by mpp_init().
+     * @param[out] packets The output packet array.
+     * @param[in] count The max number of packets to get.
+     * @param[out] done The number of packets returned in the array.
+     * @return 0 and positive for success, negative for failure. The return
+     *         value is an error code. For details, please refer mpp_err.h.
+     */
+    MPP_RET (*encode_get_packets)(MppCtx ctx, MppPacket *packets, RK_S32 count, RK_S32 *done);
+
     /**
      * @brief The reserved segment, may be used in the future
+     * @note The batch functions above are carved from the original 16 words
+     *       so the size of MppApi is kept.
      */
-    RK_U32 reserv[16];
+    RK_U32 reserv[16 - 4 * sizeof(void *) / sizeof(RK_U32)];
 } MppApi;
 
 
@@ -56,6 +56,11 @@
 #define CMD_ENC_CFG_ROI                 (0x00008300)
 #define CMD_ENC_CFG_OSD                 (0x00008400)
 
+/* event flags for MPP_GET_EVENT */
+#define MPP_EVENT_OUTPUT_READY          (0x00000001)    /* frame / packet can be got */
+#define MPP_EVENT_INPUT_SPACE           (0x00000002)    /* packet / frame can be put */
+#define MPP_EVENT_ERROR                 (0x00000004)    /* error frame output or encode failure */
+
 typedef enum {
     MPP_OSAL_CMD_BASE                   = CMD_MODULE_OSAL,
     MPP_OSAL_CMD_END,
@@ -75,6 +80,14 @@ typedef enum {
     MPP_SET_INPUT_TIMEOUT,              /* parameter type RK_S64 */
     MPP_SET_OUTPUT_TIMEOUT,             /* parameter type RK_S64 */
     MPP_SET_DISABLE_THREAD,             /* MPP no thread mode and use external thread to decode */
+    /*
+     * event notification for epoll / poll based multi-channel application
+     * MPP_GET_EVENT_FD returns an eventfd which becomes readable when any of
+     * MPP_EVENT_XXX flags is pending. MPP_GET_EVENT reads and clears the
+     * pending flags. The flags are hints, the io calls should be non-block.
+     */
+    MPP_GET_EVENT_FD,                   /* parameter type RK_S32 * */
+    MPP_GET_EVENT,                      /* parameter type RK_U32 *, MPP_EVENT_XXX flags */
 
     MPP_STATE_CMD_BASE                  = CMD_MODULE_MPP | CMD_STATE_OPS,
     MPP_START,
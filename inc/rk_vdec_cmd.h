@@ -30,6 +30,7 @@
 #define MPP_DEC_QUERY_DEC_IN_PKT    (0x00000010)
 #define MPP_DEC_QUERY_DEC_WORK      (0x00000020)
 #define MPP_DEC_QUERY_DEC_OUT_FRM   (0x00000040)
+#define MPP_DEC_QUERY_TIMING        (0x00000080)
 
 #define MPP_DEC_QUERY_ALL           (MPP_DEC_QUERY_STATUS       | \
                                      MPP_DEC_QUERY_WAIT         | \
@@ -37,7 +38,8 @@
                                      MPP_DEC_QUERY_BPS          | \
                                      MPP_DEC_QUERY_DEC_IN_PKT   | \
                                      MPP_DEC_QUERY_DEC_WORK     | \
-                                     MPP_DEC_QUERY_DEC_OUT_FRM)
+                                     MPP_DEC_QUERY_DEC_OUT_FRM  | \
+                                     MPP_DEC_QUERY_TIMING)
 
 typedef struct MppDecQueryCfg_t {
     /*
@@ -50,6 +52,7 @@ typedef struct MppDecQueryCfg_t {
      * bit 4 - for querying decoder input packet count
      * bit 5 - for querying decoder start hardware times
      * bit 6 - for querying decoder output frame count
+     * bit 7 - for querying decoder stage time statistic
      */
     RK_U32      query_flag;
 
@@ -61,6 +64,27 @@ typedef struct MppDecQueryCfg_t {
     RK_U32      dec_in_pkt_cnt;
     RK_U32      dec_hw_run_cnt;
     RK_U32      dec_out_frm_cnt;
+
+    /*
+     * Accumulated stage time in us. Only valid when decoder timing statistic
+     * is enabled by mpp_dec_debug bit 1 before mpp_init, otherwise zero.
+     * The thread total time is only updated when the thread quits.
+     * The parser thread time is split into wait / proc and the proc time is
+     * split into prepare / parse / hal gen_reg / hw start.
+     * The hal thread time is split into wait / proc and hw_wait is the time
+     * blocked on hardware done inside proc.
+     */
+    RK_S64      prs_total;
+    RK_S64      prs_wait;
+    RK_S64      prs_proc;
+    RK_S64      prs_prepare;
+    RK_S64      prs_parse;
+    RK_S64      hal_gen_reg;
+    RK_S64      hw_start;
+    RK_S64      hal_total;
+    RK_S64      hal_wait;
+    RK_S64      hal_proc;
+    RK_S64      hw_wait;
 } MppDecQueryCfg;
 
 typedef void* MppExtCbCtx;
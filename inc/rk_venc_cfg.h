@@ -21,6 +21,8 @@
 #include "mpp_err.h"
 
 typedef void* MppEncCfg;
+/* config name resolved once for set / get without the name lookup */
+typedef void* MppEncCfgHnd;
 
 #ifdef __cplusplus
 extern "C" {
@@ -43,6 +45,27 @@ MPP_RET mpp_enc_cfg_get_u64(MppEncCfg cfg, const char *name, RK_U64 *val);
 MPP_RET mpp_enc_cfg_get_ptr(MppEncCfg cfg, const char *name, void **val);
 MPP_RET mpp_enc_cfg_get_st(MppEncCfg cfg, const char *name, void *val);
 
+/*
+ * Handle access for the config updated on every frame like rc:bps_target.
+ * The handle is global and stays valid for the whole process. It returns
+ * NULL for unknown config name.
+ */
+MppEncCfgHnd mpp_enc_cfg_get_hnd(const char *name);
+
+MPP_RET mpp_enc_cfg_set_s32_by_hnd(MppEncCfg cfg, MppEncCfgHnd hnd, RK_S32 val);
+MPP_RET mpp_enc_cfg_set_u32_by_hnd(MppEncCfg cfg, MppEncCfgHnd hnd, RK_U32 val);
+MPP_RET mpp_enc_cfg_set_s64_by_hnd(MppEncCfg cfg, MppEncCfgHnd hnd, RK_S64 val);
+MPP_RET mpp_enc_cfg_set_u64_by_hnd(MppEncCfg cfg, MppEncCfgHnd hnd, RK_U64 val);
+MPP_RET mpp_enc_cfg_set_ptr_by_hnd(MppEncCfg cfg, MppEncCfgHnd hnd, void *val);
+MPP_RET mpp_enc_cfg_set_st_by_hnd(MppEncCfg cfg, MppEncCfgHnd hnd, void *val);
+
+MPP_RET mpp_enc_cfg_get_s32_by_hnd(MppEncCfg cfg, MppEncCfgHnd hnd, RK_S32 *val);
+MPP_RET mpp_enc_cfg_get_u32_by_hnd(MppEncCfg cfg, MppEncCfgHnd hnd, RK_U32 *val);
+MPP_RET mpp_enc_cfg_get_s64_by_hnd(MppEncCfg cfg, MppEncCfgHnd hnd, RK_S64 *val);
+MPP_RET mpp_enc_cfg_get_u64_by_hnd(MppEncCfg cfg, MppEncCfgHnd hnd, RK_U64 *val);
+MPP_RET mpp_enc_cfg_get_ptr_by_hnd(MppEncCfg cfg, MppEncCfgHnd hnd, void **val);
+MPP_RET mpp_enc_cfg_get_st_by_hnd(MppEncCfg cfg, MppEncCfgHnd hnd, void *val);
+
 void mpp_enc_cfg_show(void);
 
 #ifdef __cplusplus
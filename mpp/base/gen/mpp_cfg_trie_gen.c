@@ -0,0 +1,186 @@
+/*
+ * Copyright 2024 Rockchip Electronics Co. LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#define MODULE_TAG "mpp_cfg_trie_gen"
+
+#include <stdio.h>
+#include <string.h>
+
+#include "mpp_mem.h"
+#include "mpp_log.h"
+#include "mpp_common.h"
+
+#include "mpp_cfg.h"
+#include "mpp_trie.h"
+#include "mpp_enc_cfg_entry.h"
+#include "mpp_dec_cfg_entry.h"
+
+/*
+ * Usage: mpp_cfg_trie_gen <enc|dec> <output header> [check]
+ *
+ * Build the flat name trie of the enc / dec cfg entry table on the host and
+ * write it as a const word table. The payload id of each name is the byte
+ * offset of its MppCfgInfoNode in the info buffer built by the cfg service.
+ * The table only depends on the names so it is checked in and used as is by
+ * cross builds. With "check" the header is compared instead of written.
+ */
+
+#define EXPAND_AS_NAME(base, name, cfg_type, in_type, flag, field_change, field_data) \
+    #base":"#name,
+
+static const char *enc_cfg_names[] = {
+    MPP_ENC_CFG_ENTRY_TABLE(EXPAND_AS_NAME)
+};
+
+static const char *dec_cfg_names[] = {
+    MPP_DEC_CFG_ENTRY_TABLE(EXPAND_AS_NAME)
+};
+
+#define GEN_WORD_PER_LINE   8
+
+static char *gen_table(const char *tag, const char *macro, const char **names, RK_S32 count)
+{
+    MppTrie trie = NULL;
+    MppTrieFlat flat = NULL;
+    char *out = NULL;
+    RK_U8 *buf;
+    RK_S32 info_size = 0;
+    RK_S32 size;
+    RK_S32 max;
+    RK_S32 len;
+    RK_S32 i;
+
+    if (mpp_trie_init(&trie, 0, count))
+        return NULL;
+
+    for (i = 0; i < count; i++)
+        mpp_trie_add_info(trie, &names[i]);
+
+    flat = mpp_trie_flat_init(trie);
+    if (NULL == flat)
+        goto DONE;
+
+    /* same node layout as the flaten function of the cfg service */
+    for (i = 0; i < count; i++) {
+        mpp_trie_flat_set_id(flat, names[i], info_size);
+        info_size += sizeof(MppCfgInfoNode) + MPP_ALIGN(strlen(names[i]) + 1, sizeof(RK_U64));
+    }
+
+    buf = (RK_U8 *)flat;
+    size = mpp_trie_flat_get_size(flat);
+    max = size / 4 * 64 + 4096;
+    out = mpp_malloc(char, max);
+    if (NULL == out)
+        goto DONE;
+
+    len = snprintf(out, max,
+                   "/* generated by mpp_cfg_trie_gen from mpp_%s_cfg_entry.h, do not edit */\n\n"
+                   "#ifndef __MPP_%s_CFG_TRIE_H__\n"
+                   "#define __MPP_%s_CFG_TRIE_H__\n\n"
+                   "#define MPP_%s_CFG_INFO_COUNT       %d\n"
+                   "#define MPP_%s_CFG_INFO_SIZE        %d\n\n"
+                   "#ifndef MPP_CFG_TRIE_ALIGN\n"
+                   "#if defined(__GNUC__)\n"
+                   "#define MPP_CFG_TRIE_ALIGN  __attribute__((aligned(64)))\n"
+                   "#else\n"
+                   "#define MPP_CFG_TRIE_ALIGN\n"
+                   "#endif\n"
+                   "#endif\n\n"
+                   "/* MppTrieFlat of %d nodes in little endian words */\n"
+                   "static const RK_U32 mpp_%s_cfg_trie[%d] MPP_CFG_TRIE_ALIGN = {",
+                   tag, macro, macro, macro, count, macro, info_size,
+                   mpp_trie_flat_get_node_count(flat), tag, size / 4);
+
+    for (i = 0; i < size; i += 4) {
+        /* the head word 3 is the malloc offset of this process */
+        RK_U32 word = (i == 12) ? 0 : (buf[i] | (buf[i + 1] << 8) |
+                                       (buf[i + 2] << 16) | ((RK_U32)buf[i + 3] << 24));
+
+        len += snprintf(out + len, max - len, "%s0x%08x,",
+                        (i / 4 % GEN_WORD_PER_LINE) ? " " : "\n    ", word);
+    }
+
+    snprintf(out + len, max - len, "\n};\n\n#endif /*__MPP_%s_CFG_TRIE_H__*/\n", macro);
+
+DONE:
+    if (flat)
+        mpp_trie_flat_deinit(flat);
+    mpp_trie_deinit(trie);
+    return out;
+}
+
+static MPP_RET check_file(const char *name, const char *str)
+{
+    RK_S32 len = strlen(str);
+    char *buf = NULL;
+    MPP_RET ret = MPP_NOK;
+    FILE *fp = fopen(name, "rb");
+
+    if (NULL == fp)
+        goto DONE;
+
+    buf = mpp_malloc(char, len + 1);
+    if (buf && (RK_S32)fread(buf, 1, len + 1, fp) == len && !memcmp(buf, str, len))
+        ret = MPP_OK;
+
+    fclose(fp);
+DONE:
+    MPP_FREE(buf);
+    return ret;
+}
+
+int main(int argc, char **argv)
+{
+    char *str = NULL;
+    MPP_RET ret = MPP_NOK;
+
+    if (argc < 3) {
+        mpp_log("usage: %s <enc|dec> <output header> [check]\n", argv[0]);
+        return ret;
+    }
+
+    if (!strcmp(argv[1], "enc")) {
+        str = gen_table("enc", "ENC", enc_cfg_names, MPP_ARRAY_ELEMS(enc_cfg_names));
+    } else if (!strcmp(argv[1], "dec")) {
+        str = gen_table("dec", "DEC", dec_cfg_names, MPP_ARRAY_ELEMS(dec_cfg_names));
+    }
+
+    if (NULL == str) {
+        mpp_err("failed to generate %s cfg trie\n", argv[1]);
+        return ret;
+    }
+
+    if (argc > 3 && !strcmp(argv[3], "check")) {
+        ret = check_file(argv[2], str);
+        if (ret)
+            mpp_err("%s is out of date, regenerate it by: %s %s %s\n",
+                    argv[2], argv[0], argv[1], argv[2]);
+    } else {
+        FILE *fp = fopen(argv[2], "wb");
+
+        if (fp) {
+            if (fwrite(str, 1, strlen(str), fp) == strlen(str))
+                ret = MPP_OK;
+            fclose(fp);
+        }
+
+        if (ret)
+            mpp_err("failed to write %s\n", argv[2]);
+    }
+
+    MPP_FREE(str);
+    return ret;
+}
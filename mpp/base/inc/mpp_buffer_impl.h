@@ -37,6 +37,9 @@
 #define MPP_BUF_FUNCTION_LEAVE_OK()     mpp_buf_dbg_f(MPP_BUF_DBG_FUNCTION, "success\n")
 #define MPP_BUF_FUNCTION_LEAVE_FAIL()   mpp_buf_dbg_f(MPP_BUF_DBG_FUNCTION, "failed\n")
 
+/* unused buffer size class is the log2 of buffer size */
+#define MPP_BUF_SIZE_CLASS_NUM          32
+
 typedef enum MppBufOps_e {
     GRP_CREATE,
     GRP_RELEASE,
@@ -72,6 +75,18 @@ typedef struct MppBufLogs_t {
     MppBufLog           *logs;
 } MppBufLogs;
 
+/* buffer group reuse statistic shown in mpp_buffer_group_dump */
+typedef struct MppBufGrpStat_t {
+    RK_U32              get_count;
+    RK_U32              hit_count;
+    RK_U32              miss_count;
+    RK_U32              alloc_count;
+    RK_U32              free_count;
+    RK_U32              trim_count;
+    // sum of reused buffer size minus request size
+    RK_U64              waste_size;
+} MppBufGrpStat;
+
 typedef struct MppBufferImpl_t          MppBufferImpl;
 typedef struct MppBufferGroupImpl_t     MppBufferGroupImpl;
 typedef void (*MppBufCallback)(void *, void *);
@@ -80,7 +95,8 @@ typedef void (*MppBufCallback)(void *, void *);
 struct MppBufferImpl_t {
     char                tag[MPP_TAG_SIZE];
     const char          *caller;
-    pthread_mutex_t     lock;
+    /* group is valid until the buffer is destroyed */
+    MppBufferGroupImpl  *group;
     /* parameter store from MppBufferGroup */
     MppAllocator        allocator;
     MppAllocatorApi     *alloc_api;
@@ -109,8 +125,11 @@ struct MppBufferImpl_t {
     RK_S32              discard;
     // used flag is for used/unused list detection
     RK_U32              used;
+    // atomic counter, group lock is only taken on zero transition
     RK_S32              ref_count;
     struct list_head    list_status;
+    // link to list_class in MppBufferGroupImpl when unused
+    struct list_head    list_class;
 };
 
 struct MppBufferGroupImpl_t {
@@ -155,6 +174,18 @@ struct MppBufferGroupImpl_t {
     struct list_head    list_unused;
     RK_S32              count_used;
     RK_S32              count_unused;
+    // unused buffer lists indexed by size class and non-empty class mask
+    struct list_head    list_class[MPP_BUF_SIZE_CLASS_NUM];
+    RK_U32              class_mask;
+    /*
+     * internal group trim policy:
+     * trim_size 0  - release unused buffer smaller than request on get miss
+     * trim_size >0 - keep all sizes for reuse and release the oldest unused
+     *                buffer when unused_size is over the trim_size
+     */
+    size_t              unused_size;
+    size_t              trim_size;
+    MppBufGrpStat       stat;
 
     // buffer log function
     MppBufLogs          *logs;
@@ -179,8 +210,8 @@ extern RK_U32 mpp_buffer_debug;
  *                            for reducing virtual memory usage.
  *
  *  mpp_buffer_get_unused   : get unused buffer with size. it will first search
- *                            the unused list. if failed it will create on from
- *                            group allocator.
+ *                            the unused size class lists. if failed it will
+ *                            create on from group allocator.
  *
  *  mpp_buffer_ref_inc      : increase buffer's reference counter. if it is unused
  *                            then it will be moved to used list.
@@ -207,8 +238,9 @@ MPP_RET mpp_buffer_group_deinit(MppBufferGroupImpl *p);
 MPP_RET mpp_buffer_group_reset(MppBufferGroupImpl *p);
 MPP_RET mpp_buffer_group_set_callback(MppBufferGroupImpl *p,
                                       MppBufCallback callback, void *arg);
+MPP_RET mpp_buffer_group_set_trim(MppBufferGroupImpl *p, size_t size);
 // mpp_buffer_group helper function
-void mpp_buffer_group_dump(MppBufferGroupImpl *p);
+void mpp_buffer_group_dump(MppBufferGroupImpl *p, const char *caller);
 void mpp_buffer_service_dump(const char *info);
 MppBufferGroupImpl *mpp_buffer_get_misc_group(MppBufferMode mode, MppBufferType type);
 
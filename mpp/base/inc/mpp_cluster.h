@@ -22,12 +22,25 @@
 #include "mpp_thread.h"
 #include "mpp_dev_defs.h"
 
-#define MAX_PRIORITY            1
+/* node priority level, 0 is the highest */
+#define MAX_PRIORITY            4
 
 typedef void* MppNode;
 
 typedef MPP_RET (*TaskProc)(void *param);
 
+typedef struct MppNodeStat_t {
+    RK_U32  run_count;
+    /* time in us */
+    RK_S64  run_time;
+    RK_S64  run_time_max;
+    /* time from schedule to run */
+    RK_S64  wait_time;
+    RK_S64  wait_time_max;
+    /* run count on a worker which stole the node from other worker */
+    RK_U32  steal_count;
+} MppNodeStat;
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -36,6 +49,9 @@ MPP_RET mpp_node_init(MppNode *node);
 MPP_RET mpp_node_deinit(MppNode node);
 
 MPP_RET mpp_node_set_func(MppNode node, TaskProc proc, void *param);
+/* priority should be set before attach */
+MPP_RET mpp_node_set_priority(MppNode node, RK_U32 priority);
+MPP_RET mpp_node_get_stat(MppNode node, MppNodeStat *stat);
 
 MPP_RET mpp_node_attach(MppNode node, MppClientType type);
 MPP_RET mpp_node_detach(MppNode node);
@@ -24,6 +24,8 @@ extern RK_U8 uuid_refresh_cfg[16];
 
 typedef struct MppEncCfgImpl_t {
     RK_S32              size;
+    /* set when a set function leaves change flag, cleared on MPP_ENC_SET_CFG */
+    RK_U32              dirty;
     MppEncCfgSet        cfg;
 } MppEncCfgImpl;
 
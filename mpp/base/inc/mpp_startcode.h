@@ -0,0 +1,53 @@
+/*
+ * Copyright 2024 Rockchip Electronics Co. LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __MPP_STARTCODE_H__
+#define __MPP_STARTCODE_H__
+
+#include "rk_type.h"
+
+#ifdef  __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Search the first 00 00 01 prefix which lies completely in [buf, end).
+ * Return the address of its first byte, or end when there is no prefix.
+ */
+const RK_U8 *mpp_find_startcode(const RK_U8 *buf, const RK_U8 *end);
+
+/*
+ * Return the number of bytes at the head of buf which can be consumed in
+ * bulk by a byte-wise splitter without completing a 00 00 01 prefix.
+ *
+ * state is the splitter shift register holding the bytes consumed before
+ * buf in its low bits. When the last consumed byte is zero a prefix may
+ * straddle the boundary and 0 is returned so the caller falls back to its
+ * byte loop.
+ */
+RK_U32 mpp_startcode_skip(const RK_U8 *buf, RK_U32 len, RK_U32 state);
+
+/* shift the last bytes of buf into a 32bit splitter state */
+RK_U32 mpp_startcode_state(RK_U32 state, const RK_U8 *buf, RK_U32 len);
+
+/* name of the search engine selected at build time */
+const char *mpp_startcode_engine(void);
+
+#ifdef  __cplusplus
+}
+#endif
+
+#endif /* __MPP_STARTCODE_H__ */
@@ -19,6 +19,7 @@
 
 #include "mpp_list.h"
 #include "mpp_task.h"
+#include "mpp_callback.h"
 
 typedef void* MppPort;
 typedef void* MppTaskQueue;
@@ -107,18 +108,29 @@ MPP_RET mpp_task_queue_init(MppTaskQueue *queue, void *mpp, const char *name);
 MPP_RET mpp_task_queue_setup(MppTaskQueue queue, RK_S32 task_count);
 MPP_RET mpp_task_queue_deinit(MppTaskQueue queue);
 MppPort mpp_task_queue_get_port(MppTaskQueue queue, MppPortType type);
+/* callback on each task handed over to the other side by enqueue on the port */
+MPP_RET mpp_port_set_notify(MppPort port, MppCbCtx *cb);
 
 #define mpp_port_poll(port, timeout) _mpp_port_poll(__FUNCTION__, port, timeout)
 #define mpp_port_dequeue(port, task) _mpp_port_dequeue(__FUNCTION__, port, task)
 #define mpp_port_enqueue(port, task) _mpp_port_enqueue(__FUNCTION__, port, task)
 #define mpp_port_awake(port) _mpp_port_awake(__FUNCTION__, port)
 #define mpp_port_move(port, task, status) _mpp_port_move(__FUNCTION__, port, task, status)
+/* move up to count tasks in one lock, done returns the number moved */
+#define mpp_port_dequeue_batch(port, tasks, count, done) \
+    _mpp_port_dequeue_batch(__FUNCTION__, port, tasks, count, done)
+#define mpp_port_enqueue_batch(port, tasks, count) \
+    _mpp_port_enqueue_batch(__FUNCTION__, port, tasks, count)
 
 MPP_RET _mpp_port_poll(const char *caller, MppPort port, MppPollType timeout);
 MPP_RET _mpp_port_dequeue(const char *caller, MppPort port, MppTask *task);
 MPP_RET _mpp_port_enqueue(const char *caller, MppPort port, MppTask task);
 MPP_RET _mpp_port_awake(const char *caller, MppPort port);
 MPP_RET _mpp_port_move(const char *caller, MppPort port, MppTask task, MppTaskStatus status);
+MPP_RET _mpp_port_dequeue_batch(const char *caller, MppPort port, MppTask *tasks,
+                                RK_S32 count, RK_S32 *done);
+MPP_RET _mpp_port_enqueue_batch(const char *caller, MppPort port, MppTask *tasks,
+                                RK_S32 count);
 
 MppMeta mpp_task_get_meta(MppTask task);
 
@@ -21,6 +21,13 @@
 #include "mpp_err.h"
 
 typedef void* MppTrie;
+/*
+ * Flat trie is a path compressed read only copy of MppTrie in one cache line
+ * aligned buffer. Node links are offsets in the buffer so the buffer can be
+ * shared or mapped as is. Each info node carries a payload id which is the
+ * info index in add order until it is changed by mpp_trie_flat_set_id.
+ */
+typedef void* MppTrieFlat;
 
 /* spatial optimized tire tree */
 typedef struct MppAcNode_t {
@@ -46,6 +53,15 @@ MppTrieNode *mpp_trie_get_node(MppTrieNode *root, const char *name);
 const char **mpp_trie_get_info(MppTrie trie, const char *name);
 MppTrieNode *mpp_trie_node_root(MppTrie trie);
 
+MppTrieFlat mpp_trie_flat_init(MppTrie trie);
+MPP_RET mpp_trie_flat_deinit(MppTrieFlat flat);
+
+RK_S32 mpp_trie_flat_get_size(MppTrieFlat flat);
+RK_S32 mpp_trie_flat_get_node_count(MppTrieFlat flat);
+/* return payload id of name or -1 when name is not found */
+RK_S32 mpp_trie_flat_get_id(MppTrieFlat flat, const char *name);
+MPP_RET mpp_trie_flat_set_id(MppTrieFlat flat, const char *name, RK_S32 id);
+
 #ifdef __cplusplus
 }
 #endif
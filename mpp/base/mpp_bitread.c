@@ -21,6 +21,137 @@
 #include "mpp_mem.h"
 #include "mpp_bitread.h"
 
+#define BYTE_MASK_7F    (0x7f7f7f7f7f7f7f7fULL)
+
+/*
+ * Cached bit window
+ *
+ * The byte based reader state (data_ / bytes_left_ / curr_byte_ and
+ * num_remaining_bits_in_curr_byte_) is kept as is because parsers read it
+ * directly. On each read the unread bits of curr_byte_ and the next seven
+ * bytes are loaded as one 64bit big endian window. The bytes which can not
+ * hit an emulation prevention pattern are found with word operations, so
+ * reads within these bytes are done by shift and clz and the per byte
+ * update_curbyte only runs around the zero bytes.
+ */
+static RK_U64 bitread_load_be64(const RK_U8 *p)
+{
+    RK_U64 val;
+
+    memcpy(&val, p, sizeof(val));
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+    return val;
+#else
+    return __builtin_bswap64(val);
+#endif
+}
+
+/* return bit 0x80 on each zero byte */
+static RK_U64 bitread_zero_bytes(RK_U64 val)
+{
+    RK_U64 tmp = (val & BYTE_MASK_7F) + BYTE_MASK_7F;
+
+    return ~(tmp | val | BYTE_MASK_7F);
+}
+
+/*
+ * Load window and return the number of valid bits in it. The raw next bytes
+ * are also returned for bitread_consume to update curr_byte_ without reload.
+ * The emulation prevention byte needs two zero bytes ahead, so the bytes
+ * before the first zero byte plus two are safe to read without detection.
+ */
+static RK_S32 bitread_window(BitReadCtx_t *bitctx, RK_U64 *win, RK_U64 *raw)
+{
+    RK_S32 remain = bitctx->num_remaining_bits_in_curr_byte_;
+    RK_U32 bytes = MPP_MIN(bitctx->bytes_left_, 7);
+    RK_U64 next = 0;
+    RK_U64 val;
+
+    if (bitctx->bytes_left_ >= 8) {
+        next = bitread_load_be64(bitctx->data_) & ~0xffULL;
+    } else {
+        RK_U32 i;
+
+        for (i = 0; i < bytes; i++)
+            next |= (RK_U64)bitctx->data_[i] << (56 - 8 * i);
+    }
+
+    if (bitctx->prevention_type != PSEUDO_CODE_NONE && bytes) {
+        RK_U32 prev = (RK_U32)bitctx->prev_two_bytes_ & 0xffff;
+        RK_U32 safe;
+
+        if (!(prev & 0xff00)) {
+            safe = 0;
+        } else if (!(prev & 0xff)) {
+            safe = 1;
+        } else {
+            RK_U64 zero = bitread_zero_bytes(next);
+
+            safe = zero ? (RK_U32)(__builtin_clzll(zero) >> 3) + 2 : bytes;
+        }
+
+        bytes = MPP_MIN(bytes, safe);
+    }
+
+    val = remain ? ((RK_U64)(bitctx->curr_byte_ & ((1 << remain) - 1)) << (64 - remain)) : 0;
+    *win = val | (remain < 8 ? next >> remain : 0);
+    *raw = next;
+
+    return remain + bytes * 8;
+}
+
+/* consume bits loaded by bitread_window */
+static void bitread_consume(BitReadCtx_t *bitctx, RK_S32 num_bits, RK_U64 raw)
+{
+    RK_S32 remain = bitctx->num_remaining_bits_in_curr_byte_;
+    RK_S32 bytes;
+    RK_U64 tail;
+
+    if (num_bits <= remain) {
+        bitctx->num_remaining_bits_in_curr_byte_ = remain - num_bits;
+        return;
+    }
+
+    num_bits -= remain;
+    bytes = (num_bits + 7) >> 3;
+    tail = raw >> (64 - bytes * 8);
+
+    if (bytes >= 2)
+        bitctx->prev_two_bytes_ = tail & 0xffff;
+    else
+        bitctx->prev_two_bytes_ = (bitctx->prev_two_bytes_ << 8) | tail;
+
+    bitctx->curr_byte_ = tail & 0xff;
+    bitctx->data_ += bytes;
+    bitctx->bytes_left_ -= bytes;
+    bitctx->num_remaining_bits_in_curr_byte_ = bytes * 8 - num_bits;
+}
+
+/* read 1 to 32 bits from window, return 0 when the window is not enough */
+static RK_S32 bitread_fast(BitReadCtx_t *bitctx, RK_S32 num_bits, RK_U32 *out)
+{
+    RK_S32 remain = bitctx->num_remaining_bits_in_curr_byte_;
+    RK_U64 win;
+    RK_U64 raw;
+
+    if (num_bits <= remain) {
+        remain -= num_bits;
+        *out = (RK_U32)(bitctx->curr_byte_ >> remain) & ((1U << num_bits) - 1);
+        bitctx->num_remaining_bits_in_curr_byte_ = remain;
+        bitctx->used_bits += num_bits;
+        return 1;
+    }
+
+    if (bitread_window(bitctx, &win, &raw) < num_bits)
+        return 0;
+
+    *out = (RK_U32)(win >> (64 - num_bits));
+    bitread_consume(bitctx, num_bits, raw);
+    bitctx->used_bits += num_bits;
+
+    return 1;
+}
+
 static MPP_RET update_curbyte_default(BitReadCtx_t *bitctx)
 {
     if (bitctx->bytes_left_ < 1)
@@ -122,6 +253,8 @@ MPP_RET mpp_read_bits(BitReadCtx_t *bitctx, RK_S32 num_bits, RK_S32 *out)
     if (num_bits > 31) {
         return  MPP_ERR_READ_BIT;
     }
+    if (num_bits > 0 && bitread_fast(bitctx, num_bits, (RK_U32 *)out))
+        return MPP_OK;
     while (bitctx->num_remaining_bits_in_curr_byte_ < bits_left) {
         // Take all that's left in current byte, shift to make space for the rest.
         *out |= (bitctx->curr_byte_ << (bits_left - bitctx->num_remaining_bits_in_curr_byte_));
@@ -150,6 +283,9 @@ MPP_RET mpp_read_longbits(BitReadCtx_t *bitctx, RK_S32 num_bits, RK_U32 *out)
     if (num_bits < 32)
         return mpp_read_bits(bitctx, num_bits, (RK_S32 *)out);
 
+    if (num_bits == 32 && bitread_fast(bitctx, num_bits, out))
+        return MPP_OK;
+
     if (mpp_read_bits(bitctx, 16, &val)) {
         return  MPP_ERR_READ_BIT;
     }
@@ -170,6 +306,14 @@ MPP_RET mpp_read_longbits(BitReadCtx_t *bitctx, RK_S32 num_bits, RK_U32 *out)
 MPP_RET mpp_skip_bits(BitReadCtx_t *bitctx, RK_S32 num_bits)
 {
     RK_S32 bits_left = num_bits;
+    RK_U64 win;
+    RK_U64 raw;
+
+    if (num_bits > 0 && num_bits < 64 && bitread_window(bitctx, &win, &raw) >= num_bits) {
+        bitread_consume(bitctx, num_bits, raw);
+        bitctx->used_bits += num_bits;
+        return MPP_OK;
+    }
 
     while (bitctx->num_remaining_bits_in_curr_byte_ < bits_left) {
         // Take all that's left in current byte, shift to make space for the rest.
@@ -246,6 +390,23 @@ MPP_RET mpp_read_ue(BitReadCtx_t *bitctx, RK_U32 *val)
     RK_S32 num_bits = -1;
     RK_S32 bit;
     RK_S32 rest;
+    RK_U64 win;
+    RK_U64 raw;
+    RK_S32 avail = bitread_window(bitctx, &win, &raw);
+
+    // Count the leading zero bits and read the code in window.
+    if (win) {
+        RK_S32 zeros = __builtin_clzll(win);
+        RK_S32 len = zeros * 2 + 1;
+
+        if (zeros < 32 && len <= avail) {
+            *val = (RK_U32)((win >> (64 - len)) - 1);
+            bitread_consume(bitctx, len, raw);
+            bitctx->used_bits += len;
+            return MPP_OK;
+        }
+    }
+
     // Count the number of contiguous zero bits.
     do {
         if (mpp_read_bits(bitctx, 1, &bit)) {
@@ -21,6 +21,7 @@
 #include "mpp_mem.h"
 #include "mpp_env.h"
 #include "mpp_list.h"
+#include "mpp_lock.h"
 #include "mpp_debug.h"
 #include "mpp_common.h"
 
@@ -53,6 +54,7 @@ static RK_U32 buf_slot_idx = 0;
 } while (0)
 
 typedef struct MppBufSlotEntry_t MppBufSlotEntry;
+typedef struct MppBufSlotTable_t MppBufSlotTable;
 typedef struct MppBufSlotsImpl_t MppBufSlotsImpl;
 
 #define SLOT_OPS_MAX_COUNT              1024
@@ -177,12 +179,15 @@ typedef struct MppBufSlotLog_t {
     SlotStatus          status_out;
 } MppBufSlotLog;
 
+/*
+ * log ring is written without lock by atomic sequence increasing
+ * log_seq  - total write count since last reset
+ * log_read - sequence already dumped
+ */
 typedef struct MppBufSlotLogs_t {
-    pthread_mutex_t     lock;
-    RK_U16              max_count;
-    RK_U16              log_count;
-    RK_U16              log_write;
-    RK_U16              log_read;
+    RK_U32              max_count;
+    RK_U32              log_seq;
+    RK_U32              log_read;
     MppBufSlotLog       *logs;
 } MppBufSlotLogs;
 
@@ -197,8 +202,27 @@ struct MppBufSlotEntry_t {
     MppBuffer           buffer;
 };
 
+/*
+ * Slot entry never moves after allocation. When slot count grows a new table
+ * is created with the old entry pointers and the new entry chunk. The old
+ * table is retired but kept until deinit so the lock free flag path can
+ * always access a valid entry.
+ */
+struct MppBufSlotTable_t {
+    MppBufSlotTable     *prev;
+    MppBufSlotEntry     *chunk;
+    MppBufSlotEntry     **entry;
+    RK_S32              size;
+};
+
 struct MppBufSlotsImpl_t {
+    /*
+     * lock       - slot allocation, slot property and info change
+     * queue_lock - display queue list only
+     * slot status flags are updated with atomic operation without lock
+     */
     Mutex               *lock;
+    Mutex               *queue_lock;
     RK_U32              slots_idx;
 
     // status tracing
@@ -243,7 +267,9 @@ struct MppBufSlotsImpl_t {
     // list for log
     MppBufSlotLogs      *logs;
 
-    MppBufSlotEntry     *slots;
+    // slot on_used bitmap for free slot lookup, protected by lock
+    RK_U32              *used_map;
+    MppBufSlotTable     *table;
 };
 
 static RK_U32 default_align_16(RK_U32 val)
@@ -382,8 +408,7 @@ static void generate_info_set(MppBufSlotsImpl *impl, MppFrame frame, RK_U32 forc
 
 static void buf_slot_logs_reset(MppBufSlotLogs *logs)
 {
-    logs->log_count = 0;
-    logs->log_write = 0;
+    logs->log_seq = 0;
     logs->log_read = 0;
 }
 
@@ -416,47 +441,40 @@ static void buf_slot_logs_deinit(MppBufSlotLogs *logs)
 static void buf_slot_logs_write(MppBufSlotLogs *logs, RK_S32 index, MppBufSlotOps op,
                                 SlotStatus before, SlotStatus after)
 {
-    MppBufSlotLog *log = NULL;
+    RK_U32 seq = MPP_FETCH_ADD(&logs->log_seq, 1);
+    MppBufSlotLog *log = &logs->logs[seq % logs->max_count];
 
-    log = &logs->logs[logs->log_write];
     log->index      = index;
     log->ops        = op;
     log->status_in  = before;
     log->status_out = after;
-
-    logs->log_write++;
-    if (logs->log_write >= logs->max_count)
-        logs->log_write = 0;
-
-    if (logs->log_count < logs->max_count)
-        logs->log_count++;
-    else {
-        logs->log_read++;
-        if (logs->log_read >= logs->max_count)
-            logs->log_read = 0;
-    }
 }
 
 static void buf_slot_logs_dump(MppBufSlotLogs *logs)
 {
-    while (logs->log_count) {
-        MppBufSlotLog *log = &logs->logs[logs->log_read];
+    RK_U32 seq = logs->log_seq;
+    RK_U32 pos = logs->log_read;
+
+    if (seq - pos > logs->max_count)
+        pos = seq - logs->max_count;
+
+    for (; pos != seq; pos++) {
+        MppBufSlotLog *log = &logs->logs[pos % logs->max_count];
 
         mpp_log("index %2d op: %s status in %08x out %08x",
                 log->index, op_string[log->ops], log->status_in.val, log->status_out.val);
-
-        logs->log_read++;
-        if (logs->log_read >= logs->max_count)
-            logs->log_read = 0;
-        logs->log_count--;
     }
-    mpp_assert(logs->log_read == logs->log_write);
+    logs->log_read = seq;
+}
+
+static MppBufSlotEntry *get_slot_entry(MppBufSlotsImpl *impl, RK_S32 index)
+{
+    return impl->table->entry[index];
 }
 
 static void _dump_slots(const char *caller, MppBufSlotsImpl *impl)
 {
     RK_S32 i;
-    MppBufSlotEntry *slot = impl->slots;
 
     mpp_log("\ncaller %s is dumping slots\n", caller, impl->slots_idx);
     mpp_log("slots %d %p buffer count %d buffer size %d\n", impl->slots_idx,
@@ -464,8 +482,8 @@ static void _dump_slots(const char *caller, MppBufSlotsImpl *impl)
     mpp_log("decode  count %d\n", impl->decode_count);
     mpp_log("display count %d\n", impl->display_count);
 
-    for (i = 0; i < impl->buf_count; i++, slot++) {
-        SlotStatus status = slot->status;
+    for (i = 0; i < impl->buf_count; i++) {
+        SlotStatus status = get_slot_entry(impl, i)->status;
         mpp_log("slot %2d used %d refer %d decoding %d display %d status %08x\n",
                 i, status.on_used, status.codec_use, status.hal_use, status.queue_use, status.val);
     }
@@ -482,107 +500,114 @@ static void _dump_slots(const char *caller, MppBufSlotsImpl *impl)
 
 static void slot_ops_with_log(MppBufSlotsImpl *impl, MppBufSlotEntry *slot, MppBufSlotOps op, void *arg)
 {
-    RK_U32 error = 0;
+    RK_U32 error;
     RK_S32 index = slot->index;
-    SlotStatus status = slot->status;
-    SlotStatus before = status;
-    switch (op) {
-    case SLOT_INIT : {
-        status.val = 0;
-    } break;
-    case SLOT_SET_ON_USE : {
-        status.on_used = 1;
-    } break;
-    case SLOT_CLR_ON_USE : {
-        status.on_used = 0;
-    } break;
-    case SLOT_SET_NOT_READY : {
-        status.not_ready = 1;
-    } break;
-    case SLOT_CLR_NOT_READY : {
-        status.not_ready = 0;
-    } break;
-    case SLOT_SET_CODEC_READY : {
-        status.not_ready = 0;
-    } break;
-    case SLOT_CLR_CODEC_READY : {
-        status.not_ready = 1;
-    } break;
-    case SLOT_SET_CODEC_USE : {
-        status.codec_use = 1;
-    } break;
-    case SLOT_CLR_CODEC_USE : {
-        status.codec_use = 0;
-    } break;
-    case SLOT_SET_HAL_INPUT : {
-        status.hal_use++;
-    } break;
-    case SLOT_CLR_HAL_INPUT : {
-        if (status.hal_use)
-            status.hal_use--;
-        else {
-            mpp_err("can not clr hal_input on slot %d\n", slot->index);
-            error = 1;
-        }
-    } break;
-    case SLOT_SET_HAL_OUTPUT : {
-        status.hal_output++;
-        status.not_ready  = 1;
-    } break;
-    case SLOT_CLR_HAL_OUTPUT : {
-        if (status.hal_output)
-            status.hal_output--;
-        else
-            mpp_err("can not clr hal_output on slot %d\n", slot->index);
+    SlotStatus status;
+    SlotStatus before;
 
-        // NOTE: set output index ready here
-        if (!status.hal_output)
-            status.not_ready  = 0;
-    } break;
-    case SLOT_SET_QUEUE_USE :
-    case SLOT_ENQUEUE_OUTPUT :
-    case SLOT_ENQUEUE_DISPLAY :
-    case SLOT_ENQUEUE_DEINTER :
-    case SLOT_ENQUEUE_CONVERT : {
-        status.queue_use++;
-    } break;
-    case SLOT_CLR_QUEUE_USE :
-    case SLOT_DEQUEUE_OUTPUT :
-    case SLOT_DEQUEUE_DISPLAY :
-    case SLOT_DEQUEUE_DEINTER :
-    case SLOT_DEQUEUE_CONVERT : {
-        if (status.queue_use)
-            status.queue_use--;
-        else {
-            mpp_err("can not clr queue_use on slot %d\n", slot->index);
+    /* retry until the status word is not changed by other thread */
+    do {
+        error = 0;
+        before.val = slot->status.val;
+        status = before;
+        switch (op) {
+        case SLOT_INIT : {
+            status.val = 0;
+        } break;
+        case SLOT_SET_ON_USE : {
+            status.on_used = 1;
+        } break;
+        case SLOT_CLR_ON_USE : {
+            status.on_used = 0;
+        } break;
+        case SLOT_SET_NOT_READY : {
+            status.not_ready = 1;
+        } break;
+        case SLOT_CLR_NOT_READY : {
+            status.not_ready = 0;
+        } break;
+        case SLOT_SET_CODEC_READY : {
+            status.not_ready = 0;
+        } break;
+        case SLOT_CLR_CODEC_READY : {
+            status.not_ready = 1;
+        } break;
+        case SLOT_SET_CODEC_USE : {
+            status.codec_use = 1;
+        } break;
+        case SLOT_CLR_CODEC_USE : {
+            status.codec_use = 0;
+        } break;
+        case SLOT_SET_HAL_INPUT : {
+            status.hal_use++;
+        } break;
+        case SLOT_CLR_HAL_INPUT : {
+            if (status.hal_use)
+                status.hal_use--;
+            else {
+                mpp_err("can not clr hal_input on slot %d\n", slot->index);
+                error = 1;
+            }
+        } break;
+        case SLOT_SET_HAL_OUTPUT : {
+            status.hal_output++;
+            status.not_ready  = 1;
+        } break;
+        case SLOT_CLR_HAL_OUTPUT : {
+            if (status.hal_output)
+                status.hal_output--;
+            else
+                mpp_err("can not clr hal_output on slot %d\n", slot->index);
+
+            // NOTE: set output index ready here
+            if (!status.hal_output)
+                status.not_ready  = 0;
+        } break;
+        case SLOT_SET_QUEUE_USE :
+        case SLOT_ENQUEUE_OUTPUT :
+        case SLOT_ENQUEUE_DISPLAY :
+        case SLOT_ENQUEUE_DEINTER :
+        case SLOT_ENQUEUE_CONVERT : {
+            status.queue_use++;
+        } break;
+        case SLOT_CLR_QUEUE_USE :
+        case SLOT_DEQUEUE_OUTPUT :
+        case SLOT_DEQUEUE_DISPLAY :
+        case SLOT_DEQUEUE_DEINTER :
+        case SLOT_DEQUEUE_CONVERT : {
+            if (status.queue_use)
+                status.queue_use--;
+            else {
+                mpp_err("can not clr queue_use on slot %d\n", slot->index);
+                error = 1;
+            }
+        } break;
+        case SLOT_SET_EOS : {
+            status.eos = 1;
+        } break;
+        case SLOT_CLR_EOS : {
+            status.eos = 0;
+            slot->eos = 0;
+        } break;
+        case SLOT_SET_FRAME : {
+            status.has_frame = (arg) ? (1) : (0);
+        } break;
+        case SLOT_CLR_FRAME : {
+            status.has_frame = 0;
+        } break;
+        case SLOT_SET_BUFFER : {
+            status.has_buffer = (arg) ? (1) : (0);
+        } break;
+        case SLOT_CLR_BUFFER : {
+            status.has_buffer = 0;
+        } break;
+        default : {
+            mpp_err("found invalid operation code %d\n", op);
             error = 1;
+        } break;
         }
-    } break;
-    case SLOT_SET_EOS : {
-        status.eos = 1;
-    } break;
-    case SLOT_CLR_EOS : {
-        status.eos = 0;
-        slot->eos = 0;
-    } break;
-    case SLOT_SET_FRAME : {
-        status.has_frame = (arg) ? (1) : (0);
-    } break;
-    case SLOT_CLR_FRAME : {
-        status.has_frame = 0;
-    } break;
-    case SLOT_SET_BUFFER : {
-        status.has_buffer = (arg) ? (1) : (0);
-    } break;
-    case SLOT_CLR_BUFFER : {
-        status.has_buffer = 0;
-    } break;
-    default : {
-        mpp_err("found invalid operation code %d\n", op);
-        error = 1;
-    } break;
-    }
-    slot->status = status;
+    } while (!MPP_BOOL_CAS(&slot->status.val, before.val, status.val));
+
     buf_slot_dbg(BUF_SLOT_DBG_OPS_RUNTIME, "slot %3d index %2d op: %s arg %010p status in %08x out %08x",
                  impl->slots_idx, index, op_string[op], arg, before.val, status.val);
     if (impl->logs)
@@ -591,18 +616,117 @@ static void slot_ops_with_log(MppBufSlotsImpl *impl, MppBufSlotEntry *slot, MppB
         dump_slots(impl);
 }
 
+#define SLOT_MAP_BITS       32
+#define SLOT_MAP_WORDS(n)   (((n) + SLOT_MAP_BITS - 1) / SLOT_MAP_BITS)
+
+static void slot_map_set(MppBufSlotsImpl *impl, RK_S32 index)
+{
+    impl->used_map[index / SLOT_MAP_BITS] |= 1U << (index % SLOT_MAP_BITS);
+}
+
+static void slot_map_clr(MppBufSlotsImpl *impl, RK_S32 index)
+{
+    impl->used_map[index / SLOT_MAP_BITS] &= ~(1U << (index % SLOT_MAP_BITS));
+}
+
+/* return the lowest index slot which is not on_used or -1 when all are used */
+static RK_S32 slot_map_find_unused(MppBufSlotsImpl *impl)
+{
+    RK_S32 words = SLOT_MAP_WORDS(impl->buf_count);
+    RK_S32 i;
+
+    for (i = 0; i < words; i++) {
+        RK_U32 unused = ~impl->used_map[i];
+
+        if (unused) {
+            RK_S32 index = i * SLOT_MAP_BITS + __builtin_ctz(unused);
+
+            return (index < impl->buf_count) ? index : -1;
+        }
+    }
+
+    return -1;
+}
+
+/* enlarge slot table to count entries, existing entries keep their address */
+static MPP_RET grow_slot_table(MppBufSlotsImpl *impl, RK_S32 count)
+{
+    MppBufSlotTable *old = impl->table;
+    MppBufSlotTable *table = NULL;
+    MppBufSlotEntry *chunk = NULL;
+    RK_U32 *map = NULL;
+    RK_S32 size = old ? old->size : 0;
+    RK_S32 i;
+
+    if (count <= size)
+        return MPP_OK;
+
+    table = mpp_calloc_size(MppBufSlotTable, sizeof(MppBufSlotTable) +
+                            count * sizeof(MppBufSlotEntry *));
+    chunk = mpp_calloc(MppBufSlotEntry, count - size);
+    map = mpp_calloc(RK_U32, SLOT_MAP_WORDS(count));
+    if (!table || !chunk || !map) {
+        mpp_err_f("failed to grow slot table from %d to %d\n", size, count);
+        MPP_FREE(table);
+        MPP_FREE(chunk);
+        MPP_FREE(map);
+        return MPP_ERR_MALLOC;
+    }
+
+    table->prev = old;
+    table->chunk = chunk;
+    table->entry = (MppBufSlotEntry **)(table + 1);
+    table->size = count;
+
+    if (old) {
+        memcpy(table->entry, old->entry, size * sizeof(MppBufSlotEntry *));
+        memcpy(map, impl->used_map, SLOT_MAP_WORDS(size) * sizeof(RK_U32));
+    }
+
+    for (i = size; i < count; i++) {
+        MppBufSlotEntry *slot = &chunk[i - size];
+
+        slot->slots = impl;
+        slot->index = i;
+        INIT_LIST_HEAD(&slot->list);
+        table->entry[i] = slot;
+    }
+
+    MPP_FREE(impl->used_map);
+    impl->used_map = map;
+
+    /* publish table before any new slot count can be seen */
+    MPP_SYNC();
+    impl->table = table;
+    MPP_SYNC();
+
+    return MPP_OK;
+}
+
 static void init_slot_entry(MppBufSlotsImpl *impl, RK_S32 pos, RK_S32 count)
 {
-    MppBufSlotEntry *slot = impl->slots;
-    for (RK_S32 i = 0; i < count; i++, slot++) {
+    for (RK_S32 i = pos; i < pos + count; i++) {
+        MppBufSlotEntry *slot = get_slot_entry(impl, i);
+
         slot->slots = impl;
         INIT_LIST_HEAD(&slot->list);
-        slot->index = pos + i;
+        slot->index = i;
         slot->frame = NULL;
         slot_ops_with_log(impl, slot, SLOT_INIT, NULL);
+        slot_map_clr(impl, i);
     }
 }
 
+static RK_U32 slot_is_unused(SlotStatus status)
+{
+    return status.on_used &&
+           !status.not_ready &&
+           !status.codec_use &&
+           !status.hal_output &&
+           !status.hal_use &&
+           !status.queue_use;
+}
+
 /*
  * only called on unref / displayed / decoded
  *
@@ -611,35 +735,43 @@ static void init_slot_entry(MppBufSlotsImpl *impl, RK_S32 pos, RK_S32 count)
  */
 static RK_S32 check_entry_unused(MppBufSlotsImpl *impl, MppBufSlotEntry *entry)
 {
-    SlotStatus status = entry->status;
-
-    if (status.on_used &&
-        !status.not_ready &&
-        !status.codec_use &&
-        !status.hal_output &&
-        !status.hal_use &&
-        !status.queue_use) {
-        if (entry->frame) {
-            slot_ops_with_log(impl, entry, SLOT_CLR_FRAME, entry->frame);
-            mpp_frame_deinit(&entry->frame);
-        }
-        if (entry->buffer) {
-            mpp_buffer_put(entry->buffer);
-            slot_ops_with_log(impl, entry, SLOT_CLR_BUFFER, entry->buffer);
-            entry->buffer = NULL;
-        }
+    SlotStatus status;
+    SlotStatus before;
+
+    /*
+     * NOTE: called with lock held. The flags may be changed by lock free
+     * flag path so the on_used is cleared with cas on the checked status.
+     */
+    do {
+        before.val = entry->status.val;
+        if (!slot_is_unused(before))
+            return 0;
+
+        status = before;
+        status.on_used = 0;
+    } while (!MPP_BOOL_CAS(&entry->status.val, before.val, status.val));
 
-        slot_ops_with_log(impl, entry, SLOT_CLR_ON_USE, NULL);
-        impl->used_count--;
-        return 1;
+    if (impl->logs)
+        buf_slot_logs_write(impl->logs, entry->index, SLOT_CLR_ON_USE, before, status);
+
+    if (entry->frame) {
+        slot_ops_with_log(impl, entry, SLOT_CLR_FRAME, entry->frame);
+        mpp_frame_deinit(&entry->frame);
+    }
+    if (entry->buffer) {
+        mpp_buffer_put(entry->buffer);
+        slot_ops_with_log(impl, entry, SLOT_CLR_BUFFER, entry->buffer);
+        entry->buffer = NULL;
     }
 
-    return 0;
+    slot_map_clr(impl, entry->index);
+    impl->used_count--;
+    return 1;
 }
 
 static void clear_slots_impl(MppBufSlotsImpl *impl)
 {
-    MppBufSlotEntry *slot = (MppBufSlotEntry *)impl->slots;
+    MppBufSlotTable *table = impl->table;
     RK_S32 i;
 
     for (i = 0; i < (RK_S32)MPP_ARRAY_ELEMS(impl->queue); i++) {
@@ -649,7 +781,9 @@ static void clear_slots_impl(MppBufSlotsImpl *impl)
         mpp_assert(list_empty(&impl->queue[i]));
     }
 
-    for (i = 0; i < impl->buf_count; i++, slot++) {
+    for (i = 0; i < impl->buf_count; i++) {
+        MppBufSlotEntry *slot = get_slot_entry(impl, i);
+
         mpp_assert(!slot->status.on_used);
         if (slot->status.on_used) {
             dump_slots(impl);
@@ -673,7 +807,18 @@ static void clear_slots_impl(MppBufSlotsImpl *impl)
     if (impl->lock)
         delete impl->lock;
 
-    mpp_free(impl->slots);
+    if (impl->queue_lock)
+        delete impl->queue_lock;
+
+    while (table) {
+        MppBufSlotTable *prev = table->prev;
+
+        mpp_free(table->chunk);
+        mpp_free(table);
+        table = prev;
+    }
+
+    MPP_FREE(impl->used_map);
     mpp_free(impl);
 }
 
@@ -696,6 +841,10 @@ MPP_RET mpp_buf_slot_init(MppBufSlots *slots)
         if (NULL == impl->lock)
             break;
 
+        impl->queue_lock = new Mutex();
+        if (NULL == impl->queue_lock)
+            break;
+
         for (RK_U32 i = 0; i < MPP_ARRAY_ELEMS(impl->queue); i++) {
             INIT_LIST_HEAD(&impl->queue[i]);
         }
@@ -753,20 +902,20 @@ MPP_RET mpp_buf_slot_setup(MppBufSlots slots, RK_S32 count)
 
     MppBufSlotsImpl *impl = (MppBufSlotsImpl *)slots;
     AutoMutex auto_lock(impl->lock);
+    RK_U32 first = (NULL == impl->table);
 
-    if (NULL == impl->slots) {
+    if (grow_slot_table(impl, count))
+        return MPP_ERR_MALLOC;
+
+    if (first) {
         // first slot setup
-        impl->buf_count = impl->new_count = count;
-        impl->slots = mpp_calloc(MppBufSlotEntry, count);
         init_slot_entry(impl, 0, count);
+        impl->buf_count = impl->new_count = count;
         impl->used_count = 0;
     } else {
         // record the slot count for info changed ready config
-        if (count > impl->buf_count) {
-            impl->slots = mpp_realloc(impl->slots, MppBufSlotEntry, count);
-            mpp_assert(impl->slots);
+        if (count > impl->buf_count)
             init_slot_entry(impl, impl->buf_count, (count - impl->buf_count));
-        }
         impl->new_count = count;
     }
 
@@ -796,14 +945,14 @@ MPP_RET mpp_buf_slot_ready(MppBufSlots slots)
 
     MppBufSlotsImpl *impl = (MppBufSlotsImpl *)slots;
     AutoMutex auto_lock(impl->lock);
-    slot_assert(impl, impl->slots);
+    slot_assert(impl, impl->table);
     if (!impl->info_changed)
         mpp_log("found info change ready set without internal info change\n");
 
     // ready mean the info_set will be copy to info as the new configuration
     if (impl->buf_count != impl->new_count) {
-        impl->slots = mpp_realloc(impl->slots, MppBufSlotEntry, impl->new_count);
-        mpp_assert(impl->slots);
+        if (grow_slot_table(impl, impl->new_count))
+            return MPP_ERR_MALLOC;
         init_slot_entry(impl, 0, impl->new_count);
     }
     impl->buf_count = impl->new_count;
@@ -865,16 +1014,18 @@ MPP_RET mpp_buf_slot_get_unused(MppBufSlots slots, RK_S32 *index)
 
     MppBufSlotsImpl *impl = (MppBufSlotsImpl *)slots;
     AutoMutex auto_lock(impl->lock);
-    RK_S32 i;
-    MppBufSlotEntry *slot = impl->slots;
-    for (i = 0; i < impl->buf_count; i++, slot++) {
-        if (!slot->status.on_used) {
-            *index = i;
-            slot_ops_with_log(impl, slot, SLOT_SET_ON_USE, NULL);
-            slot_ops_with_log(impl, slot, SLOT_SET_NOT_READY, NULL);
-            impl->used_count++;
-            return MPP_OK;
-        }
+    RK_S32 i = impl->table ? slot_map_find_unused(impl) : -1;
+
+    if (i >= 0) {
+        MppBufSlotEntry *slot = get_slot_entry(impl, i);
+
+        slot_assert(impl, !slot->status.on_used);
+        *index = i;
+        slot_ops_with_log(impl, slot, SLOT_SET_ON_USE, NULL);
+        slot_ops_with_log(impl, slot, SLOT_SET_NOT_READY, NULL);
+        slot_map_set(impl, i);
+        impl->used_count++;
+        return MPP_OK;
     }
 
     *index = -1;
@@ -892,9 +1043,8 @@ MPP_RET mpp_buf_slot_set_flag(MppBufSlots slots, RK_S32 index, SlotUsageType typ
     }
 
     MppBufSlotsImpl *impl = (MppBufSlotsImpl *)slots;
-    AutoMutex auto_lock(impl->lock);
     slot_assert(impl, (index >= 0) && (index < impl->buf_count));
-    slot_ops_with_log(impl, &impl->slots[index], set_flag_op[type], NULL);
+    slot_ops_with_log(impl, get_slot_entry(impl, index), set_flag_op[type], NULL);
     return MPP_OK;
 }
 
@@ -907,15 +1057,17 @@ MPP_RET mpp_buf_slot_clr_flag(MppBufSlots slots, RK_S32 index, SlotUsageType typ
 
     MppBufSlotsImpl *impl = (MppBufSlotsImpl *)slots;
     RK_S32 unused = 0;
-    {
-        AutoMutex auto_lock(impl->lock);
-        slot_assert(impl, (index >= 0) && (index < impl->buf_count));
-        MppBufSlotEntry *slot = &impl->slots[index];
-        slot_ops_with_log(impl, slot, clr_flag_op[type], NULL);
 
-        if (type == SLOT_HAL_OUTPUT)
-            impl->decode_count++;
+    slot_assert(impl, (index >= 0) && (index < impl->buf_count));
+    MppBufSlotEntry *slot = get_slot_entry(impl, index);
+    slot_ops_with_log(impl, slot, clr_flag_op[type], NULL);
+
+    if (type == SLOT_HAL_OUTPUT)
+        MPP_FETCH_ADD(&impl->decode_count, 1);
 
+    // only the release of the last user need the slot lock
+    if (slot_is_unused(slot->status)) {
+        AutoMutex auto_lock(impl->lock);
         unused = check_entry_unused(impl, slot);
     }
 
@@ -932,12 +1084,12 @@ MPP_RET mpp_buf_slot_enqueue(MppBufSlots slots, RK_S32 index, SlotQueueType type
     }
 
     MppBufSlotsImpl *impl = (MppBufSlotsImpl *)slots;
-    AutoMutex auto_lock(impl->lock);
     slot_assert(impl, (index >= 0) && (index < impl->buf_count));
-    MppBufSlotEntry *slot = &impl->slots[index];
+    MppBufSlotEntry *slot = get_slot_entry(impl, index);
     slot_ops_with_log(impl, slot, (MppBufSlotOps)(SLOT_ENQUEUE + type), NULL);
 
     // add slot to display list
+    AutoMutex auto_lock(impl->queue_lock);
     list_del_init(&slot->list);
     list_add_tail(&slot->list, &impl->queue[type]);
     return MPP_OK;
@@ -951,19 +1103,23 @@ MPP_RET mpp_buf_slot_dequeue(MppBufSlots slots, RK_S32 *index, SlotQueueType typ
     }
 
     MppBufSlotsImpl *impl = (MppBufSlotsImpl *)slots;
-    AutoMutex auto_lock(impl->lock);
-    if (list_empty(&impl->queue[type]))
-        return MPP_NOK;
+    MppBufSlotEntry *slot = NULL;
+    {
+        AutoMutex auto_lock(impl->queue_lock);
+        if (list_empty(&impl->queue[type]))
+            return MPP_NOK;
 
-    MppBufSlotEntry *slot = list_entry(impl->queue[type].next, MppBufSlotEntry, list);
-    if (slot->status.not_ready)
-        return MPP_NOK;
+        slot = list_entry(impl->queue[type].next, MppBufSlotEntry, list);
+        if (slot->status.not_ready)
+            return MPP_NOK;
+
+        // make sure that this slot is just the next display slot
+        list_del_init(&slot->list);
+        impl->display_count++;
+    }
 
-    // make sure that this slot is just the next display slot
-    list_del_init(&slot->list);
     slot_assert(impl, slot->index < impl->buf_count);
     slot_ops_with_log(impl, slot, (MppBufSlotOps)(SLOT_DEQUEUE + type), NULL);
-    impl->display_count++;
     *index = slot->index;
 
     return MPP_OK;
@@ -979,7 +1135,7 @@ MPP_RET mpp_buf_slot_set_prop(MppBufSlots slots, RK_S32 index, SlotPropType type
     MppBufSlotsImpl *impl = (MppBufSlotsImpl *)slots;
     AutoMutex auto_lock(impl->lock);
     slot_assert(impl, (index >= 0) && (index < impl->buf_count));
-    MppBufSlotEntry *slot = &impl->slots[index];
+    MppBufSlotEntry *slot = get_slot_entry(impl, index);
     slot_ops_with_log(impl, slot, set_val_op[type], val);
 
     switch (type) {
@@ -1068,7 +1224,7 @@ MPP_RET mpp_buf_slot_get_prop(MppBufSlots slots, RK_S32 index, SlotPropType type
     MppBufSlotsImpl *impl = (MppBufSlotsImpl *)slots;
     AutoMutex auto_lock(impl->lock);
     slot_assert(impl, (index >= 0) && (index < impl->buf_count));
-    MppBufSlotEntry *slot = &impl->slots[index];
+    MppBufSlotEntry *slot = get_slot_entry(impl, index);
 
     switch (type) {
     case SLOT_EOS: {
@@ -1115,13 +1271,17 @@ MPP_RET mpp_buf_slot_reset(MppBufSlots slots, RK_S32 index)
     MppBufSlotsImpl *impl = (MppBufSlotsImpl *)slots;
     AutoMutex auto_lock(impl->lock);
     slot_assert(impl, (index >= 0) && (index < impl->buf_count));
-    MppBufSlotEntry *slot = &impl->slots[index];
+    MppBufSlotEntry *slot = get_slot_entry(impl, index);
 
     // make sure that this slot is just the next display slot
-    list_del_init(&slot->list);
+    {
+        AutoMutex auto_queue_lock(impl->queue_lock);
+        list_del_init(&slot->list);
+    }
     slot_ops_with_log(impl, slot, SLOT_CLR_QUEUE_USE, NULL);
     slot_ops_with_log(impl, slot, SLOT_DEQUEUE, NULL);
     slot_ops_with_log(impl, slot, SLOT_CLR_ON_USE, NULL);
+    slot_map_clr(impl, index);
     return MPP_OK;
 }
 
@@ -1135,7 +1295,7 @@ MPP_RET mpp_buf_slot_default_info(MppBufSlots slots, RK_S32 index, void *val)
     MppBufSlotsImpl *impl = (MppBufSlotsImpl *)slots;
     AutoMutex auto_lock(impl->lock);
     slot_assert(impl, (index >= 0) && (index < impl->buf_count));
-    MppBufSlotEntry *slot = &impl->slots[index];
+    MppBufSlotEntry *slot = get_slot_entry(impl, index);
 
     slot_assert(impl, slot->status.not_ready);
     slot_assert(impl, NULL == slot->frame);
@@ -1162,7 +1322,7 @@ RK_U32 mpp_slots_is_empty(MppBufSlots slots, SlotQueueType type)
     }
 
     MppBufSlotsImpl *impl = (MppBufSlotsImpl *)slots;
-    AutoMutex auto_lock(impl->lock);
+    AutoMutex auto_lock(impl->queue_lock);
     return list_empty(&impl->queue[type]) ? 1 : 0;
 }
 
@@ -1220,6 +1380,10 @@ MPP_RET mpp_slots_set_prop(MppBufSlots slots, SlotsPropType type, void *val)
         impl->hal_len_align = (AlignFunc)val;
     } break;
     case SLOTS_COUNT: {
+        if (grow_slot_table(impl, value))
+            return MPP_ERR_MALLOC;
+        if ((RK_S32)value > impl->buf_count)
+            init_slot_entry(impl, impl->buf_count, value - impl->buf_count);
         impl->buf_count = value;
     } break;
     case SLOTS_SIZE: {
@@ -1235,7 +1399,7 @@ MPP_RET mpp_slots_set_prop(MppBufSlots slots, SlotsPropType type, void *val)
         }
         mpp_frame_copy((MppFrame)val, impl->info_set);
         if (impl->info_change_slot_idx >= 0) {
-            MppBufSlotEntry *slot = &impl->slots[impl->info_change_slot_idx];
+            MppBufSlotEntry *slot = get_slot_entry(impl, impl->info_change_slot_idx);
 
             if (slot->frame) {
                 MppFrameImpl *dst = (MppFrameImpl *)slot->frame;
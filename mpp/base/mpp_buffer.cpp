@@ -447,4 +447,14 @@ MPP_RET mpp_buffer_group_limit_config(MppBufferGroup group, size_t size, RK_S32
     p->limit_size     = size;
     p->limit_count    = count;
     return MPP_OK;
-}
\ No newline at end of file
+}
+
+MPP_RET mpp_buffer_group_trim_config(MppBufferGroup group, size_t size)
+{
+    if (NULL == group) {
+        mpp_err_f("input invalid group %p\n", group);
+        return MPP_NOK;
+    }
+
+    return mpp_buffer_group_set_trim((MppBufferGroupImpl *)group, size);
+}
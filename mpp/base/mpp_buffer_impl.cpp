@@ -31,8 +31,6 @@
 #define BUFFER_OPS_MAX_COUNT            1024
 #define MPP_ALLOCATOR_WITH_FLAG_NUM     8
 
-#define SEARCH_GROUP_BY_ID(id)  ((MppBufferService::get_instance())->get_group_by_id(id))
-
 typedef MPP_RET (*BufferOp)(MppAllocator allocator, MppBufferInfo *data);
 
 // use this class only need it to init legacy group before main
@@ -126,6 +124,8 @@ static MppMemPool mpp_buffer_pool = mpp_mem_pool_init_f(MODULE_TAG, sizeof(MppBu
 static MppMemPool mpp_buf_grp_pool = mpp_mem_pool_init_f("mpp_buf_grp", sizeof(MppBufferGroupImpl));
 
 RK_U32 mpp_buffer_debug = 0;
+/* default internal group trim size in MB, 0 for no trim */
+static RK_U32 buffer_trim = 0;
 
 static MppBufLogs *buf_logs_init(RK_U32 max_count)
 {
@@ -232,30 +232,60 @@ static void buf_grp_add_log(MppBufferGroupImpl *group, MppBufOps ops, const char
         buf_logs_write(group->logs, group->group_id, -1, ops, 0, caller);
 }
 
+static RK_U32 buf_size_class(size_t size)
+{
+    RK_U32 val = (size > 0xffffffff) ? 0xffffffff : (RK_U32)size;
+
+    return val ? (31 - __builtin_clz(val)) : 0;
+}
+
+/* NOTE: unused list helper should be called with group buf_lock locked */
+static void buf_add_unused(MppBufferGroupImpl *group, MppBufferImpl *buffer)
+{
+    RK_U32 cls = buf_size_class(buffer->info.size);
+
+    list_add_tail(&buffer->list_status, &group->list_unused);
+    list_add_tail(&buffer->list_class, &group->list_class[cls]);
+    group->class_mask |= 1u << cls;
+    group->count_unused++;
+    group->unused_size += buffer->info.size;
+}
+
+static void buf_del_unused(MppBufferGroupImpl *group, MppBufferImpl *buffer)
+{
+    RK_U32 cls = buf_size_class(buffer->info.size);
+
+    list_del_init(&buffer->list_status);
+    list_del_init(&buffer->list_class);
+    if (list_empty(&group->list_class[cls]))
+        group->class_mask &= ~(1u << cls);
+    group->count_unused--;
+    group->unused_size -= buffer->info.size;
+}
+
 static MPP_RET put_buffer(MppBufferGroupImpl *group, MppBufferImpl *buffer,
                           RK_U32 reuse, const char *caller)
 {
     mpp_assert(group);
 
-    pthread_mutex_lock(&buffer->lock);
-
     if (!MppBufferService::get_instance()->is_finalizing())
         mpp_assert(buffer->ref_count == 0);
 
-    list_del_init(&buffer->list_status);
+    if (buffer->used) {
+        list_del_init(&buffer->list_status);
+        group->count_used--;
+    } else {
+        buf_del_unused(group, buffer);
+    }
 
     if (reuse) {
-        if (buffer->used && group) {
-            group->count_used--;
-            list_add_tail(&buffer->list_status, &group->list_unused);
-            group->count_unused++;
-        } else {
+        if (!buffer->used)
             mpp_err_f("can not reuse unused buffer %d at group %p:%d\n",
                       buffer->buffer_id, group, buffer->group_id);
-        }
+
+        buf_add_unused(group, buffer);
         buffer->used = 0;
 
-        pthread_mutex_unlock(&buffer->lock);
         return MPP_OK;
     }
 
@@ -266,68 +296,53 @@ static MPP_RET put_buffer(MppBufferGroupImpl *group, MppBufferImpl *buffer,
 
     func(buffer->allocator, &buffer->info);
 
-    if (group) {
-        RK_U32 destroy = 0;
+    group->usage -= buffer->info.size;
+    group->buffer_count--;
+    group->stat.free_count++;
 
-        if (buffer->used)
-            group->count_used--;
-        else
-            group->count_unused--;
+    if (group->mode == MPP_BUFFER_INTERNAL)
+        MppBufferService::get_instance()->dec_total(buffer->info.size);
 
-        group->usage -= buffer->info.size;
-        group->buffer_count--;
+    buf_add_log(buffer, BUF_DESTROY, caller);
 
-        if (group->mode == MPP_BUFFER_INTERNAL)
-            MppBufferService::get_instance()->dec_total(buffer->info.size);
+    mpp_mem_pool_put_f(caller, mpp_buffer_pool, buffer);
 
-        buf_add_log(buffer, BUF_DESTROY, caller);
+    return MPP_OK;
+}
 
-        if (group->is_orphan && !group->usage && !group->is_finalizing)
-            destroy = 1;
+/* release the oldest unused buffer until unused size is under limit */
+static void trim_unused(MppBufferGroupImpl *group, size_t limit, const char *caller)
+{
+    while (group->unused_size > limit && !list_empty(&group->list_unused)) {
+        MppBufferImpl *buffer = list_first_entry(&group->list_unused,
+                                                 MppBufferImpl, list_status);
 
-        if (destroy)
-            MppBufferService::get_instance()->put_group(caller, group);
-    } else {
-        mpp_assert(MppBufferService::get_instance()->is_finalizing());
+        put_buffer(group, buffer, 0, caller);
+        group->stat.trim_count++;
     }
-    pthread_mutex_unlock(&buffer->lock);
-
-    mpp_mem_pool_put_f(caller, mpp_buffer_pool, buffer);
-
-    return MPP_OK;
 }
 
 static MPP_RET inc_buffer_ref(MppBufferImpl *buffer, const char *caller)
 {
-    MPP_RET ret = MPP_OK;
+    RK_S32 ref_count = MPP_ADD_FETCH(&buffer->ref_count, 1);
 
-    pthread_mutex_lock(&buffer->lock);
-    buffer->ref_count++;
     buf_add_log(buffer, BUF_REF_INC, caller);
-    if (!buffer->used) {
-        MppBufferGroupImpl *group = NULL;
 
-        {
-            AutoMutex auto_lock(MppBufferService::get_lock());
-            group = SEARCH_GROUP_BY_ID(buffer->group_id);
-        }
-        // NOTE: when increasing ref_count the unused buffer must be under certain group
-        mpp_assert(group);
-        buffer->used = 1;
-        if (group) {
-            pthread_mutex_lock(&group->buf_lock);
-            list_del_init(&buffer->list_status);
+    /* only the first reference on an unused buffer needs to touch the group */
+    if (ref_count == 1) {
+        MppBufferGroupImpl *group = buffer->group;
+
+        pthread_mutex_lock(&group->buf_lock);
+        if (!buffer->used) {
+            buf_del_unused(group, buffer);
             list_add_tail(&buffer->list_status, &group->list_used);
             group->count_used++;
-            group->count_unused--;
-            pthread_mutex_unlock(&group->buf_lock);
-        } else {
-            mpp_err_f("unused buffer without group\n");
-            ret = MPP_NOK;
+            buffer->used = 1;
         }
+        pthread_mutex_unlock(&group->buf_lock);
     }
-    pthread_mutex_unlock(&buffer->lock);
-    return ret;
+
+    return MPP_OK;
 }
 
 static void dump_buffer_info(MppBufferImpl *buffer)
@@ -388,11 +403,7 @@ MPP_RET mpp_buffer_create(const char *tag, const char *caller,
 
     strncpy(p->tag, tag, sizeof(p->tag));
     p->caller = caller;
-    pthread_mutexattr_t attr;
-    pthread_mutexattr_init(&attr);
-    pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
-    pthread_mutex_init(&p->lock, &attr);
-    pthread_mutexattr_destroy(&attr);
+    p->group = group;
     p->allocator = group->allocator;
     p->alloc_api = group->alloc_api;
     p->log_runtime_en = group->log_runtime_en;
@@ -407,6 +418,7 @@ MPP_RET mpp_buffer_create(const char *tag, const char *caller,
     pthread_mutex_lock(&group->buf_lock);
     p->buffer_id = group->buffer_id++;
     INIT_LIST_HEAD(&p->list_status);
+    INIT_LIST_HEAD(&p->list_class);
 
     if (buffer) {
         p->ref_count++;
@@ -415,12 +427,12 @@ MPP_RET mpp_buffer_create(const char *tag, const char *caller,
         group->count_used++;
         *buffer = p;
     } else {
-        list_add_tail(&p->list_status, &group->list_unused);
-        group->count_unused++;
+        buf_add_unused(group, p);
     }
 
     group->usage += info->size;
     group->buffer_count++;
+    group->stat.alloc_count++;
     pthread_mutex_unlock(&group->buf_lock);
 
     buf_add_log(p, (group->mode == MPP_BUFFER_INTERNAL) ? (BUF_CREATE) : (BUF_COMMIT), caller);
@@ -464,50 +476,53 @@ MPP_RET mpp_buffer_ref_inc(MppBufferImpl *buffer, const char* caller)
 MPP_RET mpp_buffer_ref_dec(MppBufferImpl *buffer, const char* caller)
 {
     MPP_RET ret = MPP_OK;
-    RK_U32 release = 0;
+    RK_S32 ref_count;
 
     MPP_BUF_FUNCTION_ENTER();
 
-    pthread_mutex_lock(&buffer->lock);
-
     buf_add_log(buffer, BUF_REF_DEC, caller);
 
-    if (buffer->ref_count <= 0) {
+    ref_count = MPP_SUB_FETCH(&buffer->ref_count, 1);
+    if (ref_count < 0) {
         mpp_err_f("found non-positive ref_count %d caller %s\n",
-                  buffer->ref_count, buffer->caller);
+                  ref_count + 1, buffer->caller);
         mpp_abort();
+        MPP_ADD_FETCH(&buffer->ref_count, 1);
         ret = MPP_NOK;
-        pthread_mutex_unlock(&buffer->lock);
         goto done;
     }
 
-    buffer->ref_count--;
-    if (buffer->ref_count == 0)
-        release = 1;
-
-    pthread_mutex_unlock(&buffer->lock);
+    if (!ref_count) {
+        MppBufferGroupImpl *group = buffer->group;
+        RK_U32 reuse = 0;
+        RK_U32 destroy = 0;
 
-    if (release) {
-        MppBufferGroupImpl *group = NULL;
+        pthread_mutex_lock(&group->buf_lock);
 
-        {
-            AutoMutex auto_lock(MppBufferService::get_lock());
-            group = SEARCH_GROUP_BY_ID(buffer->group_id);
+        /*
+         * a concurrent first ref_inc may take the buffer back before the
+         * lock or another ref_dec may have put it already
+         */
+        if (buffer->ref_count || !buffer->used) {
+            pthread_mutex_unlock(&group->buf_lock);
+            goto done;
         }
 
-        mpp_assert(group);
-        if (group) {
-            RK_U32 reuse = 0;
+        /* orphan group buffer is released directly for group destroy */
+        reuse = (!group->is_misc && !group->is_orphan && !buffer->discard);
+        put_buffer(group, buffer, reuse, caller);
 
-            pthread_mutex_lock(&group->buf_lock);
+        if (reuse && group->trim_size && group->mode == MPP_BUFFER_INTERNAL)
+            trim_unused(group, group->trim_size, caller);
 
-            reuse = (!group->is_misc && !buffer->discard);
-            put_buffer(group, buffer, reuse, caller);
+        if (group->callback)
+            group->callback(group->arg, group);
 
-            if (group->callback)
-                group->callback(group->arg, group);
-            pthread_mutex_unlock(&group->buf_lock);
-        }
+        destroy = group->is_orphan && !group->usage && !group->is_finalizing;
+        pthread_mutex_unlock(&group->buf_lock);
+
+        if (destroy)
+            MppBufferService::get_instance()->put_group(caller, group);
     }
 
 done:
@@ -517,11 +532,20 @@ done:
 
 void mpp_buffer_group_dump(MppBufferGroupImpl *group, const char *caller)
 {
+    MppBufGrpStat *stat = &group->stat;
+    RK_U32 i;
+
     mpp_log("\ndumping buffer group %p id %d from %s\n", group,
             group->group_id, caller);
     mpp_log("mode %s\n", mode2str[group->mode]);
     mpp_log("type %s\n", type2str[group->type]);
-    mpp_log("limit size %d count %d\n", group->limit_size, group->limit_count);
+    mpp_log("limit size %zu count %d\n", group->limit_size, group->limit_count);
+    mpp_log("usage %zu unused %zu trim %zu\n", group->usage, group->unused_size,
+            group->trim_size);
+    mpp_log("get %u hit %u miss %u alloc %u free %u trim %u waste %llu\n",
+            stat->get_count, stat->hit_count, stat->miss_count,
+            stat->alloc_count, stat->free_count, stat->trim_count,
+            stat->waste_size);
 
     mpp_log("used buffer count %d\n", group->count_used);
 
@@ -531,6 +555,18 @@ void mpp_buffer_group_dump(MppBufferGroupImpl *group, const char *caller)
     }
 
     mpp_log("unused buffer count %d\n", group->count_unused);
+    for (i = 0; i < MPP_BUF_SIZE_CLASS_NUM; i++) {
+        RK_S32 count = 0;
+
+        if (!(group->class_mask & (1u << i)))
+            continue;
+
+        list_for_each_entry(pos, &group->list_class[i], MppBufferImpl, list_class) {
+            count++;
+        }
+        mpp_log("size class %2d [%10u, %10u] count %d\n", i, 1u << i,
+                (i < 31) ? ((2u << i) - 1) : 0xffffffff, count);
+    }
     list_for_each_entry_safe(pos, n, &group->list_unused, MppBufferImpl, list_status) {
         dump_buffer_info(pos);
     }
@@ -544,42 +580,63 @@ MppBufferImpl *mpp_buffer_get_unused(MppBufferGroupImpl *p, size_t size, const c
     MPP_BUF_FUNCTION_ENTER();
 
     MppBufferImpl *buffer = NULL;
+    RK_U32 cls = buf_size_class(size);
 
     pthread_mutex_lock(&p->buf_lock);
-    if (!list_empty(&p->list_unused)) {
+    p->stat.get_count++;
+    if (p->count_unused) {
         MppBufferImpl *pos, *n;
-        RK_S32 found = 0;
-        RK_S32 search_count = 0;
+        RK_U32 mask = p->class_mask & ~((1u << cls) - 1);
 
-        list_for_each_entry_safe(pos, n, &p->list_unused, MppBufferImpl, list_status) {
-            mpp_buf_dbg(MPP_BUF_DBG_CHECK_SIZE, "request size %d on buf idx %d size %d\n",
-                        size, pos->buffer_id, pos->info.size);
-            if (pos->info.size >= size) {
-                buffer = pos;
-                pthread_mutex_lock(&buffer->lock);
-                buf_add_log(buffer, BUF_REF_INC, caller);
-                buffer->ref_count++;
-                buffer->used = 1;
-                list_del_init(&buffer->list_status);
-                list_add_tail(&buffer->list_status, &p->list_used);
-                p->count_used++;
-                p->count_unused--;
-                pthread_mutex_unlock(&buffer->lock);
-                found = 1;
-                break;
-            } else {
-                if (MPP_BUFFER_INTERNAL == p->mode) {
-                    put_buffer(p, pos, 0, caller);
-                } else
-                    search_count++;
+        /* best fit in the first class which has a buffer large enough */
+        while (mask && !buffer) {
+            RK_U32 i = __builtin_ctz(mask);
+
+            list_for_each_entry(pos, &p->list_class[i], MppBufferImpl, list_class) {
+                mpp_buf_dbg(MPP_BUF_DBG_CHECK_SIZE, "request size %d on buf idx %d size %d\n",
+                            size, pos->buffer_id, pos->info.size);
+                if (pos->info.size < size)
+                    continue;
+
+                if (!buffer || pos->info.size < buffer->info.size)
+                    buffer = pos;
+
+                if (pos->info.size == size)
+                    break;
             }
+            mask &= ~(1u << i);
         }
 
-        if (!found && search_count) {
+        if (buffer) {
+            buf_del_unused(p, buffer);
+            list_add_tail(&buffer->list_status, &p->list_used);
+            p->count_used++;
+            buffer->used = 1;
+            MPP_ADD_FETCH(&buffer->ref_count, 1);
+            buf_add_log(buffer, BUF_REF_INC, caller);
+            p->stat.hit_count++;
+            p->stat.waste_size += buffer->info.size - size;
+        } else if (MPP_BUFFER_INTERNAL == p->mode) {
+            /* without trim policy small buffer is released before allocating a larger one */
+            if (!p->trim_size) {
+                mask = p->class_mask & ((2u << cls) - 1);
+                while (mask) {
+                    RK_U32 i = __builtin_ctz(mask);
+
+                    list_for_each_entry_safe(pos, n, &p->list_class[i], MppBufferImpl, list_class) {
+                        put_buffer(p, pos, 0, caller);
+                    }
+                    mask &= ~(1u << i);
+                }
+            }
+        } else {
             mpp_err_f("can not found match buffer with size larger than %d\n", size);
             mpp_buffer_group_dump(p, caller);
         }
     }
+
+    if (!buffer)
+        p->stat.miss_count++;
     pthread_mutex_unlock(&p->buf_lock);
 
     MPP_BUF_FUNCTION_LEAVE();
@@ -673,6 +730,25 @@ MPP_RET mpp_buffer_group_reset(MppBufferGroupImpl *p)
     return MPP_OK;
 }
 
+MPP_RET mpp_buffer_group_set_trim(MppBufferGroupImpl *p, size_t size)
+{
+    if (NULL == p) {
+        mpp_err_f("found NULL pointer\n");
+        return MPP_ERR_NULL_PTR;
+    }
+
+    MPP_BUF_FUNCTION_ENTER();
+
+    pthread_mutex_lock(&p->buf_lock);
+    p->trim_size = size;
+    if (size && p->mode == MPP_BUFFER_INTERNAL)
+        trim_unused(p, size, __FUNCTION__);
+    pthread_mutex_unlock(&p->buf_lock);
+
+    MPP_BUF_FUNCTION_LEAVE();
+    return MPP_OK;
+}
+
 MPP_RET mpp_buffer_group_set_callback(MppBufferGroupImpl *p,
                                       MppBufCallback callback, void *arg)
 {
@@ -771,6 +847,7 @@ MppBufferService::MppBufferService()
     INIT_LIST_HEAD(&mListOrphan);
 
     mpp_env_get_u32("mpp_buffer_debug", &mpp_buffer_debug, 0);
+    mpp_env_get_u32("mpp_buffer_trim", &buffer_trim, 0);
 
     // NOTE: Do not create misc group at beginning. Only create on when needed.
     for (i = 0; i < MPP_BUFFER_MODE_BUTT; i++)
@@ -929,6 +1006,12 @@ MppBufferGroupImpl *MppBufferService::get_group(const char *tag, const char *cal
     INIT_LIST_HEAD(&p->list_used);
     INIT_LIST_HEAD(&p->list_unused);
     INIT_HLIST_NODE(&p->hlist);
+    for (RK_U32 i = 0; i < MPP_BUF_SIZE_CLASS_NUM; i++)
+        INIT_LIST_HEAD(&p->list_class[i]);
+    p->class_mask = 0;
+    p->unused_size = 0;
+    p->trim_size = (mode == MPP_BUFFER_INTERNAL) ? ((size_t)buffer_trim << 20) : 0;
+    memset(&p->stat, 0, sizeof(p->stat));
 
     p->log_runtime_en   = (mpp_buffer_debug & MPP_BUF_DBG_OPS_RUNTIME) ? (1) : (0);
     p->log_history_en   = (mpp_buffer_debug & MPP_BUF_DBG_OPS_HISTORY) ? (1) : (0);
@@ -997,6 +1080,9 @@ void MppBufferService::put_group(const char *caller, MppBufferGroupImpl *p)
 
     buf_grp_add_log(p, GRP_RELEASE, caller);
 
+    /* sync with buffer returning from other thread */
+    pthread_mutex_lock(&p->buf_lock);
+
     // remove unused list
     if (!list_empty(&p->list_unused)) {
         MppBufferImpl *pos, *n;
@@ -1007,6 +1093,7 @@ void MppBufferService::put_group(const char *caller, MppBufferGroupImpl *p)
     }
 
     if (list_empty(&p->list_used)) {
+        pthread_mutex_unlock(&p->buf_lock);
         destroy_group(p);
     } else {
         if (!finalizing || (finalizing && p->dump_on_exit)) {
@@ -1031,6 +1118,7 @@ void MppBufferService::put_group(const char *caller, MppBufferGroupImpl *p)
                 put_buffer(p, pos, 0, caller);
             }
 
+            pthread_mutex_unlock(&p->buf_lock);
             destroy_group(p);
         } else {
             // otherwise move the group to list_orphan and wait for buffer release
@@ -1038,6 +1126,7 @@ void MppBufferService::put_group(const char *caller, MppBufferGroupImpl *p)
             list_del_init(&p->list_group);
             list_add_tail(&p->list_group, &mListOrphan);
             p->is_orphan = 1;
+            pthread_mutex_unlock(&p->buf_lock);
         }
     }
 
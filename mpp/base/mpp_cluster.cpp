@@ -30,6 +30,7 @@
 
 #define MPP_CLUSTER_DBG_FLOW            (0x00000001)
 #define MPP_CLUSTER_DBG_LOCK            (0x00000002)
+#define MPP_CLUSTER_DBG_STAT            (0x00000004)
 
 #define cluster_dbg(flag, fmt, ...)     _mpp_dbg(mpp_cluster_debug, flag, fmt, ## __VA_ARGS__)
 #define cluster_dbg_f(flag, fmt, ...)   _mpp_dbg_f(mpp_cluster_debug, flag, fmt, ## __VA_ARGS__)
@@ -37,6 +38,8 @@
 #define cluster_dbg_flow(fmt, ...)      cluster_dbg(MPP_CLUSTER_DBG_FLOW, fmt, ## __VA_ARGS__)
 #define cluster_dbg_lock(fmt, ...)      cluster_dbg(MPP_CLUSTER_DBG_LOCK, fmt, ## __VA_ARGS__)
 
+#define MAX_CLUSTER_WORKER              16
+
 RK_U32 mpp_cluster_debug = 0;
 RK_U32 mpp_cluster_thd_cnt = 1;
 
@@ -72,6 +75,10 @@ struct MppNodeProc_s {
     /* timing statistic */
     RK_U32                  run_count;
     RK_S64                  run_time;
+    RK_S64                  run_time_max;
+    RK_S64                  wait_time;
+    RK_S64                  wait_time_max;
+    RK_U32                  steal_count;
 };
 
 struct MppNodeTask_s {
@@ -79,8 +86,11 @@ struct MppNodeTask_s {
     MppNodeImpl             *node;
     const char              *node_name;
 
-    /* lock ptr to cluster queue lock */
-    ClusterQueue            *queue;
+    /* home worker of the node, other worker can steal it when idle */
+    ClusterWorker           *worker;
+    RK_U32                  priority;
+    /* time when the task is put to wait queue */
+    RK_S64                  sched_time;
 
     MppNodeProc             *proc;
 };
@@ -102,6 +112,10 @@ struct MppNodeImpl_s {
     MppNodeTask             task;
 };
 
+/*
+ * Wait task deque. The owner worker pops from head and the stealing worker
+ * takes from tail so the recently scheduled task keeps its order on owner.
+ */
 struct ClusterQueue_s {
     MppCluster              *cluster;
 
@@ -118,9 +132,16 @@ struct ClusterWorker_s {
     MppThread               *thd;
     MppWorkerState          state;
 
+    /* per worker wait queue for each priority */
+    ClusterQueue            queue[MAX_PRIORITY];
+
     RK_S32                  batch_count;
     RK_S32                  work_count;
     struct list_head        list_task;
+
+    /* statistic */
+    RK_U32                  run_count;
+    RK_U32                  steal_count;
 };
 
 struct MppCluster_s {
@@ -130,7 +151,6 @@ struct MppCluster_s {
     RK_S32                  node_id;
     RK_S32                  worker_id;
 
-    ClusterQueue            queue[MAX_PRIORITY];
     RK_S32                  node_count;
 
     /* multi-worker info */
@@ -176,7 +196,41 @@ static MPP_RET cluster_queue_unlock_f(const char *caller, ClusterQueue *queue)
     return (ret) ? MPP_NOK : MPP_OK;
 }
 
-void cluster_signal_f(const char *caller, MppCluster *p);
+void cluster_signal_f(const char *caller, MppCluster *p, ClusterWorker *hint);
+
+static void cluster_queue_push(ClusterQueue *queue, MppNodeTask *task)
+{
+    cluster_queue_lock(queue);
+    mpp_assert(list_empty(&task->list_sched));
+    list_add_tail(&task->list_sched, &queue->list);
+    queue->count++;
+    cluster_queue_unlock(queue);
+}
+
+/* pop from head on owner or take from tail on steal */
+static MppNodeTask *cluster_queue_pop(ClusterQueue *queue, RK_S32 steal)
+{
+    MppNodeTask *task = NULL;
+
+    /* unlocked peek to skip the empty queue quickly */
+    if (!queue->count)
+        return NULL;
+
+    cluster_queue_lock(queue);
+    if (!list_empty(&queue->list)) {
+        mpp_assert(queue->count);
+        if (steal)
+            task = list_entry(queue->list.prev, MppNodeTask, list_sched);
+        else
+            task = list_first_entry(&queue->list, MppNodeTask, list_sched);
+
+        list_del_init(&task->list_sched);
+        queue->count--;
+    }
+    cluster_queue_unlock(queue);
+
+    return task;
+}
 
 MPP_RET mpp_cluster_queue_init(ClusterQueue *queue, MppCluster *cluster)
 {
@@ -205,14 +259,15 @@ MPP_RET mpp_cluster_queue_deinit(ClusterQueue *queue)
 }
 
 MPP_RET mpp_node_task_attach(MppNodeTask *task, MppNodeImpl *node,
-                             ClusterQueue *queue, MppNodeProc *proc)
+                             ClusterWorker *worker, MppNodeProc *proc)
 {
     INIT_LIST_HEAD(&task->list_sched);
 
     task->node = node;
     task->node_name = node->name;
 
-    task->queue = queue;
+    task->worker = worker;
+    task->priority = node->priority;
     task->proc = proc;
 
     node->state = NODE_VALID | NODE_IDLE;
@@ -223,8 +278,9 @@ MPP_RET mpp_node_task_attach(MppNodeTask *task, MppNodeImpl *node,
 
 MPP_RET mpp_node_task_schedule_f(const char *caller, MppNodeTask *task)
 {
-    ClusterQueue *queue = task->queue;
-    MppCluster *cluster = queue->cluster;
+    ClusterWorker *worker = task->worker;
+    ClusterQueue *queue = &worker->queue[task->priority];
+    MppCluster *cluster = worker->cluster;
     MppNodeImpl *node = task->node;
     MppNodeProc *proc = task->proc;
     const char *node_name = task->node_name;
@@ -265,19 +321,16 @@ MPP_RET mpp_node_task_schedule_f(const char *caller, MppNodeTask *task)
 
     switch (action) {
     case NODE_ACT_IDLE_TO_WAIT : {
-        cluster_queue_lock(queue);
-        mpp_assert(list_empty(&task->list_sched));
-        list_add_tail(&task->list_sched, &queue->list);
-        queue->count++;
-        cluster_dbg_flow("%s sched task -> wq %s:%d\n", node_name, cluster->name, queue->count);
-        cluster_queue_unlock(queue);
+        task->sched_time = mpp_time();
+        cluster_queue_push(queue, task);
+        cluster_dbg_flow("%s sched task -> wq %s:%d\n", node_name, worker->name, queue->count);
 
         cluster_dbg_flow("%s sched signal from %s\n", node_name, caller);
-        cluster_signal_f(caller, cluster);
+        cluster_signal_f(caller, cluster, worker);
     } break;
     case NODE_ACT_RUN_TO_SIGNAL : {
-        cluster_dbg_flow("%s sched signal from %s\n", node_name, caller);
-        cluster_signal_f(caller, cluster);
+        /* the running worker will requeue the task after run */
+        cluster_dbg_flow("%s sched signal on run from %s\n", node_name, caller);
     } break;
     }
 
@@ -354,31 +407,79 @@ MPP_RET mpp_node_set_func(MppNode node, TaskProc proc, void *param)
     return MPP_OK;
 }
 
+MPP_RET mpp_node_set_priority(MppNode node, RK_U32 priority)
+{
+    MppNodeImpl *p = (MppNodeImpl *)node;
+
+    if (!p || priority >= MAX_PRIORITY || p->attached) {
+        mpp_err_f("invalid node %p priority %d\n", node, priority);
+        return MPP_NOK;
+    }
+
+    p->priority = priority;
+
+    return MPP_OK;
+}
+
+MPP_RET mpp_node_get_stat(MppNode node, MppNodeStat *stat)
+{
+    MppNodeImpl *p = (MppNodeImpl *)node;
+    MppNodeProc *proc;
+
+    if (!p || !stat)
+        return MPP_NOK;
+
+    proc = &p->work;
+    stat->run_count     = proc->run_count;
+    stat->run_time      = proc->run_time;
+    stat->run_time_max  = proc->run_time_max;
+    stat->wait_time     = proc->wait_time;
+    stat->wait_time_max = proc->wait_time_max;
+    stat->steal_count   = proc->steal_count;
+
+    return MPP_OK;
+}
+
 MPP_RET cluster_worker_init(ClusterWorker *p, MppCluster *cluster)
 {
-    MppThread *thd = NULL;
-    MPP_RET ret = MPP_NOK;
+    RK_S32 i;
 
     INIT_LIST_HEAD(&p->list_task);
     p->worker_id = cluster->worker_id++;
 
+    for (i = 0; i < MAX_PRIORITY; i++)
+        mpp_cluster_queue_init(&p->queue[i], cluster);
+
     p->batch_count = 1;
     p->work_count = 0;
     p->cluster = cluster;
     p->state = WORKER_IDLE;
+    p->thd = NULL;
+    p->run_count = 0;
+    p->steal_count = 0;
     snprintf(p->name, sizeof(p->name) - 1, "%d:W%d", cluster->pid, p->worker_id);
-    thd = new MppThread(cluster->worker_func, p, p->name);
-    if (thd) {
-        p->thd = thd;
-        thd->start();
-        ret = MPP_OK;
-    }
 
-    return ret;
+    return MPP_OK;
+}
+
+/* start after all workers are initialized for the queues may be stolen */
+MPP_RET cluster_worker_start(ClusterWorker *p)
+{
+    MppThread *thd = new MppThread(p->cluster->worker_func, p, p->name);
+
+    if (!thd)
+        return MPP_NOK;
+
+    p->thd = thd;
+    thd->start();
+
+    return MPP_OK;
 }
 
 MPP_RET cluster_worker_deinit(ClusterWorker *p)
 {
+    RK_S32 i;
+
     if (p->thd) {
         p->thd->stop();
         delete p->thd;
@@ -388,15 +489,40 @@ MPP_RET cluster_worker_deinit(ClusterWorker *p)
     mpp_assert(list_empty(&p->list_task));
     mpp_assert(p->work_count == 0);
 
+    cluster_dbg(MPP_CLUSTER_DBG_STAT, "%s run %d steal %d\n",
+                p->name, p->run_count, p->steal_count);
+
+    for (i = 0; i < MAX_PRIORITY; i++)
+        mpp_cluster_queue_deinit(&p->queue[i]);
+
     p->batch_count = 0;
     p->cluster = NULL;
 
     return MPP_OK;
 }
 
-RK_S32 cluster_worker_get_task(ClusterWorker *p)
+static MppNodeTask *cluster_worker_steal_task(ClusterWorker *p, RK_U32 priority)
 {
     MppCluster *cluster = p->cluster;
+    RK_S32 count = cluster->worker_count;
+    RK_S32 i;
+
+    for (i = 1; i < count; i++) {
+        ClusterWorker *victim = &cluster->worker[(p->worker_id + i) % count];
+        MppNodeTask *task = cluster_queue_pop(&victim->queue[priority], 1);
+
+        if (task) {
+            cluster_dbg_flow("%s steal P%d %s from %s\n", p->name, priority,
+                             task->node_name, victim->name);
+            return task;
+        }
+    }
+
+    return NULL;
+}
+
+RK_S32 cluster_worker_get_task(ClusterWorker *p)
+{
     RK_S32 batch_count = p->batch_count;
     RK_S32 count = 0;
     RK_U32 new_st;
@@ -406,27 +532,29 @@ RK_S32 cluster_worker_get_task(ClusterWorker *p)
 
     cluster_dbg_flow("%s get %d task start\n", p->name, batch_count);
 
-    for (i = 0; i < MAX_PRIORITY; i++) {
-        ClusterQueue *queue = &cluster->queue[i];
-        MppNodeTask *task = NULL;
-        MppNodeImpl *node = NULL;
+    /* higher priority task on other worker goes before own lower priority task */
+    for (i = 0; i < MAX_PRIORITY && count < batch_count; i++) {
+        ClusterQueue *queue = &p->queue[i];
 
         do {
-            cluster_queue_lock(queue);
-
-            if (list_empty(&queue->list)) {
-                mpp_assert(queue->count == 0);
-                cluster_dbg_flow("%s get P%d task ret no task\n", p->name, i);
-                cluster_queue_unlock(queue);
-                break;
+            MppNodeTask *task = cluster_queue_pop(queue, 0);
+            MppNodeImpl *node = NULL;
+            MppNodeProc *proc = NULL;
+            RK_S64 wait_time;
+
+            if (!task) {
+                task = cluster_worker_steal_task(p, i);
+                if (!task) {
+                    cluster_dbg_flow("%s get P%d task ret no task\n", p->name, i);
+                    break;
+                }
+
+                task->proc->steal_count++;
+                p->steal_count++;
             }
 
-            mpp_assert(queue->count);
-            task = list_first_entry(&queue->list, MppNodeTask, list_sched);
-            list_del_init(&task->list_sched);
             node = task->node;
-
-            queue->count--;
+            proc = task->proc;
 
             do {
                 old_st = node->state;
@@ -436,20 +564,17 @@ RK_S32 cluster_worker_get_task(ClusterWorker *p)
                 ret = MPP_BOOL_CAS(&node->state, old_st, new_st);
             } while (!ret);
 
+            wait_time = mpp_time() - task->sched_time;
+            proc->wait_time += wait_time;
+            if (wait_time > proc->wait_time_max)
+                proc->wait_time_max = wait_time;
+
             list_add_tail(&task->list_sched, &p->list_task);
             p->work_count++;
             count++;
 
             cluster_dbg_flow("%s get P%d %s -> rq %d\n", p->name, i, node->name, p->work_count);
-
-            cluster_queue_unlock(queue);
-
-            if (count >= batch_count)
-                break;
-        } while (1);
-
-        if (count >= batch_count)
-            break;
+        } while (count < batch_count);
     }
 
     cluster_dbg_flow("%s get %d task ret %d\n", p->name, batch_count, count);
@@ -485,8 +610,12 @@ static void cluster_worker_run_task(ClusterWorker *p)
         time_end = mpp_time();
 
         cluster_dbg_flow("%s run %s ret %d\n", p->name, task->node_name, proc_ret);
-        proc->run_time += time_end - time_start;
+        time_end -= time_start;
+        proc->run_time += time_end;
+        if (time_end > proc->run_time_max)
+            proc->run_time_max = time_end;
         proc->run_count++;
+        p->run_count++;
 
         state = node->state;
         if (!(state & NODE_VALID)) {
@@ -497,7 +626,8 @@ static void cluster_worker_run_task(ClusterWorker *p)
             sem_post(&node->sem_detach);
             cluster_dbg_flow("%s run sem post done\n", p->name);
         } else if (state & NODE_SIGNAL) {
-            ClusterQueue *queue = task->queue;
+            /* requeue on current worker for the task is cache hot here */
+            ClusterQueue *queue = &p->queue[task->priority];
 
             list_del_init(&task->list_sched);
 
@@ -510,10 +640,12 @@ static void cluster_worker_run_task(ClusterWorker *p)
 
             cluster_dbg_flow("%s run state %x -> %x signal -> wait\n", p->name, old_st, new_st);
 
-            cluster_queue_lock(queue);
-            list_add_tail(&task->list_sched, &queue->list);
-            queue->count++;
-            cluster_queue_unlock(queue);
+            task->sched_time = mpp_time();
+            cluster_queue_push(queue, task);
+
+            /* let idle worker steal when more than one task is waiting here */
+            if (queue->count > 1)
+                cluster_signal_f(__FUNCTION__, p->cluster, NULL);
         } else {
             list_del_init(&task->list_sched);
             do {
@@ -566,22 +698,38 @@ static void *cluster_worker(void *data)
     return NULL;
 }
 
-void cluster_signal_f(const char *caller, MppCluster *p)
+static RK_S32 cluster_worker_signal(ClusterWorker *worker)
+{
+    MppThread *thd = worker->thd;
+    AutoMutex auto_lock(thd->mutex());
+
+    if (worker->state == WORKER_IDLE) {
+        thd->signal();
+        cluster_dbg_flow("%s signal\n", worker->name);
+        return 1;
+    }
+
+    return 0;
+}
+
+/* wake up the hint worker first then any idle worker which will steal */
+void cluster_signal_f(const char *caller, MppCluster *p, ClusterWorker *hint)
 {
     RK_S32 i;
 
     cluster_dbg_flow("%s signal from %s\n", p->name, caller);
 
+    if (hint && cluster_worker_signal(hint))
+        return;
+
     for (i = 0; i < p->worker_count; i++) {
         ClusterWorker *worker = &p->worker[i];
-        MppThread *thd = worker->thd;
-        AutoMutex auto_lock(thd->mutex());
 
-        if (worker->state == WORKER_IDLE) {
-            thd->signal();
-            cluster_dbg_flow("%s signal\n", p->name);
+        if (worker == hint)
+            continue;
+
+        if (cluster_worker_signal(worker))
             break;
-        }
     }
 }
 
@@ -642,28 +790,30 @@ MppCluster *MppClusterServer::get(MppClientType client_type)
         if (p)
             goto done;
 
-        p = mpp_malloc(MppCluster, 1);
+        p = mpp_calloc(MppCluster, 1);
         if (p) {
-            for (i = 0; i < MAX_PRIORITY; i++)
-                mpp_cluster_queue_init(&p->queue[i], p);
-
             p->pid  = getpid();
             p->client_type = client_type;
             snprintf(p->name, sizeof(p->name) - 1, "%d:%d", p->pid, client_type);
             p->node_id = 0;
             p->worker_id = 0;
             p->worker_func = cluster_worker;
-            p->worker_count = mpp_cluster_thd_cnt;
-
-            mpp_assert(p->worker_count > 0);
+            p->worker_count = MPP_CLIP3(1, MAX_CLUSTER_WORKER, (RK_S32)mpp_cluster_thd_cnt);
 
-            p->worker = mpp_malloc(ClusterWorker, p->worker_count);
+            p->worker = mpp_calloc(ClusterWorker, p->worker_count);
+            if (!p->worker) {
+                MPP_FREE(p);
+                goto done;
+            }
 
             for (i = 0; i < p->worker_count; i++)
                 cluster_worker_init(&p->worker[i], p);
 
+            for (i = 0; i < p->worker_count; i++)
+                cluster_worker_start(&p->worker[i]);
+
             mClusters[client_type] = p;
-            cluster_dbg_flow("%s created\n", p->name);
+            cluster_dbg_flow("%s created with %d workers\n", p->name, p->worker_count);
         }
     }
 
@@ -694,7 +844,9 @@ MPP_RET MppClusterServer::put(MppClientType client_type)
 
     cluster_dbg_flow("put %s\n", p->name);
 
+    mpp_free(p->worker);
     mpp_free(p);
+    mClusters[client_type] = NULL;
 
     return MPP_OK;
 }
@@ -703,17 +855,20 @@ MPP_RET mpp_node_attach(MppNode node, MppClientType type)
 {
     MppNodeImpl *impl = (MppNodeImpl *)node;
     MppCluster *p = MppClusterServer::single()->get(type);
-    RK_U32 priority = impl->priority;
-    ClusterQueue *queue = &p->queue[priority];
+    ClusterWorker *worker = NULL;
+
+    if (!p)
+        return MPP_NOK;
 
-    mpp_assert(priority < MAX_PRIORITY);
-    mpp_assert(p);
+    mpp_assert(impl->priority < MAX_PRIORITY);
 
     impl->node_id = MPP_FETCH_ADD(&p->node_id, 1);
 
     snprintf(impl->name, sizeof(impl->name) - 1, "%s:%d", p->name, impl->node_id);
 
-    mpp_node_task_attach(&impl->task, impl, queue, &impl->work);
+    /* spread nodes on workers as home worker */
+    worker = &p->worker[impl->node_id % p->worker_count];
+    mpp_node_task_attach(&impl->task, impl, worker, &impl->work);
 
     MPP_FETCH_ADD(&p->node_count, 1);
 
@@ -28,6 +28,8 @@
 
 #include "mpp_cfg.h"
 #include "mpp_dec_cfg_impl.h"
+#include "mpp_dec_cfg_entry.h"
+#include "mpp_dec_cfg_trie.h"
 
 #define MPP_DEC_CFG_DBG_FUNC            (0x00000001)
 #define MPP_DEC_CFG_DBG_INFO            (0x00000002)
@@ -45,22 +47,23 @@ RK_U32 mpp_dec_cfg_debug = 0;
 
 typedef struct MppDecCfgInfo_t {
     MppCfgInfoHead      head;
-    MppTrieNode         trie_node[];
-    /* MppCfgInfoNode is following trie_node */
+    /* MppCfgInfoNode array indexed by the flat trie payload */
+    RK_U8               node[];
 } MppDecCfgInfo;
 
-static MppCfgInfoNode *mpp_dec_cfg_find(MppDecCfgInfo *info, const char *name)
+static MppCfgInfoNode *mpp_dec_cfg_find(MppDecCfgInfo *info, MppTrieFlat trie,
+                                        const char *name)
 {
-    MppTrieNode *node;
+    RK_S32 id;
 
-    if (NULL == info || NULL == name)
+    if (NULL == info || NULL == trie || NULL == name)
         return NULL;
 
-    node = mpp_trie_get_node(info->trie_node, name);
-    if (NULL == node)
+    id = mpp_trie_flat_get_id(trie, name);
+    if (id < 0)
         return NULL;
 
-    return (MppCfgInfoNode *)(((char *)info->trie_node) + node->id);
+    return (MppCfgInfoNode *)(info->node + id);
 }
 
 class MppDecCfgService
@@ -72,6 +75,7 @@ private:
     MppDecCfgService &operator=(const MppDecCfgService &);
 
     MppDecCfgInfo *mInfo;
+    MppTrieFlat mTrie;
     RK_S32 mCfgSize;
 
 public:
@@ -83,17 +87,16 @@ public:
         return &instance;
     }
 
-    MppCfgInfoNode *get_info(const char *name) { return mpp_dec_cfg_find(mInfo, name); };
+    MppCfgInfoNode *get_info(const char *name) { return mpp_dec_cfg_find(mInfo, mTrie, name); };
     MppCfgInfoNode *get_info_root();
 
-    RK_S32 get_node_count() { return mInfo ? mInfo->head.node_count : 0; };
+    RK_S32 get_node_count() { return mpp_trie_flat_get_node_count(mTrie); };
     RK_S32 get_info_count() { return mInfo ? mInfo->head.info_count : 0; };
     RK_S32 get_info_size() { return mInfo ? mInfo->head.info_size : 0; };
     RK_S32 get_cfg_size() { return mCfgSize; };
 };
 
 #define EXPAND_AS_API(base, name, cfg_type, in_type, flag, field_change, field_data) \
-    MppCfgApi api_##base##_##name = \
     { \
         #base":"#name, \
         CFG_FUNC_TYPE_##cfg_type, \
@@ -101,85 +104,50 @@ public:
         flag, \
         (RK_U32)((long)&(((MppDecCfgSet *)0)->field_change.field_data)), \
         sizeof((((MppDecCfgSet *)0)->field_change.field_data)), \
-    };
-
-#define EXPAND_AS_ARRAY(base, name, cfg_type, in_type, flag, field_change, field_data) \
-    &api_##base##_##name,
-
-#define ENTRY_TABLE(ENTRY)  \
-    /* rc config */ \
-    ENTRY(base, type,           U32, MppCtxType,        MPP_DEC_CFG_CHANGE_TYPE,            base, type) \
-    ENTRY(base, coding,         U32, MppCodingType,     MPP_DEC_CFG_CHANGE_CODING,          base, coding) \
-    ENTRY(base, hw_type,        U32, MppCodingType,     MPP_DEC_CFG_CHANGE_HW_TYPE,         base, hw_type) \
-    ENTRY(base, batch_mode,     U32, RK_U32,            MPP_DEC_CFG_CHANGE_BATCH_MODE,      base, batch_mode) \
-    ENTRY(base, out_fmt,        U32, MppFrameFormat,    MPP_DEC_CFG_CHANGE_OUTPUT_FORMAT,   base, out_fmt) \
-    ENTRY(base, fast_out,       U32, RK_U32,            MPP_DEC_CFG_CHANGE_FAST_OUT,        base, fast_out) \
-    ENTRY(base, fast_parse,     U32, RK_U32,            MPP_DEC_CFG_CHANGE_FAST_PARSE,      base, fast_parse) \
-    ENTRY(base, split_parse,    U32, RK_U32,            MPP_DEC_CFG_CHANGE_SPLIT_PARSE,     base, split_parse) \
-    ENTRY(base, internal_pts,   U32, RK_U32,            MPP_DEC_CFG_CHANGE_INTERNAL_PTS,    base, internal_pts) \
-    ENTRY(base, sort_pts,       U32, RK_U32,            MPP_DEC_CFG_CHANGE_SORT_PTS,        base, sort_pts) \
-    ENTRY(base, disable_error,  U32, RK_U32,            MPP_DEC_CFG_CHANGE_DISABLE_ERROR,   base, disable_error) \
-    ENTRY(base, enable_vproc,   U32, RK_U32,            MPP_DEC_CFG_CHANGE_ENABLE_VPROC,    base, enable_vproc) \
-    ENTRY(base, enable_fast_play, U32, RK_U32,          MPP_DEC_CFG_CHANGE_ENABLE_FAST_PLAY, base, enable_fast_play) \
-    ENTRY(base, enable_hdr_meta, U32, RK_U32,           MPP_DEC_CFG_CHANGE_ENABLE_HDR_META, base, enable_hdr_meta) \
-    ENTRY(base, enable_thumbnail, U32, RK_U32,          MPP_DEC_CFG_CHANGE_ENABLE_THUMBNAIL, base, enable_thumbnail) \
-    ENTRY(base, enable_mvc,     U32, RK_U32,            MPP_DEC_CFG_CHANGE_ENABLE_MVC,      base, enable_mvc) \
-    ENTRY(base, disable_thread, U32, RK_U32,            MPP_DEC_CFG_CHANGE_DISABLE_THREAD,  base, disable_thread) \
-    ENTRY(cb, pkt_rdy_cb,       Ptr, MppExtCbFunc,      MPP_DEC_CB_CFG_CHANGE_PKT_RDY,      cb, pkt_rdy_cb) \
-    ENTRY(cb, pkt_rdy_ctx,      Ptr, MppExtCbCtx,       MPP_DEC_CB_CFG_CHANGE_PKT_RDY,      cb, pkt_rdy_ctx) \
-    ENTRY(cb, pkt_rdy_cmd,      S32, RK_S32,            MPP_DEC_CB_CFG_CHANGE_PKT_RDY,      cb, pkt_rdy_cmd) \
-    ENTRY(cb, frm_rdy_cb,       Ptr, MppExtCbFunc,      MPP_DEC_CB_CFG_CHANGE_FRM_RDY,      cb, frm_rdy_cb) \
-    ENTRY(cb, frm_rdy_ctx,      Ptr, MppExtCbCtx,       MPP_DEC_CB_CFG_CHANGE_FRM_RDY,      cb, frm_rdy_ctx) \
-    ENTRY(cb, frm_rdy_cmd,      S32, RK_S32,            MPP_DEC_CB_CFG_CHANGE_FRM_RDY,      cb, frm_rdy_cmd)
-
-static MppDecCfgInfo *mpp_dec_cfg_flaten(MppTrie trie, MppCfgApi **cfgs)
+    },
+
+static const MppCfgApi mpp_dec_cfg_apis[] = {
+    MPP_DEC_CFG_ENTRY_TABLE(EXPAND_AS_API)
+};
+
+static MppDecCfgInfo *mpp_dec_cfg_flaten(MppTrieFlat flat, const MppCfgApi *cfgs,
+                                         RK_S32 info_count)
 {
     MppDecCfgInfo *info = NULL;
-    MppTrieNode *node_root = mpp_trie_node_root(trie);
-    RK_S32 node_count = mpp_trie_get_node_count(trie);
-    RK_S32 info_count = mpp_trie_get_info_count(trie);
-    MppTrieNode *node_trie;
     char *buf = NULL;
     RK_S32 pos = 0;
     RK_S32 len = 0;
     RK_S32 i;
 
-    pos += node_count * sizeof(*node_root);
-
-    mpp_dec_cfg_dbg_info("info node offset %d\n", pos);
-
     /* update info size and string name size */
     for (i = 0; i < info_count; i++) {
-        const char *name = cfgs[i]->name;
-        const char **info_trie = mpp_trie_get_info(trie, name);
-
-        mpp_assert(*info_trie == name);
-        len = strlen(name);
+        len = strlen(cfgs[i].name);
         pos += sizeof(MppCfgInfoNode) + MPP_ALIGN(len + 1, sizeof(RK_U64));
     }
 
+    /* the trie payload is the node offset computed by mpp_cfg_trie_gen */
+    if (info_count != MPP_DEC_CFG_INFO_COUNT || pos != MPP_DEC_CFG_INFO_SIZE) {
+        mpp_err_f("info count %d size %d mismatch trie table %d %d\n",
+                  info_count, pos, MPP_DEC_CFG_INFO_COUNT, MPP_DEC_CFG_INFO_SIZE);
+        return NULL;
+    }
+
     len = pos + sizeof(*info);
-    mpp_dec_cfg_dbg_info("tire + info size %d total %d\n", pos, len);
+    mpp_dec_cfg_dbg_info("info size %d total %d\n", pos, len);
 
     info = mpp_malloc_size(MppDecCfgInfo, len);
     if (NULL == info)
         return NULL;
 
-    memcpy(info->trie_node, node_root, sizeof(*node_root) * node_count);
-
-    node_root = info->trie_node;
-    pos = node_count * sizeof(*node_root);
-    buf = (char *)node_root + pos;
+    pos = 0;
+    buf = (char *)info->node;
 
     for (i = 0; i < info_count; i++) {
         MppCfgInfoNode *node_info = (MppCfgInfoNode *)buf;
-        MppCfgApi *api = cfgs[i];
+        const MppCfgApi *api = &cfgs[i];
         const char *name = api->name;
         RK_S32 node_size;
 
-        node_trie = mpp_trie_get_node(node_root, name);
-        node_trie->id = pos;
-
         node_info->name_len     = MPP_ALIGN(strlen(name) + 1, sizeof(RK_U64));
         node_info->data_type    = api->data_type;
         node_info->flag_offset  = api->flag_offset;
@@ -208,7 +176,7 @@ static MppDecCfgInfo *mpp_dec_cfg_flaten(MppTrie trie, MppCfgApi **cfgs)
 
     info->head.info_size  = pos;
     info->head.info_count = info_count;
-    info->head.node_count = node_count;
+    info->head.node_count = mpp_trie_flat_get_node_count(flat);
     info->head.cfg_size   = sizeof(MppDecCfgSet);
 
     return info;
@@ -216,34 +184,18 @@ static MppDecCfgInfo *mpp_dec_cfg_flaten(MppTrie trie, MppCfgApi **cfgs)
 
 MppDecCfgService::MppDecCfgService() :
     mInfo(NULL),
+    mTrie(NULL),
     mCfgSize(0)
 {
-    ENTRY_TABLE(EXPAND_AS_API);
-
-    MppCfgApi *cfgs[] = {
-        ENTRY_TABLE(EXPAND_AS_ARRAY)
-    };
-
-    RK_S32 cfg_cnt = MPP_ARRAY_ELEMS(cfgs);
-    MppTrie trie;
-    MPP_RET ret;
-    RK_S32 i;
-    /*
-     * NOTE: The dec_node_len is not the real node count should be allocated
-     * The max node count should be stream lengthg * 2 if each word is different.
-     */
-    ret = mpp_trie_init(&trie, 334, cfg_cnt);
-    if (ret) {
-        mpp_err_f("failed to init dec cfg set trie\n");
+    /* the flat trie is a const table generated on the build host */
+    mTrie = (MppTrieFlat)mpp_dec_cfg_trie;
+    mInfo = mpp_dec_cfg_flaten(mTrie, mpp_dec_cfg_apis, MPP_ARRAY_ELEMS(mpp_dec_cfg_apis));
+    if (NULL == mInfo) {
+        mpp_err_f("failed to init dec cfg info\n");
         return ;
     }
-    for (i = 0; i < cfg_cnt; i++)
-        mpp_trie_add_info(trie, &cfgs[i]->name);
 
-    mInfo = mpp_dec_cfg_flaten(trie, cfgs);
     mCfgSize = mInfo->head.cfg_size;
-
-    mpp_trie_deinit(trie);
 }
 
 MppDecCfgService::~MppDecCfgService()
@@ -256,7 +208,7 @@ MppCfgInfoNode *MppDecCfgService::get_info_root()
     if (NULL == mInfo)
         return NULL;
 
-    return (MppCfgInfoNode *)(mInfo->trie_node + mInfo->head.node_count);
+    return (MppCfgInfoNode *)mInfo->node;
 }
 
 void mpp_dec_cfg_set_default(MppDecCfgSet *cfg)
@@ -0,0 +1,39 @@
+/* generated by mpp_cfg_trie_gen from mpp_dec_cfg_entry.h, do not edit */
+
+#ifndef __MPP_DEC_CFG_TRIE_H__
+#define __MPP_DEC_CFG_TRIE_H__
+
+#define MPP_DEC_CFG_INFO_COUNT       23
+#define MPP_DEC_CFG_INFO_SIZE        1904
+
+#ifndef MPP_CFG_TRIE_ALIGN
+#if defined(__GNUC__)
+#define MPP_CFG_TRIE_ALIGN  __attribute__((aligned(64)))
+#else
+#define MPP_CFG_TRIE_ALIGN
+#endif
+#endif
+
+/* MppTrieFlat of 32 nodes in little endian words */
+static const RK_U32 mpp_dec_cfg_trie[144] MPP_CFG_TRIE_ALIGN = {
+    0x00000240, 0x00000020, 0x00000017, 0x00000000, 0xffffffff, 0x63620200, 0x001a0010, 0x00000000,
+    0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+    0xffffffff, 0x73610a04, 0x63623a65, 0x68666564, 0x74736f69, 0x00240020, 0x00300027, 0x003b0037,
+    0x00450040, 0x004b0048, 0xffffffff, 0x3a620202, 0x00507066, 0x00000056, 0x00000000, 0x00000000,
+    0x000000f0, 0x74610009, 0x6d5f6863, 0x0065646f, 0x00000050, 0x646f0005, 0x00676e69, 0xffffffff,
+    0x73690207, 0x656c6261, 0x0074655f, 0x0060005c, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+    0xffffffff, 0x616e0506, 0x5f656c62, 0x746d6866, 0x00630076, 0x006b0067, 0x00740070, 0xffffffff,
+    0x73610204, 0x706f5f74, 0x00790077, 0x000000a0, 0x5f770006, 0x65707974, 0x00000000, 0x00000000,
+    0x00000288, 0x746e000b, 0x616e7265, 0x74705f6c, 0x00000073, 0x00000140, 0x74750006, 0x746d665f,
+    0xffffffff, 0x706f0200, 0x0080007c, 0x00000000, 0x70790003, 0x00000065, 0x00000000, 0x00000000,
+    0xffffffff, 0x6d720308, 0x7964725f, 0x6d62635f, 0x00840074, 0x00880086, 0xffffffff, 0x746b0308,
+    0x7964725f, 0x6d62635f, 0x008a0074, 0x008e008c, 0x00000330, 0x72720004, 0x0000726f, 0x00000000,
+    0x00000538, 0x72680005, 0x00646165, 0x000003e0, 0x73610008, 0x6c705f74, 0x00007961, 0x00000438,
+    0x72640007, 0x74656d5f, 0x00000061, 0x000004e8, 0x63760002, 0x00000000, 0x00000000, 0x00000000,
+    0x00000490, 0x75680008, 0x616e626d, 0x00006c69, 0x00000388, 0x72700004, 0x0000636f, 0x00000190,
+    0x74750002, 0x000001e0, 0x72610004, 0x00006573, 0x000002e0, 0x74720006, 0x7374705f, 0x00000000,
+    0x00000230, 0x696c0009, 0x61705f74, 0x00657372, 0x00000680, 0x00000000, 0x00000720, 0x00640001,
+    0x000006d0, 0x00780001, 0x00000590, 0x00000000, 0x00000630, 0x00640001, 0x000005e0, 0x00780001,
+};
+
+#endif /*__MPP_DEC_CFG_TRIE_H__*/
@@ -29,6 +29,8 @@
 
 #include "mpp_cfg.h"
 #include "mpp_enc_cfg_impl.h"
+#include "mpp_enc_cfg_entry.h"
+#include "mpp_enc_cfg_trie.h"
 
 #define MPP_ENC_CFG_DBG_FUNC            (0x00000001)
 #define MPP_ENC_CFG_DBG_INFO            (0x00000002)
@@ -50,10 +52,6 @@ RK_U32 mpp_enc_cfg_debug = 0;
  *   +----------+
  *   |   head   |
  *   +----------+
- *   |   trie   |
- *   |   node   |
- *   |   ....   |
- *   +----------+
  *   |   info   |
  *   |   node   |
  *   |   ....   |
@@ -61,22 +59,23 @@ RK_U32 mpp_enc_cfg_debug = 0;
  */
 typedef struct MppEncCfgInfo_t {
     MppCfgInfoHead      head;
-    MppTrieNode         trie_node[];
-    /* MppCfgInfoNode is following trie_node */
+    /* MppCfgInfoNode array indexed by the flat trie payload */
+    RK_U8               node[];
 } MppEncCfgInfo;
 
-static MppCfgInfoNode *mpp_enc_cfg_find(MppEncCfgInfo *info, const char *name)
+static MppCfgInfoNode *mpp_enc_cfg_find(MppEncCfgInfo *info, MppTrieFlat trie,
+                                        const char *name)
 {
-    MppTrieNode *node;
+    RK_S32 id;
 
-    if (NULL == info || NULL == name)
+    if (NULL == info || NULL == trie || NULL == name)
         return NULL;
 
-    node = mpp_trie_get_node(info->trie_node, name);
-    if (NULL == node)
+    id = mpp_trie_flat_get_id(trie, name);
+    if (id < 0)
         return NULL;
 
-    return (MppCfgInfoNode *)(((char *)info->trie_node) + node->id);
+    return (MppCfgInfoNode *)(info->node + id);
 }
 
 class MppEncCfgService
@@ -88,6 +87,7 @@ private:
     MppEncCfgService &operator=(const MppEncCfgService &);
 
     MppEncCfgInfo *mInfo;
+    MppTrieFlat mTrie;
     RK_S32 mCfgSize;
 
 public:
@@ -99,17 +99,16 @@ public:
         return &instance;
     }
 
-    MppCfgInfoNode *get_info(const char *name) { return mpp_enc_cfg_find(mInfo, name); };
+    MppCfgInfoNode *get_info(const char *name) { return mpp_enc_cfg_find(mInfo, mTrie, name); };
     MppCfgInfoNode *get_info_root();
 
-    RK_S32 get_node_count() { return mInfo ? mInfo->head.node_count : 0; };
+    RK_S32 get_node_count() { return mpp_trie_flat_get_node_count(mTrie); };
     RK_S32 get_info_count() { return mInfo ? mInfo->head.info_count : 0; };
     RK_S32 get_info_size() { return mInfo ? mInfo->head.info_size : 0; };
     RK_S32 get_cfg_size() { return mCfgSize; };
 };
 
 #define EXPAND_AS_API(base, name, cfg_type, in_type, flag, field_change, field_data) \
-    MppCfgApi api_##base##_##name = \
     { \
         #base":"#name, \
         CFG_FUNC_TYPE_##cfg_type, \
@@ -117,213 +116,50 @@ public:
         flag, \
         (RK_U32)((long)&(((MppEncCfgSet *)0)->field_change.field_data)), \
         sizeof((((MppEncCfgSet *)0)->field_change.field_data)), \
-    };
-
-#define EXPAND_AS_ARRAY(base, name, cfg_type, in_type, flag, field_change, field_data) \
-    &api_##base##_##name,
-
-#define ENTRY_TABLE(ENTRY)  \
-    /* base config */ \
-    ENTRY(base, low_delay,      S32, RK_S32,            MPP_ENC_BASE_CFG_CHANGE_LOW_DELAY,      base, low_delay) \
-    /* rc config */ \
-    ENTRY(rc,   mode,           S32, MppEncRcMode,      MPP_ENC_RC_CFG_CHANGE_RC_MODE,          rc, rc_mode) \
-    ENTRY(rc,   bps_target,     S32, RK_S32,            MPP_ENC_RC_CFG_CHANGE_BPS,              rc, bps_target) \
-    ENTRY(rc,   bps_max,        S32, RK_S32,            MPP_ENC_RC_CFG_CHANGE_BPS,              rc, bps_max) \
-    ENTRY(rc,   bps_min,        S32, RK_S32,            MPP_ENC_RC_CFG_CHANGE_BPS,              rc, bps_min) \
-    ENTRY(rc,   fps_in_flex,    S32, RK_S32,            MPP_ENC_RC_CFG_CHANGE_FPS_IN,           rc, fps_in_flex) \
-    ENTRY(rc,   fps_in_num,     S32, RK_S32,            MPP_ENC_RC_CFG_CHANGE_FPS_IN,           rc, fps_in_num) \
-    ENTRY(rc,   fps_in_denorm,  S32, RK_S32,            MPP_ENC_RC_CFG_CHANGE_FPS_IN,           rc, fps_in_denorm) \
-    ENTRY(rc,   fps_out_flex,   S32, RK_S32,            MPP_ENC_RC_CFG_CHANGE_FPS_OUT,          rc, fps_out_flex) \
-    ENTRY(rc,   fps_out_num,    S32, RK_S32,            MPP_ENC_RC_CFG_CHANGE_FPS_OUT,          rc, fps_out_num) \
-    ENTRY(rc,   fps_out_denorm, S32, RK_S32,            MPP_ENC_RC_CFG_CHANGE_FPS_OUT,          rc, fps_out_denorm) \
-    ENTRY(rc,   gop,            S32, RK_S32,            MPP_ENC_RC_CFG_CHANGE_GOP,              rc, gop) \
-    ENTRY(rc,   ref_cfg,        Ptr, void *,            MPP_ENC_RC_CFG_CHANGE_GOP_REF_CFG,      rc, ref_cfg) \
-    ENTRY(rc,   max_reenc_times,U32, RK_U32,            MPP_ENC_RC_CFG_CHANGE_MAX_REENC,        rc, max_reenc_times) \
-    ENTRY(rc,   priority,       U32, MppEncRcPriority,  MPP_ENC_RC_CFG_CHANGE_PRIORITY,         rc, rc_priority) \
-    ENTRY(rc,   drop_mode,      U32, MppEncRcDropFrmMode, MPP_ENC_RC_CFG_CHANGE_DROP_FRM,       rc, drop_mode) \
-    ENTRY(rc,   drop_thd,       U32, RK_U32,            MPP_ENC_RC_CFG_CHANGE_DROP_FRM,         rc, drop_threshold) \
-    ENTRY(rc,   drop_gap,       U32, RK_U32,            MPP_ENC_RC_CFG_CHANGE_DROP_FRM,         rc, drop_gap) \
-    ENTRY(rc,   max_i_prop,     S32, RK_S32,            MPP_ENC_RC_CFG_CHANGE_MAX_I_PROP,       rc, max_i_prop) \
-    ENTRY(rc,   min_i_prop,     S32, RK_S32,            MPP_ENC_RC_CFG_CHANGE_MIN_I_PROP,       rc, min_i_prop) \
-    ENTRY(rc,   init_ip_ratio,  S32, RK_S32,            MPP_ENC_RC_CFG_CHANGE_INIT_IP_RATIO,    rc, init_ip_ratio) \
-    ENTRY(rc,   super_mode,     U32, MppEncRcSuperFrameMode, MPP_ENC_RC_CFG_CHANGE_SUPER_FRM,   rc, super_mode) \
-    ENTRY(rc,   super_i_thd,    U32, RK_U32,            MPP_ENC_RC_CFG_CHANGE_SUPER_FRM,        rc, super_i_thd) \
-    ENTRY(rc,   super_p_thd,    U32, RK_U32,            MPP_ENC_RC_CFG_CHANGE_SUPER_FRM,        rc, super_p_thd) \
-    ENTRY(rc,   debreath_en,    U32, RK_U32,            MPP_ENC_RC_CFG_CHANGE_DEBREATH,         rc, debreath_en) \
-    ENTRY(rc,   debreath_strength,  U32, RK_U32,        MPP_ENC_RC_CFG_CHANGE_DEBREATH,         rc, debre_strength) \
-    ENTRY(rc,   qp_init,        S32, RK_S32,            MPP_ENC_RC_CFG_CHANGE_QP_INIT,          rc, qp_init) \
-    ENTRY(rc,   qp_min,         S32, RK_S32,            MPP_ENC_RC_CFG_CHANGE_QP_RANGE,         rc, qp_min) \
-    ENTRY(rc,   qp_max,         S32, RK_S32,            MPP_ENC_RC_CFG_CHANGE_QP_RANGE,         rc, qp_max) \
-    ENTRY(rc,   qp_min_i,       S32, RK_S32,            MPP_ENC_RC_CFG_CHANGE_QP_RANGE_I,       rc, qp_min_i) \
-    ENTRY(rc,   qp_max_i,       S32, RK_S32,            MPP_ENC_RC_CFG_CHANGE_QP_RANGE_I,       rc, qp_max_i) \
-    ENTRY(rc,   qp_step,        S32, RK_S32,            MPP_ENC_RC_CFG_CHANGE_QP_MAX_STEP,      rc, qp_max_step) \
-    ENTRY(rc,   qp_ip,          S32, RK_S32,            MPP_ENC_RC_CFG_CHANGE_QP_IP,            rc, qp_delta_ip) \
-    ENTRY(rc,   qp_vi,          S32, RK_S32,            MPP_ENC_RC_CFG_CHANGE_QP_VI,            rc, qp_delta_vi) \
-    ENTRY(rc,   hier_qp_en,     S32, RK_S32,            MPP_ENC_RC_CFG_CHANGE_HIER_QP,          rc, hier_qp_en) \
-    ENTRY(rc,   hier_qp_delta,  St,  RK_S32 *,          MPP_ENC_RC_CFG_CHANGE_HIER_QP,          rc, hier_qp_delta) \
-    ENTRY(rc,   hier_frame_num, St,  RK_S32 *,          MPP_ENC_RC_CFG_CHANGE_HIER_QP,          rc, hier_frame_num) \
-    ENTRY(rc,   stats_time,     S32, RK_S32,            MPP_ENC_RC_CFG_CHANGE_ST_TIME,          rc, stats_time) \
-    ENTRY(rc,   refresh_en,     U32, RK_U32,            MPP_ENC_RC_CFG_CHANGE_REFRESH,          rc, refresh_en) \
-    ENTRY(rc,   refresh_mode,   U32, MppEncRcRefreshMode, MPP_ENC_RC_CFG_CHANGE_REFRESH,        rc, refresh_mode) \
-    ENTRY(rc,   refresh_num,    U32, RK_U32,            MPP_ENC_RC_CFG_CHANGE_REFRESH,          rc, refresh_num) \
-    ENTRY(rc,   fqp_min_i,      S32, RK_S32,            MPP_ENC_RC_CFG_CHANGE_FQP,              rc, fqp_min_i) \
-    ENTRY(rc,   fqp_min_p,      S32, RK_S32,            MPP_ENC_RC_CFG_CHANGE_FQP,              rc, fqp_min_p) \
-    ENTRY(rc,   fqp_max_i,      S32, RK_S32,            MPP_ENC_RC_CFG_CHANGE_FQP,              rc, fqp_max_i) \
-    ENTRY(rc,   fqp_max_p,      S32, RK_S32,            MPP_ENC_RC_CFG_CHANGE_FQP,              rc, fqp_max_p) \
-    /* prep config */ \
-    ENTRY(prep, width,          S32, RK_S32,            MPP_ENC_PREP_CFG_CHANGE_INPUT,          prep, width) \
-    ENTRY(prep, height,         S32, RK_S32,            MPP_ENC_PREP_CFG_CHANGE_INPUT,          prep, height) \
-    ENTRY(prep, hor_stride,     S32, RK_S32,            MPP_ENC_PREP_CFG_CHANGE_INPUT,          prep, hor_stride) \
-    ENTRY(prep, ver_stride,     S32, RK_S32,            MPP_ENC_PREP_CFG_CHANGE_INPUT,          prep, ver_stride) \
-    ENTRY(prep, format,         S32, MppFrameFormat,    MPP_ENC_PREP_CFG_CHANGE_FORMAT,         prep, format) \
-    ENTRY(prep, colorspace,     S32, MppFrameColorSpace,MPP_ENC_PREP_CFG_CHANGE_COLOR_SPACE,    prep, color) \
-    ENTRY(prep, colorprim,      S32, MppFrameColorPrimaries, MPP_ENC_PREP_CFG_CHANGE_COLOR_PRIME, prep, colorprim) \
-    ENTRY(prep, colortrc,       S32, MppFrameColorTransferCharacteristic, MPP_ENC_PREP_CFG_CHANGE_COLOR_TRC, prep, colortrc) \
-    ENTRY(prep, colorrange,     S32, MppFrameColorRange,MPP_ENC_PREP_CFG_CHANGE_COLOR_RANGE,    prep, range) \
-    ENTRY(prep, range,          S32, MppFrameColorRange,MPP_ENC_PREP_CFG_CHANGE_COLOR_RANGE,    prep, range) \
-    ENTRY(prep, rotation,       S32, MppEncRotationCfg, MPP_ENC_PREP_CFG_CHANGE_ROTATION,       prep, rotation_ext) \
-    ENTRY(prep, mirroring,      S32, RK_S32,            MPP_ENC_PREP_CFG_CHANGE_MIRRORING,      prep, mirroring_ext) \
-    ENTRY(prep, flip,           S32, RK_S32,            MPP_ENC_PREP_CFG_CHANGE_FLIP,           prep, flip) \
-    /* codec coding config */ \
-    ENTRY(codec, type,          S32, MppCodingType,     0,                                      codec, coding) \
-    /* h264 config */ \
-    ENTRY(h264, stream_type,    S32, RK_S32,            MPP_ENC_H264_CFG_STREAM_TYPE,           codec.h264, stream_type) \
-    ENTRY(h264, profile,        S32, RK_S32,            MPP_ENC_H264_CFG_CHANGE_PROFILE,        codec.h264, profile) \
-    ENTRY(h264, level,          S32, RK_S32,            MPP_ENC_H264_CFG_CHANGE_PROFILE,        codec.h264, level) \
-    ENTRY(h264, poc_type,       U32, RK_U32,            MPP_ENC_H264_CFG_CHANGE_POC_TYPE,       codec.h264, poc_type) \
-    ENTRY(h264, log2_max_poc_lsb,   U32, RK_U32,        MPP_ENC_H264_CFG_CHANGE_MAX_POC_LSB,    codec.h264, log2_max_poc_lsb) \
-    ENTRY(h264, log2_max_frm_num,   U32, RK_U32,        MPP_ENC_H264_CFG_CHANGE_MAX_FRM_NUM,    codec.h264, log2_max_frame_num) \
-    ENTRY(h264, gaps_not_allowed,   U32, RK_U32,        MPP_ENC_H264_CFG_CHANGE_GAPS_IN_FRM_NUM, codec.h264, gaps_not_allowed) \
-    ENTRY(h264, cabac_en,       S32, RK_S32,            MPP_ENC_H264_CFG_CHANGE_ENTROPY,        codec.h264, entropy_coding_mode_ex) \
-    ENTRY(h264, cabac_idc,      S32, RK_S32,            MPP_ENC_H264_CFG_CHANGE_ENTROPY,        codec.h264, cabac_init_idc_ex) \
-    ENTRY(h264, trans8x8,       S32, RK_S32,            MPP_ENC_H264_CFG_CHANGE_TRANS_8x8,      codec.h264, transform8x8_mode_ex) \
-    ENTRY(h264, const_intra,    S32, RK_S32,            MPP_ENC_H264_CFG_CHANGE_CONST_INTRA,    codec.h264, constrained_intra_pred_mode) \
-    ENTRY(h264, scaling_list,   S32, RK_S32,            MPP_ENC_H264_CFG_CHANGE_SCALING_LIST,   codec.h264, scaling_list_mode) \
-    ENTRY(h264, cb_qp_offset,   S32, RK_S32,            MPP_ENC_H264_CFG_CHANGE_CHROMA_QP,      codec.h264, chroma_cb_qp_offset) \
-    ENTRY(h264, cr_qp_offset,   S32, RK_S32,            MPP_ENC_H264_CFG_CHANGE_CHROMA_QP,      codec.h264, chroma_cr_qp_offset) \
-    ENTRY(h264, dblk_disable,   S32, RK_S32,            MPP_ENC_H264_CFG_CHANGE_DEBLOCKING,     codec.h264, deblock_disable) \
-    ENTRY(h264, dblk_alpha,     S32, RK_S32,            MPP_ENC_H264_CFG_CHANGE_DEBLOCKING,     codec.h264, deblock_offset_alpha) \
-    ENTRY(h264, dblk_beta,      S32, RK_S32,            MPP_ENC_H264_CFG_CHANGE_DEBLOCKING,     codec.h264, deblock_offset_beta) \
-    ENTRY(h264, qp_init,        S32, RK_S32,            MPP_ENC_RC_CFG_CHANGE_QP_INIT,          rc, qp_init) \
-    ENTRY(h264, qp_min,         S32, RK_S32,            MPP_ENC_RC_CFG_CHANGE_QP_RANGE,         rc, qp_min) \
-    ENTRY(h264, qp_max,         S32, RK_S32,            MPP_ENC_RC_CFG_CHANGE_QP_RANGE,         rc, qp_max) \
-    ENTRY(h264, qp_min_i,       S32, RK_S32,            MPP_ENC_RC_CFG_CHANGE_QP_RANGE_I,       rc, qp_min_i) \
-    ENTRY(h264, qp_max_i,       S32, RK_S32,            MPP_ENC_RC_CFG_CHANGE_QP_RANGE_I,       rc, qp_max_i) \
-    ENTRY(h264, qp_step,        S32, RK_S32,            MPP_ENC_RC_CFG_CHANGE_QP_MAX_STEP,      rc, qp_max_step) \
-    ENTRY(h264, qp_delta_ip,    S32, RK_S32,            MPP_ENC_RC_CFG_CHANGE_QP_IP,            rc, qp_delta_ip) \
-    ENTRY(h264, max_tid,        S32, RK_S32,            MPP_ENC_H264_CFG_CHANGE_MAX_TID,        codec.h264, max_tid) \
-    ENTRY(h264, max_ltr,        S32, RK_S32,            MPP_ENC_H264_CFG_CHANGE_MAX_LTR,        codec.h264, max_ltr_frames) \
-    ENTRY(h264, prefix_mode,    S32, RK_S32,            MPP_ENC_H264_CFG_CHANGE_ADD_PREFIX,     codec.h264, prefix_mode) \
-    ENTRY(h264, base_layer_pid, S32, RK_S32,            MPP_ENC_H264_CFG_CHANGE_BASE_LAYER_PID, codec.h264, base_layer_pid) \
-    ENTRY(h264, constraint_set, U32, RK_U32,            MPP_ENC_H264_CFG_CHANGE_CONSTRAINT_SET, codec.h264, constraint_set) \
-    /* h265 config*/ \
-    ENTRY(h265, profile,        S32, RK_S32,            MPP_ENC_H265_CFG_PROFILE_LEVEL_TILER_CHANGE,    codec.h265, profile) \
-    ENTRY(h265, level,          S32, RK_S32,            MPP_ENC_H265_CFG_PROFILE_LEVEL_TILER_CHANGE,    codec.h265, level) \
-    ENTRY(h265, scaling_list,   U32, RK_U32,            MPP_ENC_H265_CFG_TRANS_CHANGE,                  codec.h265, trans_cfg.defalut_ScalingList_enable) \
-    ENTRY(h265, cb_qp_offset,   S32, RK_S32,            MPP_ENC_H265_CFG_TRANS_CHANGE,                  codec.h265, trans_cfg.cb_qp_offset) \
-    ENTRY(h265, cr_qp_offset,   S32, RK_S32,            MPP_ENC_H265_CFG_TRANS_CHANGE,                  codec.h265, trans_cfg.cr_qp_offset) \
-    ENTRY(h265, dblk_disable,   U32, RK_U32,            MPP_ENC_H265_CFG_DBLK_CHANGE,                   codec.h265, dblk_cfg.slice_deblocking_filter_disabled_flag) \
-    ENTRY(h265, dblk_alpha,     S32, RK_S32,            MPP_ENC_H265_CFG_DBLK_CHANGE,                   codec.h265, dblk_cfg.slice_beta_offset_div2) \
-    ENTRY(h265, dblk_beta,      S32, RK_S32,            MPP_ENC_H265_CFG_DBLK_CHANGE,                   codec.h265, dblk_cfg.slice_tc_offset_div2) \
-    ENTRY(h265, qp_init,        S32, RK_S32,            MPP_ENC_RC_CFG_CHANGE_QP_INIT,          rc, qp_init) \
-    ENTRY(h265, qp_min,         S32, RK_S32,            MPP_ENC_RC_CFG_CHANGE_QP_RANGE,         rc, qp_min) \
-    ENTRY(h265, qp_max,         S32, RK_S32,            MPP_ENC_RC_CFG_CHANGE_QP_RANGE,         rc, qp_max) \
-    ENTRY(h265, qp_min_i,       S32, RK_S32,            MPP_ENC_RC_CFG_CHANGE_QP_RANGE_I,       rc, qp_min_i) \
-    ENTRY(h265, qp_max_i,       S32, RK_S32,            MPP_ENC_RC_CFG_CHANGE_QP_RANGE_I,       rc, qp_max_i) \
-    ENTRY(h265, qp_step,        S32, RK_S32,            MPP_ENC_RC_CFG_CHANGE_QP_MAX_STEP,      rc, qp_max_step) \
-    ENTRY(h265, qp_delta_ip,    S32, RK_S32,            MPP_ENC_RC_CFG_CHANGE_QP_IP,            rc, qp_delta_ip) \
-    ENTRY(h265, sao_luma_disable,   S32, RK_S32,        MPP_ENC_H265_CFG_SAO_CHANGE,            codec.h265, sao_cfg.slice_sao_luma_disable) \
-    ENTRY(h265, sao_chroma_disable, S32, RK_S32,        MPP_ENC_H265_CFG_SAO_CHANGE,            codec.h265, sao_cfg.slice_sao_chroma_disable) \
-    ENTRY(h265, lpf_acs_sli_en, U32, RK_U32,            MPP_ENC_H265_CFG_SLICE_LPFACS_CHANGE,   codec.h265, lpf_acs_sli_en) \
-    ENTRY(h265, lpf_acs_tile_disable, U32, RK_U32,      MPP_ENC_H265_CFG_TILE_LPFACS_CHANGE,    codec.h265, lpf_acs_tile_disable) \
-    ENTRY(h265, auto_tile,      S32, RK_S32,            MPP_ENC_H265_CFG_TILE_CHANGE,           codec.h265, auto_tile) \
-    /* vp8 config */ \
-    ENTRY(vp8,  qp_init,        S32, RK_S32,            MPP_ENC_RC_CFG_CHANGE_QP_INIT,          rc, qp_init) \
-    ENTRY(vp8,  qp_min,         S32, RK_S32,            MPP_ENC_RC_CFG_CHANGE_QP_RANGE,         rc, qp_min) \
-    ENTRY(vp8,  qp_max,         S32, RK_S32,            MPP_ENC_RC_CFG_CHANGE_QP_RANGE,         rc, qp_max) \
-    ENTRY(vp8,  qp_min_i,       S32, RK_S32,            MPP_ENC_RC_CFG_CHANGE_QP_RANGE_I,       rc, qp_min_i) \
-    ENTRY(vp8,  qp_max_i,       S32, RK_S32,            MPP_ENC_RC_CFG_CHANGE_QP_RANGE_I,       rc, qp_max_i) \
-    ENTRY(vp8,  qp_step,        S32, RK_S32,            MPP_ENC_RC_CFG_CHANGE_QP_MAX_STEP,      rc, qp_max_step) \
-    ENTRY(vp8,  qp_delta_ip,    S32, RK_S32,            MPP_ENC_RC_CFG_CHANGE_QP_IP,            rc, qp_delta_ip) \
-    ENTRY(vp8,  disable_ivf,    S32, RK_S32,            MPP_ENC_VP8_CFG_CHANGE_DIS_IVF,         codec.vp8, disable_ivf) \
-    /* jpeg config */ \
-    ENTRY(jpeg, quant,          S32, RK_S32,            MPP_ENC_JPEG_CFG_CHANGE_QP,             codec.jpeg, quant) \
-    ENTRY(jpeg, qtable_y,       Ptr, RK_U8*,            MPP_ENC_JPEG_CFG_CHANGE_QTABLE,         codec.jpeg, qtable_y) \
-    ENTRY(jpeg, qtable_u,       Ptr, RK_U8*,            MPP_ENC_JPEG_CFG_CHANGE_QTABLE,         codec.jpeg, qtable_u) \
-    ENTRY(jpeg, qtable_v,       Ptr, RK_U8*,            MPP_ENC_JPEG_CFG_CHANGE_QTABLE,         codec.jpeg, qtable_v) \
-    ENTRY(jpeg, q_factor,       S32, RK_S32,            MPP_ENC_JPEG_CFG_CHANGE_QFACTOR,        codec.jpeg, q_factor) \
-    ENTRY(jpeg, qf_max,         S32, RK_S32,            MPP_ENC_JPEG_CFG_CHANGE_QFACTOR,        codec.jpeg, qf_max) \
-    ENTRY(jpeg, qf_min,         S32, RK_S32,            MPP_ENC_JPEG_CFG_CHANGE_QFACTOR,        codec.jpeg, qf_min) \
-    /* split config */ \
-    ENTRY(split, mode,          U32, RK_U32,            MPP_ENC_SPLIT_CFG_CHANGE_MODE,          split, split_mode) \
-    ENTRY(split, arg,           U32, RK_U32,            MPP_ENC_SPLIT_CFG_CHANGE_ARG,           split, split_arg) \
-    ENTRY(split, out,           U32, RK_U32,            MPP_ENC_SPLIT_CFG_CHANGE_OUTPUT,        split, split_out) \
-    /* hardware detail config */ \
-    ENTRY(hw,   qp_row,         S32, RK_S32,            MPP_ENC_HW_CFG_CHANGE_QP_ROW,           hw, qp_delta_row) \
-    ENTRY(hw,   qp_row_i,       S32, RK_S32,            MPP_ENC_HW_CFG_CHANGE_QP_ROW_I,         hw, qp_delta_row_i) \
-    ENTRY(hw,   aq_thrd_i,      St,  RK_S32 *,          MPP_ENC_HW_CFG_CHANGE_AQ_THRD_I,        hw, aq_thrd_i) \
-    ENTRY(hw,   aq_thrd_p,      St,  RK_S32 *,          MPP_ENC_HW_CFG_CHANGE_AQ_THRD_P,        hw, aq_thrd_p) \
-    ENTRY(hw,   aq_step_i,      St,  RK_S32 *,          MPP_ENC_HW_CFG_CHANGE_AQ_STEP_I,        hw, aq_step_i) \
-    ENTRY(hw,   aq_step_p,      St,  RK_S32 *,          MPP_ENC_HW_CFG_CHANGE_AQ_STEP_P,        hw, aq_step_p) \
-    ENTRY(hw,   mb_rc_disable,  S32, RK_S32,            MPP_ENC_HW_CFG_CHANGE_MB_RC,            hw, mb_rc_disable) \
-    ENTRY(hw,   mode_bias,      St,  RK_S32 *,          MPP_ENC_HW_CFG_CHANGE_CU_MODE_BIAS,     hw, mode_bias) \
-    ENTRY(hw,   skip_bias_en,   S32, RK_S32,            MPP_ENC_HW_CFG_CHANGE_CU_SKIP_BIAS,     hw, skip_bias_en) \
-    ENTRY(hw,   skip_sad,       S32, RK_S32,            MPP_ENC_HW_CFG_CHANGE_CU_SKIP_BIAS,     hw, skip_sad) \
-    ENTRY(hw,   skip_bias,      S32, RK_S32,            MPP_ENC_HW_CFG_CHANGE_CU_SKIP_BIAS,     hw, skip_bias) \
-    ENTRY(hw,   qbias_i,        S32, RK_S32,            MPP_ENC_HW_CFG_CHANGE_QBIAS_I,          hw, qbias_i) \
-    ENTRY(hw,   qbias_p,        S32, RK_S32,            MPP_ENC_HW_CFG_CHANGE_QBIAS_P,          hw, qbias_p) \
-    ENTRY(hw,   qbias_en,       S32, RK_S32,            MPP_ENC_HW_CFG_CHANGE_QBIAS_EN,         hw, qbias_en) \
-    /* quality fine tuning config */ \
-    ENTRY(tune, scene_mode,     S32, MppEncSceneMode,   MPP_ENC_TUNE_CFG_CHANGE_SCENE_MODE,     tune, scene_mode)
-
-static MppEncCfgInfo *mpp_enc_cfg_flaten(MppTrie trie, MppCfgApi **cfgs)
+    },
+
+static const MppCfgApi mpp_enc_cfg_apis[] = {
+    MPP_ENC_CFG_ENTRY_TABLE(EXPAND_AS_API)
+};
+
+static MppEncCfgInfo *mpp_enc_cfg_flaten(MppTrieFlat flat, const MppCfgApi *cfgs,
+                                         RK_S32 info_count)
 {
     MppEncCfgInfo *info = NULL;
-    MppTrieNode *node_root = mpp_trie_node_root(trie);
-    RK_S32 node_count = mpp_trie_get_node_count(trie);
-    RK_S32 info_count = mpp_trie_get_info_count(trie);
-    MppTrieNode *node_trie;
     char *buf = NULL;
     RK_S32 pos = 0;
     RK_S32 len = 0;
     RK_S32 i;
 
-    pos += node_count * sizeof(*node_root);
-
-    mpp_enc_cfg_dbg_info("info node offset %d\n", pos);
-
     /* update info size and string name size */
     for (i = 0; i < info_count; i++) {
-        const char *name = cfgs[i]->name;
-        const char **info_trie = mpp_trie_get_info(trie, name);
-
-        mpp_assert(*info_trie == name);
-        len = strlen(name);
+        len = strlen(cfgs[i].name);
         pos += sizeof(MppCfgInfoNode) + MPP_ALIGN(len + 1, sizeof(RK_U64));
     }
 
+    /* the trie payload is the node offset computed by mpp_cfg_trie_gen */
+    if (info_count != MPP_ENC_CFG_INFO_COUNT || pos != MPP_ENC_CFG_INFO_SIZE) {
+        mpp_err_f("info count %d size %d mismatch trie table %d %d\n",
+                  info_count, pos, MPP_ENC_CFG_INFO_COUNT, MPP_ENC_CFG_INFO_SIZE);
+        return NULL;
+    }
+
     len = pos + sizeof(*info);
-    mpp_enc_cfg_dbg_info("tire + info size %d total %d\n", pos, len);
+    mpp_enc_cfg_dbg_info("info size %d total %d\n", pos, len);
 
     info = mpp_malloc_size(MppEncCfgInfo, len);
     if (NULL == info)
         return NULL;
 
-    memcpy(info->trie_node, node_root, sizeof(*node_root) * node_count);
-
-    node_root = info->trie_node;
-    pos = node_count * sizeof(*node_root);
-    buf = (char *)node_root + pos;
+    pos = 0;
+    buf = (char *)info->node;
 
     for (i = 0; i < info_count; i++) {
         MppCfgInfoNode *node_info = (MppCfgInfoNode *)buf;
-        MppCfgApi *api = cfgs[i];
+        const MppCfgApi *api = &cfgs[i];
         const char *name = api->name;
         RK_S32 node_size;
 
-        node_trie = mpp_trie_get_node(node_root, name);
-        node_trie->id = pos;
-
         node_info->name_len     = MPP_ALIGN(strlen(name) + 1, sizeof(RK_U64));
         node_info->data_type    = api->data_type;
         node_info->flag_offset  = api->flag_offset;
@@ -352,7 +188,7 @@ static MppEncCfgInfo *mpp_enc_cfg_flaten(MppTrie trie, MppCfgApi **cfgs)
 
     info->head.info_size  = pos;
     info->head.info_count = info_count;
-    info->head.node_count = node_count;
+    info->head.node_count = mpp_trie_flat_get_node_count(flat);
     info->head.cfg_size   = sizeof(MppEncCfgSet);
 
     return info;
@@ -360,34 +196,20 @@ static MppEncCfgInfo *mpp_enc_cfg_flaten(MppTrie trie, MppCfgApi **cfgs)
 
 MppEncCfgService::MppEncCfgService() :
     mInfo(NULL),
+    mTrie(NULL),
     mCfgSize(0)
 {
-    ENTRY_TABLE(EXPAND_AS_API);
-
-    MppCfgApi *cfgs[] = {
-        ENTRY_TABLE(EXPAND_AS_ARRAY)
-    };
-
-    RK_S32 cfg_cnt = MPP_ARRAY_ELEMS(cfgs);
-    MppTrie trie;
-    MPP_RET ret;
-    RK_S32 i;
-
-    ret = mpp_trie_init(&trie, 1732, cfg_cnt);
-    if (ret) {
-        mpp_err_f("failed to init enc cfg set trie\n");
+    /* the flat trie is a const table generated on the build host */
+    mTrie = (MppTrieFlat)mpp_enc_cfg_trie;
+    mInfo = mpp_enc_cfg_flaten(mTrie, mpp_enc_cfg_apis, MPP_ARRAY_ELEMS(mpp_enc_cfg_apis));
+    if (NULL == mInfo) {
+        mpp_err_f("failed to init enc cfg info\n");
         return ;
     }
 
-    for (i = 0; i < cfg_cnt; i++)
-        mpp_trie_add_info(trie, &cfgs[i]->name);
-
-    mInfo = mpp_enc_cfg_flaten(trie, cfgs);
     mCfgSize = mInfo->head.cfg_size;
 
     mpp_enc_cfg_dbg_func("node cnt: %d\n", get_node_count());
-
-    mpp_trie_deinit(trie);
 }
 
 MppEncCfgService::~MppEncCfgService()
@@ -400,7 +222,7 @@ MppCfgInfoNode *MppEncCfgService::get_info_root()
     if (NULL == mInfo)
         return NULL;
 
-    return (MppCfgInfoNode *)(mInfo->trie_node + mInfo->head.node_count);
+    return (MppCfgInfoNode *)mInfo->node;
 }
 
 static void mpp_enc_cfg_set_default(MppEncCfgSet *cfg)
@@ -461,6 +283,13 @@ MPP_RET mpp_enc_cfg_deinit(MppEncCfg cfg)
     return MPP_OK;
 }
 
+/* pending change flag of the info means the cfg needs to be applied */
+#define ENC_CFG_MARK_DIRTY(p, info) \
+    do { \
+        if (*(RK_U32 *)((char *)&(p)->cfg + (info)->flag_offset)) \
+            (p)->dirty = 1; \
+    } while (0)
+
 #define ENC_CFG_SET_ACCESS(func_name, in_type, cfg_type) \
     MPP_RET func_name(MppEncCfg cfg, const char *name, in_type val) \
     { \
@@ -475,6 +304,7 @@ MPP_RET mpp_enc_cfg_deinit(MppEncCfg cfg)
         } \
         mpp_enc_cfg_dbg_set("name %s type %s\n", info->name, cfg_type_names[info->data_type]); \
         MPP_RET ret = MPP_CFG_SET_##cfg_type(info, &p->cfg, val); \
+        ENC_CFG_MARK_DIRTY(p, info); \
         return ret; \
     }
 
@@ -509,6 +339,73 @@ ENC_CFG_GET_ACCESS(mpp_enc_cfg_get_u64, RK_U64, U64);
 ENC_CFG_GET_ACCESS(mpp_enc_cfg_get_ptr, void *, Ptr);
 ENC_CFG_GET_ACCESS(mpp_enc_cfg_get_st,  void  , St);
 
+MppEncCfgHnd mpp_enc_cfg_get_hnd(const char *name)
+{
+    MppCfgInfoNode *info;
+
+    if (NULL == name) {
+        mpp_err_f("invalid NULL input name\n");
+        return NULL;
+    }
+
+    mpp_env_get_u32("mpp_enc_cfg_debug", &mpp_enc_cfg_debug, 0);
+
+    info = MppEncCfgService::get()->get_info(name);
+    if (NULL == info)
+        mpp_err_f("cfg %s is invalid\n", name);
+
+    return (MppEncCfgHnd)info;
+}
+
+#define ENC_CFG_SET_HND_ACCESS(func_name, in_type, cfg_type) \
+    MPP_RET func_name(MppEncCfg cfg, MppEncCfgHnd hnd, in_type val) \
+    { \
+        if (NULL == cfg || NULL == hnd) { \
+            mpp_err_f("invalid input cfg %p hnd %p\n", cfg, hnd); \
+            return MPP_ERR_NULL_PTR; \
+        } \
+        MppEncCfgImpl *p = (MppEncCfgImpl *)cfg; \
+        MppCfgInfoNode *info = (MppCfgInfoNode *)hnd; \
+        if (CHECK_CFG_INFO(info, info->name, CFG_FUNC_TYPE_##cfg_type)) { \
+            return MPP_NOK; \
+        } \
+        mpp_enc_cfg_dbg_set("name %s type %s\n", info->name, cfg_type_names[info->data_type]); \
+        MPP_RET ret = MPP_CFG_SET_##cfg_type(info, &p->cfg, val); \
+        ENC_CFG_MARK_DIRTY(p, info); \
+        return ret; \
+    }
+
+ENC_CFG_SET_HND_ACCESS(mpp_enc_cfg_set_s32_by_hnd, RK_S32, S32);
+ENC_CFG_SET_HND_ACCESS(mpp_enc_cfg_set_u32_by_hnd, RK_U32, U32);
+ENC_CFG_SET_HND_ACCESS(mpp_enc_cfg_set_s64_by_hnd, RK_S64, S64);
+ENC_CFG_SET_HND_ACCESS(mpp_enc_cfg_set_u64_by_hnd, RK_U64, U64);
+ENC_CFG_SET_HND_ACCESS(mpp_enc_cfg_set_ptr_by_hnd, void *, Ptr);
+ENC_CFG_SET_HND_ACCESS(mpp_enc_cfg_set_st_by_hnd,  void *, St);
+
+#define ENC_CFG_GET_HND_ACCESS(func_name, in_type, cfg_type) \
+    MPP_RET func_name(MppEncCfg cfg, MppEncCfgHnd hnd, in_type *val) \
+    { \
+        if (NULL == cfg || NULL == hnd) { \
+            mpp_err_f("invalid input cfg %p hnd %p\n", cfg, hnd); \
+            return MPP_ERR_NULL_PTR; \
+        } \
+        MppEncCfgImpl *p = (MppEncCfgImpl *)cfg; \
+        MppCfgInfoNode *info = (MppCfgInfoNode *)hnd; \
+        if (CHECK_CFG_INFO(info, info->name, CFG_FUNC_TYPE_##cfg_type)) { \
+            return MPP_NOK; \
+        } \
+        mpp_enc_cfg_dbg_get("name %s type %s\n", info->name, cfg_type_names[info->data_type]); \
+        MPP_RET ret = MPP_CFG_GET_##cfg_type(info, &p->cfg, val); \
+        return ret; \
+    }
+
+ENC_CFG_GET_HND_ACCESS(mpp_enc_cfg_get_s32_by_hnd, RK_S32, S32);
+ENC_CFG_GET_HND_ACCESS(mpp_enc_cfg_get_u32_by_hnd, RK_U32, U32);
+ENC_CFG_GET_HND_ACCESS(mpp_enc_cfg_get_s64_by_hnd, RK_S64, S64);
+ENC_CFG_GET_HND_ACCESS(mpp_enc_cfg_get_u64_by_hnd, RK_U64, U64);
+ENC_CFG_GET_HND_ACCESS(mpp_enc_cfg_get_ptr_by_hnd, void *, Ptr);
+ENC_CFG_GET_HND_ACCESS(mpp_enc_cfg_get_st_by_hnd,  void  , St);
+
 void mpp_enc_cfg_show(void)
 {
     RK_S32 node_count = MppEncCfgService::get()->get_node_count();
@@ -0,0 +1,123 @@
+/* generated by mpp_cfg_trie_gen from mpp_enc_cfg_entry.h, do not edit */
+
+#ifndef __MPP_ENC_CFG_TRIE_H__
+#define __MPP_ENC_CFG_TRIE_H__
+
+#define MPP_ENC_CFG_INFO_COUNT       141
+#define MPP_ENC_CFG_INFO_SIZE        11512
+
+#ifndef MPP_CFG_TRIE_ALIGN
+#if defined(__GNUC__)
+#define MPP_CFG_TRIE_ALIGN  __attribute__((aligned(64)))
+#else
+#define MPP_CFG_TRIE_ALIGN
+#endif
+#endif
+
+/* MppTrieFlat of 210 nodes in little endian words */
+static const RK_U32 mpp_enc_cfg_trie[816] MPP_CFG_TRIE_ALIGN = {
+    0x00000cc0, 0x000000d2, 0x0000008d, 0x00000000, 0xffffffff, 0x63620900, 0x72706a68, 0x00767473,
+    0x00150010, 0x00200019, 0x00300026, 0x0040003b, 0x00000045, 0x00000000, 0x00000000, 0x00000000,
+    0x00000000, 0x7361000d, 0x6f6c3a65, 0x65645f77, 0x0079616c, 0x00001248, 0x646f0009, 0x743a6365,
+    0x00657079, 0xffffffff, 0x77320200, 0x00500049, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+    0xffffffff, 0x65700405, 0x5f713a67, 0x00757466, 0x00580055, 0x00650060, 0xffffffff, 0x65720704,
+    0x66633a70, 0x76726d68, 0x00680077, 0x00730070, 0x007a0076, 0x00840080, 0x00000000, 0x00000000,
+    0xffffffff, 0x3a630b02, 0x67666462, 0x706d6968, 0x00737271, 0x008b0087, 0x00930090, 0x00990095,
+    0x00a400a0, 0x00b000a8, 0x000000b4, 0xffffffff, 0x6c700305, 0x613a7469, 0x00b76f6d, 0x00bc00b9,
+    0x00002ca8, 0x6e75000e, 0x63733a65, 0x5f656e65, 0x65646f6d, 0xffffffff, 0x38700203, 0x0071643a,
+    0x00c400c0, 0xffffffff, 0x34360201, 0x00d00035, 0x000000e0, 0x00000000, 0x00000000, 0x00000000,
+    0xffffffff, 0x613a0401, 0x0073716d, 0x00eb00e7, 0x00f300f0, 0x00002660, 0x61660006, 0x726f7463,
+    0xffffffff, 0x6d5f0202, 0x00f76961, 0x000000f9, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+    0xffffffff, 0x62610305, 0x755f656c, 0x00fb7976, 0x010000fd, 0x00002520, 0x6e610003, 0x00000074,
+    0xffffffff, 0x6c6f0404, 0x7270726f, 0x01027473, 0x01080105, 0x0000010b, 0x00000000, 0x00000000,
+    0xffffffff, 0x6f6c0200, 0x0110010d, 0xffffffff, 0x6f650200, 0x01160113, 0x000011a8, 0x72690008,
+    0x69726f72, 0x0000676e, 0xffffffff, 0x6f610200, 0x011d011a, 0x00000000, 0x00000000, 0x00000000,
+    0x00000f28, 0x72650009, 0x7274735f, 0x00656469, 0x00000e38, 0x64690004, 0x00006874, 0xffffffff,
+    0x73700203, 0x00746d5f, 0x01230120, 0xffffffff, 0x72650200, 0x012b0126, 0x00000000, 0x00000000,
+    0xffffffff, 0x71700200, 0x01340130, 0x00000378, 0x706f0002, 0xffffffff, 0x65690204, 0x71665f72,
+    0x013c0138, 0x00000648, 0x696e000c, 0x70695f74, 0x7461725f, 0x00006f69, 0x00000000, 0x00000000,
+    0xffffffff, 0x69610300, 0x0140006f, 0x01480144, 0x00000468, 0x69720007, 0x7469726f, 0x00000079,
+    0xffffffff, 0x5f700402, 0x76736d69, 0x014d014a, 0x01530150, 0x00000000, 0x00000000, 0x00000000,
+    0xffffffff, 0x66650202, 0x0155725f, 0x00000158, 0xffffffff, 0x75740200, 0x01640160, 0x000027a0,
+    0x67720002, 0x00002750, 0x646f0003, 0x00000065, 0x000027f0, 0x74750002, 0x00000000, 0x00000000,
+    0x000024d0, 0x7369000a, 0x656c6261, 0x6676695f, 0xffffffff, 0x5f700402, 0x736d6964, 0x016d0169,
+    0x01730170, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+    0xffffffff, 0x623a0a01, 0x6c676463, 0x7371706d, 0x01760074, 0x0180017b, 0x018b0185, 0x01940190,
+    0x019c0197, 0x000001a0, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+    0xffffffff, 0x613a0701, 0x706c6463, 0x01a47371, 0x01ab01a8, 0x01b301b0, 0x01bb01b6, 0xffffffff,
+    0x5f710202, 0x01c07473, 0x000001c4, 0xffffffff, 0x6f620200, 0x01d001c8, 0x00000000, 0x00000000,
+    0xffffffff, 0x70620200, 0x01d901d4, 0xffffffff, 0x696b0204, 0x73625f70, 0x01e001dd, 0x000026b0,
+    0x00780001, 0x00002700, 0x006e0001, 0x000025c0, 0x00000000, 0x00002610, 0x00000000, 0x00000000,
+    0x00002570, 0x00000000, 0x00001018, 0x69720003, 0x0000006d, 0x000010b8, 0x6e610004, 0x00006567,
+    0x00000fc8, 0x61700004, 0x00006563, 0x00001068, 0x63720002, 0x000011f8, 0x70690002, 0x00000000,
+    0x00000f78, 0x6d720004, 0x00007461, 0x00000e88, 0x67690004, 0x00007468, 0x00000ed8, 0x5f720008,
+    0x69727473, 0x00006564, 0x00001108, 0x676e0003, 0x00000065, 0x00001158, 0x61740006, 0x6e6f6974,
+    0xffffffff, 0x69610200, 0x01e401e2, 0x00000098, 0x72610005, 0x00746567, 0xffffffff, 0x72620207,
+    0x68746165, 0x0073655f, 0x01e801e6, 0xffffffff, 0x706f0303, 0x746d675f, 0x01f001ec, 0x000001f3,
+    0xffffffff, 0x5f730202, 0x01f56f69, 0x000001fa, 0xffffffff, 0x5f700203, 0x0069616d, 0x02040200,
+    0x00000b60, 0x61720008, 0x6e5f656d, 0x00006d75, 0xffffffff, 0x5f700202, 0x02086564, 0x0000020b,
+    0xffffffff, 0x5f780202, 0x020d7269, 0x00000210, 0x000005f8, 0x5f6e0008, 0x72705f69, 0x0000706f,
+    0x00000050, 0x65640002, 0xffffffff, 0x706e0200, 0x02160214, 0xffffffff, 0x69610200, 0x021b0218,
+    0x000009c8, 0x65740003, 0x00000070, 0x00000a68, 0x00690001, 0x000003c0, 0x66630003, 0x00000067,
+    0xffffffff, 0x73650304, 0x6d655f68, 0x021e006e, 0x02230220, 0x00000000, 0x00000000, 0x00000000,
+    0x00000bb8, 0x74610008, 0x69745f73, 0x0000656d, 0xffffffff, 0x65700304, 0x6d695f72, 0x02250070,
+    0x022b0228, 0x00002480, 0x6c650007, 0x695f6174, 0x00000070, 0x000022a0, 0x696e0003, 0x00000074,
+    0xffffffff, 0x69610200, 0x02330230, 0x00002430, 0x65740003, 0x00000070, 0x00001b60, 0x7361000d,
+    0x616c5f65, 0x5f726579, 0x00646970, 0xffffffff, 0x62610400, 0x0236726f, 0x0240023a, 0x00000244,
+    0xffffffff, 0x6c620304, 0x62615f6b, 0x02480064, 0x0250024b, 0x00001490, 0x7061000f, 0x6f6e5f73,
+    0x6c615f74, 0x65776f6c, 0x00000064, 0xffffffff, 0x6f650200, 0x02560253, 0x00000000, 0x00000000,
+    0xffffffff, 0x78610203, 0x00746c5f, 0x025d025b, 0xffffffff, 0x726f0200, 0x02630260, 0xffffffff,
+    0x5f700402, 0x736d6964, 0x026a0266, 0x0270026d, 0xffffffff, 0x74630200, 0x02770273, 0x00000000,
+    0x00001588, 0x61720007, 0x7838736e, 0x00000038, 0x00002250, 0x74750008, 0x69745f6f, 0x0000656c,
+    0xffffffff, 0x72620200, 0x0280027b, 0xffffffff, 0x6c620304, 0x62615f6b, 0x02840064, 0x028a0287,
+    0xffffffff, 0x70650200, 0x0290028d, 0x00001c10, 0x6f720006, 0x656c6966, 0xffffffff, 0x5f700402,
+    0x736d6964, 0x02990295, 0x02a0029c, 0xffffffff, 0x63610200, 0x02a702a3, 0x00000000, 0x00000000,
+    0xffffffff, 0x65740204, 0x70695f70, 0x02ad02ab, 0xffffffff, 0x72680204, 0x70695f64, 0x02b202b0,
+    0x00002a20, 0x725f000b, 0x69645f63, 0x6c626173, 0x00000065, 0x00000000, 0x00000000, 0x00000000,
+    0x00002a78, 0x65640007, 0x6169625f, 0x00000073, 0xffffffff, 0x61690304, 0x69655f73, 0x02b40070,
+    0x02b802b6, 0x00002840, 0x725f0104, 0x005f776f, 0x000002ba, 0x00002b68, 0x61690103, 0x02bc5f73,
+    0x00002b18, 0x64610002, 0x000000e8, 0x00780001, 0x00000138, 0x006e0001, 0x00000790, 0x006e0001,
+    0x000007e0, 0x72740007, 0x74676e65, 0x00000068, 0x00000558, 0x70610002, 0x00000000, 0x00000000,
+    0x000004b8, 0x646f0003, 0x00000065, 0x00000508, 0x64680002, 0xffffffff, 0x5f6e0302, 0x006e6664,
+    0x02c302c0, 0x000002c6, 0xffffffff, 0x74750303, 0x6e66645f, 0x02cb02c8, 0x000002ce, 0x00000000,
+    0xffffffff, 0x5f780202, 0x02d07069, 0x000002d2, 0xffffffff, 0x5f6e0202, 0x02d47069, 0x000002d6,
+    0x00000b08, 0x6c650004, 0x00006174, 0x00000ab8, 0x006e0001, 0x000005a8, 0x705f0005, 0x00706f72,
+    0x00000410, 0x6565000a, 0x745f636e, 0x73656d69, 0x00000838, 0x74690002, 0x00000a18, 0x00000000,
+    0x000008d8, 0x5f780101, 0x000002d8, 0x00000888, 0x5f6e0101, 0x000002da, 0x00000c08, 0x006e0001,
+    0x00000c58, 0x646f0003, 0x00000065, 0x00000ca8, 0x6d750002, 0x000006f0, 0x745f0004, 0x00006468,
+    0x000006a0, 0x646f0003, 0x00000065, 0x00000740, 0x745f0004, 0x00006468, 0x00000000, 0x00000000,
+    0x00002340, 0x5f780101, 0x000002dc, 0x000022f0, 0x5f6e0101, 0x000002de, 0xffffffff, 0x61620204,
+    0x69655f63, 0x02e202e0, 0x00001688, 0x715f000a, 0x666f5f70, 0x74657366, 0x00000000, 0x00000000,
+    0xffffffff, 0x736e0203, 0x00725f74, 0x02e702e4, 0x000016e0, 0x715f000a, 0x666f5f70, 0x74657366,
+    0x00001790, 0x706c0004, 0x00006168, 0x000017e0, 0x74650003, 0x00000061, 0x00000000, 0x00000000,
+    0x00001738, 0x73690006, 0x656c6261, 0x00001340, 0x65760003, 0x0000006c, 0xffffffff, 0x32670207,
+    0x78616d5f, 0x0070665f, 0x02f002eb, 0x00001ab8, 0x72740002, 0x00001a68, 0x64690002, 0x00000000,
+    0x00001390, 0x5f630006, 0x65707974, 0xffffffff, 0x6f650200, 0x02f702f3, 0x00001a10, 0x6c650007,
+    0x695f6174, 0x00000070, 0x00001830, 0x696e0003, 0x00000074, 0xffffffff, 0x69610200, 0x02fd02fa,
+    0x000019c0, 0x65740003, 0x00000070, 0x00001630, 0x6c61000a, 0x5f676e69, 0x7473696c, 0x00001298,
+    0x65720009, 0x745f6d61, 0x00657079, 0x00001d08, 0x715f000a, 0x666f5f70, 0x74657366, 0x00000000,
+    0x00001d60, 0x715f000a, 0x666f5f70, 0x74657366, 0x00001e10, 0x706c0004, 0x00006168, 0x00001e60,
+    0x74650003, 0x00000061, 0x00001db8, 0x73690006, 0x656c6261, 0x00001c60, 0x65760003, 0x0000006c,
+    0xffffffff, 0x5f660206, 0x5f736361, 0x03007473, 0x00000303, 0x00002090, 0x6c650007, 0x695f6174,
+    0x00000070, 0x00001eb0, 0x696e0003, 0x00000074, 0xffffffff, 0x69610200, 0x030b0308, 0x00000000,
+    0x00002040, 0x65740003, 0x00000070, 0xffffffff, 0x5f6f0202, 0x03106c63, 0x00000315, 0x00001cb0,
+    0x6c61000a, 0x5f676e69, 0x7473696c, 0x00002980, 0x00000000, 0x000029d0, 0x00000000, 0x00000000,
+    0x000028e0, 0x00000000, 0x00002930, 0x00000000, 0x00002c58, 0x006e0001, 0x00002bb8, 0x00000000,
+    0x00002c08, 0x00000000, 0x00002890, 0x00690001, 0x00002ac8, 0x6e650002, 0x00000000, 0x00000000,
+    0x00000228, 0x6e650005, 0x006d726f, 0x00000188, 0x656c0003, 0x00000078, 0x000001d8, 0x6d750002,
+    0x00000320, 0x6e650005, 0x006d726f, 0x00000280, 0x656c0003, 0x00000078, 0x000002d0, 0x6d750002,
+    0x00000d98, 0x00000000, 0x00000de8, 0x00000000, 0x00000cf8, 0x00000000, 0x00000d48, 0x00000000,
+    0x00000978, 0x00690001, 0x00000928, 0x00690001, 0x000023e0, 0x00690001, 0x00002390, 0x00690001,
+    0x000014e8, 0x006e0001, 0x00001538, 0x63640002, 0x000015d8, 0x6e690005, 0x00617274, 0x00001bb8,
+    0x69610008, 0x735f746e, 0x00007465, 0x00001438, 0x6d720006, 0x6d756e5f, 0x00000000, 0x00000000,
+    0x000013e0, 0x636f0006, 0x62736c5f, 0x00001b08, 0x69660008, 0x6f6d5f78, 0x00006564, 0x000012f0,
+    0x69660004, 0x0000656c, 0x000018d0, 0x5f780101, 0x0000031a, 0x00001880, 0x5f6e0101, 0x0000031c,
+    0x00002198, 0x696c0005, 0x006e655f, 0x000021f0, 0x6c69000b, 0x69645f65, 0x6c626173, 0x00000065,
+    0x00001f50, 0x5f780101, 0x0000031e, 0x00001f00, 0x5f6e0101, 0x00000320, 0x00000000, 0x00000000,
+    0x00002140, 0x7268000d, 0x5f616d6f, 0x61736964, 0x00656c62, 0x000020e8, 0x6d75000b, 0x69645f61,
+    0x6c626173, 0x00000065, 0x00001970, 0x00690001, 0x00001920, 0x00690001, 0x00001ff0, 0x00690001,
+    0x00001fa0, 0x00690001, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+    0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+};
+
+#endif /*__MPP_ENC_CFG_TRIE_H__*/
@@ -18,9 +18,11 @@
 
 #include <string.h>
 
+#include "mpp_env.h"
 #include "mpp_mem.h"
 #include "mpp_list.h"
 #include "mpp_lock.h"
+#include "mpp_mem_pool.h"
 
 #include "mpp_meta_impl.h"
 
@@ -28,6 +30,14 @@
 #define META_VAL_VALID      (0x00000001)
 #define META_VAL_READY      (0x00000002)
 
+/* track all metas in a global list for leak check */
+#define META_DBG_LIST       (0x00000001)
+
+/* open addressing key index, keep the load factor under 1/2 */
+#define META_KEY_HASH_BITS  7
+#define META_KEY_HASH_SIZE  (1 << META_KEY_HASH_BITS)
+#define META_KEY_HASH(key)  (((RK_U32)(key) * 0x9E3779B1) >> (32 - META_KEY_HASH_BITS))
+
 #define WRITE_ONCE(x, val)  ((*(volatile typeof(x) *) &(x)) = (val))
 #define READ_ONCE(var)      (*((volatile typeof(var) *)(&(var))))
 
@@ -86,6 +96,10 @@ static MppMetaDef meta_defs[] = {
     {   KEY_DEC_TBN_UV_OFFSET,  TYPE_S32,       },
 };
 
+static RK_U32 mpp_meta_debug = 0;
+static MppMemPool mpp_meta_pool = mpp_mem_pool_init_f(MODULE_TAG, sizeof(MppMetaImpl) +
+                                                      sizeof(MppMetaVal) * MPP_ARRAY_ELEMS(meta_defs));
+
 class MppMetaService
 {
 private:
@@ -98,6 +112,9 @@ private:
     spinlock_t          mLock;
     struct list_head    mlist_meta;
 
+    /* meta_defs index of each key hash slot, -1 for empty slot */
+    RK_S8               mKeyIndex[META_KEY_HASH_SIZE];
+
     RK_U32              meta_id;
     RK_S32              meta_count;
     RK_U32              finished;
@@ -112,7 +129,7 @@ public:
      * get_index_of_key does two things:
      * 1. Check the key / type pair is correct or not.
      *    If failed on check return negative value
-     * 2. Compare all exsisting meta data defines to find the non-negative index
+     * 2. Look up the key hash index to find the non-negative index
      */
     RK_S32 get_index_of_key(MppMetaKey key, MppMetaType type);
 
@@ -125,8 +142,26 @@ MppMetaService::MppMetaService()
       meta_count(0),
       finished(0)
 {
+    RK_U32 i;
+
     mpp_spinlock_init(&mLock);
     INIT_LIST_HEAD(&mlist_meta);
+
+    mpp_env_get_u32("mpp_meta_debug", &mpp_meta_debug, 0);
+
+    mpp_assert(MPP_ARRAY_ELEMS(meta_defs) * 2 <= META_KEY_HASH_SIZE);
+    memset(mKeyIndex, -1, sizeof(mKeyIndex));
+
+    for (i = 0; i < MPP_ARRAY_ELEMS(meta_defs); i++) {
+        RK_U32 pos = META_KEY_HASH(meta_defs[i].key);
+
+        while (mKeyIndex[pos] >= 0) {
+            mpp_assert(meta_defs[mKeyIndex[pos]].key != meta_defs[i].key);
+            pos = (pos + 1) & (META_KEY_HASH_SIZE - 1);
+        }
+
+        mKeyIndex[pos] = i;
+    }
 }
 
 MppMetaService::~MppMetaService()
@@ -147,24 +182,27 @@ MppMetaService::~MppMetaService()
 
 RK_S32 MppMetaService::get_index_of_key(MppMetaKey key, MppMetaType type)
 {
-    RK_S32 i = 0;
-    RK_S32 num = MPP_ARRAY_ELEMS(meta_defs);
+    RK_U32 pos = META_KEY_HASH(key);
+
+    /* keys are unique in meta_defs so the type is checked on the key hit */
+    while (mKeyIndex[pos] >= 0) {
+        RK_S32 i = mKeyIndex[pos];
 
-    for (i = 0; i < num; i++) {
-        if ((meta_defs[i].key == key) && (meta_defs[i].type == type))
-            break;
+        if (meta_defs[i].key == key)
+            return (meta_defs[i].type == type) ? (i) : (-1);
+
+        pos = (pos + 1) & (META_KEY_HASH_SIZE - 1);
     }
 
-    return (i < num) ? (i) : (-1);
+    return -1;
 }
 
 MppMetaImpl *MppMetaService::get_meta(const char *tag, const char *caller)
 {
-    MppMetaImpl *impl = mpp_malloc_size(MppMetaImpl, sizeof(MppMetaImpl) +
-                                        sizeof(MppMetaVal) * MPP_ARRAY_ELEMS(meta_defs));
+    /* the pool returns zeroed memory so all values start as invalid */
+    MppMetaImpl *impl = (MppMetaImpl *)mpp_mem_pool_get(mpp_meta_pool);
     if (impl) {
         const char *tag_src = (tag) ? (tag) : (MODULE_TAG);
-        RK_U32 i;
 
         strncpy(impl->tag, tag_src, sizeof(impl->tag));
         impl->caller = caller;
@@ -173,13 +211,12 @@ MppMetaImpl *MppMetaService::get_meta(const char *tag, const char *caller)
         impl->ref_count = 1;
         impl->node_count = 0;
 
-        for (i = 0; i < MPP_ARRAY_ELEMS(meta_defs); i++)
-            impl->vals[i].state = 0;
-
-        mpp_spinlock_lock(&mLock);
-        list_add_tail(&impl->list_meta, &mlist_meta);
-        mpp_spinlock_unlock(&mLock);
-        MPP_FETCH_ADD(&meta_count, 1);
+        if (mpp_meta_debug & META_DBG_LIST) {
+            mpp_spinlock_lock(&mLock);
+            list_add_tail(&impl->list_meta, &mlist_meta);
+            mpp_spinlock_unlock(&mLock);
+            MPP_FETCH_ADD(&meta_count, 1);
+        }
     } else {
         mpp_err_f("failed to malloc meta data\n");
     }
@@ -201,12 +238,14 @@ void MppMetaService::put_meta(MppMetaImpl *meta)
         return;
     }
 
-    mpp_spinlock_lock(&mLock);
-    list_del_init(&meta->list_meta);
-    mpp_spinlock_unlock(&mLock);
-    MPP_FETCH_SUB(&meta_count, 1);
+    if (!list_empty(&meta->list_meta)) {
+        mpp_spinlock_lock(&mLock);
+        list_del_init(&meta->list_meta);
+        mpp_spinlock_unlock(&mLock);
+        MPP_FETCH_SUB(&meta_count, 1);
+    }
 
-    mpp_free(meta);
+    mpp_mem_pool_put(mpp_meta_pool, meta);
 }
 
 MPP_RET mpp_meta_get_with_tag(MppMeta *meta, const char *tag, const char *caller)
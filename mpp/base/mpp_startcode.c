@@ -0,0 +1,151 @@
+/*
+ * Copyright 2024 Rockchip Electronics Co. LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#define MODULE_TAG "mpp_startcode"
+
+#include "mpp_startcode.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define STARTCODE_ENGINE    "avx2"
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#define STARTCODE_ENGINE    "sse2"
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define STARTCODE_ENGINE    "neon"
+#else
+#define STARTCODE_ENGINE    "c"
+#endif
+
+/*
+ * Scalar search skipping up to three bytes per step.
+ * When p[2] is greater than one no prefix can cover any of p[0..2].
+ */
+static const RK_U8 *find_startcode_c(const RK_U8 *p, const RK_U8 *end)
+{
+    while (p + 2 < end) {
+        if (p[2] > 1) {
+            p += 3;
+        } else if (p[1]) {
+            p += 2;
+        } else if (p[0] || p[2] != 1) {
+            p++;
+        } else {
+            return p;
+        }
+    }
+
+    return end;
+}
+
+const RK_U8 *mpp_find_startcode(const RK_U8 *buf, const RK_U8 *end)
+{
+    const RK_U8 *p = buf;
+
+    if (!buf || end - buf < 3)
+        return end;
+
+#if defined(__AVX2__)
+    {
+        const __m256i zero = _mm256_setzero_si256();
+        const __m256i one = _mm256_set1_epi8(1);
+
+        while (end - p >= 34) {
+            __m256i b0 = _mm256_loadu_si256((const __m256i *)p);
+            __m256i b1 = _mm256_loadu_si256((const __m256i *)(p + 1));
+            __m256i b2 = _mm256_loadu_si256((const __m256i *)(p + 2));
+            __m256i m = _mm256_and_si256(_mm256_cmpeq_epi8(b0, zero),
+                                         _mm256_cmpeq_epi8(b1, zero));
+            RK_U32 mask;
+
+            m = _mm256_and_si256(m, _mm256_cmpeq_epi8(b2, one));
+            mask = (RK_U32)_mm256_movemask_epi8(m);
+            if (mask)
+                return p + __builtin_ctz(mask);
+
+            p += 32;
+        }
+    }
+#elif defined(__SSE2__)
+    {
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i one = _mm_set1_epi8(1);
+
+        while (end - p >= 18) {
+            __m128i b0 = _mm_loadu_si128((const __m128i *)p);
+            __m128i b1 = _mm_loadu_si128((const __m128i *)(p + 1));
+            __m128i b2 = _mm_loadu_si128((const __m128i *)(p + 2));
+            __m128i m = _mm_and_si128(_mm_cmpeq_epi8(b0, zero),
+                                      _mm_cmpeq_epi8(b1, zero));
+            RK_U32 mask;
+
+            m = _mm_and_si128(m, _mm_cmpeq_epi8(b2, one));
+            mask = (RK_U32)_mm_movemask_epi8(m);
+            if (mask)
+                return p + __builtin_ctz(mask);
+
+            p += 16;
+        }
+    }
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+    {
+        const uint8x16_t zero = vdupq_n_u8(0);
+        const uint8x16_t one = vdupq_n_u8(1);
+
+        while (end - p >= 18) {
+            uint8x16_t b0 = vld1q_u8(p);
+            uint8x16_t b1 = vld1q_u8(p + 1);
+            uint8x16_t b2 = vld1q_u8(p + 2);
+            uint8x16_t m = vandq_u8(vceqq_u8(b0, zero), vceqq_u8(b1, zero));
+            uint64x2_t m64;
+
+            m = vandq_u8(m, vceqq_u8(b2, one));
+            m64 = vreinterpretq_u64_u8(m);
+            /* locate the hit inside this block with the scalar loop */
+            if (vgetq_lane_u64(m64, 0) | vgetq_lane_u64(m64, 1))
+                return find_startcode_c(p, p + 18);
+
+            p += 16;
+        }
+    }
+#endif
+
+    return find_startcode_c(p, end);
+}
+
+RK_U32 mpp_startcode_skip(const RK_U8 *buf, RK_U32 len, RK_U32 state)
+{
+    if (!(state & 0xff))
+        return 0;
+
+    return (RK_U32)(mpp_find_startcode(buf, buf + len) - buf);
+}
+
+RK_U32 mpp_startcode_state(RK_U32 state, const RK_U8 *buf, RK_U32 len)
+{
+    RK_U32 i = (len > 4) ? (len - 4) : 0;
+
+    for (; i < len; i++)
+        state = (state << 8) | buf[i];
+
+    return state;
+}
+
+const char *mpp_startcode_engine(void)
+{
+    return STARTCODE_ENGINE;
+}
@@ -66,6 +66,8 @@ typedef struct MppPortImpl_t {
     MppTaskStatus       status_curr;
     MppTaskStatus       next_on_dequeue;
     MppTaskStatus       next_on_enqueue;
+
+    MppCbCtx            notify;
 } MppPortImpl;
 
 static const char *module_name = MODULE_TAG;
@@ -102,7 +104,7 @@ MPP_RET check_mpp_task_name(MppTask task)
 
 static MPP_RET mpp_port_init(MppTaskQueueImpl *queue, MppPortType type, MppPort *port)
 {
-    MppPortImpl *impl = mpp_malloc(MppPortImpl, 1);
+    MppPortImpl *impl = mpp_calloc(MppPortImpl, 1);
     if (NULL == impl) {
         mpp_err_f("failed to malloc MppPort type %d\n", type);
         return MPP_ERR_MALLOC;
@@ -251,30 +253,13 @@ RET:
     return ret;
 }
 
-MPP_RET _mpp_port_dequeue(const char *caller, MppPort port, MppTask *task)
+static MppTask port_dequeue_locked(const char *caller, MppPortImpl *port_impl)
 {
-    MppPortImpl *port_impl = (MppPortImpl *)port;
     MppTaskQueueImpl *queue = port_impl->queue;
-    MppTaskStatusInfo *curr = NULL;
-    MppTaskStatusInfo *next = NULL;
+    MppTaskStatusInfo *curr = &queue->info[port_impl->status_curr];
+    MppTaskStatusInfo *next = &queue->info[port_impl->next_on_dequeue];
     MppTaskImpl *task_impl = NULL;
-    MppTask p = NULL;
-
-    AutoMutex auto_lock(queue->lock);
-    MPP_RET ret = MPP_NOK;
-
-    mpp_task_dbg_func("caller %s enter port %p\n", caller, port);
-
-    if (!queue->ready) {
-        mpp_err("try to dequeue when %s queue is not ready\n",
-                port_type_str[port_impl->type]);
-        goto RET;
-    }
-
-    curr = &queue->info[port_impl->status_curr];
-    next = &queue->info[port_impl->next_on_dequeue];
 
-    *task = NULL;
     if (curr->count == 0) {
         mpp_assert(list_empty(&curr->list));
         mpp_task_dbg_flow("mpp %p %s from %s dequeue %s port task %s -> %s failed\n",
@@ -282,13 +267,12 @@ MPP_RET _mpp_port_dequeue(const char *caller, MppPort port, MppTask *task)
                           port_type_str[port_impl->type],
                           task_status_str[port_impl->status_curr],
                           task_status_str[port_impl->next_on_dequeue]);
-        goto RET;
+        return NULL;
     }
 
     mpp_assert(!list_empty(&curr->list));
     task_impl = list_entry(curr->list.next, MppTaskImpl, list);
-    p = (MppTask)task_impl;
-    check_mpp_task_name(p);
+    check_mpp_task_name((MppTask)task_impl);
     list_del_init(&task_impl->list);
     curr->count--;
     mpp_assert(curr->count >= 0);
@@ -303,33 +287,16 @@ MPP_RET _mpp_port_dequeue(const char *caller, MppPort port, MppTask *task)
                       task_status_str[port_impl->status_curr],
                       task_status_str[port_impl->next_on_dequeue]);
 
-    *task = p;
-    ret = MPP_OK;
-RET:
-    mpp_task_dbg_func("caller %s leave port %p task %p ret %d\n", caller, port, *task, ret);
-
-    return ret;
+    return (MppTask)task_impl;
 }
 
-MPP_RET _mpp_port_enqueue(const char *caller, MppPort port, MppTask task)
+static void port_enqueue_locked(const char *caller, MppPortImpl *port_impl, MppTask task)
 {
     MppTaskImpl *task_impl = (MppTaskImpl *)task;
-    MppPortImpl *port_impl = (MppPortImpl *)port;
     MppTaskQueueImpl *queue = port_impl->queue;
     MppTaskStatusInfo *curr = NULL;
     MppTaskStatusInfo *next = NULL;
 
-    AutoMutex auto_lock(queue->lock);
-    MPP_RET ret = MPP_NOK;
-
-    mpp_task_dbg_func("caller %s enter port %p task %p\n", caller, port, task);
-
-    if (!queue->ready) {
-        mpp_err("try to enqueue when %s queue is not ready\n",
-                port_type_str[port_impl->type]);
-        goto RET;
-    }
-
     check_mpp_task_name(task);
 
     mpp_assert(task_impl->queue  == (MppTaskQueue)queue);
@@ -349,9 +316,59 @@ MPP_RET _mpp_port_enqueue(const char *caller, MppPort port, MppTask task)
                       port_type_str[port_impl->type], task_impl,
                       task_status_str[port_impl->next_on_dequeue],
                       task_status_str[port_impl->next_on_enqueue]);
+}
+
+MPP_RET _mpp_port_dequeue(const char *caller, MppPort port, MppTask *task)
+{
+    MppPortImpl *port_impl = (MppPortImpl *)port;
+    MppTaskQueueImpl *queue = port_impl->queue;
+
+    AutoMutex auto_lock(queue->lock);
+    MPP_RET ret = MPP_NOK;
+
+    mpp_task_dbg_func("caller %s enter port %p\n", caller, port);
+
+    *task = NULL;
+    if (!queue->ready) {
+        mpp_err("try to dequeue when %s queue is not ready\n",
+                port_type_str[port_impl->type]);
+        goto RET;
+    }
+
+    *task = port_dequeue_locked(caller, port_impl);
+    if (*task)
+        ret = MPP_OK;
+RET:
+    mpp_task_dbg_func("caller %s leave port %p task %p ret %d\n", caller, port, *task, ret);
+
+    return ret;
+}
+
+MPP_RET _mpp_port_enqueue(const char *caller, MppPort port, MppTask task)
+{
+    MppPortImpl *port_impl = (MppPortImpl *)port;
+    MppTaskQueueImpl *queue = port_impl->queue;
+
+    AutoMutex auto_lock(queue->lock);
+    MPP_RET ret = MPP_NOK;
+
+    mpp_task_dbg_func("caller %s enter port %p task %p\n", caller, port, task);
+
+    if (!queue->ready) {
+        mpp_err("try to enqueue when %s queue is not ready\n",
+                port_type_str[port_impl->type]);
+        goto RET;
+    }
+
+    port_enqueue_locked(caller, port_impl, task);
+
+    queue->info[port_impl->next_on_enqueue].cond->signal();
+    mpp_task_dbg_func("signal port %p\n", &queue->info[port_impl->next_on_enqueue]);
+
+    /* only enqueue hands the task over, dequeue does not free a slot */
+    if (port_impl->notify.callBack)
+        mpp_callback_f(caller, &port_impl->notify, task);
 
-    next->cond->signal();
-    mpp_task_dbg_func("signal port %p\n", next);
     ret = MPP_OK;
 RET:
     mpp_task_dbg_func("caller %s leave port %p task %p ret %d\n", caller, port, task, ret);
@@ -359,6 +376,70 @@ RET:
     return ret;
 }
 
+MPP_RET _mpp_port_dequeue_batch(const char *caller, MppPort port, MppTask *tasks,
+                                RK_S32 count, RK_S32 *done)
+{
+    MppPortImpl *port_impl = (MppPortImpl *)port;
+    MppTaskQueueImpl *queue = port_impl->queue;
+
+    AutoMutex auto_lock(queue->lock);
+    RK_S32 cnt = 0;
+
+    mpp_task_dbg_func("caller %s enter port %p count %d\n", caller, port, count);
+
+    if (!queue->ready) {
+        mpp_err("try to dequeue when %s queue is not ready\n",
+                port_type_str[port_impl->type]);
+        *done = 0;
+        return MPP_NOK;
+    }
+
+    while (cnt < count) {
+        tasks[cnt] = port_dequeue_locked(caller, port_impl);
+        if (NULL == tasks[cnt])
+            break;
+
+        cnt++;
+    }
+
+    *done = cnt;
+    mpp_task_dbg_func("caller %s leave port %p done %d\n", caller, port, cnt);
+
+    return cnt ? MPP_OK : MPP_NOK;
+}
+
+MPP_RET _mpp_port_enqueue_batch(const char *caller, MppPort port, MppTask *tasks,
+                                RK_S32 count)
+{
+    MppPortImpl *port_impl = (MppPortImpl *)port;
+    MppTaskQueueImpl *queue = port_impl->queue;
+
+    AutoMutex auto_lock(queue->lock);
+    RK_S32 i;
+
+    mpp_task_dbg_func("caller %s enter port %p count %d\n", caller, port, count);
+
+    if (!queue->ready) {
+        mpp_err("try to enqueue when %s queue is not ready\n",
+                port_type_str[port_impl->type]);
+        return MPP_NOK;
+    }
+
+    for (i = 0; i < count; i++)
+        port_enqueue_locked(caller, port_impl, tasks[i]);
+
+    if (count) {
+        queue->info[port_impl->next_on_enqueue].cond->signal();
+
+        if (port_impl->notify.callBack)
+            mpp_callback_f(caller, &port_impl->notify, tasks[count - 1]);
+    }
+
+    mpp_task_dbg_func("caller %s leave port %p\n", caller, port);
+
+    return MPP_OK;
+}
+
 MPP_RET _mpp_port_awake(const char *caller, MppPort port)
 {
     if (port == NULL)
@@ -568,3 +649,22 @@ MppMeta mpp_task_get_meta(MppTask task)
 
     return meta;
 }
+
+MPP_RET mpp_port_set_notify(MppPort port, MppCbCtx *cb)
+{
+    MppPortImpl *impl = (MppPortImpl *)port;
+
+    if (NULL == impl) {
+        mpp_err_f("invalid NULL port\n");
+        return MPP_ERR_NULL_PTR;
+    }
+
+    AutoMutex auto_lock(impl->queue->lock);
+
+    if (cb)
+        impl->notify = *cb;
+    else
+        memset(&impl->notify, 0, sizeof(impl->notify));
+
+    return MPP_OK;
+}
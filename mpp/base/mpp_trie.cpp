@@ -41,6 +41,12 @@
 #define DEFAULT_INFO_COUNT              80
 #define INVALID_NODE_ID                 (-1)
 
+#define TRIE_CACHE_LINE                 64
+#define TRIE_FLAT_NODE_HEAD             6
+/* child offset position and node size of the flat node */
+#define TRIE_FLAT_CHILD_POS(len, cnt)   MPP_ALIGN(TRIE_FLAT_NODE_HEAD + (len) + (cnt), 2)
+#define TRIE_FLAT_NODE_SIZE(len, cnt)   MPP_ALIGN(TRIE_FLAT_CHILD_POS(len, cnt) + (cnt) * 2, 4)
+
 typedef struct MppAcImpl_t {
     RK_S32          info_count;
     RK_S32          info_used;
@@ -50,6 +56,40 @@ typedef struct MppAcImpl_t {
     MppTrieNode     *nodes;
 } MppTrieImpl;
 
+/* 16 byte head at the start of the flat trie buffer */
+typedef struct MppTrieFlatHead_t {
+    RK_S32          size;
+    RK_S32          node_count;
+    RK_S32          info_count;
+    /* offset from malloc address to the aligned buffer */
+    RK_S32          buf_offset;
+} MppTrieFlatHead;
+
+/*
+ * Flat node layout:
+ * id | prefix_len | child_count | prefix chars | child key chars | pad |
+ * child offsets in 4 byte unit
+ * The key char of a child is consumed on entering the child then the child
+ * prefix chars are matched.
+ */
+typedef struct MppTrieFlatNode_t {
+    RK_S32          id;
+    RK_U8           prefix_len;
+    RK_U8           child_count;
+    RK_U8           data[];
+} MppTrieFlatNode;
+
+typedef struct TrieFlatBuild_t {
+    /* trie char node entered by key char and the node after the prefix */
+    RK_S32          start;
+    RK_S32          end;
+    RK_S32          prefix_len;
+    RK_S32          child_count;
+    /* queue index of the first child */
+    RK_S32          first;
+    RK_S32          offset;
+} TrieFlatBuild;
+
 RK_U32 mpp_trie_debug = 0;
 
 static RK_S32 trie_get_node(MppTrieImpl *trie)
@@ -322,3 +362,243 @@ const char **mpp_trie_get_info(MppTrie trie, const char *name)
 
     return (node && node->id >= 0) ? p->info[node->id] : NULL;
 }
+
+/* collect the child char nodes of a char node in ascending char order */
+static RK_S32 trie_char_child(MppTrieImpl *p, RK_S32 idx, RK_U8 *keys, RK_S32 *childs)
+{
+    MppTrieNode *node = &p->nodes[idx];
+    RK_S32 cnt = 0;
+    RK_S32 k0;
+    RK_S32 k1;
+
+    for (k0 = 0; k0 < 16; k0++) {
+        MppTrieNode *mid;
+
+        if (!node->next[k0])
+            continue;
+
+        mid = &p->nodes[node->next[k0]];
+        for (k1 = 0; k1 < 16; k1++) {
+            if (!mid->next[k1])
+                continue;
+
+            if (keys)
+                keys[cnt] = (k0 << 4) | k1;
+            if (childs)
+                childs[cnt] = mid->next[k1];
+            cnt++;
+        }
+    }
+
+    return cnt;
+}
+
+/* follow the single child chain without info and return the end node */
+static RK_S32 trie_char_chain(MppTrieImpl *p, RK_S32 idx, RK_U8 *prefix, RK_S32 *len)
+{
+    RK_S32 cnt = 0;
+    RK_U8 key;
+    RK_S32 child;
+
+    while (p->nodes[idx].id == INVALID_NODE_ID && cnt < 255) {
+        if (trie_char_child(p, idx, NULL, NULL) != 1)
+            break;
+
+        trie_char_child(p, idx, &key, &child);
+        if (prefix)
+            prefix[cnt] = key;
+        cnt++;
+        idx = child;
+    }
+
+    *len = cnt;
+    return idx;
+}
+
+MppTrieFlat mpp_trie_flat_init(MppTrie trie)
+{
+    MppTrieImpl *p = (MppTrieImpl *)trie;
+    MppTrieFlatHead *head = NULL;
+    TrieFlatBuild *q = NULL;
+    RK_U8 *buf = NULL;
+    RK_U8 *base = NULL;
+    RK_S32 childs[256];
+    RK_S32 pos = sizeof(MppTrieFlatHead);
+    RK_S32 q_cnt = 1;
+    RK_S32 size;
+    RK_S32 i;
+    RK_S32 j;
+
+    if (NULL == trie) {
+        mpp_err_f("invalid NULL trie\n");
+        return NULL;
+    }
+
+    q = mpp_calloc(TrieFlatBuild, p->node_used);
+    if (NULL == q) {
+        mpp_err_f("failed to alloc %d build nodes\n", p->node_used);
+        return NULL;
+    }
+
+    /* breadth first layout keeps the shared upper levels in the first lines */
+    for (i = 0; i < q_cnt; i++) {
+        TrieFlatBuild *b = &q[i];
+
+        b->end = trie_char_chain(p, b->start, NULL, &b->prefix_len);
+        b->child_count = trie_char_child(p, b->end, NULL, childs);
+        b->first = q_cnt;
+
+        for (j = 0; j < b->child_count; j++)
+            q[q_cnt++].start = childs[j];
+
+        /* do not let a small node cross cache line */
+        size = TRIE_FLAT_NODE_SIZE(b->prefix_len, b->child_count);
+        if (size <= TRIE_CACHE_LINE &&
+            (pos & (TRIE_CACHE_LINE - 1)) + size > TRIE_CACHE_LINE)
+            pos = MPP_ALIGN(pos, TRIE_CACHE_LINE);
+
+        b->offset = pos;
+        pos += size;
+    }
+
+    size = MPP_ALIGN(pos, TRIE_CACHE_LINE);
+    if (size / 4 > 0xffff) {
+        mpp_err_f("trie size %d overflow\n", size);
+        goto DONE;
+    }
+
+    buf = mpp_calloc_size(RK_U8, size + TRIE_CACHE_LINE);
+    if (NULL == buf) {
+        mpp_err_f("failed to alloc flat trie size %d\n", size);
+        goto DONE;
+    }
+
+    base = (RK_U8 *)MPP_ALIGN((intptr_t)buf, TRIE_CACHE_LINE);
+    head = (MppTrieFlatHead *)base;
+    head->size = size;
+    head->node_count = q_cnt;
+    head->info_count = p->info_used;
+    head->buf_offset = (RK_S32)(base - buf);
+
+    for (i = 0; i < q_cnt; i++) {
+        TrieFlatBuild *b = &q[i];
+        MppTrieFlatNode *node = (MppTrieFlatNode *)(base + b->offset);
+        RK_U16 *child = (RK_U16 *)((RK_U8 *)node +
+                                   TRIE_FLAT_CHILD_POS(b->prefix_len, b->child_count));
+        RK_S32 len;
+
+        node->id = p->nodes[b->end].id;
+        node->prefix_len = b->prefix_len;
+        node->child_count = b->child_count;
+
+        trie_char_chain(p, b->start, node->data, &len);
+        trie_char_child(p, b->end, node->data + len, NULL);
+
+        for (j = 0; j < b->child_count; j++)
+            child[j] = q[b->first + j].offset >> 2;
+    }
+
+    trie_dbg_cnt("flat trie %d nodes -> %d nodes size %d\n",
+                 p->node_used, q_cnt, size);
+
+DONE:
+    MPP_FREE(q);
+    return base;
+}
+
+MPP_RET mpp_trie_flat_deinit(MppTrieFlat flat)
+{
+    MppTrieFlatHead *head = (MppTrieFlatHead *)flat;
+    RK_U8 *buf;
+
+    if (NULL == flat) {
+        mpp_err_f("invalid NULL flat trie\n");
+        return MPP_ERR_NULL_PTR;
+    }
+
+    buf = (RK_U8 *)flat - head->buf_offset;
+    MPP_FREE(buf);
+
+    return MPP_OK;
+}
+
+RK_S32 mpp_trie_flat_get_size(MppTrieFlat flat)
+{
+    return flat ? ((MppTrieFlatHead *)flat)->size : 0;
+}
+
+RK_S32 mpp_trie_flat_get_node_count(MppTrieFlat flat)
+{
+    return flat ? ((MppTrieFlatHead *)flat)->node_count : 0;
+}
+
+static MppTrieFlatNode *trie_flat_find(MppTrieFlat flat, const char *name)
+{
+    RK_U8 *base = (RK_U8 *)flat;
+    MppTrieFlatNode *node = (MppTrieFlatNode *)(base + sizeof(MppTrieFlatHead));
+    const char *s = name;
+
+    while (1) {
+        RK_S32 len = node->prefix_len;
+        RK_S32 cnt = node->child_count;
+        const RK_U8 *keys;
+        RK_U16 *child;
+        RK_S32 i;
+
+        /* strncmp stops on the end of name before reading past it */
+        if (len && strncmp(s, (const char *)node->data, len))
+            return NULL;
+
+        s += len;
+        if (!s[0])
+            return (node->id != INVALID_NODE_ID) ? node : NULL;
+
+        keys = node->data + len;
+        for (i = 0; i < cnt; i++) {
+            if (keys[i] == (RK_U8)s[0])
+                break;
+        }
+
+        if (i >= cnt)
+            return NULL;
+
+        child = (RK_U16 *)((RK_U8 *)node + TRIE_FLAT_CHILD_POS(len, cnt));
+        node = (MppTrieFlatNode *)(base + child[i] * 4);
+        s++;
+    }
+
+    return NULL;
+}
+
+RK_S32 mpp_trie_flat_get_id(MppTrieFlat flat, const char *name)
+{
+    MppTrieFlatNode *node;
+
+    if (NULL == flat || NULL == name) {
+        mpp_err_f("invalid flat trie %p name %p\n", flat, name);
+        return INVALID_NODE_ID;
+    }
+
+    node = trie_flat_find(flat, name);
+
+    trie_dbg_get("flat %p search %s id %d\n", flat, name, node ? node->id : INVALID_NODE_ID);
+
+    return node ? node->id : INVALID_NODE_ID;
+}
+
+MPP_RET mpp_trie_flat_set_id(MppTrieFlat flat, const char *name, RK_S32 id)
+{
+    MppTrieFlatNode *node;
+
+    if (NULL == flat || NULL == name) {
+        mpp_err_f("invalid flat trie %p name %p\n", flat, name);
+        return MPP_ERR_NULL_PTR;
+    }
+
+    node = trie_flat_find(flat, name);
+    if (NULL == node)
+        return MPP_NOK;
+
+    node->id = id;
+    return MPP_OK;
+}
@@ -20,10 +20,13 @@
 #include <string.h>
 
 #include "mpp_log.h"
+#include "mpp_mem.h"
+#include "mpp_time.h"
 #include "mpp_common.h"
 #include "mpp_bitread.h"
 
 #define BIT_READ_BUFFER_SIZE        (1024)
+#define RANDOM_RBSP_SIZE            (1024 * 1024)
 
 typedef enum BitOpsType_e {
     BIT_GET,
@@ -328,6 +331,153 @@ __NORMAL:
     return ret;
 }
 
+/*
+ * Random check: generate rbsp without 00 00 00, insert emulation prevention
+ * bytes like the encoder and compare the reader with a plain msb first reader
+ * on the rbsp for random read / skip / ue operations.
+ */
+typedef struct RefReader_t {
+    RK_U8   *buf;
+    RK_U32  size;
+    RK_U32  pos;
+} RefReader;
+
+static RK_U32 ref_read(RefReader *ref, RK_S32 num_bits)
+{
+    RK_U32 val = 0;
+
+    while (num_bits--) {
+        val = (val << 1) | ((ref->buf[ref->pos >> 3] >> (7 - (ref->pos & 7))) & 1);
+        ref->pos++;
+    }
+
+    return val;
+}
+
+static RK_U32 ref_read_ue(RefReader *ref)
+{
+    RK_S32 zeros = 0;
+
+    while (!ref_read(ref, 1))
+        zeros++;
+
+    return (1U << zeros) - 1 + ref_read(ref, zeros);
+}
+
+static RK_U32 gen_random_stream(RK_U8 *rbsp, RK_U8 *nalu, RK_U32 size)
+{
+    RK_U32 seed = 0x5a5a1234;
+    RK_U32 len = 0;
+    RK_U32 i;
+
+    for (i = 0; i < size; i++) {
+        RK_U32 val;
+
+        seed = seed * 1103515245 + 12345;
+        val = (seed >> 16) & 0xff;
+        /* many zero and small bytes to hit the emulation prevention path */
+        val = (val < 48) ? 0 : (val < 64) ? (val & 3) : val;
+        if (i >= 2 && !rbsp[i - 1] && !rbsp[i - 2] && !val)
+            val = 1;
+        rbsp[i] = val;
+
+        if (len >= 2 && !nalu[len - 1] && !nalu[len - 2] && val <= 3)
+            nalu[len++] = 0x03;
+        nalu[len++] = val;
+    }
+
+    return len;
+}
+
+static MPP_RET check_random_stream(void)
+{
+    RK_U8 *rbsp = mpp_malloc(RK_U8, RANDOM_RBSP_SIZE);
+    RK_U8 *nalu = mpp_malloc(RK_U8, RANDOM_RBSP_SIZE * 3 / 2);
+    MPP_RET ret = MPP_NOK;
+    BitReadCtx_t reader;
+    RefReader ref;
+    RK_U32 seed = 0x1234;
+    RK_U32 count = 0;
+    RK_U32 len;
+    RK_S64 time;
+
+    if (!rbsp || !nalu)
+        goto DONE;
+
+    len = gen_random_stream(rbsp, nalu, RANDOM_RBSP_SIZE);
+    ref.buf = rbsp;
+    ref.size = RANDOM_RBSP_SIZE;
+    ref.pos = 0;
+
+    mpp_set_bitread_ctx(&reader, nalu, len);
+    mpp_set_bitread_pseudo_code_type(&reader, PSEUDO_CODE_H264_H265);
+
+    while (ref.pos + 256 < ref.size * 8) {
+        RK_U32 op;
+        RK_U32 n;
+        RK_U32 val = 0;
+        RK_U32 expect;
+        RK_S32 tmp = 0;
+
+        seed = seed * 1103515245 + 12345;
+        op = (seed >> 16) % 3;
+        n = ((seed >> 20) & 31) + 1;
+
+        switch (op) {
+        case 0 : {
+            expect = ref_read(&ref, n);
+            if (n == 32) {
+                ret = mpp_read_longbits(&reader, n, &val);
+            } else {
+                ret = mpp_read_bits(&reader, n, &tmp);
+                val = tmp;
+            }
+        } break;
+        case 1 : {
+            expect = ref_read_ue(&ref);
+            ret = mpp_read_ue(&reader, &val);
+        } break;
+        default : {
+            expect = ref_read(&ref, n);
+            ret = mpp_skip_longbits(&reader, n);
+            val = expect;
+        } break;
+        }
+
+        if (ret || val != expect) {
+            mpp_err("random check failed at op %d type %d bits %d ret %d val %x expect %x\n",
+                    count, op, n, ret, val, expect);
+            ret = MPP_NOK;
+            goto DONE;
+        }
+        count++;
+    }
+    mpp_log("random check %d ops with %d emulation prevention bytes ok\n",
+            count, (RK_S32)reader.emulation_prevention_bytes_);
+
+    /* ue throughput on the escaped stream */
+    mpp_set_bitread_ctx(&reader, nalu, len);
+    mpp_set_bitread_pseudo_code_type(&reader, PSEUDO_CODE_H264_H265);
+    count = 0;
+    time = mpp_time();
+    while (mpp_get_bits_left(&reader) > 64) {
+        RK_U32 val;
+
+        if (mpp_read_ue(&reader, &val))
+            break;
+        count++;
+    }
+    time = mpp_time() - time;
+    mpp_log("read %d ue in %lld us %.1f ns/ue\n", count, time,
+            (double)time * 1000 / MPP_MAX(count, 1));
+
+    ret = MPP_OK;
+DONE:
+    MPP_FREE(rbsp);
+    MPP_FREE(nalu);
+    return ret;
+}
+
 int main()
 {
     BitReadCtx_t reader;
@@ -381,6 +531,10 @@ int main()
 
         tmp = 0;
     }
+
+    if (check_random_stream())
+        goto __READ_FAILED;
+
     mpp_log("mpp bit read test end\n");
     return 0;
 __READ_FAILED:
@@ -0,0 +1,220 @@
+/*
+ * Copyright 2024 Rockchip Electronics Co. LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#define MODULE_TAG "mpp_buf_slot_test"
+
+#include <sched.h>
+#include <string.h>
+
+#include "mpp_log.h"
+#include "mpp_lock.h"
+#include "mpp_time.h"
+#include "mpp_thread.h"
+#include "mpp_common.h"
+
+#include "mpp_buf_slot.h"
+
+#define SLOT_COUNT          16
+#define FRAME_COUNT         200000
+#define HAL_RING_SIZE       32
+
+/*
+ * Usage: mpp_buf_slot_test
+ *
+ * Simulate the decoder slot flow with three threads:
+ * parser  - get unused slot, mark codec / hal output / queue use, enqueue
+ *           display and drop the codec reference
+ * hal     - clear hal output when the frame is "decoded"
+ * output  - dequeue display slot and clear queue use to release the slot
+ *
+ * The parser and hal only touch the slot status flags which are updated
+ * lock free, so the time spent in slot calls reflects the contention left.
+ */
+
+typedef struct SlotTestCtx_t {
+    MppBufSlots     slots;
+
+    /* single producer single consumer ring from parser to hal */
+    RK_S32          ring[HAL_RING_SIZE];
+    RK_U32          ring_wr;
+    RK_U32          ring_rd;
+
+    RK_U32          parsed;
+    RK_U32          decoded;
+    RK_U32          displayed;
+    RK_U32          released;
+
+    RK_S64          parser_time;
+    RK_S64          hal_time;
+} SlotTestCtx;
+
+static MPP_RET slot_release_cb(const char *caller, void *ctx, RK_S32 cmd, void *param)
+{
+    SlotTestCtx *p = (SlotTestCtx *)ctx;
+    (void) caller;
+    (void) cmd;
+    (void) param;
+
+    MPP_FETCH_ADD(&p->released, 1);
+    return MPP_OK;
+}
+
+static void *parser_thread(void *arg)
+{
+    SlotTestCtx *p = (SlotTestCtx *)arg;
+    MppBufSlots slots = p->slots;
+
+    while (p->parsed < FRAME_COUNT) {
+        RK_S64 start;
+        RK_S32 index = -1;
+
+        if (!mpp_slots_get_unused_count(slots) ||
+            p->ring_wr - p->ring_rd >= HAL_RING_SIZE) {
+            sched_yield();
+            continue;
+        }
+
+        start = mpp_time();
+        mpp_buf_slot_get_unused(slots, &index);
+        mpp_buf_slot_set_flag(slots, index, SLOT_CODEC_USE);
+        mpp_buf_slot_set_flag(slots, index, SLOT_HAL_OUTPUT);
+        mpp_buf_slot_set_flag(slots, index, SLOT_QUEUE_USE);
+        mpp_buf_slot_enqueue(slots, index, QUEUE_DISPLAY);
+        mpp_buf_slot_clr_flag(slots, index, SLOT_CODEC_USE);
+        p->parser_time += mpp_time() - start;
+
+        p->ring[p->ring_wr % HAL_RING_SIZE] = index;
+        MPP_SYNC();
+        p->ring_wr++;
+        p->parsed++;
+    }
+
+    return NULL;
+}
+
+static void *hal_thread(void *arg)
+{
+    SlotTestCtx *p = (SlotTestCtx *)arg;
+    MppBufSlots slots = p->slots;
+
+    while (p->decoded < FRAME_COUNT) {
+        RK_S64 start;
+        RK_S32 index;
+
+        if (p->ring_rd == ((volatile SlotTestCtx *)p)->ring_wr) {
+            sched_yield();
+            continue;
+        }
+
+        MPP_SYNC();
+        index = p->ring[p->ring_rd % HAL_RING_SIZE];
+
+        start = mpp_time();
+        mpp_buf_slot_set_flag(slots, index, SLOT_HAL_INPUT);
+        mpp_buf_slot_clr_flag(slots, index, SLOT_HAL_INPUT);
+        mpp_buf_slot_clr_flag(slots, index, SLOT_HAL_OUTPUT);
+        p->hal_time += mpp_time() - start;
+
+        MPP_SYNC();
+        p->ring_rd++;
+        p->decoded++;
+    }
+
+    return NULL;
+}
+
+static void *output_thread(void *arg)
+{
+    SlotTestCtx *p = (SlotTestCtx *)arg;
+    MppBufSlots slots = p->slots;
+
+    while (p->displayed < FRAME_COUNT) {
+        RK_S32 index = -1;
+
+        if (mpp_buf_slot_dequeue(slots, &index, QUEUE_DISPLAY)) {
+            sched_yield();
+            continue;
+        }
+
+        mpp_buf_slot_clr_flag(slots, index, SLOT_QUEUE_USE);
+        p->displayed++;
+    }
+
+    return NULL;
+}
+
+int main()
+{
+    SlotTestCtx ctx;
+    MppCbCtx cb_ctx;
+    pthread_t parser;
+    pthread_t hal;
+    pthread_t output;
+    RK_S64 start;
+    RK_S64 total;
+    RK_S32 ret = MPP_NOK;
+
+    mpp_log("mpp_buf_slot_test start\n");
+
+    memset(&ctx, 0, sizeof(ctx));
+
+    if (mpp_buf_slot_init(&ctx.slots)) {
+        mpp_err("mpp_buf_slot_init failed\n");
+        goto DONE;
+    }
+
+    cb_ctx.callBack = slot_release_cb;
+    cb_ctx.ctx = &ctx;
+    cb_ctx.cmd = 0;
+    mpp_buf_slot_set_callback(ctx.slots, &cb_ctx);
+    mpp_buf_slot_setup(ctx.slots, SLOT_COUNT);
+
+    start = mpp_time();
+    pthread_create(&parser, NULL, parser_thread, &ctx);
+    pthread_create(&hal, NULL, hal_thread, &ctx);
+    pthread_create(&output, NULL, output_thread, &ctx);
+
+    pthread_join(parser, NULL);
+    pthread_join(hal, NULL);
+    pthread_join(output, NULL);
+    total = mpp_time() - start;
+
+    mpp_log("frames parsed %d decoded %d displayed %d released %d\n",
+            ctx.parsed, ctx.decoded, ctx.displayed, ctx.released);
+    mpp_log("total %lld us %.1f frames/ms\n", total,
+            (double)FRAME_COUNT * 1000 / MPP_MAX(total, 1));
+    mpp_log("parser slot ops %.3f us/frame hal slot ops %.3f us/frame\n",
+            (double)ctx.parser_time / FRAME_COUNT,
+            (double)ctx.hal_time / FRAME_COUNT);
+
+    if (ctx.released != FRAME_COUNT) {
+        mpp_err("released %d frames mismatch %d\n", ctx.released, FRAME_COUNT);
+        goto DONE;
+    }
+
+    if (mpp_slots_get_used_count(ctx.slots)) {
+        mpp_err("found %d slots still in use\n", mpp_slots_get_used_count(ctx.slots));
+        goto DONE;
+    }
+
+    ret = MPP_OK;
+DONE:
+    if (ctx.slots)
+        mpp_buf_slot_deinit(ctx.slots);
+
+    mpp_log("mpp_buf_slot_test %s\n", ret ? "failed" : "success");
+    return ret;
+}
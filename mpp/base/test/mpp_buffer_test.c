@@ -44,6 +44,7 @@ int main()
     MppBuffer normal_buffer[MPP_BUFFER_TEST_NORMAL_COUNT];
     MppBuffer legacy_buffer = NULL;
     size_t size = MPP_BUFFER_TEST_SIZE;
+    size_t usage = 0;
     RK_S32 count = MPP_BUFFER_TEST_COMMIT_COUNT;
     RK_S32 i;
     RK_U32 debug = 0;
@@ -232,6 +233,29 @@ int main()
         }
     }
 
+    /* mixed size request should reuse unused buffer without reallocation */
+    usage = mpp_buffer_group_usage(group);
+
+    for (i = count - 1; i >= 0; i--) {
+        ret = mpp_buffer_get(group, &normal_buffer[i], (i + 1) * SZ_1K);
+        if (MPP_OK != ret) {
+            mpp_err("mpp_buffer_test mpp_buffer_get mode normal reuse failed\n");
+            goto MPP_BUFFER_failed;
+        }
+    }
+
+    if (usage != mpp_buffer_group_usage(group)) {
+        mpp_err("mpp_buffer_test group usage %d -> %d on reuse\n",
+                usage, mpp_buffer_group_usage(group));
+        ret = MPP_NOK;
+        goto MPP_BUFFER_failed;
+    }
+
+    for (i = 0; i < count; i++) {
+        mpp_buffer_put(normal_buffer[i]);
+        normal_buffer[i] = NULL;
+    }
+
     mpp_log("mpp_buffer_test normal mode success\n");
 
     if (group) {
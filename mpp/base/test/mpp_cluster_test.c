@@ -16,83 +16,116 @@
 
 #define MODULE_TAG "mpp_cluster_test"
 
+#include <stdlib.h>
+
 #include "mpp_log.h"
 #include "mpp_time.h"
 #include "mpp_common.h"
 
 #include "mpp_cluster.h"
 
+#define TEST_NODE_COUNT     8
+#define TEST_TRIGGER_COUNT  200
+
 typedef struct MppTestNode_t {
     MppNode         node;
+    RK_S32          id;
+    RK_U32          run;
 } MppTestNode;
 
-MppTestNode test_node;
+MppTestNode test_node[TEST_NODE_COUNT];
 
-static RK_S32 mpp_cluster_test_worker(void *param)
+static MPP_RET mpp_cluster_test_worker(void *param)
 {
-    RK_S32 ret = MPP_NOK;
-    (void) param;
+    MppTestNode *p = (MppTestNode *)param;
+    RK_S64 end = mpp_time() + 50;
 
-    mpp_log_f("worker run start\n");
-    mpp_log_f("worker run ret %d\n", ret);
+    /* simulate a short hardware submission */
+    while (mpp_time() < end)
+        ;
 
-    return ret;
+    p->run++;
+
+    return MPP_OK;
 }
 
 int main()
 {
     MPP_RET ret = MPP_OK;
-    MppNode node = test_node.node;
-    RK_U32 total_run = 2;
+    RK_U32 total_run = TEST_TRIGGER_COUNT;
+    RK_S32 i;
 
     mpp_log("mpp_cluster_test start\n");
 
-    ret = mpp_node_init(&node);
-    if (ret) {
-        mpp_err("mpp_node_init failed ret %d\n", ret);
-        goto DONE;
-    }
-
-    mpp_log("mpp_cluster_test init node done\n");
+    /* use multiple workers when not specified */
+    setenv("mpp_cluster_thd_cnt", "4", 0);
 
-    /* setup node info */
-    mpp_node_set_func(node, mpp_cluster_test_worker, &test_node);
+    for (i = 0; i < TEST_NODE_COUNT; i++) {
+        MppTestNode *p = &test_node[i];
 
-    mpp_log("mpp_cluster_test attach node start\n");
-    ret = mpp_node_attach(node, VPU_CLIENT_RKVDEC);
-    if (ret) {
-        mpp_err("mpp_node_attach failed ret %d\n", ret);
-        goto DONE;
-    }
+        p->id = i;
+        ret = mpp_node_init(&p->node);
+        if (ret) {
+            mpp_err("mpp_node_init failed ret %d\n", ret);
+            goto DONE;
+        }
 
-    mpp_log("mpp_cluster_test trigger start\n");
+        /* setup node info */
+        mpp_node_set_func(p->node, mpp_cluster_test_worker, p);
+        mpp_node_set_priority(p->node, i % MAX_PRIORITY);
 
-    do {
-        ret = mpp_node_trigger(node, 1);
+        ret = mpp_node_attach(p->node, VPU_CLIENT_RKVDEC);
         if (ret) {
-            mpp_err("mpp_node_trigger failed ret %d\n", ret);
+            mpp_err("mpp_node_attach failed ret %d\n", ret);
             goto DONE;
         }
+    }
+
+    mpp_log("mpp_cluster_test attach %d nodes done\n", TEST_NODE_COUNT);
 
-        mpp_log("mpp_cluster_test trigger %d left\n", total_run);
+    do {
+        for (i = 0; i < TEST_NODE_COUNT; i++) {
+            ret = mpp_node_trigger(test_node[i].node, 1);
+            if (ret) {
+                mpp_err("mpp_node_trigger failed ret %d\n", ret);
+                goto DONE;
+            }
+        }
 
-        msleep(5);
+        usleep(100);
     } while (--total_run);
 
     mpp_log("mpp_cluster_test detach start\n");
 
-    ret = mpp_node_detach(node);
-    if (ret) {
-        mpp_err("mpp_node_detach failed ret %d\n", ret);
-        goto DONE;
-    }
+    for (i = 0; i < TEST_NODE_COUNT; i++) {
+        MppTestNode *p = &test_node[i];
+        MppNodeStat stat;
+
+        ret = mpp_node_detach(p->node);
+        if (ret) {
+            mpp_err("mpp_node_detach failed ret %d\n", ret);
+            goto DONE;
+        }
 
-    mpp_log("mpp_cluster_test deinit start\n");
+        mpp_node_get_stat(p->node, &stat);
+        mpp_log("node %d P%d run %4d avg %3lld max %4lld us wait avg %4lld max %5lld us steal %d\n",
+                i, i % MAX_PRIORITY, stat.run_count,
+                stat.run_time / MPP_MAX(stat.run_count, 1), stat.run_time_max,
+                stat.wait_time / MPP_MAX(stat.run_count, 1), stat.wait_time_max,
+                stat.steal_count);
 
-    ret = mpp_node_deinit(node);
-    if (ret) {
-        mpp_err("mpp_node_deinit failed ret %d\n", ret);
-        goto DONE;
+        if (!stat.run_count || stat.run_count != p->run) {
+            mpp_err("node %d run count %d mismatch %d\n", i, stat.run_count, p->run);
+            ret = MPP_NOK;
+            goto DONE;
+        }
+
+        ret = mpp_node_deinit(p->node);
+        if (ret) {
+            mpp_err("mpp_node_deinit failed ret %d\n", ret);
+            goto DONE;
+        }
+        p->node = NULL;
     }
 
     mpp_log("mpp_cluster_test deinit done\n");
@@ -24,6 +24,74 @@
 #include "rk_venc_cfg.h"
 #include "mpp_enc_cfg_impl.h"
 
+#define HND_TEST_LOOP   100000
+
+static MPP_RET test_cfg_hnd(MppEncCfg cfg)
+{
+    MppEncCfgImpl *impl = (MppEncCfgImpl *)cfg;
+    MppEncCfgHnd hnd_bps = mpp_enc_cfg_get_hnd("rc:bps_target");
+    MppEncCfgHnd hnd_qp = mpp_enc_cfg_get_hnd("rc:qp_init");
+    RK_S64 time_name;
+    RK_S64 time_hnd;
+    RK_S32 val = 0;
+    RK_S32 i;
+
+    if (!hnd_bps || !hnd_qp || mpp_enc_cfg_get_hnd("rc:not_exist")) {
+        mpp_err("get cfg handle failed\n");
+        return MPP_NOK;
+    }
+
+    /* wrong type must be rejected like the name access */
+    if (!mpp_enc_cfg_set_s64_by_hnd(cfg, hnd_bps, 1)) {
+        mpp_err("cfg handle type check failed\n");
+        return MPP_NOK;
+    }
+
+    impl->cfg.rc.change = 0;
+    impl->dirty = 0;
+
+    /* setting the same value keeps the cfg clean */
+    mpp_enc_cfg_get_s32(cfg, "rc:bps_target", &val);
+    mpp_enc_cfg_set_s32_by_hnd(cfg, hnd_bps, val);
+    if (impl->dirty) {
+        mpp_err("cfg dirty on unchanged value\n");
+        return MPP_NOK;
+    }
+
+    mpp_enc_cfg_set_s32_by_hnd(cfg, hnd_bps, 2000000);
+    mpp_enc_cfg_get_s32(cfg, "rc:bps_target", &val);
+    if (val != 2000000 || !impl->dirty) {
+        mpp_err("cfg handle set failed val %d dirty %d\n", val, impl->dirty);
+        return MPP_NOK;
+    }
+
+    mpp_enc_cfg_set_s32(cfg, "rc:qp_init", 30);
+    mpp_enc_cfg_get_s32_by_hnd(cfg, hnd_qp, &val);
+    if (val != 30) {
+        mpp_err("cfg handle get failed val %d\n", val);
+        return MPP_NOK;
+    }
+
+    time_name = mpp_time();
+    for (i = 0; i < HND_TEST_LOOP; i++) {
+        mpp_enc_cfg_set_s32(cfg, "rc:bps_target", i);
+        mpp_enc_cfg_set_s32(cfg, "rc:qp_init", i & 31);
+    }
+    time_name = mpp_time() - time_name;
+
+    time_hnd = mpp_time();
+    for (i = 0; i < HND_TEST_LOOP; i++) {
+        mpp_enc_cfg_set_s32_by_hnd(cfg, hnd_bps, i);
+        mpp_enc_cfg_set_s32_by_hnd(cfg, hnd_qp, i & 31);
+    }
+    time_hnd = mpp_time() - time_hnd;
+
+    mpp_log("%d set by name %lld us by handle %lld us\n",
+            HND_TEST_LOOP * 2, time_name, time_hnd);
+
+    return MPP_OK;
+}
+
 int main()
 {
     MPP_RET ret = MPP_OK;
@@ -97,6 +165,12 @@ int main()
             aq_thrd_i_ret[8], aq_thrd_i_ret[9], aq_thrd_i_ret[10], aq_thrd_i_ret[11],
             aq_thrd_i_ret[12], aq_thrd_i_ret[13], aq_thrd_i_ret[14], aq_thrd_i_ret[15]);
 
+    ret = test_cfg_hnd(cfg);
+    if (ret) {
+        mpp_enc_cfg_deinit(cfg);
+        goto DONE;
+    }
+
     ret = mpp_enc_cfg_deinit(cfg);
     if (ret) {
         mpp_err("mpp_enc_cfg_deinit failed\n");
@@ -25,6 +25,59 @@
 #define TEST_MAX    200
 #define LOOP_MAX    100000
 
+static MPP_RET meta_check(void)
+{
+    MppMeta meta = NULL;
+    MPP_RET ret = MPP_NOK;
+    RK_S64 val_s64 = 0;
+    RK_S32 val = 0;
+    void *ptr = NULL;
+
+    mpp_meta_get(&meta);
+    if (!meta)
+        return MPP_NOK;
+
+    /* key lookup must match both key and type */
+    if (!mpp_meta_set_s64(meta, KEY_TEMPORAL_ID, 1) ||
+        !mpp_meta_set_s32(meta, KEY_ENC_SSE, 1) ||
+        !mpp_meta_set_s32(meta, KEY_INPUT_IDR_REQ, 1)) {
+        mpp_err("invalid key / type pair accepted\n");
+        goto DONE;
+    }
+
+    if (mpp_meta_set_s32(meta, KEY_TEMPORAL_ID, 3) ||
+        mpp_meta_set_s64(meta, KEY_ENC_SSE, 1LL << 40) ||
+        mpp_meta_set_ptr(meta, KEY_USER_DATA, &val) ||
+        mpp_meta_set_s32(meta, KEY_DEC_TBN_UV_OFFSET, 7)) {
+        mpp_err("valid key / type pair rejected\n");
+        goto DONE;
+    }
+
+    if (mpp_meta_size(meta) != 4) {
+        mpp_err("node count %d mismatch\n", mpp_meta_size(meta));
+        goto DONE;
+    }
+
+    if (mpp_meta_get_s32(meta, KEY_TEMPORAL_ID, &val) || val != 3 ||
+        mpp_meta_get_s64(meta, KEY_ENC_SSE, &val_s64) || val_s64 != 1LL << 40 ||
+        mpp_meta_get_ptr(meta, KEY_USER_DATA, &ptr) || ptr != &val ||
+        mpp_meta_get_s32(meta, KEY_DEC_TBN_UV_OFFSET, &val) || val != 7) {
+        mpp_err("value mismatch\n");
+        goto DONE;
+    }
+
+    /* values are consumed by get */
+    if (!mpp_meta_get_s32(meta, KEY_TEMPORAL_ID, &val) || mpp_meta_size(meta)) {
+        mpp_err("value not consumed\n");
+        goto DONE;
+    }
+
+    ret = MPP_OK;
+DONE:
+    mpp_meta_put(meta);
+    return ret;
+}
+
 void *meta_test(void *param)
 {
     RK_S32 loop_max = LOOP_MAX;
@@ -135,6 +188,11 @@ int main()
 
     mpp_log("mpp_meta_test start\n");
 
+    if (meta_check()) {
+        mpp_err("mpp_meta_test check failed\n");
+        return -1;
+    }
+
     for (i = 0; i < thd_cnt; i++)
         pthread_create(&thds[i], &attr, meta_test, &times[i]);
 
@@ -0,0 +1,143 @@
+/*
+ * Copyright 2024 Rockchip Electronics Co. LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#define MODULE_TAG "mpp_startcode_test"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "mpp_log.h"
+#include "mpp_mem.h"
+#include "mpp_common.h"
+
+#include "mpp_startcode.h"
+
+#include "utils.h"
+
+#define SYNTH_STREAM_SIZE   (32 * 1024 * 1024)
+#define SYNTH_NALU_MAX      (256 * 1024)
+
+/*
+ * Usage: mpp_startcode_test [annexb bitstream file]
+ *
+ * Without input file a synthetic stream with random payload and random nalu
+ * size is generated. The test checks the start code positions against the
+ * byte-wise shift register reference. The nalu split of the parser prepare is
+ * checked on real streams by h264d_prepare_test.
+ */
+
+static const RK_U8 synth_hdr[] = {
+    0x65,
+};
+
+static RK_S32 check_positions(const RK_U8 *buf, RK_U32 size)
+{
+    const RK_U8 *end = buf + size;
+    const RK_U8 *p = buf;
+    RK_U32 state = 0xffffffff;
+    RK_U32 pos;
+    RK_U32 count = 0;
+
+    for (pos = 0; pos < size; pos++) {
+        state = (state << 8) | buf[pos];
+        if ((state & 0x00ffffff) != 0x000001 || pos < 2)
+            continue;
+
+        p = mpp_find_startcode(p, end);
+        if (p != buf + pos - 2) {
+            mpp_err("mismatch at %d expect %d\n", (RK_S32)(p - buf), pos - 2);
+            return MPP_NOK;
+        }
+        p++;
+        count++;
+    }
+
+    if (mpp_find_startcode(p, end) != end) {
+        mpp_err("found extra start code at end\n");
+        return MPP_NOK;
+    }
+
+    mpp_log("checked %d start codes\n", count);
+    return MPP_OK;
+}
+
+static RK_S32 check_corner_case(void)
+{
+    RK_U8 data[64];
+    RK_U32 i;
+    RK_U32 j;
+
+    /* every prefix position and every buffer length around the vector size */
+    for (i = 0; i + 3 <= sizeof(data); i++) {
+        for (j = i + 3; j <= sizeof(data); j++) {
+            const RK_U8 *p;
+
+            memset(data, 0xff, sizeof(data));
+            data[i] = 0;
+            data[i + 1] = 0;
+            data[i + 2] = 1;
+
+            p = mpp_find_startcode(data, data + j);
+            if (p != data + i) {
+                mpp_err("corner case failed at %d len %d\n", i, j);
+                return MPP_NOK;
+            }
+
+            p = mpp_find_startcode(data, data + i + 2);
+            if (p != data + i + 2) {
+                mpp_err("corner case partial prefix failed at %d\n", i);
+                return MPP_NOK;
+            }
+        }
+    }
+
+    return MPP_OK;
+}
+
+int main(int argc, char **argv)
+{
+    RK_U8 *buf = NULL;
+    RK_U32 size = 0;
+    RK_S32 ret = MPP_NOK;
+
+    mpp_log("mpp start code test start with %s engine\n", mpp_startcode_engine());
+
+    if (check_corner_case())
+        goto DONE;
+
+    if (argc > 1) {
+        buf = load_stream(argv[1], &size);
+        mpp_log("load %s size %d\n", argv[1], size);
+    } else {
+        size = SYNTH_STREAM_SIZE;
+        buf = gen_stream(size, SYNTH_NALU_MAX, synth_hdr, 1, MPP_ARRAY_ELEMS(synth_hdr));
+        mpp_log("generate synthetic stream size %d\n", size);
+    }
+
+    if (!buf || !size)
+        goto DONE;
+
+    if (check_positions(buf, size))
+        goto DONE;
+
+    ret = MPP_OK;
+DONE:
+    MPP_FREE(buf);
+    mpp_log("mpp start code test %s\n", ret ? "failed" : "success");
+
+    return ret;
+}
@@ -48,6 +48,8 @@ TestAction test_info[] = {
     { "rc:bps_target",  &test_info[1],  print_opt},
     { "rc:bps_max",     &test_info[2],  print_opt},
     { "rc:bps_min",     &test_info[3],  print_opt},
+    { "rc",             &test_info[4],  print_opt},
+    { "prep:width",     &test_info[5],  print_opt},
 };
 
 const char *test_str[] = {
@@ -56,6 +58,74 @@ const char *test_str[] = {
     "rc:bps_max",
 };
 
+/* prefix, extension and unknown name should all miss */
+const char *miss_str[] = {
+    "r",
+    "rc:",
+    "rc:bps",
+    "rc:bps_target_x",
+    "prep",
+    "codec:type",
+    "",
+};
+
+#define FLAT_TEST_LOOP      100000
+
+static RK_S32 test_flat(MppTrie trie)
+{
+    MppTrieFlat flat = mpp_trie_flat_init(trie);
+    RK_S32 info_cnt = MPP_ARRAY_ELEMS(test_info);
+    RK_S32 ret = MPP_NOK;
+    RK_S64 time_trie;
+    RK_S64 time_flat;
+    RK_S64 start;
+    RK_S32 i;
+    RK_S32 j;
+
+    if (NULL == flat)
+        return MPP_NOK;
+
+    for (i = 0; i < info_cnt; i++) {
+        RK_S32 id = mpp_trie_flat_get_id(flat, test_info[i].name);
+
+        if (id != i) {
+            mpp_err("flat trie %s get id %d expect %d\n", test_info[i].name, id, i);
+            goto DONE;
+        }
+    }
+
+    for (i = 0; i < (RK_S32)MPP_ARRAY_ELEMS(miss_str); i++) {
+        if (mpp_trie_flat_get_id(flat, miss_str[i]) >= 0 ||
+            mpp_trie_get_info(trie, miss_str[i])) {
+            mpp_err("flat trie %s should not be found\n", miss_str[i]);
+            goto DONE;
+        }
+    }
+
+    start = mpp_time();
+    for (j = 0; j < FLAT_TEST_LOOP; j++)
+        for (i = 0; i < info_cnt; i++)
+            mpp_trie_get_info(trie, test_info[i].name);
+    time_trie = mpp_time() - start;
+
+    start = mpp_time();
+    for (j = 0; j < FLAT_TEST_LOOP; j++)
+        for (i = 0; i < info_cnt; i++)
+            mpp_trie_flat_get_id(flat, test_info[i].name);
+    time_flat = mpp_time() - start;
+
+    mpp_log("trie %d nodes size %d search %lld us\n",
+            mpp_trie_get_node_count(trie),
+            mpp_trie_get_node_count(trie) * (RK_S32)sizeof(MppTrieNode), time_trie);
+    mpp_log("flat %d nodes size %d search %lld us\n",
+            mpp_trie_flat_get_node_count(flat), mpp_trie_flat_get_size(flat), time_flat);
+
+    ret = MPP_OK;
+DONE:
+    mpp_trie_flat_deinit(flat);
+    return ret;
+}
+
 int main()
 {
     MppTrie trie = NULL;
@@ -65,14 +135,13 @@ int main()
     RK_S64 start = 0;
     RK_S32 info_cnt = MPP_ARRAY_ELEMS(test_info);
     RK_S32 node_cnt = 100;
+    RK_S32 ret;
 
     mpp_trie_init(&trie, node_cnt, info_cnt);
 
     start = mpp_time();
-    mpp_trie_add_info(trie, &test_info[0].name);
-    mpp_trie_add_info(trie, &test_info[1].name);
-    mpp_trie_add_info(trie, &test_info[2].name);
-    mpp_trie_add_info(trie, &test_info[3].name);
+    for (i = 0; i < (RK_U32)info_cnt; i++)
+        mpp_trie_add_info(trie, &test_info[i].name);
     end = mpp_time();
     mpp_log("add act time %lld us\n", end - start);
 
@@ -90,7 +159,11 @@ int main()
         }
     }
 
+    ret = test_flat(trie);
+
     mpp_trie_deinit(trie);
 
-    return 0;
+    mpp_log("mpp_trie_test %s\n", ret ? "failed" : "success");
+
+    return ret;
 }
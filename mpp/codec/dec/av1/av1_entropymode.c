@@ -17,6 +17,7 @@
 #include "av1_entropymode.h"
 #include "av1d_syntax.h"
 #include <string.h>
+#include <pthread.h>
 #include "rk_type.h"
 
 #define AOM_ICDF ICDF
@@ -4360,12 +4361,8 @@ int get_q_ctx(int q)
     return 3;
 }
 
-void Av1DefaultCoeffProbs(RK_U32 base_qindex, void *ptr)
+static void av1_set_coeff_cdfs(AV1CDFs *cdfs, int index)
 {
-
-    AV1CDFs *cdfs = (AV1CDFs*)ptr;
-    const int index = get_q_ctx(base_qindex);
-
     memcpy(cdfs->txb_skip_cdf, av1_default_txb_skip_cdfs[index],
            sizeof(av1_default_txb_skip_cdfs[0]));
     memcpy(cdfs->eob_extra_cdf, av1_default_eob_extra_cdfs[index],
@@ -4395,6 +4392,11 @@ void Av1DefaultCoeffProbs(RK_U32 base_qindex, void *ptr)
            sizeof(av1_default_eob_multi1024_cdfs[0]));
 }
 
+void Av1DefaultCoeffProbs(RK_U32 base_qindex, void *ptr)
+{
+    av1_set_coeff_cdfs((AV1CDFs *)ptr, get_q_ctx(base_qindex));
+}
+
 void AV1InitCDFs(RK_U32 base_qindex, void *ptr)
 {
     Av1DefaultCoeffProbs(base_qindex, ptr);
@@ -4559,3 +4561,40 @@ void AV1SetDefaultCDFs(AV1CDFs *cdfs, MvCDFs *cdfs_ndvc)
 
     // Av1DefaultCoeffProbs(x);
 }
+
+/*
+ * Default cdf images for each coefficient q context. They are built once per
+ * process and shared read only by all decoder instances so the frames which
+ * reset to the defaults only switch a pointer instead of rebuilding ~90
+ * tables. The default intrabc mv cdfs equal the default mv cdfs so each
+ * image is also valid for key and intra only frames.
+ */
+static AV1CDFs av1_default_cdfs[TOKEN_CDF_Q_CTXS];
+static MvCDFs av1_default_cdfs_ndvc;
+static pthread_once_t av1_default_cdfs_once = PTHREAD_ONCE_INIT;
+
+static void av1_default_cdfs_build(void)
+{
+    RK_S32 i;
+
+    AV1SetDefaultCDFs(&av1_default_cdfs[0], &av1_default_cdfs_ndvc);
+    for (i = 1; i < TOKEN_CDF_Q_CTXS; i++)
+        av1_default_cdfs[i] = av1_default_cdfs[0];
+
+    for (i = 0; i < TOKEN_CDF_Q_CTXS; i++)
+        av1_set_coeff_cdfs(&av1_default_cdfs[i], i);
+}
+
+const AV1CDFs *Av1GetDefaultCDFs(RK_S32 q_ctx)
+{
+    pthread_once(&av1_default_cdfs_once, av1_default_cdfs_build);
+
+    return &av1_default_cdfs[q_ctx];
+}
+
+const MvCDFs *Av1GetDefaultCDFsNdvc(void)
+{
+    pthread_once(&av1_default_cdfs_once, av1_default_cdfs_build);
+
+    return &av1_default_cdfs_ndvc;
+}
@@ -2029,14 +2029,16 @@ static RK_S32 mpp_av1_uncompressed_header(AV1Context *ctx, BitReadCtx_t *gb,
     if (current->error_resilient_mode || frame_is_intra || current->primary_ref_frame == AV1_PRIMARY_REF_NONE) {
         // Init non-coeff CDFs.
         // Setup past independence.
-        ctx->cdfs = &ctx->default_cdfs;
-        ctx->cdfs_ndvc = &ctx->default_cdfs_ndvc;
-        Av1DefaultCoeffProbs(current->base_q_idx, ctx->cdfs);
+        // The shared default images are never written, stores copy from them.
+        ctx->cdfs_default_idx = get_q_ctx(current->base_q_idx);
+        ctx->cdfs = (AV1CDFs *)Av1GetDefaultCDFs(ctx->cdfs_default_idx);
+        ctx->cdfs_ndvc = (MvCDFs *)Av1GetDefaultCDFsNdvc();
     } else {
         // Load CDF tables from previous frame.
         // Load params from previous frame.
         RK_U32 idx = current->ref_frame_idx[current->primary_ref_frame];
 
+        ctx->cdfs_default_idx = -1;
         Av1GetCDFs(ctx, idx);
     }
     av1d_dbg(AV1D_DBG_HEADER, "show_existing_frame_index %d primary_ref_frame %d %d (%d) refresh_frame_flags %d base_q_idx %d\n",
@@ -838,9 +838,9 @@ MPP_RET av1d_parser_init(Av1CodecContext *ctx, ParserCfg *init)
         mpp_err("Failed to allocate frame buffer %d\n", i);
         return MPP_ERR_NOMEM;
     }
-    s->cdfs = &s->default_cdfs;
-    s->cdfs_ndvc = &s->default_cdfs_ndvc;
-    AV1SetDefaultCDFs(s->cdfs, s->cdfs_ndvc);
+    s->cdfs = (AV1CDFs *)Av1GetDefaultCDFs(0);
+    s->cdfs_ndvc = (MvCDFs *)Av1GetDefaultCDFsNdvc();
+    s->cdfs_default_idx = 0;
 
     return MPP_OK;
 
@@ -122,8 +122,8 @@ typedef struct AV1Context_t {
 
     AV1CDFs *cdfs;
     MvCDFs  *cdfs_ndvc;
-    AV1CDFs default_cdfs;
-    MvCDFs  default_cdfs_ndvc;
+    /* q context of the shared default cdfs in use, -1 for reference cdfs */
+    RK_S32  cdfs_default_idx;
     AV1CDFs cdfs_last[NUM_REF_FRAMES];
     MvCDFs  cdfs_last_ndvc[NUM_REF_FRAMES];
     RK_U8 disable_frame_end_update_cdf;
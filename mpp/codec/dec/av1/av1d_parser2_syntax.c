@@ -273,6 +273,7 @@ static int av1d_fill_picparams(Av1CodecContext *ctx, DXVA_PicParams_AV1 *pp)
 
     pp->cdfs = h->cdfs;
     pp->cdfs_ndvc = h->cdfs_ndvc;
+    pp->cdfs_default_idx = h->cdfs_default_idx;
     pp->tile_cols_log2 = frame_header->tile_cols_log2;
     // XXX: Setting the StatusReportFeedbackNumber breaks decoding on some drivers (tested on NVIDIA 457.09)
     // Status Reporting is not used by FFmpeg, hence not providing a number does not cause any issues
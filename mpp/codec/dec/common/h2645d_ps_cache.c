@@ -0,0 +1,99 @@
+/* SPDX-License-Identifier: Apache-2.0 */
+/*
+ * Copyright (c) 2024 Rockchip Electronics Co., Ltd.
+ */
+
+#define MODULE_TAG "h2645d_ps_cache"
+
+#include <string.h>
+
+#include "mpp_mem.h"
+
+#include "h2645d_ps_cache.h"
+
+/* FNV-1a */
+static RK_U32 ps_hash(const RK_U8 *data, RK_S32 len)
+{
+    RK_U32 hash = 2166136261u;
+    RK_S32 i;
+
+    for (i = 0; i < len; i++) {
+        hash ^= data[i];
+        hash *= 16777619u;
+    }
+
+    return hash;
+}
+
+RK_S32 h2645d_ps_cache_find(H2645dPsCache *cache, RK_S32 count,
+                            const RK_U8 *data, RK_S32 len, RK_U32 *hash)
+{
+    RK_U32 val;
+    RK_S32 i;
+
+    if (!cache || !data || len <= 0)
+        return -1;
+
+    val = ps_hash(data, len);
+    if (hash)
+        *hash = val;
+
+    for (i = 0; i < count; i++) {
+        H2645dPsCache *p = &cache[i];
+
+        if (p->len == len && p->hash == val && !memcmp(p->data, data, len))
+            return i;
+    }
+
+    return -1;
+}
+
+MPP_RET h2645d_ps_cache_update(H2645dPsCache *cache, const RK_U8 *data,
+                               RK_S32 len, RK_U32 hash)
+{
+    if (!cache || !data || len <= 0)
+        return MPP_ERR_VALUE;
+
+    if (cache->size < len) {
+        MPP_FREE(cache->data);
+        cache->data = mpp_malloc(RK_U8, len);
+        if (!cache->data) {
+            cache->len = 0;
+            cache->size = 0;
+            return MPP_ERR_NOMEM;
+        }
+        cache->size = len;
+    }
+
+    memcpy(cache->data, data, len);
+    cache->hash = hash;
+    cache->len = len;
+
+    return MPP_OK;
+}
+
+void h2645d_ps_cache_clear(H2645dPsCache *cache, RK_S32 count)
+{
+    RK_S32 i;
+
+    if (!cache)
+        return;
+
+    /* keep the buffer for the next update */
+    for (i = 0; i < count; i++)
+        cache[i].len = 0;
+}
+
+void h2645d_ps_cache_deinit(H2645dPsCache *cache, RK_S32 count)
+{
+    RK_S32 i;
+
+    if (!cache)
+        return;
+
+    for (i = 0; i < count; i++) {
+        MPP_FREE(cache[i].data);
+        cache[i].len = 0;
+        cache[i].size = 0;
+    }
+}
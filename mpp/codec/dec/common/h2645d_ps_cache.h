@@ -0,0 +1,40 @@
+/* SPDX-License-Identifier: Apache-2.0 */
+/*
+ * Copyright (c) 2024 Rockchip Electronics Co., Ltd.
+ */
+
+#ifndef _H2645D_PS_CACHE_H_
+#define _H2645D_PS_CACHE_H_
+
+#include "rk_type.h"
+#include "mpp_err.h"
+
+/*
+ * Raw bytes of the last parameter set nal stored on each id.
+ * A repeated vps / sps / pps with identical bytes can be skipped without
+ * parsing it again. len 0 means the entry is empty.
+ */
+typedef struct H2645dPsCache_t {
+    RK_U32  hash;
+    RK_S32  len;
+    RK_S32  size;
+    RK_U8   *data;
+} H2645dPsCache;
+
+#ifdef  __cplusplus
+extern "C" {
+#endif
+
+/* return the id of the entry holding the same bytes, or -1 with the hash for update */
+RK_S32 h2645d_ps_cache_find(H2645dPsCache *cache, RK_S32 count,
+                            const RK_U8 *data, RK_S32 len, RK_U32 *hash);
+MPP_RET h2645d_ps_cache_update(H2645dPsCache *cache, const RK_U8 *data,
+                               RK_S32 len, RK_U32 hash);
+void h2645d_ps_cache_clear(H2645dPsCache *cache, RK_S32 count);
+void h2645d_ps_cache_deinit(H2645dPsCache *cache, RK_S32 count);
+
+#ifdef  __cplusplus
+}
+#endif
+
+#endif /* _H2645D_PS_CACHE_H_ */
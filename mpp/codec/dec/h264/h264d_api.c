@@ -144,6 +144,9 @@ static MPP_RET free_vid_ctx(H264dVideoCtx_t *p_Vid)
     for (i = 0; i < MAXPPS; i++)
         MPP_FREE(p_Vid->ppsSet[i]);
 
+    h2645d_ps_cache_deinit(p_Vid->sps_cache, MAXSPS);
+    h2645d_ps_cache_deinit(p_Vid->pps_cache, MAXPPS);
+
     for (i = 0; i < MAX_NUM_DPB_LAYERS; i++) {
         free_dpb(p_Vid->p_Dpb_layer[i]);
         MPP_FREE(p_Vid->p_Dpb_layer[i]);
@@ -156,6 +159,11 @@ static MPP_RET free_vid_ctx(H264dVideoCtx_t *p_Vid)
         p_Vid->pic_st = NULL;
     }
 
+    if (p_Vid->fs_st) {
+        mpp_mem_pool_deinit(p_Vid->fs_st);
+        p_Vid->fs_st = NULL;
+    }
+
 __RETURN:
     return ret = MPP_OK;
 }
@@ -181,6 +189,7 @@ static MPP_RET init_vid_ctx(H264dVideoCtx_t *p_Vid)
     p_Vid->active_sps_id[0] = -1;
     p_Vid->active_sps_id[1] = -1;
     p_Vid->pic_st = mpp_mem_pool_init(sizeof(H264_StorePic_t));
+    p_Vid->fs_st = mpp_mem_pool_init(sizeof(H264_FrameStore_t));
 __RETURN:
     return ret = MPP_OK;
 __FAILED:
@@ -437,6 +446,7 @@ MPP_RET h264d_reset(void *decoder)
     p_strm->first_mb_in_slice = 0;
     p_strm->endcode_found     = 0;
     p_strm->startcode_found   = p_Dec->p_Inp->is_nalff;
+    p_strm->nalu_span         = 0;
     //!< reset decoder parameter
     p_Dec->next_state = SliceSTATE_ResetSlice;
     p_Dec->nalu_ret = NALU_NULL;
@@ -756,10 +756,10 @@ static RK_S32 get_smallest_poc(H264_DpbBuf_t *p_Dpb, RK_S32 *poc, RK_S32 *pos)
     return find_flag;
 }
 
-static H264_FrameStore_t *alloc_frame_store()
+static H264_FrameStore_t *alloc_frame_store(H264dVideoCtx_t *p_Vid)
 {
     MPP_RET ret = MPP_ERR_UNKNOW;
-    H264_FrameStore_t *f = mpp_calloc(H264_FrameStore_t, 1);
+    H264_FrameStore_t *f = mpp_mem_pool_get(p_Vid->fs_st);
     MEM_CHECK(ret, f);
 
     f->is_used = 0;
@@ -1552,7 +1552,7 @@ void free_frame_store(H264_DecCtx_t *p_Dec, H264_FrameStore_t* f)
             free_storable_picture(p_Dec, f->bottom_field);
             f->bottom_field = NULL;
         }
-        MPP_FREE(f);
+        mpp_mem_pool_put(p_Dec->p_Vid->fs_st, f);
     }
 }
 
@@ -1584,6 +1584,7 @@ void free_dpb(H264_DpbBuf_t *p_Dpb)
         }
         MPP_FREE(p_Dpb->fs_ilref);
     }
+    MPP_FREE(p_Dpb->fs_list_tmp);
     p_Dpb->last_output_view_id = -1;
     p_Dpb->last_output_poc = INT_MIN;
     p_Dpb->init_done = 0;
@@ -1897,8 +1898,12 @@ static MPP_RET enlarge_dpb(H264_DpbBuf_t *p_Dpb, RK_U32 size)
     mpp_free(p_Dpb->fs_ilref);
     p_Dpb->fs_ilref = tmp;
 
+    mpp_free(p_Dpb->fs_list_tmp);
+    p_Dpb->fs_list_tmp = mpp_calloc(H264_FrameStore_t*, size * H264_FS_LIST_TMP_CNT);
+    MEM_CHECK(ret, p_Dpb->fs_list_tmp);
+
     for (i = p_Dpb->size; i < size; i++) {
-        p_Dpb->fs[i] = alloc_frame_store();
+        p_Dpb->fs[i] = alloc_frame_store(p_Dpb->p_Vid);
         MEM_CHECK(ret, p_Dpb->fs[i]);
         p_Dpb->fs_ref[i] = NULL;
         p_Dpb->fs_ltref[i] = NULL;
@@ -1984,9 +1989,10 @@ MPP_RET init_dpb(H264dVideoCtx_t *p_Vid, H264_DpbBuf_t *p_Dpb, RK_S32 type)  //
     p_Dpb->fs_ref   = mpp_calloc(H264_FrameStore_t*, p_Dpb->size);
     p_Dpb->fs_ltref = mpp_calloc(H264_FrameStore_t*, p_Dpb->size);
     p_Dpb->fs_ilref = mpp_calloc(H264_FrameStore_t*, 1);  //!< inter-layer reference (for multi-layered codecs)
-    MEM_CHECK(ret, p_Dpb->fs && p_Dpb->fs_ref && p_Dpb->fs_ltref && p_Dpb->fs_ilref);
+    p_Dpb->fs_list_tmp = mpp_calloc(H264_FrameStore_t*, p_Dpb->size * H264_FS_LIST_TMP_CNT);
+    MEM_CHECK(ret, p_Dpb->fs && p_Dpb->fs_ref && p_Dpb->fs_ltref && p_Dpb->fs_ilref && p_Dpb->fs_list_tmp);
     for (i = 0; i < p_Dpb->size; i++) {
-        p_Dpb->fs[i] = alloc_frame_store();
+        p_Dpb->fs[i] = alloc_frame_store(p_Vid);
         MEM_CHECK(ret, p_Dpb->fs[i]);
         p_Dpb->fs_ref[i] = NULL;
         p_Dpb->fs_ltref[i] = NULL;
@@ -1996,7 +2002,7 @@ MPP_RET init_dpb(H264dVideoCtx_t *p_Vid, H264_DpbBuf_t *p_Dpb, RK_S32 type)  //
         p_Dpb->fs[i]->anchor_pic_flag[0] = p_Dpb->fs[i]->anchor_pic_flag[1] = 0;
     }
     if (type == 2) {
-        p_Dpb->fs_ilref[0] = alloc_frame_store();
+        p_Dpb->fs_ilref[0] = alloc_frame_store(p_Vid);
         MEM_CHECK(ret, p_Dpb->fs_ilref[0]);
         //!< These may need some cleanups
         p_Dpb->fs_ilref[0]->view_id = -1;
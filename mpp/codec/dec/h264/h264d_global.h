@@ -20,6 +20,7 @@
 
 #include <stdio.h>
 #include "h2645d_sei.h"
+#include "h2645d_ps_cache.h"
 #include "rk_type.h"
 
 #include "mpp_debug.h"
@@ -385,6 +386,16 @@ typedef struct h264_frame_store_t {
 } H264_FrameStore_t;
 
 //!< decode picture buffer
+//!< scratch frame store lists used on reference list init
+typedef enum h264_fs_list_tmp_e {
+    H264_FS_LIST_TMP_L0,
+    H264_FS_LIST_TMP_L1,
+    H264_FS_LIST_TMP_LT,
+    H264_FS_LIST_TMP_IV0,
+    H264_FS_LIST_TMP_IV1,
+    H264_FS_LIST_TMP_CNT,
+} H264_FS_LIST_TMP_E;
+
 typedef struct h264_dpb_buf_t {
     RK_U32   size;
     RK_U32   used_size;
@@ -406,6 +417,8 @@ typedef struct h264_dpb_buf_t {
     struct h264_frame_store_t  **fs_ltref;
     struct h264_frame_store_t  **fs_ilref;   //!< inter-layer reference (for multi-layered codecs)
     struct h264_frame_store_t   *last_picture;
+    //!< scratch for reference list init, H264_FS_LIST_TMP_CNT lists of allocated_size
+    struct h264_frame_store_t  **fs_list_tmp;
 
     struct h264d_video_ctx_t   *p_Vid;
 } H264_DpbBuf_t;
@@ -937,6 +950,8 @@ typedef struct h264d_curstrm_t {
     RK_U32    prefixdata;
     RK_U8     startcode_found;
     RK_U8     endcode_found;
+    RK_U8     nalu_span;         //!< nalu data is referenced in input packet
+    RK_U32    nalu_span_pos;     //!< nalu start offset in input packet
 
 } H264dCurStream_t;
 
@@ -978,6 +993,8 @@ typedef struct h264d_video_ctx_t {
     struct h264_sps_t            *spsSet[MAXSPS];      //!< MAXSPS, all sps storage
     struct h264_subsps_t         *subspsSet[MAXSPS];   //!< MAXSPS, all subpps storage
     struct h264_pps_t            *ppsSet[MAXPPS];      //!< MAXPPS, all pps storage
+    H2645dPsCache                 sps_cache[MAXSPS];   //!< raw nal of spsSet for repeated sps skip
+    H2645dPsCache                 pps_cache[MAXPPS];   //!< raw nal of ppsSet for repeated pps skip
     struct h264_sps_t            *active_sps;
     struct h264_subsps_t         *active_subsps;
     struct h264_pps_t            *active_pps;
@@ -1049,6 +1066,7 @@ typedef struct h264d_video_ctx_t {
     RK_U32     dpb_size[MAX_NUM_DPB_LAYERS];
 
     MppMemPool pic_st;
+    MppMemPool fs_st;
     //!< spspps data update
     RK_U32     spspps_update;
 
@@ -1067,6 +1067,9 @@ static RK_S32 compare_fs_by_poc_asc(const void *arg1, const void *arg2)
         return 0;
 }
 
+/* reference list init scratch kept in the dpb, see H264_FS_LIST_TMP_E */
+#define FS_LIST_TMP(p_Dpb, idx) (&(p_Dpb)->fs_list_tmp[(idx) * (p_Dpb)->allocated_size])
+
 static MPP_RET init_lists_p_slice_mvc(H264_SLICE_t *currSlice)
 {
     RK_U32 i = 0;
@@ -1108,9 +1111,8 @@ static MPP_RET init_lists_p_slice_mvc(H264_SLICE_t *currSlice)
               list0idx - currSlice->listXsizeP[0], sizeof(H264_StorePic_t*), compare_pic_by_lt_pic_num_asc);
         currSlice->listXsizeP[0] = (RK_U8)list0idx;
     } else {
-        fs_list0  = mpp_calloc(H264_FrameStore_t*, p_Dpb->size);
-        fs_listlt = mpp_calloc(H264_FrameStore_t*, p_Dpb->size);
-        MEM_CHECK(ret, fs_list0 && fs_listlt);
+        fs_list0  = FS_LIST_TMP(p_Dpb, H264_FS_LIST_TMP_L0);
+        fs_listlt = FS_LIST_TMP(p_Dpb, H264_FS_LIST_TMP_LT);
         for (i = 0; i < p_Dpb->ref_frames_in_buffer; i++) {
             if (p_Dpb->fs_ref[i]->is_reference) {
                 fs_list0[list0idx++] = p_Dpb->fs_ref[i];
@@ -1125,15 +1127,12 @@ static MPP_RET init_lists_p_slice_mvc(H264_SLICE_t *currSlice)
         }
         qsort((void *)fs_listlt, listltidx, sizeof(H264_FrameStore_t*), compare_fs_by_lt_pic_idx_asc);
         gen_pic_list_from_frame_list(currSlice->structure, fs_listlt, listltidx, currSlice->listP[0], &currSlice->listXsizeP[0], 1);
-        MPP_FREE(fs_list0);
-        MPP_FREE(fs_listlt);
     }
 
     currSlice->listXsizeP[1] = 0;
     if (currSlice->mvcExt.valid && currSlice->svc_extension_flag == 0) {
         RK_S32 curr_layer_id = currSlice->layer_id;
-        currSlice->fs_listinterview0 = mpp_calloc(H264_FrameStore_t*, p_Dpb->size);
-        MEM_CHECK(ret, currSlice->fs_listinterview0);
+        currSlice->fs_listinterview0 = FS_LIST_TMP(p_Dpb, H264_FS_LIST_TMP_IV0);
         list0idx = currSlice->listXsizeP[0];
         if (currSlice->structure == FRAME) {
             FUN_CHECK(ret = append_interview_list(p_Vid->p_Dpb_layer[1], currSlice->structure, 0,
@@ -1156,13 +1155,11 @@ static MPP_RET init_lists_p_slice_mvc(H264_SLICE_t *currSlice)
     for (i = currSlice->listXsizeP[1]; i < (MAX_LIST_SIZE); i++) {
         currSlice->listP[1][i] = p_Vid->no_ref_pic;
     }
-    MPP_FREE(currSlice->fs_listinterview0);
+    currSlice->fs_listinterview0 = NULL;
 
     return ret = MPP_OK;
 __FAILED:
-    MPP_FREE(fs_list0);
-    MPP_FREE(fs_listlt);
-    MPP_FREE(currSlice->fs_listinterview0);
+    currSlice->fs_listinterview0 = NULL;
 
     return ret;
 }
@@ -1234,10 +1231,9 @@ static MPP_RET init_lists_b_slice_mvc(H264_SLICE_t *currSlice)
               list0idx - currSlice->listXsizeB[0], sizeof(H264_StorePic_t*), compare_pic_by_lt_pic_num_asc);
         currSlice->listXsizeB[0] = currSlice->listXsizeB[1] = (RK_U8)list0idx;
     } else {
-        fs_list0  = mpp_calloc(H264_FrameStore_t*, p_Dpb->size);
-        fs_list1  = mpp_calloc(H264_FrameStore_t*, p_Dpb->size);
-        fs_listlt = mpp_calloc(H264_FrameStore_t*, p_Dpb->size);
-        MEM_CHECK(ret, fs_list0 && fs_list1 && fs_listlt);
+        fs_list0  = FS_LIST_TMP(p_Dpb, H264_FS_LIST_TMP_L0);
+        fs_list1  = FS_LIST_TMP(p_Dpb, H264_FS_LIST_TMP_L1);
+        fs_listlt = FS_LIST_TMP(p_Dpb, H264_FS_LIST_TMP_LT);
         currSlice->listXsizeB[0] = 0;
         currSlice->listXsizeB[1] = 1;
         for (i = 0; i < p_Dpb->ref_frames_in_buffer; i++) {
@@ -1277,10 +1273,6 @@ static MPP_RET init_lists_b_slice_mvc(H264_SLICE_t *currSlice)
 
         gen_pic_list_from_frame_list(currSlice->structure, fs_listlt, listltidx, currSlice->listB[0], &currSlice->listXsizeB[0], 1);
         gen_pic_list_from_frame_list(currSlice->structure, fs_listlt, listltidx, currSlice->listB[1], &currSlice->listXsizeB[1], 1);
-
-        MPP_FREE(fs_list0);
-        MPP_FREE(fs_list1);
-        MPP_FREE(fs_listlt);
     }
     if ((currSlice->listXsizeB[0] == currSlice->listXsizeB[1]) && (currSlice->listXsizeB[0] > 1)) {
         // check if lists are identical, if yes swap first two elements of currSlice->listX[1]
@@ -1300,9 +1292,8 @@ static MPP_RET init_lists_b_slice_mvc(H264_SLICE_t *currSlice)
     if (currSlice->mvcExt.valid && currSlice->svc_extension_flag == 0) {
         RK_S32 curr_layer_id = currSlice->layer_id;
         // B-Slice
-        currSlice->fs_listinterview0 = mpp_calloc(H264_FrameStore_t*, p_Dpb->size);
-        currSlice->fs_listinterview1 = mpp_calloc(H264_FrameStore_t*, p_Dpb->size);
-        MEM_CHECK(ret, currSlice->fs_listinterview0 && currSlice->fs_listinterview1);
+        currSlice->fs_listinterview0 = FS_LIST_TMP(p_Dpb, H264_FS_LIST_TMP_IV0);
+        currSlice->fs_listinterview1 = FS_LIST_TMP(p_Dpb, H264_FS_LIST_TMP_IV1);
         list0idx = currSlice->listXsizeB[0];
         if (currSlice->structure == FRAME) {
             FUN_CHECK(ret = append_interview_list(p_Vid->p_Dpb_layer[1], currSlice->structure, 0,
@@ -1337,16 +1328,13 @@ static MPP_RET init_lists_b_slice_mvc(H264_SLICE_t *currSlice)
     for (i = currSlice->listXsizeB[1]; i < (MAX_LIST_SIZE); i++) {
         currSlice->listB[1][i] = p_Vid->no_ref_pic;
     }
-    MPP_FREE(currSlice->fs_listinterview0);
-    MPP_FREE(currSlice->fs_listinterview1);
+    currSlice->fs_listinterview0 = NULL;
+    currSlice->fs_listinterview1 = NULL;
 
     return ret = MPP_OK;
 __FAILED:
-    MPP_FREE(fs_list0);
-    MPP_FREE(fs_list1);
-    MPP_FREE(fs_listlt);
-    MPP_FREE(currSlice->fs_listinterview0);
-    MPP_FREE(currSlice->fs_listinterview1);
+    currSlice->fs_listinterview0 = NULL;
+    currSlice->fs_listinterview1 = NULL;
 
     return ret;
 }
@@ -22,6 +22,7 @@
 
 #include "mpp_mem.h"
 #include "mpp_packet_impl.h"
+#include "mpp_startcode.h"
 #include "hal_dec_task.h"
 
 #include "h264d_global.h"
@@ -129,11 +130,25 @@ static void reset_nalu(H264dCurStream_t *p_strm)
     if (p_strm->endcode_found) {
         p_strm->startcode_found = p_strm->endcode_found;
         p_strm->nalu_len = 0;
+        p_strm->nalu_span = 0;
         p_strm->nalu_type = H264_NALU_TYPE_NULL;
         p_strm->endcode_found = 0;
     }
 }
 
+/*!
+***********************************************************************
+* \brief
+*    drop the nalu stored on eos, its span must not outlive the packet
+***********************************************************************
+*/
+static void clear_nalu(H264dCurStream_t *p_strm)
+{
+    p_strm->nalu_len = 0;
+    p_strm->nalu_span = 0;
+    p_strm->nalu_type = H264_NALU_TYPE_NULL;
+}
+
 static void find_prefix_code(RK_U8 *p_data, H264dCurStream_t *p_strm)
 {
     (void)p_data;
@@ -147,6 +162,108 @@ static void find_prefix_code(RK_U8 *p_data, H264dCurStream_t *p_strm)
     }
 }
 
+/*!
+***********************************************************************
+* \brief
+*    get current nalu data, in input packet or in nalu buffer
+***********************************************************************
+*/
+static RK_U8 *get_nalu_data(H264dInputCtx_t *p_Inp, H264dCurStream_t *p_strm)
+{
+    return p_strm->nalu_span ? &p_Inp->in_buf[p_strm->nalu_span_pos] : p_strm->nalu_buf;
+}
+/*!
+***********************************************************************
+* \brief
+*    append data to current nalu
+*    a nalu starting in current packet is only referenced as a span of
+*    the packet and is copied once when it is stored to bitstream
+***********************************************************************
+*/
+static MPP_RET push_nalu_data(H264dInputCtx_t *p_Inp, H264dCurStream_t *p_strm, RK_U8 *src, RK_U32 len)
+{
+    MPP_RET ret = MPP_OK;
+
+    if (!p_strm->nalu_len) {
+        p_strm->nalu_span = 1;
+        p_strm->nalu_span_pos = (RK_U32)(src - p_Inp->in_buf);
+    }
+
+    if (!p_strm->nalu_span) {
+        if (p_strm->nalu_len + len >= p_strm->nalu_max_size) {
+            RK_U32 add_size = p_strm->nalu_len + len + 1 - p_strm->nalu_max_size;
+
+            FUN_CHECK(ret = realloc_buffer(&p_strm->nalu_buf, &p_strm->nalu_max_size,
+                                           MPP_MAX(NALU_BUF_ADD_SIZE, add_size)));
+        }
+        memcpy(&p_strm->nalu_buf[p_strm->nalu_len], src, len);
+    }
+    p_strm->nalu_len += len;
+
+__FAILED:
+    return ret;
+}
+/*!
+***********************************************************************
+* \brief
+*    copy the unfinished nalu span to nalu buffer before the input
+*    packet is returned
+***********************************************************************
+*/
+static MPP_RET flush_nalu_span(H264dInputCtx_t *p_Inp, H264dCurStream_t *p_strm)
+{
+    MPP_RET ret = MPP_OK;
+
+    if (!p_strm->nalu_span)
+        return ret;
+
+    p_strm->nalu_span = 0;
+    if (p_strm->nalu_len >= p_strm->nalu_max_size) {
+        RK_U32 add_size = p_strm->nalu_len + 1 - p_strm->nalu_max_size;
+
+        FUN_CHECK(ret = realloc_buffer(&p_strm->nalu_buf, &p_strm->nalu_max_size,
+                                       MPP_MAX(NALU_BUF_ADD_SIZE, add_size)));
+    }
+    memcpy(p_strm->nalu_buf, &p_Inp->in_buf[p_strm->nalu_span_pos], p_strm->nalu_len);
+
+    return ret;
+__FAILED:
+    p_strm->nalu_len = 0;
+    return ret;
+}
+/*!
+***********************************************************************
+* \brief
+*    consume nalu payload up to next start code in bulk
+*    head_len bytes of each nalu still go through the byte loop
+***********************************************************************
+*/
+static MPP_RET skip_nalu_payload(H264dInputCtx_t *p_Inp, H264dCurStream_t *p_strm, RK_U32 head_len)
+{
+    MPP_RET ret = MPP_OK;
+    MppPacketImpl *pkt_impl = (MppPacketImpl *)p_Inp->in_pkt;
+    RK_U8 *src = &p_Inp->in_buf[p_strm->nalu_offset];
+    RK_U32 skip = 0;
+
+    if (p_strm->startcode_found && p_strm->nalu_len < head_len)
+        return ret;
+
+    skip = mpp_startcode_skip(src, (RK_U32)pkt_impl->length, p_strm->prefixdata);
+    if (!skip)
+        return ret;
+
+    if (p_strm->startcode_found)
+        FUN_CHECK(ret = push_nalu_data(p_Inp, p_strm, src, skip));
+
+    p_strm->prefixdata = mpp_startcode_state(p_strm->prefixdata, src, skip);
+    p_strm->curdata = src + skip - 1;
+    p_strm->nalu_offset += skip;
+    pkt_impl->length -= skip;
+
+__FAILED:
+    return ret;
+}
+
 static MPP_RET parser_nalu_header(H264_SLICE_t *currSlice)
 {
     MPP_RET ret = MPP_ERR_UNKNOW;
@@ -337,6 +454,7 @@ static MPP_RET store_cur_nalu(H264dCurCtx_t *p_Cur, H264dCurStream_t *p_strm, H2
 {
     MPP_RET ret = MPP_ERR_UNKNOW;
     RK_U8 *p_des = NULL;
+    RK_U8 *p_src = get_nalu_data(p_Cur->p_Inp, p_strm);
 
     //!< fill head buffer
     if (   (p_strm->nalu_type == H264_NALU_TYPE_SLICE)
@@ -367,7 +485,7 @@ static MPP_RET store_cur_nalu(H264dCurCtx_t *p_Cur, H264dCurStream_t *p_strm, H2
         ((H264dNaluHead_t *)p_des)->is_frame_end  = 0;
         ((H264dNaluHead_t *)p_des)->nalu_type = p_strm->nalu_type;
         ((H264dNaluHead_t *)p_des)->sodb_len = head_size;
-        memcpy(p_des + sizeof(H264dNaluHead_t), p_strm->nalu_buf, head_size);
+        memcpy(p_des + sizeof(H264dNaluHead_t), p_src, head_size);
         p_strm->head_offset += add_size;
 
         H264D_LOG("store current header, NAL type %d", p_strm->nalu_type);
@@ -399,7 +517,7 @@ static MPP_RET store_cur_nalu(H264dCurCtx_t *p_Cur, H264dCurStream_t *p_strm, H2
 
         p_des = &dxva_ctx->bitstream[dxva_ctx->strm_offset];
         memcpy(p_des, g_start_precode, sizeof(g_start_precode));
-        memcpy(p_des + sizeof(g_start_precode), p_strm->nalu_buf, p_strm->nalu_len);
+        memcpy(p_des + sizeof(g_start_precode), p_src, p_strm->nalu_len);
         dxva_ctx->strm_offset += add_size;
     }
     if (h264d_debug & H264D_DBG_WRITE_ES_EN) {
@@ -409,7 +527,7 @@ static MPP_RET store_cur_nalu(H264dCurCtx_t *p_Cur, H264dCurStream_t *p_strm, H2
             if (p_Inp->spspps_update_flag) {
                 p_des = &p_Inp->spspps_buf[p_Inp->spspps_offset];
                 memcpy(p_des, g_start_precode, sizeof(g_start_precode));
-                memcpy(p_des + sizeof(g_start_precode), p_strm->nalu_buf, p_strm->nalu_len);
+                memcpy(p_des + sizeof(g_start_precode), p_src, p_strm->nalu_len);
                 p_Inp->spspps_offset += p_strm->nalu_len + sizeof(g_start_precode);
                 p_Inp->spspps_len = p_Inp->spspps_offset;
             }
@@ -429,13 +547,14 @@ static MPP_RET judge_is_new_frame(H264dCurCtx_t *p_Cur, H264dCurStream_t *p_strm
 {
     MPP_RET ret = MPP_ERR_UNKNOW;
     RK_U32 nalu_header_bytes  = 0;
+    RK_U8 *p_src = get_nalu_data(p_Cur->p_Inp, p_strm);
 
     BitReadCtx_t    *p_bitctx = &p_Cur->bitctx;
     memset(p_bitctx, 0, sizeof(BitReadCtx_t));
     {
         RK_U32      forbidden_bit = -1;
         RK_U32  nal_reference_idc = -1;
-        mpp_set_bitread_ctx(p_bitctx, p_strm->nalu_buf, 4);
+        mpp_set_bitread_ctx(p_bitctx, p_src, 4);
         mpp_set_bitread_pseudo_code_type(p_bitctx, PSEUDO_CODE_H264_H265);
 
         READ_BITS(p_bitctx, 1, &forbidden_bit);
@@ -471,7 +590,7 @@ static MPP_RET judge_is_new_frame(H264dCurCtx_t *p_Cur, H264dCurStream_t *p_strm
                && (p_strm->nalu_type == H264_NALU_TYPE_SLICE
                    || p_strm->nalu_type == H264_NALU_TYPE_IDR)) {
         RK_U32 first_mb_in_slice  = 0;
-        mpp_set_bitread_ctx(p_bitctx, (p_strm->nalu_buf + nalu_header_bytes), 4); // reset
+        mpp_set_bitread_ctx(p_bitctx, (p_src + nalu_header_bytes), 4); // reset
         mpp_set_bitread_pseudo_code_type(p_bitctx, PSEUDO_CODE_H264_H265);
         READ_UE(p_bitctx, &first_mb_in_slice);
         if (first_mb_in_slice == 0) {
@@ -613,6 +732,7 @@ MPP_RET parse_prepare(H264dInputCtx_t *p_Inp, H264dCurCtx_t *p_Cur)
     //!< check eos
     if (p_Inp->pkt_eos && !p_Inp->in_length) {
         FUN_CHECK(ret = store_cur_nalu(p_Cur, p_strm, p_Dec->dxva_ctx));
+        clear_nalu(p_strm);
         FUN_CHECK(ret = add_empty_nalu(p_strm));
         p_Dec->p_Inp->task_valid = p_Dec->p_Inp->task_eos ? 0 : 1;
         p_Dec->p_Inp->task_eos = 1;
@@ -626,14 +746,15 @@ MPP_RET parse_prepare(H264dInputCtx_t *p_Inp, H264dCurCtx_t *p_Cur)
     }
 
     while (pkt_impl->length > 0) {
+        FUN_CHECK(ret = skip_nalu_payload(p_Inp, p_strm, NALU_TYPE_EXT_LENGTH));
+        if (!pkt_impl->length)
+            break;
+
         p_strm->curdata = &p_Inp->in_buf[p_strm->nalu_offset++];
         pkt_impl->length--;
         p_strm->prefixdata = (p_strm->prefixdata << 8) | (*p_strm->curdata);
         if (p_strm->startcode_found) {
-            if (p_strm->nalu_len >= p_strm->nalu_max_size) {
-                FUN_CHECK(ret = realloc_buffer(&p_strm->nalu_buf, &p_strm->nalu_max_size, NALU_BUF_ADD_SIZE));
-            }
-            p_strm->nalu_buf[p_strm->nalu_len++] = *p_strm->curdata;
+            FUN_CHECK(ret = push_nalu_data(p_Inp, p_strm, p_strm->curdata, 1));
             if ((p_strm->nalu_len == NALU_TYPE_NORMAL_LENGTH)
                 || (p_strm->nalu_len == NALU_TYPE_EXT_LENGTH)) {
                 FUN_CHECK(ret = judge_is_new_frame(p_Cur, p_strm));
@@ -655,10 +776,12 @@ MPP_RET parse_prepare(H264dInputCtx_t *p_Inp, H264dCurCtx_t *p_Cur)
         find_prefix_code(p_strm->curdata, p_strm);
 
         if (p_strm->endcode_found) {
+            RK_U8 *p_src = get_nalu_data(p_Inp, p_strm);
+
             p_strm->nalu_len -= START_PREFIX_3BYTE;
             if (p_strm->nalu_len > START_PREFIX_3BYTE) {
                 while ((p_strm->nalu_len > 0) &&
-                       (p_strm->nalu_buf[p_strm->nalu_len - 1] == 0x00)) {
+                       (p_src[p_strm->nalu_len - 1] == 0x00)) {
                     p_strm->nalu_len--;
                 }
             }
@@ -671,12 +794,15 @@ MPP_RET parse_prepare(H264dInputCtx_t *p_Inp, H264dCurCtx_t *p_Cur)
     p_Inp->in_length = pkt_impl->length;
     //!< check input
     if (!p_Inp->in_length) {
+        //!< packet is going to be returned, keep the unfinished nalu
+        FUN_CHECK(ret = flush_nalu_span(p_Inp, p_strm));
         p_strm->nalu_offset = 0;
         p_Dec->nalu_ret = HaveNoStream;
     }
 
     if (p_Inp->pkt_eos && p_Inp->in_length < 4) {
         FUN_CHECK(ret = store_cur_nalu(p_Cur, p_strm, p_Dec->dxva_ctx));
+        clear_nalu(p_strm);
         FUN_CHECK(ret = add_empty_nalu(p_strm));
         p_Dec->p_Inp->task_valid = 1;
         p_Dec->p_Inp->task_eos = 1;
@@ -687,6 +813,7 @@ __RETURN:
 
     return ret = MPP_OK;
 __FAILED:
+    flush_nalu_span(p_Inp, p_strm);
     return ret;
 }
 
@@ -708,16 +835,17 @@ MPP_RET parse_prepare_fast(H264dInputCtx_t *p_Inp, H264dCurCtx_t *p_Cur)
     p_Inp->task_valid = 0;
 
     while (pkt_impl->length > 0) {
+        FUN_CHECK(ret = skip_nalu_payload(p_Inp, p_strm, NALU_TYPE_NORMAL_LENGTH));
+        if (!pkt_impl->length)
+            break;
+
         p_strm->curdata = &p_Inp->in_buf[p_strm->nalu_offset++];
         pkt_impl->length--;
         p_strm->prefixdata = (p_strm->prefixdata << 8) | (*p_strm->curdata);
         if (p_strm->startcode_found) {
-            if (p_strm->nalu_len >= p_strm->nalu_max_size) {
-                FUN_CHECK(ret = realloc_buffer(&p_strm->nalu_buf, &p_strm->nalu_max_size, NALU_BUF_ADD_SIZE));
-            }
-            p_strm->nalu_buf[p_strm->nalu_len++] = *p_strm->curdata;
+            FUN_CHECK(ret = push_nalu_data(p_Inp, p_strm, p_strm->curdata, 1));
             if (p_strm->nalu_len == 1) {
-                p_strm->nalu_type = p_strm->nalu_buf[0] & 0x1F;
+                p_strm->nalu_type = *get_nalu_data(p_Inp, p_strm) & 0x1F;
 
                 if (p_strm->nalu_type == H264_NALU_TYPE_SLICE
                     || p_strm->nalu_type == H264_NALU_TYPE_IDR || p_strm->nalu_type == H264_NALU_TYPE_SLC_EXT) {
@@ -725,12 +853,8 @@ MPP_RET parse_prepare_fast(H264dInputCtx_t *p_Inp, H264dCurCtx_t *p_Cur)
                     if (p_strm->nalu_type == H264_NALU_TYPE_SLC_EXT)
                         p_strm->nalu_type = H264_NALU_TYPE_SLICE;
 
-                    p_strm->nalu_len += (RK_U32)pkt_impl->length;
-                    if (p_strm->nalu_len >= p_strm->nalu_max_size) {
-                        RK_U32 add_size =  pkt_impl->length + 1 - p_strm->nalu_max_size;
-                        FUN_CHECK(ret = realloc_buffer(&p_strm->nalu_buf, &p_strm->nalu_max_size, MPP_MAX(NALU_BUF_ADD_SIZE, add_size)));
-                    }
-                    memcpy(&p_strm->nalu_buf[0], p_strm->curdata, pkt_impl->length + 1);
+                    FUN_CHECK(ret = push_nalu_data(p_Inp, p_strm, p_strm->curdata + 1,
+                                                   (RK_U32)pkt_impl->length));
                     pkt_impl->length = 0;
                     p_Cur->p_Inp->task_valid = 1;
                     break;
@@ -741,8 +865,10 @@ MPP_RET parse_prepare_fast(H264dInputCtx_t *p_Inp, H264dCurCtx_t *p_Cur)
         find_prefix_code(p_strm->curdata, p_strm);
 
         if (p_strm->endcode_found) {
+            RK_U8 *p_src = get_nalu_data(p_Inp, p_strm);
+
             p_strm->nalu_len -= START_PREFIX_3BYTE;
-            while (p_strm->nalu_len > 0 && p_strm->nalu_buf[p_strm->nalu_len - 1] == 0x00) {
+            while (p_strm->nalu_len > 0 && p_src[p_strm->nalu_len - 1] == 0x00) {
                 p_strm->nalu_len--;
             }
             p_Dec->nalu_ret = EndOfNalu;
@@ -772,10 +898,12 @@ MPP_RET parse_prepare_fast(H264dInputCtx_t *p_Inp, H264dCurCtx_t *p_Cur)
 
         reset_nalu(p_strm);
         p_strm->startcode_found = 0;
+        FUN_CHECK(ret = flush_nalu_span(p_Inp, p_strm));
     }
 
     return ret = MPP_OK;
 __FAILED:
+    flush_nalu_span(p_Inp, p_strm);
     return ret;
 }
 /*!
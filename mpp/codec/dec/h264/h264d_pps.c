@@ -132,19 +132,32 @@ MPP_RET process_pps(H264_SLICE_t *currSlice)
     MPP_RET ret = MPP_ERR_UNKNOW;
 
     H264dCurCtx_t *p_Cur = currSlice->p_Cur;
+    H264dVideoCtx_t *p_Vid = currSlice->p_Vid;
     BitReadCtx_t *p_bitctx = &p_Cur->bitctx;
     H264_PPS_t *cur_pps = &p_Cur->pps;
+    RK_U32 hash = 0;
+    RK_S32 id;
+
+    //!< same bytes as the pps in ppsSet, no need to parse again
+    id = h2645d_ps_cache_find(p_Vid->pps_cache, MAXPPS, p_bitctx->buf, p_bitctx->buf_len, &hash);
+    if (id >= 0 && p_Vid->ppsSet[id]) {
+        H264D_DBG(H264D_DBG_PPS_SPS, "skip repeated pps %d", id);
+        memcpy(cur_pps, p_Vid->ppsSet[id], sizeof(H264_PPS_t));
+        return ret = MPP_OK;
+    }
 
     reset_curpps_data(cur_pps);// reset
 
     FUN_CHECK(ret = parser_pps(p_bitctx, &p_Cur->sps, cur_pps));
     //!< MakePPSavailable
     ASSERT(cur_pps->Valid == 1);
-    if (!currSlice->p_Vid->ppsSet[cur_pps->pic_parameter_set_id]) {
-        currSlice->p_Vid->ppsSet[cur_pps->pic_parameter_set_id] = mpp_calloc(H264_PPS_t, 1);
+    id = cur_pps->pic_parameter_set_id;
+    if (!p_Vid->ppsSet[id]) {
+        p_Vid->ppsSet[id] = mpp_calloc(H264_PPS_t, 1);
     }
 
-    memcpy(currSlice->p_Vid->ppsSet[cur_pps->pic_parameter_set_id], cur_pps, sizeof(H264_PPS_t));
+    memcpy(p_Vid->ppsSet[id], cur_pps, sizeof(H264_PPS_t));
+    h2645d_ps_cache_update(&p_Vid->pps_cache[id], p_bitctx->buf, p_bitctx->buf_len, hash);
     p_Cur->p_Vid->spspps_update = 1;
 
     return ret = MPP_OK;
@@ -455,8 +455,21 @@ MPP_RET process_sps(H264_SLICE_t *currSlice)
     MPP_RET ret = MPP_ERR_UNKNOW;
 
     H264dCurCtx_t *p_Cur = currSlice->p_Cur;
+    H264dVideoCtx_t *p_Vid = currSlice->p_Vid;
     BitReadCtx_t *p_bitctx = &p_Cur->bitctx;
     H264_SPS_t *cur_sps = &p_Cur->sps;
+    RK_S32 chroma_format_idc = cur_sps->chroma_format_idc;
+    RK_U32 hash = 0;
+    RK_S32 id;
+
+    //!< same bytes as the sps in spsSet, no need to parse again
+    id = h2645d_ps_cache_find(p_Vid->sps_cache, MAXSPS, p_bitctx->buf, p_bitctx->buf_len, &hash);
+    if (id >= 0 && p_Vid->spsSet[id]) {
+        H264D_DBG(H264D_DBG_PPS_SPS, "skip repeated sps %d", id);
+        memcpy(cur_sps, p_Vid->spsSet[id], sizeof(H264_SPS_t));
+        currSlice->p_Dec->errctx.un_spt_flag = 0;
+        goto __DONE;
+    }
 
     reset_cur_sps_data(cur_sps); // reset
     //!< parse sps
@@ -465,16 +478,23 @@ MPP_RET process_sps(H264_SLICE_t *currSlice)
     FUN_CHECK(ret = get_max_dec_frame_buf_size(cur_sps));
     //!< make SPS available, copy
     if (cur_sps->Valid) {
-        if (!currSlice->p_Vid->spsSet[cur_sps->seq_parameter_set_id]) {
-            currSlice->p_Vid->spsSet[cur_sps->seq_parameter_set_id] = mpp_calloc(H264_SPS_t, 1);
+        id = cur_sps->seq_parameter_set_id;
+        if (!p_Vid->spsSet[id]) {
+            p_Vid->spsSet[id] = mpp_calloc(H264_SPS_t, 1);
         }
-        memcpy(currSlice->p_Vid->spsSet[cur_sps->seq_parameter_set_id],
-               cur_sps, sizeof(H264_SPS_t));
+        memcpy(p_Vid->spsSet[id], cur_sps, sizeof(H264_SPS_t));
+        h2645d_ps_cache_update(&p_Vid->sps_cache[id], p_bitctx->buf, p_bitctx->buf_len, hash);
     }
     p_Cur->p_Vid->spspps_update = 1;
 
+__DONE:
+    //!< pps scaling list parsing depends on the current sps chroma format
+    if (cur_sps->chroma_format_idc != chroma_format_idc)
+        h2645d_ps_cache_clear(p_Vid->pps_cache, MAXPPS);
+
     return ret = MPP_OK;
 __FAILED:
+    h2645d_ps_cache_clear(p_Vid->pps_cache, MAXPPS);
     return ret;
 }
 
@@ -0,0 +1,279 @@
+/*
+ * Copyright 2024 Rockchip Electronics Co. LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#define MODULE_TAG "h264d_prepare_test"
+
+#include <stdio.h>
+#include <string.h>
+
+#include "mpp_mem.h"
+#include "mpp_log.h"
+#include "mpp_time.h"
+#include "mpp_common.h"
+
+#include "h264d_api.h"
+#include "h264d_global.h"
+
+#include "utils.h"
+
+#define SYNTH_STREAM_SIZE   (8 * 1024 * 1024)
+#define SYNTH_NALU_MAX      (64 * 1024)
+
+/*
+ * Usage: h264d_prepare_test [annexb h264 file ...]
+ *
+ * Feed the elementary stream to the h264 parser prepare in packets of
+ * several sizes with split parse enabled and collect the slice bitstream of
+ * every task. The result must match the nalu found by the byte-wise start
+ * code shift register which the prepare used before the bulk payload skip.
+ * Without input file a synthetic stream of random slice payload is checked.
+ */
+
+static const RK_U32 pkt_sizes[] = {
+    1, 3, 5, 188, 4096, 65536,
+};
+
+/* sps pps idr and non-idr slices with first_mb_in_slice 0 */
+static const RK_U8 synth_hdr[][2] = {
+    { 0x67, 0x42 }, { 0x68, 0xce }, { 0x65, 0x88 }, { 0x41, 0x9a },
+    { 0x41, 0x9a }, { 0x41, 0x9a }, { 0x41, 0x9a }, { 0x41, 0x9a },
+};
+
+static void ref_store_nalu(const RK_U8 *nal, RK_U32 len, RK_U32 trim,
+                           RK_U8 *out, RK_U32 *out_len)
+{
+    RK_U32 type;
+
+    if (trim && len > 3) {
+        while (len && !nal[len - 1])
+            len--;
+    }
+
+    if (!len)
+        return;
+
+    type = nal[0] & 0x1f;
+    if (type != H264_NALU_TYPE_SLICE && type != H264_NALU_TYPE_IDR &&
+        type != H264_NALU_TYPE_SLC_EXT)
+        return;
+
+    out[(*out_len)++] = 0;
+    out[(*out_len)++] = 0;
+    out[(*out_len)++] = 1;
+    memcpy(out + *out_len, nal, len);
+    *out_len += len;
+}
+
+/* old prepare: shift register update on every byte of the stream */
+static RK_U32 ref_split(const RK_U8 *buf, RK_U32 size, RK_U8 *out, RK_U32 *out_len)
+{
+    RK_U32 state = 0xffffffff;
+    RK_U32 found = 0;
+    RK_U32 start = 0;
+    RK_U32 count = 0;
+    RK_U32 pos;
+
+    *out_len = 0;
+
+    for (pos = 0; pos < size; pos++) {
+        state = (state << 8) | buf[pos];
+        if ((state & 0x00ffffff) != 0x000001)
+            continue;
+
+        if (found)
+            ref_store_nalu(buf + start, pos - 2 - start, 1, out, out_len);
+
+        found = 1;
+        start = pos + 1;
+        count++;
+    }
+
+    /* the last nalu is stored on eos without trailing zero removal */
+    if (found)
+        ref_store_nalu(buf + start, size - start, 0, out, out_len);
+
+    return count;
+}
+
+static MPP_RET prepare_split(const RK_U8 *buf, RK_U32 size, RK_U32 pkt_size,
+                             RK_U8 *out, RK_U32 out_size, RK_U32 *out_len,
+                             RK_U32 *task_cnt)
+{
+    const ParserApi *api = &api_h264d_parser;
+    H264_DecCtx_t *dec = NULL;
+    MppBufSlots frame_slots = NULL;
+    MppBufSlots packet_slots = NULL;
+    MppDecCfgSet cfg;
+    ParserCfg init;
+    MppPacket pkt = NULL;
+    MPP_RET ret = MPP_NOK;
+    RK_U32 pos = 0;
+
+    *out_len = 0;
+    *task_cnt = 0;
+
+    memset(&cfg, 0, sizeof(cfg));
+    cfg.base.split_parse = 1;
+
+    mpp_buf_slot_init(&frame_slots);
+    mpp_buf_slot_init(&packet_slots);
+    dec = mpp_calloc_size(H264_DecCtx_t, api->ctx_size);
+    if (!frame_slots || !packet_slots || !dec)
+        goto DONE;
+
+    init.coding = MPP_VIDEO_CodingAVC;
+    init.frame_slots = frame_slots;
+    init.packet_slots = packet_slots;
+    init.cfg = &cfg;
+    init.hw_info = NULL;
+
+    ret = api->init(dec, &init);
+    if (ret)
+        goto DONE;
+
+    /* the empty packet after the stream carries the eos flag */
+    while (pos <= size) {
+        RK_U32 len = MPP_MIN(pkt_size, size - pos);
+
+        mpp_packet_init(&pkt, (void *)(buf + pos), len);
+        if (!len)
+            mpp_packet_set_eos(pkt);
+
+        do {
+            H264dDxvaCtx_t *dxva = dec->dxva_ctx;
+            HalDecTask task;
+
+            memset(&task, 0, sizeof(task));
+            ret = api->prepare(dec, pkt, &task);
+            if (ret)
+                break;
+
+            if (!task.valid)
+                continue;
+
+            if (*out_len + dxva->strm_offset > out_size) {
+                mpp_err("task bitstream overflow at packet %d\n", pos);
+                ret = MPP_NOK;
+                break;
+            }
+
+            /* parse is skipped, consume the task bitstream here */
+            memcpy(out + *out_len, dxva->bitstream, dxva->strm_offset);
+            *out_len += dxva->strm_offset;
+            dxva->strm_offset = 0;
+            (*task_cnt)++;
+        } while (mpp_packet_get_length(pkt));
+
+        mpp_packet_deinit(&pkt);
+        if (ret || !len)
+            break;
+
+        pos += len;
+    }
+
+    api->deinit(dec);
+DONE:
+    MPP_FREE(dec);
+    if (frame_slots)
+        mpp_buf_slot_deinit(frame_slots);
+    if (packet_slots)
+        mpp_buf_slot_deinit(packet_slots);
+
+    return ret;
+}
+
+static MPP_RET check_stream(const char *name, const RK_U8 *buf, RK_U32 size)
+{
+    RK_U8 *ref = NULL;
+    RK_U8 *out = NULL;
+    RK_U32 ref_len = 0;
+    RK_U32 nal_cnt;
+    MPP_RET ret = MPP_NOK;
+    RK_U32 i;
+
+    ref = mpp_malloc(RK_U8, size + 3);
+    out = mpp_malloc(RK_U8, size + 3);
+    if (!ref || !out)
+        goto DONE;
+
+    nal_cnt = ref_split(buf, size, ref, &ref_len);
+    mpp_log("%s size %d nalu %d slice bitstream %d\n", name, size, nal_cnt, ref_len);
+
+    for (i = 0; i < MPP_ARRAY_ELEMS(pkt_sizes); i++) {
+        RK_U32 out_len = 0;
+        RK_U32 task_cnt = 0;
+        RK_S64 start = mpp_time();
+        RK_U32 pos;
+
+        ret = prepare_split(buf, size, pkt_sizes[i], out, size + 3, &out_len, &task_cnt);
+        if (ret) {
+            mpp_err("prepare failed with packet size %d\n", pkt_sizes[i]);
+            goto DONE;
+        }
+
+        for (pos = 0; pos < MPP_MIN(out_len, ref_len); pos++) {
+            if (out[pos] != ref[pos])
+                break;
+        }
+
+        if (pos != out_len || pos != ref_len) {
+            mpp_err("packet size %d bitstream mismatch at %d length %d expect %d\n",
+                    pkt_sizes[i], pos, out_len, ref_len);
+            ret = MPP_NOK;
+            goto DONE;
+        }
+
+        mpp_log("packet size %6d tasks %d prepare %lld us\n",
+                pkt_sizes[i], task_cnt, mpp_time() - start);
+    }
+
+    ret = MPP_OK;
+DONE:
+    MPP_FREE(ref);
+    MPP_FREE(out);
+
+    return ret;
+}
+
+int main(int argc, char **argv)
+{
+    RK_U8 *buf = NULL;
+    RK_U32 size = 0;
+    MPP_RET ret = MPP_NOK;
+    RK_S32 i;
+
+    mpp_log("h264d prepare test start\n");
+
+    if (argc < 2) {
+        size = SYNTH_STREAM_SIZE;
+        buf = gen_stream(size, SYNTH_NALU_MAX, synth_hdr[0],
+                         sizeof(synth_hdr[0]), MPP_ARRAY_ELEMS(synth_hdr));
+        ret = buf ? check_stream("synthetic stream", buf, size) : MPP_NOK;
+        MPP_FREE(buf);
+    }
+
+    for (i = 1; i < argc; i++) {
+        buf = load_stream(argv[i], &size);
+        ret = buf ? check_stream(argv[i], buf, size) : MPP_NOK;
+        MPP_FREE(buf);
+        if (ret)
+            break;
+    }
+
+    mpp_log("h264d prepare test %s\n", ret ? "failed" : "success");
+
+    return ret;
+}
@@ -31,6 +31,7 @@
 #include "mpp_mem.h"
 #include "mpp_bitread.h"
 #include "mpp_packet_impl.h"
+#include "mpp_startcode.h"
 #include "rk_hdr_meta_com.h"
 
 #include "h265d_parser.h"
@@ -58,6 +59,28 @@ static RK_S32 hevc_find_frame_end(SplitContext_t *sc, const RK_U8 *buf,
     for (i = 0; i < buf_size; i++) {
         int nut, layer_id;
 
+        /*
+         * A start code is checked five bytes after its first byte. Beyond
+         * the first five bytes no start code straddles the previous buffer,
+         * so jump to the next check position found by the start code
+         * scanner and rebuild the state from the bytes just before it.
+         */
+        if (i >= 5) {
+            const RK_U8 *sc_pos = mpp_find_startcode(buf + i - 5, buf + buf_size);
+            RK_S32 next = (RK_S32)(sc_pos - buf) + 5;
+            RK_S32 k;
+
+            if (next > buf_size)
+                next = buf_size;
+
+            for (k = MPP_MAX(i, next - 8); k < next; k++)
+                sc->state64 = (sc->state64 << 8) | buf[k];
+
+            i = next;
+            if (i >= buf_size)
+                break;
+        }
+
         sc->state64 = (sc->state64 << 8) | buf[i];
 
         if (((sc->state64 >> 3 * 8) & 0xFFFFFF) != START_CODE)
@@ -2040,6 +2063,10 @@ MPP_RET h265d_deinit(void *ctx)
     for (i = 0; i < MAX_PPS_COUNT; i++)
         mpp_hevc_pps_free(s->pps_list[i]);
 
+    h2645d_ps_cache_deinit(s->vps_cache, MAX_VPS_COUNT);
+    h2645d_ps_cache_deinit(s->sps_cache, MAX_SPS_COUNT);
+    h2645d_ps_cache_deinit(s->pps_cache, MAX_PPS_COUNT);
+
     mpp_free(s->HEVClc);
 
     s->HEVClc = NULL;
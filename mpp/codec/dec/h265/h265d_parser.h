@@ -41,6 +41,7 @@
 #include "h265d_codec.h"
 #include "h265_syntax.h"
 #include "h2645d_sei.h"
+#include "h2645d_ps_cache.h"
 
 extern RK_U32 h265d_debug;
 
@@ -503,6 +504,10 @@ typedef struct HEVCContext {
     RK_U8 *vps_list[MAX_VPS_COUNT];
     RK_U8 *sps_list[MAX_SPS_COUNT];
     RK_U8 *pps_list[MAX_PPS_COUNT];
+    /* raw nal of the parameter sets above for repeated nal skip */
+    H2645dPsCache vps_cache[MAX_VPS_COUNT];
+    H2645dPsCache sps_cache[MAX_SPS_COUNT];
+    H2645dPsCache pps_cache[MAX_PPS_COUNT];
 
     MppMemPool sps_pool;
 
@@ -1027,9 +1027,17 @@ int mpp_hevc_decode_nal_vps(HEVCContext *s)
     BitReadCtx_t *gb = &s->HEVClc->gb;
     RK_U32 vps_id = 0;
     HEVCVPS *vps = NULL;
-    RK_U8 *vps_buf = mpp_calloc(RK_U8, sizeof(HEVCVPS));
+    RK_U8 *vps_buf = NULL;
     RK_S32 value = 0;
+    RK_U32 hash = 0;
 
+    /* repeated vps with the same bytes is already in vps_list */
+    if (h2645d_ps_cache_find(s->vps_cache, MAX_VPS_COUNT, gb->buf, gb->buf_len, &hash) >= 0) {
+        h265d_dbg(H265D_DBG_VPS, "skip repeated vps\n");
+        return 0;
+    }
+
+    vps_buf = mpp_calloc(RK_U8, sizeof(HEVCVPS));
     if (!vps_buf)
         return MPP_ERR_NOMEM;
     vps = (HEVCVPS*)vps_buf;
@@ -1151,6 +1159,7 @@ int mpp_hevc_decode_nal_vps(HEVCContext *s)
         s->vps_list[vps_id] = vps_buf;
         s->ps_need_upate = 1;
     }
+    h2645d_ps_cache_update(&s->vps_cache[vps_id], gb->buf, gb->buf_len, hash);
 
     return 0;
 __BITREAD_ERR:
@@ -1401,10 +1410,19 @@ RK_S32 mpp_hevc_decode_nal_sps(HEVCContext *s)
     RK_S32 bit_depth_chroma, start, vui_present, sublayer_ordering_info;
     RK_S32 i;
     RK_S32 value = 0;
+    RK_U32 hash = 0;
 
     HEVCSPS *sps;
-    RK_U8 *sps_buf = mpp_mem_pool_get(s->sps_pool);
+    RK_U8 *sps_buf = NULL;
+
+    i = h2645d_ps_cache_find(s->sps_cache, MAX_SPS_COUNT, gb->buf, gb->buf_len, &hash);
+    if (i >= 0) {
+        h265d_dbg(H265D_DBG_SPS, "skip repeated sps %d\n", i);
+        s->sps_list_of_updated[i] = 1;
+        return 0;
+    }
 
+    sps_buf = mpp_mem_pool_get(s->sps_pool);
     if (!sps_buf)
         return MPP_ERR_NOMEM;
     sps = (HEVCSPS*)sps_buf;
@@ -1854,6 +1872,7 @@ RK_S32 mpp_hevc_decode_nal_sps(HEVCContext *s)
             if (s->pps_list[i] && ((HEVCPPS*)s->pps_list[i])->sps_id == sps_id) {
                 mpp_hevc_pps_free(s->pps_list[i]);
                 s->pps_list[i] = NULL;
+                h2645d_ps_cache_clear(&s->pps_cache[i], 1);
             }
         }
         if (s->sps_list[sps_id] != NULL)
@@ -1861,6 +1880,7 @@ RK_S32 mpp_hevc_decode_nal_sps(HEVCContext *s)
         s->sps_list[sps_id] = sps_buf;
         s->ps_need_upate = 1;
     }
+    h2645d_ps_cache_update(&s->sps_cache[sps_id], gb->buf, gb->buf_len, hash);
 
     if (s->sps_list[sps_id])
         s->sps_list_of_updated[sps_id] = 1;
@@ -1893,10 +1913,22 @@ int mpp_hevc_decode_nal_pps(HEVCContext *s)
     RK_S32 new_pps = 0;
     RK_U32 pps_id = 0;
     RK_S32 ret = 0;
+    RK_U32 hash = 0;
     RK_S32 i;
 
     h265d_dbg(H265D_DBG_FUNCTION, "Decoding PPS\n");
 
+    /*
+     * pps depends on its sps which drops the cached pps on change,
+     * so the same bytes always give the same pps in pps_list.
+     */
+    i = h2645d_ps_cache_find(s->pps_cache, MAX_PPS_COUNT, gb->buf, gb->buf_len, &hash);
+    if (i >= 0) {
+        h265d_dbg(H265D_DBG_PPS, "skip repeated pps %d\n", i);
+        s->pps_list_of_updated[i] = 1;
+        return 0;
+    }
+
     // Coded parameters
     READ_UE(gb, &pps_id);
     if (pps_id >= MAX_PPS_COUNT) {
@@ -2193,12 +2225,15 @@ int mpp_hevc_decode_nal_pps(HEVCContext *s)
 
     if (s->pps_list[pps_id])
         s->pps_list_of_updated[pps_id] = 1;
+    h2645d_ps_cache_update(&s->pps_cache[pps_id], gb->buf, gb->buf_len, hash);
 
     return 0;
 __BITREAD_ERR:
 err:
     if (new_pps)
         mpp_hevc_pps_free((RK_U8 *)pps);
+    else if (pps)
+        h2645d_ps_cache_clear(&s->pps_cache[pps_id], 1);
 
     return ret;
 }
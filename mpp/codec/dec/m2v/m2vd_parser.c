@@ -22,6 +22,7 @@
 #include "mpp_env.h"
 #include "mpp_debug.h"
 #include "mpp_packet_impl.h"
+#include "mpp_startcode.h"
 
 #include "m2vd_parser.h"
 #include "m2vd_codec.h"
@@ -437,6 +438,17 @@ MPP_RET mpp_m2vd_parser_split(M2VDParserContext *ctx, MppPacket dst, MppPacket s
 
     if (p->vop_header_found) {
         while (src_pos < src_len) {
+            /* copy the payload before next start code in one go */
+            RK_U32 skip = mpp_startcode_skip(src_buf + src_pos, src_len - src_pos, p->state);
+
+            if (skip) {
+                memcpy(dst_buf + dst_len, src_buf + src_pos, skip);
+                p->state = mpp_startcode_state(p->state, src_buf + src_pos, skip);
+                dst_len += skip;
+                src_pos += skip;
+                continue;
+            }
+
             p->state = (p->state << 8) | src_buf[src_pos];
             dst_buf[dst_len++] = src_buf[src_pos++];
 
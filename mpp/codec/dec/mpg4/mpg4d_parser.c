@@ -23,6 +23,7 @@
 #include "mpp_mem.h"
 #include "mpp_debug.h"
 #include "mpp_bitread.h"
+#include "mpp_startcode.h"
 
 #include "mpg4d_parser.h"
 #include "mpg4d_syntax.h"
@@ -1210,6 +1211,17 @@ MPP_RET mpp_mpg4_parser_split(Mpg4dParser ctx, MppPacket dst, MppPacket src)
     // find the end of the vop
     if (p->vop_header_found) {
         while (src_pos < src_len) {
+            /* copy the payload before next start code in one go */
+            RK_U32 skip = mpp_startcode_skip(src_buf + src_pos, src_len - src_pos, p->state);
+
+            if (skip) {
+                memcpy(dst_buf + dst_len, src_buf + src_pos, skip);
+                p->state = mpp_startcode_state(p->state, src_buf + src_pos, skip);
+                dst_len += skip;
+                src_pos += skip;
+                continue;
+            }
+
             p->state = (p->state << 8) | src_buf[src_pos];
             dst_buf[dst_len++] = src_buf[src_pos++];
             if ((p->state & 0x00FFFFFF) == 0x000001) {
@@ -0,0 +1,297 @@
+/*
+ * Copyright 2024 Rockchip Electronics Co. LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#define MODULE_TAG "dec_prepare_test"
+
+#include <string.h>
+
+#include "mpp_mem.h"
+#include "mpp_log.h"
+#include "mpp_time.h"
+#include "mpp_common.h"
+#include "mpp_startcode.h"
+
+#include "avs2d_api.h"
+#include "h264d_api.h"
+#include "h265d_api.h"
+#include "m2vd_api.h"
+#include "mpg4d_api.h"
+#if HAVE_H264D
+#include "h264d_global.h"
+#endif
+
+#include "utils.h"
+
+/*
+ * Usage: dec_prepare_test [<h264|h265|avs2|m2v|mpg4> <elementary stream file>]
+ *
+ * Measure the parser prepare throughput in GB/s of the split parse paths
+ * which use the start code search of mpp_startcode. The stream is fed in
+ * packets of several sizes and every valid task is dropped right after the
+ * prepare, so the time is the nalu / frame split only.
+ * Without input file a synthetic stream is generated for every parser.
+ */
+
+#define SYNTH_STREAM_SIZE   (16 * 1024 * 1024)
+#define SYNTH_UNIT_MAX      (64 * 1024)
+#define UNIT_HDR_SIZE       2
+
+typedef void (*TaskDrop)(void *ctx);
+
+typedef struct PrepareCodec_t {
+    const char          *name;
+    MppCodingType       coding;
+    const ParserApi     *api;
+    /* drop the task data which the parse would have consumed */
+    TaskDrop            drop;
+    /* unit headers of the synthetic stream */
+    RK_U8               hdr[10][UNIT_HDR_SIZE];
+    RK_U32              hdr_cnt;
+} PrepareCodec;
+
+#if HAVE_H264D
+static void h264d_drop(void *ctx)
+{
+    H264_DecCtx_t *dec = (H264_DecCtx_t *)ctx;
+
+    dec->dxva_ctx->strm_offset = 0;
+}
+#endif
+
+static const PrepareCodec prepare_codecs[] = {
+#if HAVE_H264D
+    {
+        "h264", MPP_VIDEO_CodingAVC, &api_h264d_parser, h264d_drop,
+        /* sps pps idr and non-idr slices with first_mb_in_slice 0 */
+        {
+            { 0x67, 0x42 }, { 0x68, 0xce }, { 0x65, 0x88 }, { 0x41, 0x9a },
+            { 0x41, 0x9a }, { 0x41, 0x9a }, { 0x41, 0x9a }, { 0x41, 0x9a },
+        }, 8,
+    },
+#endif
+#if HAVE_H265D
+    {
+        "h265", MPP_VIDEO_CodingHEVC, &api_h265d_parser, NULL,
+        /* vps sps pps idr and trail slices */
+        {
+            { 0x40, 0x01 }, { 0x42, 0x01 }, { 0x44, 0x01 }, { 0x26, 0x01 },
+            { 0x02, 0x01 }, { 0x02, 0x01 }, { 0x02, 0x01 }, { 0x02, 0x01 },
+        }, 8,
+    },
+#endif
+#if HAVE_AVS2D
+    {
+        "avs2", MPP_VIDEO_CodingAVS2, &api_avs2d_parser, NULL,
+        /* sequence header, intra and inter pictures with two slices */
+        {
+            { 0xb0, 0x00 }, { 0xb3, 0x00 }, { 0x00, 0x00 }, { 0x01, 0x00 },
+            { 0xb6, 0x00 }, { 0x00, 0x00 }, { 0x01, 0x00 },
+        }, 7,
+    },
+#endif
+#if HAVE_MPEG2D
+    {
+        "m2v", MPP_VIDEO_CodingMPEG2, &api_m2vd_parser, NULL,
+        /* sequence header and extension, pictures with two slices */
+        {
+            { 0xb3, 0x16 }, { 0xb5, 0x14 }, { 0x00, 0x00 }, { 0x01, 0x0a },
+            { 0x02, 0x0a }, { 0x00, 0x00 }, { 0x01, 0x0a }, { 0x02, 0x0a },
+        }, 8,
+    },
+#endif
+#if HAVE_MPEG4D
+    {
+        "mpg4", MPP_VIDEO_CodingMPEG4, &api_mpg4d_parser, NULL,
+        /* visual object sequence, vol header and vops */
+        {
+            { 0xb0, 0x01 }, { 0x00, 0x00 }, { 0x20, 0x00 }, { 0xb6, 0x10 },
+            { 0xb6, 0x50 }, { 0xb6, 0x50 }, { 0xb6, 0x50 },
+        }, 7,
+    },
+#endif
+};
+
+static const RK_U32 pkt_sizes[] = {
+    188, 4096, 65536,
+};
+
+static MPP_RET prepare_stream(const PrepareCodec *codec, const RK_U8 *buf, RK_U32 size,
+                              RK_U32 pkt_size, RK_U32 *task_cnt, RK_S64 *time)
+{
+    const ParserApi *api = codec->api;
+    void *ctx = NULL;
+    MppBufSlots frame_slots = NULL;
+    MppBufSlots packet_slots = NULL;
+    MppDecCfgSet cfg;
+    ParserCfg init;
+    MppPacket pkt = NULL;
+    MPP_RET ret = MPP_NOK;
+    RK_U32 pos = 0;
+    RK_S64 start;
+
+    *task_cnt = 0;
+    *time = 0;
+
+    memset(&cfg, 0, sizeof(cfg));
+    cfg.base.split_parse = 1;
+
+    mpp_buf_slot_init(&frame_slots);
+    mpp_buf_slot_init(&packet_slots);
+    ctx = mpp_calloc_size(void, api->ctx_size);
+    if (!frame_slots || !packet_slots || !ctx)
+        goto DONE;
+
+    init.coding = codec->coding;
+    init.frame_slots = frame_slots;
+    init.packet_slots = packet_slots;
+    init.cfg = &cfg;
+    init.hw_info = NULL;
+
+    ret = api->init(ctx, &init);
+    if (ret)
+        goto DONE;
+
+    start = mpp_time();
+
+    /* the empty packet after the stream carries the eos flag */
+    while (pos <= size) {
+        RK_U32 len = MPP_MIN(pkt_size, size - pos);
+
+        mpp_packet_init(&pkt, (void *)(buf + pos), len);
+        if (!len)
+            mpp_packet_set_eos(pkt);
+
+        do {
+            HalDecTask task;
+            RK_U32 left = mpp_packet_get_length(pkt);
+
+            memset(&task, 0, sizeof(task));
+            /* no hardware packet slot, the parser keeps the task stream */
+            task.input = -1;
+            ret = api->prepare(ctx, pkt, &task);
+            /* h265 reports a packet without complete frame as split fail */
+            if (ret == MPP_FAIL_SPLIT_FRAME)
+                ret = MPP_OK;
+            if (ret)
+                break;
+
+            if (task.valid) {
+                if (codec->drop)
+                    codec->drop(ctx);
+                (*task_cnt)++;
+            } else if (left == mpp_packet_get_length(pkt)) {
+                break;
+            }
+        } while (mpp_packet_get_length(pkt));
+
+        if (!ret && len && mpp_packet_get_length(pkt)) {
+            mpp_err("%s packet at %d is not consumed\n", codec->name, pos);
+            ret = MPP_NOK;
+        }
+
+        mpp_packet_deinit(&pkt);
+        if (ret || !len)
+            break;
+
+        pos += len;
+    }
+
+    *time = mpp_time() - start;
+
+    api->deinit(ctx);
+DONE:
+    MPP_FREE(ctx);
+    if (frame_slots)
+        mpp_buf_slot_deinit(frame_slots);
+    if (packet_slots)
+        mpp_buf_slot_deinit(packet_slots);
+
+    return ret;
+}
+
+static MPP_RET bench_stream(const PrepareCodec *codec, const char *name,
+                            const RK_U8 *buf, RK_U32 size)
+{
+    MPP_RET ret = MPP_OK;
+    RK_U32 i;
+
+    mpp_log("%s %s size %d\n", codec->name, name, size);
+
+    for (i = 0; i < MPP_ARRAY_ELEMS(pkt_sizes); i++) {
+        RK_U32 task_cnt = 0;
+        RK_S64 time = 0;
+
+        ret = prepare_stream(codec, buf, size, pkt_sizes[i], &task_cnt, &time);
+        if (ret || !task_cnt) {
+            mpp_err("%s prepare failed with packet size %d ret %d tasks %d\n",
+                    codec->name, pkt_sizes[i], ret, task_cnt);
+            return MPP_NOK;
+        }
+
+        mpp_log("%s packet size %6d tasks %5d prepare %6lld us %6.2f GB/s\n",
+                codec->name, pkt_sizes[i], task_cnt, time,
+                time ? (double)size / time / 1000 : 0.0);
+    }
+
+    return ret;
+}
+
+int main(int argc, char **argv)
+{
+    RK_U8 *buf = NULL;
+    RK_U32 size = 0;
+    RK_U32 found = 0;
+    MPP_RET ret = MPP_OK;
+    RK_U32 i;
+
+    if (argc == 2) {
+        mpp_log("usage: %s [<h264|h265|avs2|m2v|mpg4> <stream file>]\n", argv[0]);
+        return MPP_NOK;
+    }
+
+    mpp_log("dec prepare test start with %s engine\n", mpp_startcode_engine());
+
+    for (i = 0; i < MPP_ARRAY_ELEMS(prepare_codecs); i++) {
+        const PrepareCodec *codec = &prepare_codecs[i];
+
+        if (argc > 2) {
+            if (strcmp(argv[1], codec->name))
+                continue;
+
+            found = 1;
+            buf = load_stream(argv[2], &size);
+            ret = buf ? bench_stream(codec, argv[2], buf, size) : MPP_NOK;
+        } else {
+            size = SYNTH_STREAM_SIZE;
+            buf = gen_stream(size, SYNTH_UNIT_MAX, codec->hdr[0], UNIT_HDR_SIZE,
+                             codec->hdr_cnt);
+            ret = buf ? bench_stream(codec, "synthetic stream", buf, size) : MPP_NOK;
+        }
+
+        MPP_FREE(buf);
+        if (ret)
+            break;
+    }
+
+    if (argc > 2 && !found) {
+        mpp_err("parser %s is not enabled\n", argv[1]);
+        ret = MPP_NOK;
+    }
+
+    mpp_log("dec prepare test %s\n", ret ? "failed" : "success");
+
+    return ret;
+}
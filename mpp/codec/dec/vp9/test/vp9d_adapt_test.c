@@ -0,0 +1,165 @@
+/*
+ * Copyright 2024 Rockchip Electronics Co. LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#define MODULE_TAG "vp9d_adapt_test"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "mpp_log.h"
+#include "mpp_common.h"
+
+#include "vp9d_codec.h"
+#include "vp9d_parser.h"
+#include "hal_vp9d_com.h"
+
+#define TEST_LOOP           2000
+#define TEST_PROB_NUM       (4 * 2 * 2 * 6 * 6 * 3)
+#define TEST_COEF_NUM       (6 * 6)
+
+extern const RK_U32 vpx_inverse[257];
+
+/* scalar reference of hal_vp9d_update_coef_counts */
+static void ref_coef_counts(RK_U32 *eob, RK_U32 *coef, const RK_U32 *src, RK_S32 count)
+{
+    RK_S32 i;
+
+    for (i = 0; i < count; i++, src += 5, eob += 2, coef += 3) {
+        eob[0] = src[1];
+        eob[1] = src[0] - src[1];
+        coef[0] = src[2];
+        coef[1] = src[3];
+        coef[2] = src[4];
+    }
+}
+
+/* scalar reference of vp9d_adapt_prob_batch */
+static void ref_adapt_prob(RK_U8 *p, RK_U32 ct0, RK_U32 ct1,
+                           RK_S32 max_count, RK_S32 update_factor)
+{
+    RK_U32 ct = ct0 + ct1, p2, p1;
+
+    if (!ct)
+        return;
+
+    p1 = *p;
+    p2 = ((ct0 << 8) + (ct >> 1)) / ct;
+    p2 = mpp_clip(p2, 1, 255);
+    ct = MPP_MIN(ct, (RK_U32)max_count);
+    update_factor = (RK_U32)(((RK_U64)(update_factor * ct) * vpx_inverse[max_count]) >> 32);
+
+    *p = p1 + (((p2 - p1) * update_factor + 128) >> 8);
+}
+
+/* mostly small counts with zero and huge ones to hit the skip and fallback lanes */
+static RK_U32 rand_count(void)
+{
+    switch (rand() % 8) {
+    case 0 : return 0;
+    case 1 : return rand() % 4;
+    case 2 : return rand() % 64;
+    case 3 : return rand() % 4096;
+    case 4 : return rand() % (1 << 22);
+    case 5 : return (1 << 22) + rand() % (1 << 20);
+    default : return rand() % 32;
+    }
+}
+
+static RK_S32 test_coef_counts(void)
+{
+    RK_U32 src[TEST_COEF_NUM * 5 + 3];
+    RK_U32 eob[2][TEST_COEF_NUM * 2];
+    RK_U32 coef[2][TEST_COEF_NUM * 3];
+    RK_S32 loop;
+    RK_S32 i;
+
+    for (loop = 0; loop < TEST_LOOP; loop++) {
+        for (i = 0; i < (RK_S32)MPP_ARRAY_ELEMS(src); i++)
+            src[i] = rand_count();
+
+        /* eob count is more_coef + eob so it is never below more_coef */
+        for (i = 0; i < TEST_COEF_NUM; i++)
+            src[i * 5] += src[i * 5 + 1];
+
+        memset(eob, 0xff, sizeof(eob));
+        memset(coef, 0xff, sizeof(coef));
+        ref_coef_counts(eob[0], coef[0], src, TEST_COEF_NUM);
+        hal_vp9d_update_coef_counts(eob[1], coef[1], src, TEST_COEF_NUM);
+
+        if (memcmp(eob[0], eob[1], sizeof(eob[0])) ||
+            memcmp(coef[0], coef[1], sizeof(coef[0]))) {
+            mpp_err("coef count mismatch at loop %d\n", loop);
+            return MPP_NOK;
+        }
+    }
+
+    return MPP_OK;
+}
+
+static RK_S32 test_adapt_prob(void)
+{
+    static const RK_S32 max_counts[] = { 20, 24 };
+    static const RK_S32 factors[] = { 112, 128 };
+    RK_U32 ct0[TEST_PROB_NUM];
+    RK_U32 ct1[TEST_PROB_NUM];
+    RK_U8 p[2][TEST_PROB_NUM];
+    RK_S32 loop;
+    RK_S32 i;
+
+    for (loop = 0; loop < TEST_LOOP; loop++) {
+        RK_S32 max_count = max_counts[loop & 1];
+        RK_S32 uf = factors[(loop >> 1) & 1];
+        /* odd length to cover the scalar tail */
+        RK_S32 n = (loop & 4) ? TEST_PROB_NUM : rand() % TEST_PROB_NUM;
+
+        for (i = 0; i < n; i++) {
+            ct0[i] = rand_count();
+            ct1[i] = rand_count();
+            p[0][i] = 1 + rand() % 255;
+        }
+        memcpy(p[1], p[0], n);
+
+        for (i = 0; i < n; i++)
+            ref_adapt_prob(&p[0][i], ct0[i], ct1[i], max_count, uf);
+        vp9d_adapt_prob_batch(p[1], ct0, ct1, n, max_count, uf);
+
+        for (i = 0; i < n; i++) {
+            if (p[0][i] != p[1][i]) {
+                mpp_err("prob mismatch at loop %d pos %d ct %u %u ref %d batch %d\n",
+                        loop, i, ct0[i], ct1[i], p[0][i], p[1][i]);
+                return MPP_NOK;
+            }
+        }
+    }
+
+    return MPP_OK;
+}
+
+int main()
+{
+    RK_S32 ret;
+
+    mpp_log("vp9d adapt test start\n");
+
+    srand(0x5eed);
+
+    ret = test_coef_counts();
+    if (!ret)
+        ret = test_adapt_prob();
+
+    mpp_log("vp9d adapt test %s\n", ret ? "failed" : "success");
+    return ret;
+}
@@ -16,6 +16,7 @@
 */
 #include <stdlib.h>
 
+#include <errno.h>
 #include <string.h>
 
 #include "mpp_env.h"
@@ -31,6 +32,12 @@
 #include "vp9d_parser.h"
 #include "mpp_frame_impl.h"
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
 /**
  * Clip a signed integer into the -(2^p),(2^p-1) range.
  * @param  a value to clip
@@ -47,6 +54,7 @@ static   RK_U32 av_clip_uintp2(RK_S32 a, RK_S32 p)
 RK_U32 vp9d_debug = 0;
 
 #define VP9_SYNCCODE 0x498342
+#define VP9_ADAPT_TIMEOUT_MS    500
 //#define dump
 #ifdef dump
 static FILE *vp9_p_fp = NULL;
@@ -345,6 +353,45 @@ static RK_S32 vp9_frame_init(VP9Context *s)
     return MPP_OK;
 }
 
+/*
+ * In async adapt mode the hal callback of previous frame adapts the frame
+ * context while the uncompressed header of current frame is parsing. Wait
+ * here before the probabilities and counts are touched.
+ */
+static void vp9_wait_adapt(VP9Context *s)
+{
+    if (!s->async_adapt)
+        return;
+
+    pthread_mutex_lock(&s->adapt_lock);
+    while (s->adapt_pending) {
+        struct timespec ts;
+
+        clock_gettime(CLOCK_REALTIME_COARSE, &ts);
+        ts.tv_nsec += VP9_ADAPT_TIMEOUT_MS * 1000000;
+        ts.tv_sec += ts.tv_nsec / 1000000000;
+        ts.tv_nsec %= 1000000000;
+
+        if (pthread_cond_timedwait(&s->adapt_cond, &s->adapt_lock, &ts) == ETIMEDOUT) {
+            mpp_err("wait backward adaptation timeout\n");
+            s->adapt_pending = 0;
+        }
+    }
+    pthread_mutex_unlock(&s->adapt_lock);
+}
+
+/* release the parser wait on the backward adaptation of previous frame */
+static void vp9_adapt_done(VP9Context *s)
+{
+    if (!s->async_adapt)
+        return;
+
+    pthread_mutex_lock(&s->adapt_lock);
+    s->adapt_pending = 0;
+    pthread_cond_signal(&s->adapt_cond);
+    pthread_mutex_unlock(&s->adapt_lock);
+}
+
 MPP_RET vp9d_parser_init(Vp9CodecContext *vp9_ctx, ParserCfg *init)
 {
     VP9Context *s = mpp_calloc(VP9Context, 1);
@@ -368,6 +415,9 @@ MPP_RET vp9d_parser_init(Vp9CodecContext *vp9_ctx, ParserCfg *init)
     mpp_buf_slot_setup(s->slots, 25);
 
     mpp_env_get_u32("vp9d_debug", &vp9d_debug, 0);
+    mpp_env_get_u32("vp9d_async_adapt", &s->async_adapt, 0);
+    pthread_mutex_init(&s->adapt_lock, NULL);
+    pthread_cond_init(&s->adapt_cond, NULL);
 
     return MPP_OK;
 }
@@ -375,6 +425,10 @@ MPP_RET vp9d_parser_init(Vp9CodecContext *vp9_ctx, ParserCfg *init)
 MPP_RET vp9d_parser_deinit(Vp9CodecContext *vp9_ctx)
 {
     VP9Context *s = vp9_ctx->priv_data;
+
+    /* hal is stopped before parser deinit, no adaptation callback is left */
+    pthread_mutex_destroy(&s->adapt_lock);
+    pthread_cond_destroy(&s->adapt_cond);
     vp9_frame_free(s);
     mpp_free(s->c_b);
     s->c_b_size = 0;
@@ -1049,6 +1103,8 @@ static RK_S32 decode_parser_header(Vp9CodecContext *ctx,
         }
     }
 
+    vp9_wait_adapt(s);
+
     if (s->keyframe || s->errorres ||
         (s->intraonly && s->resetctx == 3)) {
         s->prob_ctx[0].p = s->prob_ctx[1].p = s->prob_ctx[2].p =
@@ -1377,42 +1433,173 @@ static void adapt_prob(RK_U8 *p, RK_U32 ct0, RK_U32 ct1,
     *p = p1 + (((p2 - p1) * update_factor + 128) >> 8);
 }
 
+#define VP9_COEF_PROB_NUM   (4 * 2 * 2 * 6 * 6 * 3)
+#define ADAPT_BATCH_BITS    22
+
+/*
+ * adapt_prob on n continuous probabilities
+ *
+ * Four probabilities are merged in one vector step. The divisions are done
+ * in double which is exact for 32bit integer operands, so the result matches
+ * adapt_prob bit exactly. Counts above ADAPT_BATCH_BITS which may overflow
+ * the 32bit lanes go back to adapt_prob.
+ */
+void vp9d_adapt_prob_batch(RK_U8 *p, const RK_U32 *ct0, const RK_U32 *ct1,
+                           RK_S32 n, RK_S32 max_count, RK_S32 update_factor)
+{
+    RK_S32 i = 0;
+
+#if defined(__SSE2__)
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i min_p = _mm_set1_epi32(1);
+    const __m128i max_p = _mm_set1_epi32(255);
+    const __m128i max_ct = _mm_set1_epi32(max_count);
+    const __m128i uf = _mm_set1_epi32(update_factor);
+    const __m128i round = _mm_set1_epi32(128);
+    const __m128d div = _mm_set1_pd(max_count);
+
+    for (; i + 4 <= n; i += 4) {
+        __m128i c0 = _mm_loadu_si128((const __m128i *)(ct0 + i));
+        __m128i c1 = _mm_loadu_si128((const __m128i *)(ct1 + i));
+        __m128i ct, num, p1, p2, skip, cmp, f;
+        __m128d q_lo, q_hi;
+        RK_U32 val;
+
+        if (_mm_movemask_epi8(_mm_cmpeq_epi32(_mm_srli_epi32(_mm_or_si128(c0, c1),
+                                                             ADAPT_BATCH_BITS), zero)) != 0xffff) {
+            RK_S32 j;
+
+            for (j = i; j < i + 4; j++)
+                adapt_prob(&p[j], ct0[j], ct1[j], max_count, update_factor);
+            continue;
+        }
+
+        memcpy(&val, p + i, sizeof(val));
+        p1 = _mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(val), zero), zero);
+
+        ct = _mm_add_epi32(c0, c1);
+        skip = _mm_cmpeq_epi32(ct, zero);
+        num = _mm_add_epi32(_mm_slli_epi32(c0, 8), _mm_srli_epi32(ct, 1));
+
+        // p2 = clip(num / ct, 1, 255), values are in 16bit for min / max
+        q_lo = _mm_div_pd(_mm_cvtepi32_pd(num), _mm_cvtepi32_pd(ct));
+        q_hi = _mm_div_pd(_mm_cvtepi32_pd(_mm_srli_si128(num, 8)),
+                          _mm_cvtepi32_pd(_mm_srli_si128(ct, 8)));
+        p2 = _mm_unpacklo_epi64(_mm_cvttpd_epi32(q_lo), _mm_cvttpd_epi32(q_hi));
+        p2 = _mm_andnot_si128(skip, p2);
+        p2 = _mm_min_epi16(_mm_max_epi16(p2, min_p), max_p);
+
+        // update_factor * min(ct, max_count) / max_count
+        cmp = _mm_cmpgt_epi32(ct, max_ct);
+        ct = _mm_or_si128(_mm_and_si128(cmp, max_ct), _mm_andnot_si128(cmp, ct));
+        f = _mm_mullo_epi16(ct, uf);
+        q_lo = _mm_div_pd(_mm_cvtepi32_pd(f), div);
+        q_hi = _mm_div_pd(_mm_cvtepi32_pd(_mm_srli_si128(f, 8)), div);
+        f = _mm_unpacklo_epi64(_mm_cvttpd_epi32(q_lo), _mm_cvttpd_epi32(q_hi));
+
+        // p1 + (((p2 - p1) * f + 128) >> 8), the product fits in signed 16bit
+        p2 = _mm_mullo_epi16(_mm_sub_epi32(p2, p1), f);
+        p2 = _mm_srai_epi32(_mm_slli_epi32(p2, 16), 16);
+        p2 = _mm_add_epi32(p1, _mm_srai_epi32(_mm_add_epi32(p2, round), 8));
+        p2 = _mm_or_si128(_mm_and_si128(skip, p1), _mm_andnot_si128(skip, p2));
+
+        p2 = _mm_packus_epi16(_mm_packs_epi32(p2, zero), zero);
+        val = (RK_U32)_mm_cvtsi128_si32(p2);
+        memcpy(p + i, &val, sizeof(val));
+    }
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+    const uint32x4_t max_ct = vdupq_n_u32(max_count);
+    const float64x2_t div = vdupq_n_f64(max_count);
+
+    for (; i + 4 <= n; i += 4) {
+        uint32x4_t c0 = vld1q_u32(ct0 + i);
+        uint32x4_t c1 = vld1q_u32(ct1 + i);
+        uint32x4_t ct, num, p2, skip, f;
+        int32x4_t p1, d;
+        float64x2_t q_lo, q_hi;
+        RK_U32 val;
+
+        if (vmaxvq_u32(vorrq_u32(c0, c1)) >> ADAPT_BATCH_BITS) {
+            RK_S32 j;
+
+            for (j = i; j < i + 4; j++)
+                adapt_prob(&p[j], ct0[j], ct1[j], max_count, update_factor);
+            continue;
+        }
+
+        memcpy(&val, p + i, sizeof(val));
+        p1 = vreinterpretq_s32_u32(vmovl_u16(vget_low_u16(vmovl_u8(vcreate_u8(val)))));
+
+        ct = vaddq_u32(c0, c1);
+        skip = vceqq_u32(ct, vdupq_n_u32(0));
+        num = vaddq_u32(vshlq_n_u32(c0, 8), vshrq_n_u32(ct, 1));
+
+        // p2 = clip(num / ct, 1, 255)
+        q_lo = vdivq_f64(vcvtq_f64_u64(vmovl_u32(vget_low_u32(num))),
+                         vcvtq_f64_u64(vmovl_u32(vget_low_u32(ct))));
+        q_hi = vdivq_f64(vcvtq_f64_u64(vmovl_high_u32(num)),
+                         vcvtq_f64_u64(vmovl_high_u32(ct)));
+        p2 = vcombine_u32(vmovn_u64(vcvtq_u64_f64(q_lo)), vmovn_u64(vcvtq_u64_f64(q_hi)));
+        p2 = vminq_u32(vmaxq_u32(p2, vdupq_n_u32(1)), vdupq_n_u32(255));
+
+        // update_factor * min(ct, max_count) / max_count
+        f = vmulq_n_u32(vminq_u32(ct, max_ct), update_factor);
+        q_lo = vdivq_f64(vcvtq_f64_u64(vmovl_u32(vget_low_u32(f))), div);
+        q_hi = vdivq_f64(vcvtq_f64_u64(vmovl_high_u32(f)), div);
+        f = vcombine_u32(vmovn_u64(vcvtq_u64_f64(q_lo)), vmovn_u64(vcvtq_u64_f64(q_hi)));
+
+        // p1 + (((p2 - p1) * f + 128) >> 8)
+        d = vmulq_s32(vsubq_s32(vreinterpretq_s32_u32(p2), p1), vreinterpretq_s32_u32(f));
+        d = vaddq_s32(p1, vshrq_n_s32(vaddq_s32(d, vdupq_n_s32(128)), 8));
+        p2 = vbslq_u32(skip, vreinterpretq_u32_s32(p1), vreinterpretq_u32_s32(d));
+
+        val = vget_lane_u32(vreinterpret_u32_u8(vmovn_u16(vcombine_u16(vmovn_u32(p2),
+                                                                       vdup_n_u16(0)))), 0);
+        memcpy(p + i, &val, sizeof(val));
+    }
+#endif
+
+    for (; i < n; i++)
+        adapt_prob(&p[i], ct0[i], ct1[i], max_count, update_factor);
+}
+
 static void adapt_probs(VP9Context *s)
 {
-    RK_S32 i, j, k, l, m;
-    prob_context *p = &s->prob_ctx[s->framectxid].p;
-    RK_S32 uf = (s->keyframe || s->intraonly || !s->last_keyframe) ? 112 : 128;
+    RK_S32 i, j;
+    prob_context *p = &s->prob_ctx[s->adapt.framectxid].p;
+    RK_S32 uf = (s->adapt.keyframe || s->adapt.intraonly || !s->adapt.last_keyframe) ? 112 : 128;
 
     // coefficients
-    for (i = 0; i < 4; i++)
-        for (j = 0; j < 2; j++)
-            for (k = 0; k < 2; k++)
-                for (l = 0; l < 6; l++)
-                    for (m = 0; m < 6; m++) {
-                        RK_U8 *pp = s->prob_ctx[s->framectxid].coef[i][j][k][l][m];
-                        RK_U32 *e = s->counts.eob[i][j][k][l][m];
-                        RK_U32 *c = s->counts.coef[i][j][k][l][m];
-
-                        if (l == 0 && m >= 3) // dc only has 3 pt
-                            break;
-                        /*  if(i == 0 && j == 0 && k== 1 && l == 0){
-                             mpp_log("e[0] = 0x%x e[1] = 0x%x c[0] = 0x%x c[1] = 0x%x c[2] = 0x%x \n",
-                             e[0],e[1],c[0],c[1],c[2]);
-                             mpp_log("pp[0] = 0x%x pp[1] = 0x%x pp[2] = 0x%x",pp[0],pp[1],pp[2]);
-                          }*/
-                        adapt_prob(&pp[0], e[0], e[1], 24, uf);
-                        adapt_prob(&pp[1], c[0], c[1] + c[2], 24, uf);
-                        adapt_prob(&pp[2], c[1], c[2], 24, uf);
-                        /* if(i == 0 && j == 0 && k== 1 && l == 0){
-                            mpp_log("after pp[0] = 0x%x pp[1] = 0x%x pp[2] = 0x%x",pp[0],pp[1],pp[2]);
-                         }*/
-                    }
+    {
+        RK_U8 *pp = &s->prob_ctx[s->adapt.framectxid].coef[0][0][0][0][0][0];
+        RK_U32 *e = &s->counts.eob[0][0][0][0][0][0];
+        RK_U32 *c = &s->counts.coef[0][0][0][0][0][0];
+        RK_U32 ct0[VP9_COEF_PROB_NUM];
+        RK_U32 ct1[VP9_COEF_PROB_NUM];
+
+        for (i = 0; i < VP9_COEF_PROB_NUM; i += 3, e += 2, c += 3) {
+            // dc only has 3 pt, zero counts keep the probability
+            if ((i / 3) % 36 >= 3 && (i / 3) % 36 < 6) {
+                memset(&ct0[i], 0, sizeof(ct0[0]) * 3);
+                memset(&ct1[i], 0, sizeof(ct1[0]) * 3);
+                continue;
+            }
+            ct0[i + 0] = e[0];
+            ct1[i + 0] = e[1];
+            ct0[i + 1] = c[0];
+            ct1[i + 1] = c[1] + c[2];
+            ct0[i + 2] = c[1];
+            ct1[i + 2] = c[2];
+        }
+
+        vp9d_adapt_prob_batch(pp, ct0, ct1, VP9_COEF_PROB_NUM, 24, uf);
+    }
 #ifdef dump
     fwrite(&s->counts, 1, sizeof(s->counts), vp9_p_fp);
     fflush(vp9_p_fp);
 #endif
 
-    if (s->keyframe || s->intraonly) {
+    if (s->adapt.keyframe || s->adapt.intraonly) {
         memcpy(p->skip,  s->prob.p.skip,  sizeof(p->skip));
         memcpy(p->tx32p, s->prob.p.tx32p, sizeof(p->tx32p));
         memcpy(p->tx16p, s->prob.p.tx16p, sizeof(p->tx16p));
@@ -1429,19 +1616,19 @@ static void adapt_probs(VP9Context *s)
         adapt_prob(&p->intra[i], s->counts.intra[i][0], s->counts.intra[i][1], 20, 128);
 
     // comppred flag
-    if (s->comppredmode == PRED_SWITCHABLE) {
+    if (s->adapt.comppredmode == PRED_SWITCHABLE) {
         for (i = 0; i < 5; i++)
             adapt_prob(&p->comp[i], s->counts.comp[i][0], s->counts.comp[i][1], 20, 128);
     }
 
     // reference frames
-    if (s->comppredmode != PRED_SINGLEREF) {
+    if (s->adapt.comppredmode != PRED_SINGLEREF) {
         for (i = 0; i < 5; i++)
             adapt_prob(&p->comp_ref[i], s->counts.comp_ref[i][0],
                        s->counts.comp_ref[i][1], 20, 128);
     }
 
-    if (s->comppredmode != PRED_COMPREF) {
+    if (s->adapt.comppredmode != PRED_COMPREF) {
         for (i = 0; i < 5; i++) {
             RK_U8 *pp = p->single_ref[i];
             RK_U32 (*c)[2] = s->counts.single_ref[i];
@@ -1465,7 +1652,7 @@ static void adapt_probs(VP9Context *s)
         }
 
     // tx size
-    if (s->txfmmode == TX_SWITCHABLE) {
+    if (s->adapt.txfmmode == TX_SWITCHABLE) {
         for (i = 0; i < 2; i++) {
             RK_U32 *c16 = s->counts.tx16p[i], *c32 = s->counts.tx32p[i];
 
@@ -1479,7 +1666,7 @@ static void adapt_probs(VP9Context *s)
     }
 
     // interpolation filter
-    if (s->filtermode == FILTER_SWITCHABLE) {
+    if (s->adapt.filtermode == FILTER_SWITCHABLE) {
         for (i = 0; i < 4; i++) {
             RK_U8 *pp = p->filter[i];
             RK_U32 *c = s->counts.filter[i];
@@ -1555,7 +1742,7 @@ static void adapt_probs(VP9Context *s)
         adapt_prob(&pp[1], c[1], c[2] + c[3], 20, 128);
         adapt_prob(&pp[2], c[2], c[3], 20, 128);
 
-        if (s->highprecisionmvs) {
+        if (s->adapt.highprecisionmvs) {
             adapt_prob(&p->mv_comp[i].class0_hp, s->counts.class0_hp[i][0],
                        s->counts.class0_hp[i][1], 20, 128);
             adapt_prob(&p->mv_comp[i].hp, s->counts.hp[i][0],
@@ -1698,6 +1885,26 @@ RK_S32 vp9_parser_frame(Vp9CodecContext *ctx, HalDecTask *task)
     task->syntax.data = (void*)&ctx->pic_params;
     task->syntax.number = 1;
     task->valid = 1;
+
+    // save header info for backward adaptation in hal callback
+    s->adapt.valid = s->refreshctx && !s->parallelmode;
+    if (s->adapt.valid) {
+        s->adapt.keyframe = s->keyframe;
+        s->adapt.last_keyframe = s->last_keyframe;
+        s->adapt.intraonly = s->intraonly;
+        s->adapt.highprecisionmvs = s->highprecisionmvs;
+        s->adapt.framectxid = s->framectxid;
+        s->adapt.filtermode = s->filtermode;
+        s->adapt.txfmmode = s->txfmmode;
+        s->adapt.comppredmode = s->comppredmode;
+
+        if (s->async_adapt) {
+            pthread_mutex_lock(&s->adapt_lock);
+            s->adapt_pending = 1;
+            pthread_mutex_unlock(&s->adapt_lock);
+            task->flags.wait_async = 1;
+        }
+    }
     task->output = s->frames[CUR_FRAME].slot_index;
     task->input_packet = ctx->pkt;
 
@@ -1756,6 +1963,11 @@ MPP_RET vp9d_paser_reset(Vp9CodecContext *ctx)
     SplitContext_t *ps = (SplitContext_t *)ctx->priv_data2;
     VP9ParseContext *pc = (VP9ParseContext *)ps->priv_data;
 
+    /*
+     * hal tasks are all done before parser reset, a pending adaptation left
+     * here is from a parsed task dropped before hal and never called back
+     */
+    vp9_adapt_done(s);
     s->got_keyframes = 0;
     s->cur_poc = 0;
     for (i = 0; i < 3; i++) {
@@ -1798,7 +2010,7 @@ static void inv_count_data(VP9Context *s)
         memcpy(&s->counts.partition[j], &partition_probs[i], 64);
         j++;
     }
-    if (!(s->keyframe || s->intraonly)) {
+    if (!(s->adapt.keyframe || s->adapt.intraonly)) {
         memcpy(count_y_mode, s->counts.y_mode, sizeof(s->counts.y_mode));
         for (i = 0; i < 4; i++) {
             RK_U32 value = 0;
@@ -1899,7 +2111,7 @@ void vp9_parser_update(Vp9CodecContext *ctx, void *count_info)
 
         memcpy((void *)&s->counts, count_info, sizeof(s->counts));
 
-        if (s->refreshctx && !s->parallelmode) {
+        if (s->adapt.valid) {
 #ifdef dump
             count++;
 #endif
@@ -1909,5 +2121,7 @@ void vp9_parser_update(Vp9CodecContext *ctx, void *count_info)
         }
     }
 
+    vp9_adapt_done(s);
+
     return;
 }
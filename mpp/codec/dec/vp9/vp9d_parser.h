@@ -20,6 +20,7 @@
 #include <stdlib.h>
 
 #include "mpp_debug.h"
+#include "mpp_thread.h"
 #include "mpp_bitread.h"
 
 #include "parser_api.h"
@@ -262,6 +263,26 @@ typedef struct VP9Context {
     RK_S32 upprobe_num;
     RK_S32 outframe_num;
     RK_U32 cur_poc;
+
+    /*
+     * backward adaptation info of the last frame sent to hal
+     * header fields used by adapt_probs are saved on task ready so the hal
+     * callback can run adaptation while next frame header is parsing
+     */
+    struct {
+        RK_U8 valid;
+        RK_U8 keyframe, last_keyframe;
+        RK_U8 intraonly;
+        RK_U8 highprecisionmvs;
+        RK_U8 framectxid;
+        enum FilterMode filtermode;
+        enum TxfmMode txfmmode;
+        enum CompPredMode comppredmode;
+    } adapt;
+    RK_U32 async_adapt;
+    RK_U32 adapt_pending;
+    pthread_mutex_t adapt_lock;
+    pthread_cond_t adapt_cond;
 } VP9Context;
 
 #ifdef  __cplusplus
@@ -288,6 +309,9 @@ MPP_RET vp9d_split_init(Vp9CodecContext *vp9_ctx);
 
 RK_S32 vp9d_parser2_syntax(Vp9CodecContext *ctx);
 
+void vp9d_adapt_prob_batch(RK_U8 *p, const RK_U32 *ct0, const RK_U32 *ct1,
+                           RK_S32 n, RK_S32 max_count, RK_S32 update_factor);
+
 #ifdef  __cplusplus
 }
 #endif
@@ -233,6 +233,7 @@ extern "C" {
 
 MPP_RET dec_task_info_init(HalTaskInfo *task);
 void dec_task_init(DecTask *task);
+MppBuffer dec_get_zero_copy_buf(MppPacket packet);
 
 MPP_RET mpp_dec_proc_cfg(MppDecImpl *dec, MpiCmd cmd, void *param);
 
@@ -19,6 +19,7 @@
 #include <string.h>
 
 #include "mpp_env.h"
+#include "mpp_trace.h"
 
 #include "mpp_buffer_impl.h"
 #include "mpp_frame_impl.h"
@@ -56,9 +57,32 @@ void dec_task_init(DecTask *task)
     task->status.prev_task_rdy  = 1;
     INIT_LIST_HEAD(&task->ts_cur.link);
 
+    task->hal_pkt_buf_in = NULL;
+    task->hal_frm_buf_out = NULL;
+
     dec_task_info_init(&task->info);
 }
 
+/*
+ * Hal can read stream from the MppBuffer of prepared packet directly when
+ * the stream starts at the beginning of the buffer.
+ */
+MppBuffer dec_get_zero_copy_buf(MppPacket packet)
+{
+    MppBuffer buffer = NULL;
+
+    if (packet)
+        buffer = mpp_packet_get_buffer(packet);
+
+    if (buffer) {
+        if (mpp_packet_get_data(packet) != mpp_buffer_get_ptr(buffer) ||
+            mpp_packet_get_size(packet) > mpp_buffer_get_size(buffer))
+            buffer = NULL;
+    }
+
+    return buffer;
+}
+
 static MPP_RET mpp_dec_update_cfg(MppDecImpl *p)
 {
     MppDecCfgSet *cfg = &p->cfg;
@@ -173,6 +197,20 @@ MPP_RET mpp_dec_proc_cfg(MppDecImpl *dec, MpiCmd cmd, void *param)
 
         if (flag & MPP_DEC_QUERY_DEC_OUT_FRM)
             query->dec_out_frm_cnt = dec->dec_out_frame_count;
+
+        if (flag & MPP_DEC_QUERY_TIMING) {
+            query->prs_total    = mpp_clock_get_sum(dec->clocks[DEC_PRS_TOTAL]);
+            query->prs_wait     = mpp_clock_get_sum(dec->clocks[DEC_PRS_WAIT]);
+            query->prs_proc     = mpp_clock_get_sum(dec->clocks[DEC_PRS_PROC]);
+            query->prs_prepare  = mpp_clock_get_sum(dec->clocks[DEC_PRS_PREPARE]);
+            query->prs_parse    = mpp_clock_get_sum(dec->clocks[DEC_PRS_PARSE]);
+            query->hal_gen_reg  = mpp_clock_get_sum(dec->clocks[DEC_HAL_GEN_REG]);
+            query->hw_start     = mpp_clock_get_sum(dec->clocks[DEC_HW_START]);
+            query->hal_total    = mpp_clock_get_sum(dec->clocks[DEC_HAL_TOTAL]);
+            query->hal_wait     = mpp_clock_get_sum(dec->clocks[DEC_HAL_WAIT]);
+            query->hal_proc     = mpp_clock_get_sum(dec->clocks[DEC_HAL_PROC]);
+            query->hw_wait      = mpp_clock_get_sum(dec->clocks[DEC_HW_WAIT]);
+        }
     } break;
     case MPP_DEC_SET_CFG: {
         MppDecCfgImpl *dec_cfg = (MppDecCfgImpl *)param;
@@ -376,6 +414,7 @@ void mpp_dec_put_frame(Mpp *mpp, RK_S32 index, HalDecTaskFlag flags)
         mpp_frame_copy(out, frame);
 
         mpp_dbg_pts("output frame pts %lld\n", mpp_frame_get_pts(out));
+        mpp_trace_point("display", mpp, mpp_frame_get_pts(out));
 
         list->lock();
         list->add_at_tail(&out, sizeof(out));
@@ -383,6 +422,10 @@ void mpp_dec_put_frame(Mpp *mpp, RK_S32 index, HalDecTaskFlag flags)
         list->signal();
         list->unlock();
 
+        mpp->signal_event(MPP_EVENT_OUTPUT_READY |
+                          ((mpp_frame_get_errinfo(out) || mpp_frame_get_discard(out)) ?
+                           MPP_EVENT_ERROR : 0));
+
         if (fake_frame)
             mpp_frame_deinit(&frame);
 
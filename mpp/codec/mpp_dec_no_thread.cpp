@@ -113,7 +113,13 @@ MPP_RET mpp_dec_decode(MppDec ctx, MppPacket packet)
         mpp_assert(slot_pkt >= 0);
         stream_size = mpp_packet_get_size(task_dec->input_packet);
 
-        mpp_buf_slot_get_prop(packet_slots, slot_pkt, SLOT_BUFFER, &hal_buf_in);
+        /* zero copy path: hal reads stream from input packet buffer */
+        hal_buf_in = dec_get_zero_copy_buf(task_dec->input_packet);
+        if (hal_buf_in)
+            mpp_buf_slot_set_prop(packet_slots, slot_pkt, SLOT_BUFFER, hal_buf_in);
+        else
+            mpp_buf_slot_get_prop(packet_slots, slot_pkt, SLOT_BUFFER, &hal_buf_in);
+
         if (NULL == hal_buf_in) {
             mpp_buffer_get(mpp->mPacketGroup, &hal_buf_in, stream_size);
             if (hal_buf_in) {
@@ -142,9 +148,14 @@ MPP_RET mpp_dec_decode(MppDec ctx, MppPacket packet)
         mpp_assert(task->hal_pkt_buf_in);
         mpp_assert(task_dec->input_packet);
 
-        dec_dbg_detail("detail: %p copy to hw length %d\n", dec, length);
-        mpp_buffer_write(task->hal_pkt_buf_in, 0, src, length);
-        mpp_buffer_sync_partial_end(task->hal_pkt_buf_in, 0, length);
+        if (task->hal_pkt_buf_in == mpp_packet_get_buffer(task_dec->input_packet)) {
+            dec_dbg_detail("detail: %p zero copy length %d\n", dec, length);
+            mpp_buffer_sync_end(task->hal_pkt_buf_in);
+        } else {
+            dec_dbg_detail("detail: %p copy to hw length %d\n", dec, length);
+            mpp_buffer_write(task->hal_pkt_buf_in, 0, src, length);
+            mpp_buffer_sync_partial_end(task->hal_pkt_buf_in, 0, length);
+        }
 
         mpp_buf_slot_set_flag(packet_slots, task_dec->input, SLOT_CODEC_READY);
         mpp_buf_slot_set_flag(packet_slots, task_dec->input, SLOT_HAL_INPUT);
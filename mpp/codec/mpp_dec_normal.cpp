@@ -18,6 +18,7 @@
 
 #include <string.h>
 
+#include "mpp_trace.h"
 #include "mpp_buffer_impl.h"
 
 #include "mpp_dec_debug.h"
@@ -39,6 +40,19 @@ static RK_S32 ts_cmp(void *priv, const struct list_head *a, const struct list_he
  * return MPP_OK for not wait
  * return MPP_NOK for wait
  */
+/* trace id is the output frame pts */
+static RK_S64 dec_trace_id(MppDecImpl *dec, RK_S32 index, RK_S64 start)
+{
+    MppFrame frame = NULL;
+
+    if (!start || index < 0)
+        return -1;
+
+    mpp_buf_slot_get_prop(dec->frame_slots, index, SLOT_FRAME_PTR, &frame);
+
+    return frame ? mpp_frame_get_pts(frame) : -1;
+}
+
 static MPP_RET check_task_wait(MppDecImpl *dec, DecTask *task)
 {
     MPP_RET ret = MPP_OK;
@@ -82,7 +96,11 @@ static MPP_RET check_task_wait(MppDecImpl *dec, DecTask *task)
     return ret;
 }
 
-static MPP_RET dec_release_task_in_port(MppPort port)
+/*
+ * own_pkt: packets in port are created by mpp on put_packet and should be
+ * released here whether they have MppBuffer or not.
+ */
+static MPP_RET dec_release_task_in_port(MppPort port, RK_U32 own_pkt)
 {
     MPP_RET ret = MPP_OK;
     MppPacket packet = NULL;
@@ -106,7 +124,7 @@ static MPP_RET dec_release_task_in_port(MppPort port)
             frame = NULL;
         }
         ret = mpp_task_meta_get_packet(mpp_task, KEY_INPUT_PACKET, &packet);
-        if (packet && NULL == mpp_packet_get_buffer(packet)) {
+        if (packet && (own_pkt || NULL == mpp_packet_get_buffer(packet))) {
             mpp_packet_deinit(&packet);
             packet = NULL;
         }
@@ -142,7 +160,7 @@ static RK_U32 reset_parser_thread(Mpp *mpp, DecTask *task)
     dec_dbg_reset("reset: parser reset start\n");
     dec_dbg_reset("reset: parser wait hal proc reset start\n");
 
-    dec_release_task_in_port(mpp->mMppInPort);
+    dec_release_task_in_port(mpp->mMppInPort, 1);
 
     mpp_assert(hal);
 
@@ -191,6 +209,10 @@ static RK_U32 reset_parser_thread(Mpp *mpp, DecTask *task)
         }
 
         dec_release_input_packet(dec, 1);
+        if (task->hal_pkt_buf_in) {
+            mpp_buffer_put(task->hal_pkt_buf_in);
+            task->hal_pkt_buf_in = NULL;
+        }
 
         while (MPP_OK == mpp_buf_slot_dequeue(frame_slots, &index, QUEUE_DISPLAY)) {
             /* release extra ref in slot's MppBuffer */
@@ -298,9 +320,11 @@ static MPP_RET try_get_input_packet(Mpp *mpp, DecTask *task)
     mpp_task_meta_get_packet(mpp_task, KEY_INPUT_PACKET, &packet);
     mpp_assert(packet);
 
-    /* when it is copy buffer return packet right here */
-    if (NULL == mpp_packet_get_buffer(packet))
-        mpp_port_enqueue(input, mpp_task);
+    /*
+     * packet is always owned by mpp after put_packet, even on zero copy path,
+     * so return the task right here
+     */
+    mpp_port_enqueue(input, mpp_task);
 
     dec->mpp_pkt_in = packet;
     mpp->mPacketGetCount++;
@@ -323,6 +347,8 @@ static MPP_RET try_proc_dec_task(Mpp *mpp, DecTask *task)
     MppBuffer hal_buf_out = NULL;
     size_t stream_size = 0;
     RK_S32 output = 0;
+    RK_S64 trace = 0;
+    RK_S64 trace_id = -1;
 
     /*
      * 1. get task handle from hal for parsing one frame
@@ -379,13 +405,21 @@ static MPP_RET try_proc_dec_task(Mpp *mpp, DecTask *task)
     if (!task->status.curr_task_rdy) {
         mpp_dbg_pts("input packet pts %lld\n", mpp_packet_get_pts(dec->mpp_pkt_in));
 
+        trace = mpp_trace_time();
         mpp_clock_start(dec->clocks[DEC_PRS_PREPARE]);
         mpp_parser_prepare(dec->parser, dec->mpp_pkt_in, task_dec);
         mpp_clock_pause(dec->clocks[DEC_PRS_PREPARE]);
+        mpp_trace_span("prepare", mpp, mpp_packet_get_pts(dec->mpp_pkt_in), trace);
         if (dec->cfg.base.sort_pts && task_dec->valid) {
             task->ts_cur.pts = mpp_packet_get_pts(dec->mpp_pkt_in);
             task->ts_cur.dts = mpp_packet_get_dts(dec->mpp_pkt_in);
         }
+        /* hold zero copy stream buffer before input packet is released */
+        if (task_dec->valid && !task->hal_pkt_buf_in) {
+            task->hal_pkt_buf_in = dec_get_zero_copy_buf(task_dec->input_packet);
+            if (task->hal_pkt_buf_in)
+                mpp_buffer_inc_ref(task->hal_pkt_buf_in);
+        }
         dec_release_input_packet(dec, 0);
     }
 
@@ -420,7 +454,13 @@ static MPP_RET try_proc_dec_task(Mpp *mpp, DecTask *task)
      */
     stream_size = mpp_packet_get_size(task_dec->input_packet);
 
-    mpp_buf_slot_get_prop(packet_slots, task_dec->input, SLOT_BUFFER, &hal_buf_in);
+    if (task->hal_pkt_buf_in) {
+        /* zero copy path: hal reads stream from input packet buffer */
+        hal_buf_in = task->hal_pkt_buf_in;
+        mpp_buf_slot_set_prop(packet_slots, task_dec->input, SLOT_BUFFER, hal_buf_in);
+    } else
+        mpp_buf_slot_get_prop(packet_slots, task_dec->input, SLOT_BUFFER, &hal_buf_in);
+
     if (NULL == hal_buf_in) {
         mpp_buffer_get(mpp->mPacketGroup, &hal_buf_in, stream_size);
         if (hal_buf_in) {
@@ -440,11 +480,18 @@ static MPP_RET try_proc_dec_task(Mpp *mpp, DecTask *task)
      * 6. copy prepared stream to hardware buffer
      */
     if (!task->status.dec_pkt_copy_rdy) {
-        void *src = mpp_packet_get_data(task_dec->input_packet);
-        size_t length = mpp_packet_get_length(task_dec->input_packet);
+        if (task->hal_pkt_buf_in) {
+            mpp_buffer_sync_end(hal_buf_in);
+            /* slot keeps the buffer reference until SLOT_HAL_INPUT clear */
+            mpp_buffer_put(task->hal_pkt_buf_in);
+            task->hal_pkt_buf_in = NULL;
+        } else {
+            void *src = mpp_packet_get_data(task_dec->input_packet);
+            size_t length = mpp_packet_get_length(task_dec->input_packet);
 
-        mpp_buffer_write(hal_buf_in, 0, src, length);
-        mpp_buffer_sync_partial_end(hal_buf_in, 0, length);
+            mpp_buffer_write(hal_buf_in, 0, src, length);
+            mpp_buffer_sync_partial_end(hal_buf_in, 0, length);
+        }
         mpp_buf_slot_set_flag(packet_slots, task_dec->input, SLOT_CODEC_READY);
         mpp_buf_slot_set_flag(packet_slots, task_dec->input, SLOT_HAL_INPUT);
         task->status.dec_pkt_copy_rdy = 1;
@@ -506,9 +553,11 @@ static MPP_RET try_proc_dec_task(Mpp *mpp, DecTask *task)
      *    4. detect whether output index has MppBuffer and task valid
      */
     if (!task->status.task_parsed_rdy) {
+        trace = mpp_trace_time();
         mpp_clock_start(dec->clocks[DEC_PRS_PARSE]);
         mpp_parser_parse(dec->parser, task_dec);
         mpp_clock_pause(dec->clocks[DEC_PRS_PARSE]);
+        mpp_trace_span("parse", mpp, dec_trace_id(dec, task_dec->output, trace), trace);
         task->status.task_parsed_rdy = 1;
     }
 
@@ -640,14 +689,19 @@ static MPP_RET try_proc_dec_task(Mpp *mpp, DecTask *task)
     }
 
     /* generating registers table */
+    trace = mpp_trace_time();
+    trace_id = dec_trace_id(dec, output, trace);
     mpp_clock_start(dec->clocks[DEC_HAL_GEN_REG]);
     mpp_hal_reg_gen(dec->hal, &task->info);
     mpp_clock_pause(dec->clocks[DEC_HAL_GEN_REG]);
+    mpp_trace_span("gen_reg", mpp, trace_id, trace);
 
     /* send current register set to hardware */
+    trace = mpp_trace_time();
     mpp_clock_start(dec->clocks[DEC_HW_START]);
     mpp_hal_hw_start(dec->hal, &task->info);
     mpp_clock_pause(dec->clocks[DEC_HW_START]);
+    mpp_trace_span("hw_start", mpp, trace_id, trace);
 
     /*
      * 12. send dxva output information and buffer information to hal thread
@@ -656,7 +710,8 @@ static MPP_RET try_proc_dec_task(Mpp *mpp, DecTask *task)
     mpp_dec_put_task(mpp, task);
 
     task->wait.dec_all_done = (dec->parser_fast_mode &&
-                               task_dec->flags.wait_done) ? 1 : 0;
+                               task_dec->flags.wait_done &&
+                               !task_dec->flags.wait_async) ? 1 : 0;
 
     task->status.dec_pkt_copy_rdy  = 0;
     task->status.curr_task_rdy  = 0;
@@ -743,8 +798,12 @@ void *mpp_dec_parser_thread(void *data)
         mpp_buf_slot_set_flag(packet_slots, task_dec->input, SLOT_HAL_INPUT);
         mpp_buf_slot_clr_flag(packet_slots, task_dec->input, SLOT_HAL_INPUT);
     }
+    if (task.hal_pkt_buf_in) {
+        mpp_buffer_put(task.hal_pkt_buf_in);
+        task.hal_pkt_buf_in = NULL;
+    }
     mpp_buffer_group_clear(mpp->mPacketGroup);
-    dec_release_task_in_port(mpp->mMppInPort);
+    dec_release_task_in_port(mpp->mMppInPort, 1);
     mpp_dbg_info("mpp_dec_parser_thread exited\n");
     return NULL;
 }
@@ -761,6 +820,7 @@ void *mpp_dec_hal_thread(void *data)
     HalTaskHnd  task = NULL;
     HalTaskInfo task_info;
     HalDecTask  *task_dec = &task_info.dec;
+    RK_S64 trace = 0;
 
     mpp_clock_start(dec->clocks[DEC_HAL_TOTAL]);
 
@@ -838,9 +898,11 @@ void *mpp_dec_hal_thread(void *data)
                 continue;
             }
 
+            trace = mpp_trace_time();
             mpp_clock_start(dec->clocks[DEC_HW_WAIT]);
             mpp_hal_hw_wait(dec->hal, &task_info);
             mpp_clock_pause(dec->clocks[DEC_HW_WAIT]);
+            mpp_trace_span("hw_wait", mpp, dec_trace_id(dec, task_dec->output, trace), trace);
             dec->dec_hw_run_count++;
 
             /*
@@ -1078,9 +1140,9 @@ void *mpp_dec_advanced_thread(void *data)
     }
 
     // clear remain task in output port
-    dec_release_task_in_port(input);
-    dec_release_task_in_port(mpp->mUsrInPort);
-    dec_release_task_in_port(mpp->mUsrOutPort);
+    dec_release_task_in_port(input, 0);
+    dec_release_task_in_port(mpp->mUsrInPort, 0);
+    dec_release_task_in_port(mpp->mUsrOutPort, 0);
 
     return NULL;
 }
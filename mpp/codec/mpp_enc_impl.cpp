@@ -21,6 +21,7 @@
 #include <limits.h>
 
 #include "mpp_time.h"
+#include "mpp_trace.h"
 #include "mpp_common.h"
 
 #include "mpp_frame_impl.h"
@@ -528,6 +529,7 @@ MPP_RET mpp_enc_callback(const char *caller, void *ctx, RK_S32 cmd, void *param)
                 pkt_out->add_at_tail(&impl, sizeof(impl));
                 mpp->mPacketPutCount++;
                 pkt_out->signal();
+                mpp->signal_event(MPP_EVENT_OUTPUT_READY);
             }
         }
     } break;
@@ -958,6 +960,8 @@ MPP_RET mpp_enc_proc_cfg(MppEncImpl *enc, MpiCmd cmd, void *param)
         ret_tmp = enc_impl_proc_cfg(enc->impl, cmd, param);
         if (ret_tmp != MPP_OK)
             ret = ret_tmp;
+
+        impl->dirty = 0;
     } break;
     case MPP_ENC_SET_RC_CFG : {
         MppEncRcCfg *src = (MppEncRcCfg *)param;
@@ -1393,6 +1397,12 @@ MPP_RET mpp_enc_proc_rc_update(MppEncImpl *enc)
         goto TASK_DONE;                                 \
     }
 
+/* trace id is the input frame pts */
+static RK_S64 enc_trace_id(HalEncTask *task)
+{
+    return task->frame ? mpp_frame_get_pts(task->frame) : -1;
+}
+
 static MPP_RET mpp_enc_check_frm_pkt(MppEncImpl *enc)
 {
     enc->frm_buf = NULL;
@@ -1609,6 +1619,7 @@ static MPP_RET mpp_enc_normal(Mpp *mpp, EncAsyncTaskInfo *task)
     EncCpbStatus *cpb = &rc_task->cpb;
     EncFrmStatus *frm = &rc_task->frm;
     HalEncTask *hal_task = &task->task;
+    RK_S64 trace = 0;
     MPP_RET ret = MPP_OK;
 
     if (enc->support_hw_deflicker && enc->cfg.rc.debreath_en) {
@@ -1649,15 +1660,21 @@ static MPP_RET mpp_enc_normal(Mpp *mpp, EncAsyncTaskInfo *task)
     ENC_RUN_FUNC2(rc_hal_start, enc->rc_ctx, rc_task, mpp, ret);
 
     enc_dbg_detail("task %d hal generate reg\n", frm->seq_idx);
+    trace = mpp_trace_time();
     ENC_RUN_FUNC2(mpp_enc_hal_gen_regs, hal, hal_task, mpp, ret);
+    mpp_trace_span("enc_gen_reg", mpp, enc_trace_id(hal_task), trace);
 
     hal_task->segment_nb = mpp_packet_get_segment_nb(hal_task->packet);
     mpp_stopwatch_record(hal_task->stopwatch, "encode hal start");
     enc_dbg_detail("task %d hal start\n", frm->seq_idx);
+    trace = mpp_trace_time();
     ENC_RUN_FUNC2(mpp_enc_hal_start, hal, hal_task, mpp, ret);
+    mpp_trace_span("enc_hw_start", mpp, enc_trace_id(hal_task), trace);
 
     enc_dbg_detail("task %d hal wait\n", frm->seq_idx);
+    trace = mpp_trace_time();
     ENC_RUN_FUNC2(mpp_enc_hal_wait,  hal, hal_task, mpp, ret);
+    mpp_trace_span("enc_hw_wait", mpp, enc_trace_id(hal_task), trace);
 
     mpp_stopwatch_record(hal_task->stopwatch, "encode hal finish");
 
@@ -1697,6 +1714,7 @@ static MPP_RET mpp_enc_reenc_simple(Mpp *mpp, EncAsyncTaskInfo *task)
     EncRcTask *rc_task = &task->rc;
     EncFrmStatus *frm = &rc_task->frm;
     HalEncTask *hal_task = &task->task;
+    RK_S64 trace = 0;
     MPP_RET ret = MPP_OK;
 
     enc_dbg_func("enter\n");
@@ -1713,13 +1731,19 @@ static MPP_RET mpp_enc_reenc_simple(Mpp *mpp, EncAsyncTaskInfo *task)
     ENC_RUN_FUNC2(rc_hal_start, enc->rc_ctx, rc_task, mpp, ret);
 
     enc_dbg_detail("task %d hal generate reg\n", frm->seq_idx);
+    trace = mpp_trace_time();
     ENC_RUN_FUNC2(mpp_enc_hal_gen_regs, hal, hal_task, mpp, ret);
+    mpp_trace_span("enc_gen_reg", mpp, enc_trace_id(hal_task), trace);
 
     enc_dbg_detail("task %d hal start\n", frm->seq_idx);
+    trace = mpp_trace_time();
     ENC_RUN_FUNC2(mpp_enc_hal_start, hal, hal_task, mpp, ret);
+    mpp_trace_span("enc_hw_start", mpp, enc_trace_id(hal_task), trace);
 
     enc_dbg_detail("task %d hal wait\n", frm->seq_idx);
+    trace = mpp_trace_time();
     ENC_RUN_FUNC2(mpp_enc_hal_wait,  hal, hal_task, mpp, ret);
+    mpp_trace_span("enc_hw_wait", mpp, enc_trace_id(hal_task), trace);
 
     enc_dbg_detail("task %d rc hal end\n", frm->seq_idx);
     ENC_RUN_FUNC2(rc_hal_end, enc->rc_ctx, rc_task, mpp, ret);
@@ -2023,6 +2047,7 @@ static MPP_RET try_proc_low_deley_task(Mpp *mpp, EncAsyncTaskInfo *task, EncAsyn
     EncAsyncStatus *status = &task->status;
     HalEncTask *hal_task = &task->task;
     MppPacket packet = hal_task->packet;
+    RK_S64 trace = 0;
     MPP_RET ret = MPP_OK;
 
     if (hal_task->flags.drop_by_fps)
@@ -2053,7 +2078,9 @@ static MPP_RET try_proc_low_deley_task(Mpp *mpp, EncAsyncTaskInfo *task, EncAsyn
     ENC_RUN_FUNC2(rc_hal_start, enc->rc_ctx, rc_task, mpp, ret);
 
     enc_dbg_detail("task %d hal generate reg\n", frm->seq_idx);
+    trace = mpp_trace_time();
     ENC_RUN_FUNC2(mpp_enc_hal_gen_regs, hal, hal_task, mpp, ret);
+    mpp_trace_span("enc_gen_reg", mpp, enc_trace_id(hal_task), trace);
 
     hal_task->part_first = 0;
     hal_task->part_last = 0;
@@ -2481,6 +2508,7 @@ static void async_task_terminate(MppEncImpl *enc, EncAsyncTaskInfo *async)
             pkt_out->add_at_tail(&pkt, sizeof(pkt));
             mpp->mPacketPutCount++;
             pkt_out->signal();
+            mpp->signal_event(MPP_EVENT_OUTPUT_READY);
             mpp_assert(pkt);
 
             enc_dbg_detail("packet out ready\n");
@@ -2500,6 +2528,7 @@ static void async_task_skip(MppEncImpl *enc)
 
     mpp->mFrmIn->del_at_head(&frm, sizeof(frm));
     mpp->mFrameGetCount++;
+    mpp->signal_event(MPP_EVENT_INPUT_SPACE);
 
     mpp_assert(frm);
 
@@ -2541,6 +2570,7 @@ static void async_task_skip(MppEncImpl *enc)
         pkt_out->add_at_tail(&pkt, sizeof(pkt));
         mpp->mPacketPutCount++;
         pkt_out->signal();
+        mpp->signal_event(MPP_EVENT_OUTPUT_READY);
         pkt_out->unlock();
     }
 
@@ -2666,6 +2696,7 @@ static MPP_RET try_get_async_task(MppEncImpl *enc, EncAsyncWait *wait)
             if (frm_in->list_size()) {
                 frm_in->del_at_head(&frame, sizeof(frame));
                 frm_in->signal();
+                mpp->signal_event(MPP_EVENT_INPUT_SPACE);
                 mpp->mFrameGetCount++;
 
                 mpp_assert(frame);
@@ -2847,6 +2878,7 @@ static MPP_RET proc_async_task(MppEncImpl *enc)
     EncCpbStatus *cpb = &rc_task->cpb;
     EncFrmStatus *frm = &rc_task->frm;
     RK_U32 seq_idx = async->seq_idx;
+    RK_S64 trace = 0;
     MPP_RET ret = MPP_OK;
 
     mpp_assert(hal_task->valid);
@@ -2876,11 +2908,15 @@ static MPP_RET proc_async_task(MppEncImpl *enc)
     ENC_RUN_FUNC2(rc_hal_start, enc->rc_ctx, rc_task, mpp, ret);
 
     enc_dbg_detail("task %d hal generate reg\n", frm->seq_idx);
+    trace = mpp_trace_time();
     ENC_RUN_FUNC2(mpp_enc_hal_gen_regs, hal, hal_task, mpp, ret);
+    mpp_trace_span("enc_gen_reg", mpp, enc_trace_id(hal_task), trace);
 
     mpp_stopwatch_record(hal_task->stopwatch, "encode hal start");
     enc_dbg_detail("task %d hal start\n", frm->seq_idx);
+    trace = mpp_trace_time();
     ENC_RUN_FUNC2(mpp_enc_hal_start, hal, hal_task, mpp, ret);
+    mpp_trace_span("enc_hw_start", mpp, enc_trace_id(hal_task), trace);
 
 SEND_TASK_INFO:
     status->enc_done = 0;
@@ -2947,13 +2983,16 @@ static MPP_RET enc_async_wait_task(MppEncImpl *enc, EncAsyncTaskInfo *info)
     EncRcTask *rc_task = hal_task->rc_task;
     EncFrmStatus *frm = &info->rc.frm;
     MppPacket pkt = hal_task->packet;
+    RK_S64 trace = 0;
     MPP_RET ret = MPP_OK;
 
     if (hal_task->flags.drop_by_fps)
         goto TASK_DONE;
 
     enc_dbg_detail("task %d hal wait\n", frm->seq_idx);
+    trace = mpp_trace_time();
     ENC_RUN_FUNC2(mpp_enc_hal_wait, hal, hal_task, mpp, ret);
+    mpp_trace_span("enc_hw_wait", mpp, enc_trace_id(hal_task), trace);
 
     mpp_stopwatch_record(hal_task->stopwatch, "encode hal finish");
 
@@ -2995,6 +3034,7 @@ TASK_DONE:
         enc->enc_failed_drop = 1;
 
         mpp_err_f("enc failed force idr!\n");
+        mpp->signal_event(MPP_EVENT_ERROR);
     } else
         set_enc_info_to_packet(enc, hal_task);
 
@@ -3006,6 +3046,7 @@ TASK_DONE:
         pkt_out->add_at_tail(&pkt, sizeof(pkt));
         mpp->mPacketPutCount++;
         pkt_out->signal();
+        mpp->signal_event(MPP_EVENT_OUTPUT_READY);
     }
 
     return ret;
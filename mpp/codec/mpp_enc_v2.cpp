@@ -355,6 +355,7 @@ MPP_RET mpp_enc_control_v2(MppEnc ctx, MpiCmd cmd, void *param)
         cfg->codec.change = 0;
         cfg->split.change = 0;
         cfg->tune.change = 0;
+        p->dirty = 0;
     } break;
     case MPP_ENC_GET_PREP_CFG : {
         enc_dbg_ctrl("get prep config\n");
@@ -376,6 +377,13 @@ MPP_RET mpp_enc_control_v2(MppEnc ctx, MpiCmd cmd, void *param)
         enc_dbg_ctrl("get osd plt cfg\n");
         memcpy(param, &enc->cfg.plt_cfg, sizeof(enc->cfg.plt_cfg));
     } break;
+    case MPP_ENC_SET_CFG :
+        /* nothing updated since last apply, skip the encoder thread round trip */
+        if (!((MppEncCfgImpl *)param)->dirty) {
+            enc_dbg_ctrl("skip clean config\n");
+            break;
+        }
+        /* fall through */
     default : {
         // Cmd which is not get configure will handle by enc_impl
         enc->cmd = cmd;
@@ -224,6 +224,8 @@ typedef struct _DXVA_PicParams_AV1 {
     RK_U8 refresh_frame_flags;
     void         *cdfs;
     void          *cdfs_ndvc;
+    /* q context of the default cdfs when cdfs is a shared default image, else -1 */
+    RK_S8         cdfs_default_idx;
     RK_U8 tile_cols_log2;
 } DXVA_PicParams_AV1, *LPDXVA_PicParams_AV1;
 
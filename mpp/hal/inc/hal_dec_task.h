@@ -63,7 +63,8 @@ typedef union HalDecTaskFlag_t {
         RK_U32      used_for_ref     : 1;
 
         RK_U32      wait_done        : 1;
-        RK_U32      reserved0        : 1;
+        /* parser syncs with the wait_done callback itself */
+        RK_U32      wait_async       : 1;
         RK_U32      ref_info_valid   : 1;
         RK_U32      ref_miss         : 16;
         RK_U32      ref_used         : 16;
@@ -22,6 +22,12 @@
 #include "vp9d_syntax.h"
 #include "hal_vp9d_com.h"
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#endif
+
 typedef struct {
     RK_U8 y_mode[4][9];
     RK_U8 uv_mode[10][9];
@@ -1922,10 +1928,56 @@ MPP_RET hal_vp9d_prob_flag_delta(void *buf, void *dxva)
     return 0;
 }
 
+/*
+ * Hardware writes one record of 5 words for each coefficient context:
+ * { more_coef + eob, more_coef, zero, one, two_or_more }
+ * Split the records into eob counts { neob, eob - neob } and coef counts.
+ */
+void hal_vp9d_update_coef_counts(RK_U32 *eob, RK_U32 *coef, const RK_U32 *src, RK_S32 count)
+{
+    RK_S32 i;
+
+#if defined(__SSE2__)
+    const __m128i mask = _mm_set_epi32(0, 0, -1, 0);
+
+    for (i = 0; i < count; i++, src += 5, eob += 2, coef += 3) {
+        __m128i v = _mm_loadu_si128((const __m128i *)src);
+        /* { e1, e0, c0, c1 } - { 0, e1, 0, 0 } */
+        __m128i a = _mm_shuffle_epi32(v, _MM_SHUFFLE(3, 2, 0, 1));
+        __m128i b = _mm_and_si128(_mm_shuffle_epi32(v, _MM_SHUFFLE(0, 0, 1, 0)), mask);
+
+        v = _mm_sub_epi32(a, b);
+        _mm_storel_epi64((__m128i *)eob, v);
+        _mm_storel_epi64((__m128i *)coef, _mm_unpackhi_epi64(v, v));
+        coef[2] = src[4];
+    }
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+    const uint32x2_t mask = vcreate_u32(0xffffffff00000000ULL);
+
+    for (i = 0; i < count; i++, src += 5, eob += 2, coef += 3) {
+        uint32x4_t v = vld1q_u32(src);
+        uint32x2_t e = vget_low_u32(v);
+
+        /* { e1, e0 } - { 0, e1 } */
+        vst1_u32(eob, vsub_u32(vrev64_u32(e), vand_u32(e, mask)));
+        vst1_u32(coef, vget_high_u32(v));
+        coef[2] = src[4];
+    }
+#else
+    for (i = 0; i < count; i++, src += 5, eob += 2, coef += 3) {
+        eob[0] = src[1];
+        eob[1] = src[0] - src[1];
+        coef[0] = src[2];
+        coef[1] = src[3];
+        coef[2] = src[4];
+    }
+#endif
+}
+
 void hal_vp9d_update_counts(void *buf, void *dxva)
 {
     DXVA_PicParams_VP9 *s = (DXVA_PicParams_VP9*)dxva;
-    RK_S32 i, j, m, n, k;
+    RK_S32 i, j, m;
     RK_U32 *eob_coef;
     RK_S32 ref_type;
 #ifdef dump
@@ -1955,19 +2007,14 @@ void hal_vp9d_update_counts(void *buf, void *dxva)
         memset(s->counts.eob, 0, sizeof(s->counts.eob));
         memset(s->counts.coef, 0, sizeof(s->counts.coef));
     }
+    /* the 6x6 band / context records of one tx size / plane / ref are continuous */
     for (i = 0; i < ref_type; i++) {
         for (j = 0; j < 4; j++) {
             for (m = 0; m < 2; m++) {
-                for (n = 0; n < 6; n++) {
-                    for (k = 0; k < 6; k++) {
-                        s->counts.eob[j][m][i][n][k][0] = eob_coef[1];
-                        s->counts.eob[j][m][i][n][k][1] = eob_coef[0] - eob_coef[1]; //ffmpeg need do  branch_ct[UNCONSTRAINED_NODES][2] =  { neob, eob_counts[i][j][k][l] - neob },
-                        s->counts.coef[j][m][i][n][k][0] = eob_coef[2];
-                        s->counts.coef[j][m][i][n][k][1] = eob_coef[3];
-                        s->counts.coef[j][m][i][n][k][2] = eob_coef[4];
-                        eob_coef += 5;
-                    }
-                }
+                hal_vp9d_update_coef_counts(&s->counts.eob[j][m][i][0][0][0],
+                                            &s->counts.coef[j][m][i][0][0][0],
+                                            eob_coef, 6 * 6);
+                eob_coef += 6 * 6 * 5;
             }
         }
     }
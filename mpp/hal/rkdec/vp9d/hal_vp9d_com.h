@@ -90,6 +90,7 @@ RK_U32 vp9_hor_align(RK_U32 val);
 MPP_RET hal_vp9d_output_probe(void *buf, void *dxva);
 MPP_RET hal_vp9d_prob_flag_delta(void *buf, void *dxva);
 void hal_vp9d_update_counts(void *buf, void *dxva);
+void hal_vp9d_update_coef_counts(RK_U32 *eob, RK_U32 *coef, const RK_U32 *src, RK_S32 count);
 MPP_RET hal_vp9d_prob_default(void *buf, void *dxva);
 
 #ifdef __cplusplus
@@ -1040,7 +1040,14 @@ static MPP_RET hal_vp9d_vdpu382_wait(void *hal, HalTaskInfo *task)
         DXVA_PicParams_VP9 *pic_param = (DXVA_PicParams_VP9*)task->dec.syntax.data;
         hal_vp9d_update_counts(mpp_buffer_get_ptr(hw_ctx->count_base), task->dec.syntax.data);
         mpp_callback(p_hal->dec_cb, &pic_param->counts);
+    } else if (p_hal->dec_cb && task->dec.flags.wait_async) {
+        /* registers are not generated, only release the parser wait */
+        mpp_callback(p_hal->dec_cb, NULL);
     }
+#else
+    /* probabilities are adapted by hardware, only release the parser wait */
+    if (p_hal->dec_cb && (task->dec.flags.wait_done || task->dec.flags.wait_async))
+        mpp_callback(p_hal->dec_cb, NULL);
 #endif
     if (p_hal->fast_mode) {
         hw_ctx->g_buf[task->dec.reg_index].use_flag = 0;
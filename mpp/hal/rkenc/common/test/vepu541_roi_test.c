@@ -0,0 +1,270 @@
+/*
+ * Copyright 2024 Rockchip Electronics Co. LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#define MODULE_TAG "vepu541_roi_test"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "mpp_mem.h"
+#include "mpp_log.h"
+#include "mpp_common.h"
+
+#include "vepu541_common.h"
+
+/*
+ * Write a sequence of roi configs with vepu541_set_roi_diff into one buffer
+ * and check the buffer after each step against a fresh vepu541_set_roi
+ * write into a buffer filled with garbage.
+ */
+
+#define RANDOM_STEP_COUNT   1000
+
+typedef struct RoiStep_t {
+    const char          *name;
+    RK_U32              number;
+    MppEncROIRegion     regions[VEPU541_MAX_ROI_NUM];
+} RoiStep;
+
+/* x y w h intra quality qp_area_idx area_map_en abs_qp_en */
+static const RoiStep roi_steps[] = {
+    {
+        "two overlapping regions", 2, {
+            { 16, 16, 256, 128, 0, -8, 0, 1, 0 },
+            { 128, 64, 256, 128, 1, 30, 1, 1, 1 },
+        },
+    },
+    {
+        "add region over both", 3, {
+            { 16, 16, 256, 128, 0, -8, 0, 1, 0 },
+            { 128, 64, 256, 128, 1, 30, 1, 1, 1 },
+            { 64, 32, 512, 64, 0, 4, 2, 1, 0 },
+        },
+    },
+    {
+        "move middle region down", 3, {
+            { 16, 16, 256, 128, 0, -8, 0, 1, 0 },
+            { 136, 400, 256, 128, 1, 30, 1, 1, 1 },
+            { 64, 32, 512, 64, 0, 4, 2, 1, 0 },
+        },
+    },
+    {
+        "change qp without moving", 3, {
+            { 16, 16, 256, 128, 0, -12, 0, 1, 0 },
+            { 136, 400, 256, 128, 1, 30, 1, 1, 1 },
+            { 64, 32, 512, 64, 0, 4, 2, 1, 0 },
+        },
+    },
+    {
+        "remove last region", 2, {
+            { 16, 16, 256, 128, 0, -12, 0, 1, 0 },
+            { 136, 400, 256, 128, 1, 30, 1, 1, 1 },
+        },
+    },
+    {
+        "unchanged regions", 2, {
+            { 16, 16, 256, 128, 0, -12, 0, 1, 0 },
+            { 136, 400, 256, 128, 1, 30, 1, 1, 1 },
+        },
+    },
+    {
+        "swap region order", 2, {
+            { 136, 400, 256, 128, 1, 30, 1, 1, 1 },
+            { 16, 16, 256, 128, 0, -12, 0, 1, 0 },
+        },
+    },
+    {
+        "remove all regions", 0, {
+            { 0 },
+        },
+    },
+    {
+        "unaligned edge regions", 2, {
+            { 0, 0, 17, 15, 0, 20, 0, 1, 1 },
+            { 1890, 1070, 30, 10, 1, -4, 3, 1, 0 },
+        },
+    },
+    {
+        "invalid region out of picture", 1, {
+            { 1900, 0, 64, 64, 0, 0, 0, 1, 0 },
+        },
+    },
+    {
+        "full picture region", 1, {
+            { 0, 0, 1920, 1080, 0, 2, 0, 1, 0 },
+        },
+    },
+};
+
+static MPP_RET check_step(const char *name, MppEncROICfg *roi, RK_S32 w, RK_S32 h,
+                          RK_U8 *diff_buf, RK_U8 *full_buf, RK_S32 size,
+                          RK_S32 cfg_size, Vepu541RoiPrev *prev)
+{
+    MPP_RET ret_diff;
+    MPP_RET ret_full;
+    RK_S32 i;
+
+    ret_diff = vepu541_set_roi_diff(diff_buf, roi, w, h, prev);
+
+    memset(full_buf, 0xa5, size);
+    ret_full = vepu541_set_roi(full_buf, roi, w, h);
+
+    if ((ret_diff != MPP_OK) != (ret_full != MPP_OK)) {
+        mpp_err("%s diff ret %d mismatch full ret %d\n", name, ret_diff, ret_full);
+        return MPP_NOK;
+    }
+
+    /* the hardware access padding after the mb config is not written */
+    for (i = 0; i < cfg_size; i++) {
+        if (diff_buf[i] != full_buf[i]) {
+            mpp_err("%s mismatch at byte %d of %d\n", name, i, cfg_size);
+            return MPP_NOK;
+        }
+    }
+
+    return MPP_OK;
+}
+
+static void random_region(MppEncROIRegion *region, RK_S32 w, RK_S32 h)
+{
+    region->x = rand() % (w - 1);
+    region->y = rand() % (h - 1);
+    region->w = 1 + rand() % (w - region->x);
+    region->h = 1 + rand() % (h - region->y);
+    region->intra = rand() & 1;
+    region->abs_qp_en = rand() & 1;
+    region->quality = region->abs_qp_en ? rand() % 52 : rand() % 103 - 51;
+    region->qp_area_idx = rand() % VEPU541_MAX_ROI_NUM;
+    region->area_map_en = 1;
+}
+
+/* add, remove, move or change one region of the previous step */
+static void random_step(MppEncROICfg *roi, RK_S32 w, RK_S32 h)
+{
+    MppEncROIRegion *region;
+
+    switch (rand() % 4) {
+    case 0 : {
+        if (roi->number < VEPU541_MAX_ROI_NUM) {
+            random_region(&roi->regions[roi->number], w, h);
+            roi->number++;
+        }
+    } break;
+    case 1 : {
+        if (roi->number) {
+            RK_U32 idx = rand() % roi->number;
+
+            memmove(&roi->regions[idx], &roi->regions[idx + 1],
+                    (roi->number - idx - 1) * sizeof(*region));
+            roi->number--;
+        }
+    } break;
+    case 2 : {
+        if (roi->number) {
+            region = &roi->regions[rand() % roi->number];
+            region->x = rand() % (w - region->w + 1);
+            region->y = rand() % (h - region->h + 1);
+        }
+    } break;
+    default : {
+        if (roi->number) {
+            region = &roi->regions[rand() % roi->number];
+            region->abs_qp_en = 0;
+            region->quality = rand() % 103 - 51;
+        }
+    } break;
+    }
+}
+
+static MPP_RET test_size(RK_S32 w, RK_S32 h)
+{
+    MppEncROIRegion regions[VEPU541_MAX_ROI_NUM];
+    MppEncROICfg roi;
+    Vepu541RoiPrev prev;
+    RK_S32 size = vepu541_get_roi_buf_size(w, h);
+    RK_S32 cfg_size = MPP_ALIGN(w, 64) / 16 * MPP_ALIGN(h, 64) / 16 *
+                      sizeof(Vepu541RoiCfg);
+    RK_U8 *diff_buf = mpp_malloc(RK_U8, size);
+    RK_U8 *full_buf = mpp_malloc(RK_U8, size);
+    MPP_RET ret = MPP_NOK;
+    RK_U32 i;
+
+    mpp_log("roi diff test size %dx%d buffer %d\n", w, h, size);
+
+    if (!diff_buf || !full_buf)
+        goto DONE;
+
+    memset(&prev, 0, sizeof(prev));
+    memset(diff_buf, 0x5a, size);
+    roi.regions = regions;
+
+    /* fixed steps are designed for 1080p only */
+    for (i = 0; w == 1920 && h == 1080 && i < MPP_ARRAY_ELEMS(roi_steps); i++) {
+        roi.number = roi_steps[i].number;
+        memcpy(regions, roi_steps[i].regions, sizeof(regions));
+
+        ret = check_step(roi_steps[i].name, &roi, w, h, diff_buf, full_buf, size,
+                         cfg_size, &prev);
+        if (ret)
+            goto DONE;
+
+        mpp_log("step %-30s rows [%3d:%3d] rewritten\n", roi_steps[i].name,
+                prev.row_start, prev.row_end);
+    }
+
+    srand(w * h);
+    roi.number = 0;
+
+    for (i = 0; i < RANDOM_STEP_COUNT; i++) {
+        random_step(&roi, w, h);
+
+        /* buffer written by other function */
+        if (i % 97 == 96) {
+            memset(diff_buf, 0x5a, size);
+            prev.buf = NULL;
+        }
+
+        ret = check_step("random step", &roi, w, h, diff_buf, full_buf, size,
+                         cfg_size, &prev);
+        if (ret) {
+            mpp_err("random step %d with %d regions failed\n", i, roi.number);
+            goto DONE;
+        }
+    }
+
+    ret = MPP_OK;
+DONE:
+    MPP_FREE(diff_buf);
+    MPP_FREE(full_buf);
+    return ret;
+}
+
+int main()
+{
+    MPP_RET ret;
+
+    mpp_log("vepu541 roi test start\n");
+
+    ret = test_size(1920, 1080);
+    if (!ret)
+        ret = test_size(100, 60);
+    if (!ret)
+        ret = test_size(4096, 2304);
+
+    mpp_log("vepu541 roi test %s\n", ret ? "failed" : "success");
+
+    return ret;
+}
@@ -348,6 +348,84 @@ RK_S32 vepu541_get_roi_buf_size(RK_S32 w, RK_S32 h)
     return buf_size + 32;
 }
 
+static void roi_default_cfg(Vepu541RoiCfg *cfg)
+{
+    cfg->force_intra = 0;
+    cfg->reserved    = 0;
+    cfg->qp_area_idx = 0;
+    cfg->qp_area_en  = 1;
+    cfg->qp_adj      = 0;
+    cfg->qp_adj_mode = 0;
+}
+
+static void roi_region_cfg(MppEncROIRegion *region, Vepu541RoiCfg *cfg)
+{
+    cfg->force_intra = region->intra;
+    cfg->reserved    = 0;
+    cfg->qp_area_idx = region->qp_area_idx;
+    // NOTE: When roi is enabled the qp_area_en should be one.
+    cfg->qp_area_en  = 1;    // region->area_map_en;
+    cfg->qp_adj      = region->quality;
+    cfg->qp_adj_mode = region->abs_qp_en;
+}
+
+/* region position in mb clipped to the mb_w x mb_h picture */
+static void roi_region_rect(MppEncROIRegion *region, RK_S32 mb_w, RK_S32 mb_h,
+                            RK_S32 *x0, RK_S32 *x1, RK_S32 *y0, RK_S32 *y1)
+{
+    RK_S32 pos_x_init = region->x / 16;
+    RK_S32 pos_y_init = region->y / 16;
+
+    *x1 = MPP_MIN(pos_x_init + (region->w + 15) / 16, mb_w);
+    *y1 = MPP_MIN(pos_y_init + (region->h + 15) / 16, mb_h);
+    *x0 = MPP_MAX(pos_x_init, 0);
+    *y0 = MPP_MAX(pos_y_init, 0);
+}
+
+static MPP_RET roi_check(MppEncROICfg *roi, RK_S32 w, RK_S32 h)
+{
+    MppEncROIRegion *region = roi->regions;
+    MPP_RET ret = MPP_OK;
+    RK_S32 i;
+
+    if (w <= 0 || h <= 0) {
+        mpp_err_f("invalid size [%d:%d]\n", w, h);
+        return MPP_NOK;
+    }
+
+    if (roi->number > VEPU541_MAX_ROI_NUM) {
+        mpp_err_f("invalid region number %d\n", roi->number);
+        return MPP_NOK;
+    }
+
+    /* check region config */
+    for (i = 0; i < (RK_S32)roi->number; i++, region++) {
+        if (region->x + region->w > w || region->y + region->h > h)
+            ret = MPP_NOK;
+
+        if (region->intra > 1 || region->qp_area_idx >= VEPU541_MAX_ROI_NUM ||
+            region->area_map_en > 1 || region->abs_qp_en > 1)
+            ret = MPP_NOK;
+
+        if ((region->abs_qp_en && region->quality > 51) ||
+            (!region->abs_qp_en && (region->quality > 51 || region->quality < -51)))
+            ret = MPP_NOK;
+
+        if (ret) {
+            mpp_err_f("region %d invalid param:\n", i);
+            mpp_err_f("position [%d:%d:%d:%d] vs [%d:%d]\n",
+                      region->x, region->y, region->w, region->h, w, h);
+            mpp_err_f("force intra %d qp area index %d\n",
+                      region->intra, region->qp_area_idx);
+            mpp_err_f("abs qp mode %d value %d\n",
+                      region->abs_qp_en, region->quality);
+            return ret;
+        }
+    }
+
+    return ret;
+}
+
 MPP_RET vepu541_set_one_roi(void *buf, MppEncROIRegion *region, RK_S32 w, RK_S32 h)
 {
     Vepu541RoiCfg *ptr = (Vepu541RoiCfg *)buf;
@@ -356,46 +434,24 @@ MPP_RET vepu541_set_one_roi(void *buf, MppEncROIRegion *region, RK_S32 w, RK_S32
     RK_S32 stride_h = MPP_ALIGN(mb_w, 4);
     Vepu541RoiCfg cfg;
     MPP_RET ret = MPP_NOK;
+    RK_S32 x0, x1, y0, y1;
+    RK_S32 y;
 
     if (NULL == buf || NULL == region) {
         mpp_err_f("invalid buf %p roi %p\n", buf, region);
         goto DONE;
     }
 
-    RK_S32 roi_width  = (region->w + 15) / 16;
-    RK_S32 roi_height = (region->h + 15) / 16;
-    RK_S32 pos_x_init = region->x / 16;
-    RK_S32 pos_y_init = region->y / 16;
-    RK_S32 pos_x_end  = pos_x_init + roi_width;
-    RK_S32 pos_y_end  = pos_y_init + roi_height;
-    RK_S32 x, y;
-
-    pos_x_end = MPP_MIN(pos_x_end, mb_w);
-    pos_y_end = MPP_MIN(pos_y_end, mb_h);
-    pos_x_init = MPP_MAX(pos_x_init, 0);
-    pos_y_init = MPP_MAX(pos_y_init, 0);
-
-    mpp_assert(pos_x_end > pos_x_init);
-    mpp_assert(pos_y_end > pos_y_init);
-
-    cfg.force_intra = region->intra;
-    cfg.reserved    = 0;
-    cfg.qp_area_idx = region->qp_area_idx;
-    // NOTE: When roi is enabled the qp_area_en should be one.
-    cfg.qp_area_en  = 1;    // region->area_map_en;
-    cfg.qp_adj      = region->quality;
-    cfg.qp_adj_mode = region->abs_qp_en;
-
-    ptr += pos_y_init * stride_h + pos_x_init;
-    roi_width = pos_x_end - pos_x_init;
-    roi_height = pos_y_end - pos_y_init;
+    roi_region_rect(region, mb_w, mb_h, &x0, &x1, &y0, &y1);
 
-    for (y = 0; y < roi_height; y++) {
-        Vepu541RoiCfg *dst = ptr;
+    mpp_assert(x1 > x0);
+    mpp_assert(y1 > y0);
 
-        for (x = 0; x < roi_width; x++, dst++)
-            memcpy(dst, &cfg, sizeof(cfg));
+    roi_region_cfg(region, &cfg);
 
+    ptr += y0 * stride_h + x0;
+    for (y = y0; y < y1; y++) {
+        mpp_fill_pattern(ptr, &cfg, sizeof(cfg), x1 - x0);
         ptr += stride_h;
     }
 DONE:
@@ -405,7 +461,6 @@ DONE:
 MPP_RET vepu541_set_roi(void *buf, MppEncROICfg *roi, RK_S32 w, RK_S32 h)
 {
     MppEncROIRegion *region = roi->regions;
-    Vepu541RoiCfg *ptr = (Vepu541RoiCfg *)buf;
     RK_S32 mb_w = MPP_ALIGN(w, 16) / 16;
     RK_S32 mb_h = MPP_ALIGN(h, 16) / 16;
     RK_S32 stride_h = MPP_ALIGN(mb_w, 4);
@@ -419,61 +474,135 @@ MPP_RET vepu541_set_roi(void *buf, MppEncROICfg *roi, RK_S32 w, RK_S32 h)
         goto DONE;
     }
 
-    cfg.force_intra = 0;
-    cfg.reserved    = 0;
-    cfg.qp_area_idx = 0;
-    cfg.qp_area_en  = 1;
-    cfg.qp_adj      = 0;
-    cfg.qp_adj_mode = 0;
-
     /* step 1. reset all the config */
-    for (i = 0; i < stride_h * stride_v; i++, ptr++)
-        memcpy(ptr, &cfg, sizeof(cfg));
+    roi_default_cfg(&cfg);
+    mpp_fill_pattern(buf, &cfg, sizeof(cfg), stride_h * stride_v);
 
-    if (w <= 0 || h <= 0) {
-        mpp_err_f("invalid size [%d:%d]\n", w, h);
+    ret = roi_check(roi, w, h);
+    if (ret)
         goto DONE;
+
+    /* step 2. setup region for top to bottom */
+    for (i = 0; i < (RK_S32)roi->number; i++, region++) {
+        vepu541_set_one_roi(buf, region, w, h);
     }
 
-    if (roi->number > VEPU541_MAX_ROI_NUM) {
-        mpp_err_f("invalid region number %d\n", roi->number);
-        goto DONE;
+DONE:
+    return ret;
+}
+
+/* rewrite one mb row with the default config and all regions in order */
+static void roi_set_row(Vepu541RoiCfg *row, MppEncROICfg *roi, RK_S32 y,
+                        RK_S32 mb_w, RK_S32 mb_h, RK_S32 stride_h)
+{
+    MppEncROIRegion *region = roi->regions;
+    Vepu541RoiCfg cfg;
+    RK_U32 i;
+
+    roi_default_cfg(&cfg);
+    mpp_fill_pattern(row, &cfg, sizeof(cfg), stride_h);
+
+    for (i = 0; i < roi->number; i++, region++) {
+        RK_S32 x0, x1, y0, y1;
+
+        roi_region_rect(region, mb_w, mb_h, &x0, &x1, &y0, &y1);
+        if (y < y0 || y >= y1 || x1 <= x0)
+            continue;
+
+        roi_region_cfg(region, &cfg);
+        mpp_fill_pattern(row + x0, &cfg, sizeof(cfg), x1 - x0);
     }
+}
 
-    /* check region config */
-    ret = MPP_OK;
-    for (i = 0; i < (RK_S32)roi->number; i++, region++) {
-        if (region->x + region->w > w || region->y + region->h > h)
-            ret = MPP_NOK;
+MPP_RET vepu541_set_roi_diff(void *buf, MppEncROICfg *roi, RK_S32 w, RK_S32 h,
+                             Vepu541RoiPrev *prev)
+{
+    RK_S32 mb_w = MPP_ALIGN(w, 16) / 16;
+    RK_S32 mb_h = MPP_ALIGN(h, 16) / 16;
+    RK_S32 stride_h = MPP_ALIGN(mb_w, 4);
+    RK_S32 stride_v = MPP_ALIGN(mb_h, 4);
+    /* rows of the old and new region for each changed index */
+    RK_S32 dirty_y0[VEPU541_MAX_ROI_NUM * 2];
+    RK_S32 dirty_y1[VEPU541_MAX_ROI_NUM * 2];
+    RK_S32 dirty_cnt = 0;
+    RK_S32 row_start = mb_h;
+    RK_S32 row_end = 0;
+    RK_U32 count;
+    RK_U32 i;
+    RK_S32 y;
+    MPP_RET ret;
+
+    if (NULL == prev)
+        return vepu541_set_roi(buf, roi, w, h);
 
-        if (region->intra > 1 || region->qp_area_idx >= VEPU541_MAX_ROI_NUM ||
-            region->area_map_en > 1 || region->abs_qp_en > 1)
-            ret = MPP_NOK;
+    if (NULL == buf || NULL == roi) {
+        mpp_err_f("invalid buf %p roi %p\n", buf, roi);
+        return MPP_NOK;
+    }
 
-        if ((region->abs_qp_en && region->quality > 51) ||
-            (!region->abs_qp_en && (region->quality > 51 || region->quality < -51)))
-            ret = MPP_NOK;
+    if (prev->buf != buf || prev->w != w || prev->h != h ||
+        prev->number > VEPU541_MAX_ROI_NUM || roi_check(roi, w, h)) {
+        /* full write, invalid roi leaves the buffer in default config */
+        ret = vepu541_set_roi(buf, roi, w, h);
+
+        prev->buf = buf;
+        prev->w = w;
+        prev->h = h;
+        prev->number = ret ? 0 : roi->number;
+        if (prev->number)
+            memcpy(prev->regions, roi->regions, prev->number * sizeof(*roi->regions));
+        prev->row_start = 0;
+        prev->row_end = stride_v;
+
+        return ret;
+    }
 
-        if (ret) {
-            mpp_err_f("region %d invalid param:\n", i);
-            mpp_err_f("position [%d:%d:%d:%d] vs [%d:%d]\n",
-                      region->x, region->y, region->w, region->h, w, h);
-            mpp_err_f("force intra %d qp area index %d\n",
-                      region->intra, region->qp_area_idx);
-            mpp_err_f("abs qp mode %d value %d\n",
-                      region->abs_qp_en, region->quality);
-            goto DONE;
+    count = MPP_MAX(roi->number, prev->number);
+    for (i = 0; i < count; i++) {
+        RK_S32 x0, x1;
+
+        if (i < roi->number && i < prev->number &&
+            !memcmp(&roi->regions[i], &prev->regions[i], sizeof(*roi->regions)))
+            continue;
+
+        if (i < prev->number) {
+            roi_region_rect(&prev->regions[i], mb_w, mb_h, &x0, &x1,
+                            &dirty_y0[dirty_cnt], &dirty_y1[dirty_cnt]);
+            dirty_cnt++;
+        }
+
+        if (i < roi->number) {
+            roi_region_rect(&roi->regions[i], mb_w, mb_h, &x0, &x1,
+                            &dirty_y0[dirty_cnt], &dirty_y1[dirty_cnt]);
+            dirty_cnt++;
         }
     }
 
-    region = roi->regions;
-    /* step 2. setup region for top to bottom */
-    for (i = 0; i < (RK_S32)roi->number; i++, region++) {
-        vepu541_set_one_roi(buf, region, w, h);
+    for (i = 0; i < (RK_U32)dirty_cnt; i++) {
+        row_start = MPP_MIN(row_start, dirty_y0[i]);
+        row_end = MPP_MAX(row_end, dirty_y1[i]);
     }
 
-DONE:
-    return ret;
+    for (y = row_start; y < row_end; y++) {
+        RK_S32 j;
+
+        for (j = 0; j < dirty_cnt; j++) {
+            if (y >= dirty_y0[j] && y < dirty_y1[j])
+                break;
+        }
+
+        if (j < dirty_cnt)
+            roi_set_row((Vepu541RoiCfg *)buf + y * stride_h, roi, y,
+                        mb_w, mb_h, stride_h);
+    }
+
+    prev->number = roi->number;
+    if (prev->number)
+        memcpy(prev->regions, roi->regions, prev->number * sizeof(*roi->regions));
+    prev->row_start = row_start < row_end ? row_start : 0;
+    prev->row_end = row_start < row_end ? row_end : 0;
+
+    return MPP_OK;
 }
 
 /*
@@ -563,8 +692,8 @@ typedef struct Vepu541OsdReg_t {
     RK_U32  osd_addr[8];
 } Vepu541OsdReg;
 
-#define SET_OSD_INV_THR(index, reg, region)\
-    if(region[index].inverse)   \
+#define SET_OSD_INV_THR(index, reg, inv_e)\
+    if ((inv_e) & (1 << index))  \
         reg.osd_ithd_r##index = ENC_DEFAULT_OSD_INV_THR;
 
 static MPP_RET copy2osd2(MppEncOSDData2* dst, MppEncOSDData *src1, MppEncOSDData2 *src2)
@@ -573,8 +702,10 @@ static MPP_RET copy2osd2(MppEncOSDData2* dst, MppEncOSDData *src1, MppEncOSDData
     RK_U32 i = 0;
 
     if (src1) {
+        /* clear unused regions for the change detection */
+        memset(dst, 0, sizeof(*dst));
         dst->num_region = src1->num_region;
-        for (i = 0; i < src1->num_region; i++) {
+        for (i = 0; i < src1->num_region && i < MPP_ARRAY_ELEMS(dst->region); i++) {
             dst->region[i].enable       = src1->region[i].enable;
             dst->region[i].inverse      = src1->region[i].inverse;
             dst->region[i].start_mb_x   = src1->region[i].start_mb_x;
@@ -594,26 +725,153 @@ static MPP_RET copy2osd2(MppEncOSDData2* dst, MppEncOSDData *src1, MppEncOSDData
     return ret;
 }
 
+static void osd_rgn_get_buf(MppEncOSDRegion2 *tmp, RK_S32 *fd, size_t *size)
+{
+    if (tmp->buf) {
+        *fd = mpp_buffer_get_fd(tmp->buf);
+        *size = mpp_buffer_get_size(tmp->buf);
+    } else {
+        *fd = -1;
+        *size = 0;
+    }
+}
+
+static MPP_RET osd_blk_compile(Vepu541OsdBlk *blk)
+{
+    MppEncOSDData2 *osd = &blk->src;
+    RK_U32 num = osd->num_region;
+    MPP_RET ret = MPP_OK;
+    RK_U32 i;
+
+    blk->done = 1;
+    blk->valid = 0;
+    blk->num = 0;
+    blk->osd_e = 0;
+    blk->inv_e = 0;
+    blk->pos_e = 0;
+
+    if (num > 8) {
+        mpp_err_f("do NOT support more than 8 regions invalid num %d\n", num);
+        mpp_assert(num <= 8);
+        return MPP_NOK;
+    }
+
+    blk->num = num;
+
+    /* go through all regions so the fd / size of every region is recorded */
+    for (i = 0; i < num; i++) {
+        MppEncOSDRegion2 *tmp = &osd->region[i];
+        Vepu541OsdBlkRgn *rgn = &blk->rgn[i];
+        size_t blk_len;
+
+        blk->osd_e |= tmp->enable ? (1 << i) : 0;
+        blk->inv_e |= tmp->inverse ? (1 << i) : 0;
+
+        if (!tmp->enable || !tmp->num_mb_x || !tmp->num_mb_y)
+            continue;
+
+        rgn->lt_x = tmp->start_mb_x;
+        rgn->lt_y = tmp->start_mb_y;
+        rgn->rb_x = tmp->start_mb_x + tmp->num_mb_x - 1;
+        rgn->rb_y = tmp->start_mb_y + tmp->num_mb_y - 1;
+        rgn->offset = tmp->buf_offset;
+        osd_rgn_get_buf(tmp, &rgn->fd, &rgn->size);
+        if (rgn->fd < 0) {
+            mpp_err_f("invalid osd buffer fd %d\n", rgn->fd);
+            ret = MPP_NOK;
+            continue;
+        }
+
+        /* There should be enough buffer and offset should be 16B aligned */
+        blk_len = tmp->num_mb_x * tmp->num_mb_y * 256;
+        if (rgn->size < tmp->buf_offset + blk_len ||
+            (tmp->buf_offset & 0xf)) {
+            mpp_err_f("invalid osd cfg: %d x:y:w:h:off %d:%d:%d:%d:%x size %x\n",
+                      i, tmp->start_mb_x, tmp->start_mb_y,
+                      tmp->num_mb_x, tmp->num_mb_y, tmp->buf_offset, (RK_U32)rgn->size);
+        }
+
+        blk->pos_e |= 1 << i;
+    }
+
+    blk->valid = !ret;
+    return ret;
+}
+
+/*
+ * The MppBuffer handle in the user data may be freed and reused by another
+ * buffer with the same address, so the fd / size of each region buffer is
+ * part of the change check besides the user data itself.
+ */
+static RK_U32 osd_blk_match(Vepu541OsdBlk *blk, MppEncOSDData2 *src)
+{
+    RK_U32 i;
+
+    if (!blk->done || memcmp(&blk->src, src, sizeof(*src)))
+        return 0;
+
+    for (i = 0; i < blk->num; i++) {
+        MppEncOSDRegion2 *tmp = &src->region[i];
+        Vepu541OsdBlkRgn *rgn = &blk->rgn[i];
+        RK_S32 fd;
+        size_t size;
+
+        if (!tmp->enable || !tmp->num_mb_x || !tmp->num_mb_y)
+            continue;
+
+        osd_rgn_get_buf(tmp, &fd, &size);
+        if (fd != rgn->fd || size != rgn->size)
+            return 0;
+    }
+
+    return 1;
+}
+
+/*
+ * Merge the user osd data and compare it with both blocks. The block in
+ * use is kept when nothing changes. Otherwise the idle block is compiled
+ * and becomes the one in use on success, so an invalid update does not
+ * touch the current block. A failed config stays in the idle block and is
+ * not compiled and reported again until it changes.
+ */
+static Vepu541OsdBlk *osd_get_blk(Vepu541OsdCfg *cfg)
+{
+    Vepu541OsdBlk *cur = &cfg->blk[cfg->blk_idx];
+    Vepu541OsdBlk *nxt = &cfg->blk[!cfg->blk_idx];
+    MppEncOSDData2 src;
+
+    if (copy2osd2(&src, cfg->osd_data, cfg->osd_data2))
+        return NULL;
+
+    if (osd_blk_match(cur, &src))
+        return cur;
+
+    if (!osd_blk_match(nxt, &src)) {
+        memcpy(&nxt->src, &src, sizeof(src));
+        osd_blk_compile(nxt);
+    }
+
+    if (!nxt->valid)
+        return NULL;
+
+    cfg->blk_idx = !cfg->blk_idx;
+    return nxt;
+}
+
 MPP_RET vepu541_set_osd(Vepu541OsdCfg *cfg)
 {
     Vepu541OsdReg *regs = (Vepu541OsdReg *)(cfg->reg_base + (size_t)VEPU541_OSD_CFG_OFFSET);
     MppDev dev = cfg->dev;
     MppEncOSDPltCfg *plt_cfg = cfg->plt_cfg;
-    MppEncOSDData2 osd;
+    Vepu541OsdBlk *blk = osd_get_blk(cfg);
+    RK_U32 i;
 
-    if (copy2osd2(&osd, cfg->osd_data, cfg->osd_data2))
+    if (!blk)
         return MPP_NOK;
 
-    if (osd.num_region == 0)
+    if (blk->num == 0)
         return MPP_OK;
 
-    if (osd.num_region > 8) {
-        mpp_err_f("do NOT support more than 8 regions invalid num %d\n",
-                  osd.num_region);
-        mpp_assert(osd.num_region <= 8);
-        return MPP_NOK;
-    }
-
     if (plt_cfg->type == MPP_ENC_OSD_PLT_TYPE_USERDEF) {
         MppDevRegWrCfg wr_cfg;
 
@@ -630,63 +888,39 @@ MPP_RET vepu541_set_osd(Vepu541OsdCfg *cfg)
         regs->reg112.osd_plt_typ = VEPU541_OSD_PLT_TYPE_DEFAULT;
     }
 
-    regs->reg112.osd_e = 0;
-    regs->reg112.osd_inv_e = 0;
+    regs->reg112.osd_e = blk->osd_e;
+    regs->reg112.osd_inv_e = blk->inv_e;
 
-    RK_U32 i = 0;
-    MppEncOSDRegion2 *region = osd.region;
-    MppEncOSDRegion2 *tmp = region;
-    RK_U32 num = osd.num_region;
-
-    for (i = 0; i < num; i++, tmp++) {
-        regs->reg112.osd_e      |= tmp->enable << i;
-        regs->reg112.osd_inv_e  |= tmp->inverse << i;
-
-        if (tmp->enable && tmp->num_mb_x && tmp->num_mb_y) {
-            Vepu541OsdPos *pos = &regs->osd_pos[i];
-            size_t blk_len = tmp->num_mb_x * tmp->num_mb_y * 256;
-            RK_S32 fd = 0;
-            RK_U32 buf_size = 0;
-
-            pos->osd_lt_x = tmp->start_mb_x;
-            pos->osd_lt_y = tmp->start_mb_y;
-            pos->osd_rb_x = tmp->start_mb_x + tmp->num_mb_x - 1;
-            pos->osd_rb_y = tmp->start_mb_y + tmp->num_mb_y - 1;
-
-            buf_size = mpp_buffer_get_size(tmp->buf);
-            fd = mpp_buffer_get_fd(tmp->buf);
-            if (fd < 0) {
-                mpp_err_f("invalid osd buffer fd %d\n", fd);
-                return MPP_NOK;
-            }
-            regs->osd_addr[i] = fd;
-
-            if (tmp->buf_offset) {
-                MppDevRegOffsetCfg trans_cfg;
-
-                trans_cfg.reg_idx = VEPU541_OSD_ADDR_IDX_BASE + i;
-                trans_cfg.offset = tmp->buf_offset;
-                mpp_dev_ioctl(cfg->dev, MPP_DEV_REG_OFFSET, &trans_cfg);
-            }
-
-            /* There should be enough buffer and offset should be 16B aligned */
-            if (buf_size < tmp->buf_offset + blk_len ||
-                (tmp->buf_offset & 0xf)) {
-                mpp_err_f("invalid osd cfg: %d x:y:w:h:off %d:%d:%d:%d:%x\n",
-                          i, tmp->start_mb_x, tmp->start_mb_y,
-                          tmp->num_mb_x, tmp->num_mb_y, tmp->buf_offset);
-            }
+    for (i = 0; i < blk->num; i++) {
+        Vepu541OsdBlkRgn *rgn = &blk->rgn[i];
+        Vepu541OsdPos *pos = &regs->osd_pos[i];
+
+        if (!(blk->pos_e & (1 << i)))
+            continue;
+
+        pos->osd_lt_x = rgn->lt_x;
+        pos->osd_lt_y = rgn->lt_y;
+        pos->osd_rb_x = rgn->rb_x;
+        pos->osd_rb_y = rgn->rb_y;
+        regs->osd_addr[i] = rgn->fd;
+
+        if (rgn->offset) {
+            MppDevRegOffsetCfg trans_cfg;
+
+            trans_cfg.reg_idx = VEPU541_OSD_ADDR_IDX_BASE + i;
+            trans_cfg.offset = rgn->offset;
+            mpp_dev_ioctl(dev, MPP_DEV_REG_OFFSET, &trans_cfg);
         }
     }
 
-    SET_OSD_INV_THR(0, regs->reg113, region);
-    SET_OSD_INV_THR(1, regs->reg113, region);
-    SET_OSD_INV_THR(2, regs->reg113, region);
-    SET_OSD_INV_THR(3, regs->reg113, region);
-    SET_OSD_INV_THR(4, regs->reg113, region);
-    SET_OSD_INV_THR(5, regs->reg113, region);
-    SET_OSD_INV_THR(6, regs->reg113, region);
-    SET_OSD_INV_THR(7, regs->reg113, region);
+    SET_OSD_INV_THR(0, regs->reg113, blk->inv_e);
+    SET_OSD_INV_THR(1, regs->reg113, blk->inv_e);
+    SET_OSD_INV_THR(2, regs->reg113, blk->inv_e);
+    SET_OSD_INV_THR(3, regs->reg113, blk->inv_e);
+    SET_OSD_INV_THR(4, regs->reg113, blk->inv_e);
+    SET_OSD_INV_THR(5, regs->reg113, blk->inv_e);
+    SET_OSD_INV_THR(6, regs->reg113, blk->inv_e);
+    SET_OSD_INV_THR(7, regs->reg113, blk->inv_e);
 
     return MPP_OK;
 }
@@ -803,21 +1037,15 @@ MPP_RET vepu540_set_osd(Vepu541OsdCfg *cfg)
     Vepu540OsdReg *regs = (Vepu540OsdReg *)(cfg->reg_base + (size_t)VEPU540_OSD_CFG_OFFSET);
     MppDev dev = cfg->dev;
     MppEncOSDPltCfg *plt_cfg = cfg->plt_cfg;
-    MppEncOSDData2 osd;
+    Vepu541OsdBlk *blk = osd_get_blk(cfg);
+    RK_U32 k;
 
-    if (copy2osd2(&osd, cfg->osd_data, cfg->osd_data2))
+    if (!blk)
         return MPP_NOK;
 
-    if (osd.num_region == 0)
+    if (blk->num == 0)
         return MPP_OK;
 
-    if (osd.num_region > 8) {
-        mpp_err_f("do NOT support more than 8 regions invalid num %d\n",
-                  osd.num_region);
-        mpp_assert(osd.num_region <= 8);
-        return MPP_NOK;
-    }
-
     if (plt_cfg->type == MPP_ENC_OSD_PLT_TYPE_USERDEF) {
         MppDevRegWrCfg wr_cfg;
 
@@ -833,66 +1061,41 @@ MPP_RET vepu540_set_osd(Vepu541OsdCfg *cfg)
         regs->reg112.osd_plt_typ = VEPU541_OSD_PLT_TYPE_DEFAULT;
     }
 
-    regs->reg112.osd_e = 0;
-    regs->reg112.osd_lu_inv_en = 0;
-    regs->reg094.osd_ch_inv_en = 0;
+    regs->reg112.osd_e = blk->osd_e;
+    regs->reg112.osd_lu_inv_en = blk->inv_e;
+    regs->reg094.osd_ch_inv_en = blk->inv_e;
     regs->reg094.osd_lu_inv_msk = 0;
 
-    RK_U32 num = osd.num_region;
-    RK_U32 k = 0;
-    MppEncOSDRegion2 *region = osd.region;
-    MppEncOSDRegion2 *tmp = region;
-
-    for (k = 0; k < num; k++, tmp++) {
-        regs->reg112.osd_e          |= tmp->enable << k;
-        regs->reg112.osd_lu_inv_en  |= (tmp->inverse) ? (1 << k) : 0;
-        regs->reg094.osd_ch_inv_en  |= (tmp->inverse) ? (1 << k) : 0;
-
-        if (tmp->enable && tmp->num_mb_x && tmp->num_mb_y) {
-            Vepu541OsdPos *pos = &regs->osd_pos[k];
-            size_t blk_len = tmp->num_mb_x * tmp->num_mb_y * 256;
-            RK_S32 fd = -1;
-            size_t buf_size = 0;
-
-            pos->osd_lt_x = tmp->start_mb_x;
-            pos->osd_lt_y = tmp->start_mb_y;
-            pos->osd_rb_x = tmp->start_mb_x + tmp->num_mb_x - 1;
-            pos->osd_rb_y = tmp->start_mb_y + tmp->num_mb_y - 1;
-
-            buf_size = mpp_buffer_get_size(tmp->buf);
-            fd = mpp_buffer_get_fd(tmp->buf);
-            if (fd < 0) {
-                mpp_err_f("invalid osd buffer fd %d\n", fd);
-                return MPP_NOK;
-            }
-            regs->osd_addr[k] = fd;
-
-            if (tmp->buf_offset) {
-                MppDevRegOffsetCfg trans_cfg;
-
-                trans_cfg.reg_idx = VEPU541_OSD_ADDR_IDX_BASE + k;
-                trans_cfg.offset = tmp->buf_offset;
-                mpp_dev_ioctl(dev, MPP_DEV_REG_OFFSET, &trans_cfg);
-            }
-
-            /* There should be enough buffer and offset should be 16B aligned */
-            if (buf_size < tmp->buf_offset + blk_len ||
-                (tmp->buf_offset & 0xf)) {
-                mpp_err_f("invalid osd cfg: %d x:y:w:h:off %d:%d:%d:%d:%x size %x\n",
-                          k, tmp->start_mb_x, tmp->start_mb_y,
-                          tmp->num_mb_x, tmp->num_mb_y, tmp->buf_offset, buf_size);
-            }
+    for (k = 0; k < blk->num; k++) {
+        Vepu541OsdBlkRgn *rgn = &blk->rgn[k];
+        Vepu541OsdPos *pos = &regs->osd_pos[k];
+
+        if (!(blk->pos_e & (1 << k)))
+            continue;
+
+        pos->osd_lt_x = rgn->lt_x;
+        pos->osd_lt_y = rgn->lt_y;
+        pos->osd_rb_x = rgn->rb_x;
+        pos->osd_rb_y = rgn->rb_y;
+        regs->osd_addr[k] = rgn->fd;
+
+        if (rgn->offset) {
+            MppDevRegOffsetCfg trans_cfg;
+
+            trans_cfg.reg_idx = VEPU541_OSD_ADDR_IDX_BASE + k;
+            trans_cfg.offset = rgn->offset;
+            mpp_dev_ioctl(dev, MPP_DEV_REG_OFFSET, &trans_cfg);
         }
     }
 
-    SET_OSD_INV_THR(0, regs->reg113, region);
-    SET_OSD_INV_THR(1, regs->reg113, region);
-    SET_OSD_INV_THR(2, regs->reg113, region);
-    SET_OSD_INV_THR(3, regs->reg113, region);
-    SET_OSD_INV_THR(4, regs->reg113, region);
-    SET_OSD_INV_THR(5, regs->reg113, region);
-    SET_OSD_INV_THR(6, regs->reg113, region);
-    SET_OSD_INV_THR(7, regs->reg113, region);
+    SET_OSD_INV_THR(0, regs->reg113, blk->inv_e);
+    SET_OSD_INV_THR(1, regs->reg113, blk->inv_e);
+    SET_OSD_INV_THR(2, regs->reg113, blk->inv_e);
+    SET_OSD_INV_THR(3, regs->reg113, blk->inv_e);
+    SET_OSD_INV_THR(4, regs->reg113, blk->inv_e);
+    SET_OSD_INV_THR(5, regs->reg113, blk->inv_e);
+    SET_OSD_INV_THR(6, regs->reg113, blk->inv_e);
+    SET_OSD_INV_THR(7, regs->reg113, blk->inv_e);
 
     return MPP_OK;
 }
@@ -1009,21 +1212,15 @@ MPP_RET vepu580_set_osd(Vepu541OsdCfg *cfg)
     MppDev dev = cfg->dev;
     MppDevRegOffCfgs *reg_cfg = cfg->reg_cfg;
     MppEncOSDPltCfg *plt_cfg = cfg->plt_cfg;
-    MppEncOSDData2 osd;
+    Vepu541OsdBlk *blk = osd_get_blk(cfg);
+    RK_U32 k;
 
-    if (copy2osd2(&osd, cfg->osd_data, cfg->osd_data2))
+    if (!blk)
         return MPP_NOK;
 
-    if (osd.num_region == 0)
+    if (blk->num == 0)
         return MPP_OK;
 
-    if (osd.num_region > 8) {
-        mpp_err_f("do NOT support more than 8 regions invalid num %d\n",
-                  osd.num_region);
-        mpp_assert(osd.num_region <= 8);
-        return MPP_NOK;
-    }
-
     if (plt_cfg->type == MPP_ENC_OSD_PLT_TYPE_USERDEF) {
         memcpy(regs->plt_data, plt_cfg->plt, sizeof(MppEncOSDPlt));
         regs->reg3074.osd_plt_cks = 1;
@@ -1033,66 +1230,41 @@ MPP_RET vepu580_set_osd(Vepu541OsdCfg *cfg)
         regs->reg3074.osd_plt_typ = VEPU541_OSD_PLT_TYPE_DEFAULT;
     }
 
-    regs->reg3074.osd_e = 0;
-    regs->reg3072.osd_lu_inv_en = 0;
-    regs->reg3072.osd_ch_inv_en = 0;
+    regs->reg3074.osd_e = blk->osd_e;
+    regs->reg3072.osd_lu_inv_en = blk->inv_e;
+    regs->reg3072.osd_ch_inv_en = blk->inv_e;
     regs->reg3072.osd_lu_inv_msk = 0;
     regs->reg3072.osd_ch_inv_msk = 0;
 
-    RK_U32 num = osd.num_region;
-    RK_U32 k = 0;
-    MppEncOSDRegion2 *region = osd.region;
-    MppEncOSDRegion2 *tmp = region;
-
-    for (k = 0; k < num; k++, tmp++) {
-        regs->reg3074.osd_e          |= tmp->enable << k;
-        regs->reg3072.osd_lu_inv_en  |= (tmp->inverse) ? (1 << k) : 0;
-        regs->reg3072.osd_ch_inv_en  |= (tmp->inverse) ? (1 << k) : 0;
-
-        if (tmp->enable && tmp->num_mb_x && tmp->num_mb_y) {
-            Vepu580OsdPos *pos = &regs->osd_pos[k];
-            size_t blk_len = tmp->num_mb_x * tmp->num_mb_y * 256;
-            RK_S32 fd = -1;
-            size_t buf_size = 0;
-
-            pos->osd_lt_x = tmp->start_mb_x;
-            pos->osd_lt_y = tmp->start_mb_y;
-            pos->osd_rb_x = tmp->start_mb_x + tmp->num_mb_x - 1;
-            pos->osd_rb_y = tmp->start_mb_y + tmp->num_mb_y - 1;
-
-            buf_size = mpp_buffer_get_size(tmp->buf);
-            fd = mpp_buffer_get_fd(tmp->buf);
-            if (fd < 0) {
-                mpp_err_f("invalid osd buffer fd %d\n", fd);
-                return MPP_NOK;
-            }
-            regs->osd_addr[k] = fd;
-
-            if (tmp->buf_offset) {
-                if (reg_cfg)
-                    mpp_dev_multi_offset_update(reg_cfg, VEPU580_OSD_ADDR_IDX_BASE + k, tmp->buf_offset);
-                else
-                    mpp_dev_set_reg_offset(dev, VEPU580_OSD_ADDR_IDX_BASE + k, tmp->buf_offset);
-            }
-
-            /* There should be enough buffer and offset should be 16B aligned */
-            if (buf_size < tmp->buf_offset + blk_len ||
-                (tmp->buf_offset & 0xf)) {
-                mpp_err_f("invalid osd cfg: %d x:y:w:h:off %d:%d:%d:%d:%x size %x\n",
-                          k, tmp->start_mb_x, tmp->start_mb_y,
-                          tmp->num_mb_x, tmp->num_mb_y, tmp->buf_offset, buf_size);
-            }
+    for (k = 0; k < blk->num; k++) {
+        Vepu541OsdBlkRgn *rgn = &blk->rgn[k];
+        Vepu580OsdPos *pos = &regs->osd_pos[k];
+
+        if (!(blk->pos_e & (1 << k)))
+            continue;
+
+        pos->osd_lt_x = rgn->lt_x;
+        pos->osd_lt_y = rgn->lt_y;
+        pos->osd_rb_x = rgn->rb_x;
+        pos->osd_rb_y = rgn->rb_y;
+        regs->osd_addr[k] = rgn->fd;
+
+        if (rgn->offset) {
+            if (reg_cfg)
+                mpp_dev_multi_offset_update(reg_cfg, VEPU580_OSD_ADDR_IDX_BASE + k, rgn->offset);
+            else
+                mpp_dev_set_reg_offset(dev, VEPU580_OSD_ADDR_IDX_BASE + k, rgn->offset);
         }
     }
 
-    SET_OSD_INV_THR(0, regs->reg3073, region);
-    SET_OSD_INV_THR(1, regs->reg3073, region);
-    SET_OSD_INV_THR(2, regs->reg3073, region);
-    SET_OSD_INV_THR(3, regs->reg3073, region);
-    SET_OSD_INV_THR(4, regs->reg3073, region);
-    SET_OSD_INV_THR(5, regs->reg3073, region);
-    SET_OSD_INV_THR(6, regs->reg3073, region);
-    SET_OSD_INV_THR(7, regs->reg3073, region);
+    SET_OSD_INV_THR(0, regs->reg3073, blk->inv_e);
+    SET_OSD_INV_THR(1, regs->reg3073, blk->inv_e);
+    SET_OSD_INV_THR(2, regs->reg3073, blk->inv_e);
+    SET_OSD_INV_THR(3, regs->reg3073, blk->inv_e);
+    SET_OSD_INV_THR(4, regs->reg3073, blk->inv_e);
+    SET_OSD_INV_THR(5, regs->reg3073, blk->inv_e);
+    SET_OSD_INV_THR(6, regs->reg3073, blk->inv_e);
+    SET_OSD_INV_THR(7, regs->reg3073, blk->inv_e);
 
     return MPP_OK;
 }
@@ -106,6 +106,25 @@ typedef struct Vepu541RoiCfg_t {
     RK_U16 qp_adj_mode  : 1;
 } Vepu541RoiCfg;
 
+/*
+ * Vepu541RoiPrev
+ *
+ * Region list last written into a roi buffer by vepu541_set_roi_diff.
+ * Clear buf to force a full buffer write on next call, e.g. when the roi
+ * buffer has been written by other function like intra refresh.
+ */
+typedef struct Vepu541RoiPrev_t {
+    void            *buf;
+    RK_S32          w;
+    RK_S32          h;
+    RK_U32          number;
+    MppEncROIRegion regions[VEPU541_MAX_ROI_NUM];
+
+    /* mb row range [row_start, row_end) rewritten by the last call */
+    RK_S32          row_start;
+    RK_S32          row_end;
+} Vepu541RoiPrev;
+
 typedef struct Vepu541OsdPos_t {
     /* X coordinate/16 of OSD region's left-top point. */
     RK_U32  osd_lt_x                : 8;
@@ -148,6 +167,40 @@ typedef struct Vepu541OsdPltColor_t {
     RK_U32  alpha                   : 8;
 } Vepu541OsdPltColor;
 
+typedef struct Vepu541OsdBlkRgn_t {
+    /* region position in mb unit */
+    RK_U16              lt_x;
+    RK_U16              lt_y;
+    RK_U16              rb_x;
+    RK_U16              rb_y;
+    RK_S32              fd;
+    RK_U32              offset;
+    /* buffer size when compiled, with fd it detects a reused buffer handle */
+    size_t              size;
+} Vepu541OsdBlkRgn;
+
+/*
+ * Vepu541OsdBlk
+ *
+ * Osd config compiled from the user osd data into register values.
+ * It is only rebuilt when the user osd data or the fd / size of its
+ * buffers changes and then applied to the register set of each frame.
+ */
+typedef struct Vepu541OsdBlk_t {
+    /* merged user osd data this block is compiled from */
+    MppEncOSDData2      src;
+    /* src has been compiled, valid is the compile result */
+    RK_U32              done;
+    RK_U32              valid;
+
+    RK_U32              num;
+    /* bit masks of enabled / color inversed / position valid regions */
+    RK_U32              osd_e;
+    RK_U32              inv_e;
+    RK_U32              pos_e;
+    Vepu541OsdBlkRgn    rgn[8];
+} Vepu541OsdBlk;
+
 typedef struct Vepu541OsdCfg_t {
     void                *reg_base;
     MppDev              dev;
@@ -155,6 +208,10 @@ typedef struct Vepu541OsdCfg_t {
     MppEncOSDPltCfg     *plt_cfg;
     MppEncOSDData       *osd_data;
     MppEncOSDData2      *osd_data2;
+
+    /* double buffered compiled osd, blk[blk_idx] is the one in use */
+    Vepu541OsdBlk       blk[2];
+    RK_U32              blk_idx;
 } Vepu541OsdCfg;
 
 #ifdef __cplusplus
@@ -171,11 +228,24 @@ MPP_RET vepu541_set_fmt(VepuFmtCfg *cfg, MppFrameFormat format);
  *
  * vepu541_set_roi
  * Setup roi config buffeer for image with mb count mb_w * mb_h
+ *
+ * vepu541_set_roi_diff
+ * Same result as vepu541_set_roi but only rewrite the mb rows covered by
+ * the regions changed from the list recorded in prev.
  */
 RK_S32  vepu541_get_roi_buf_size(RK_S32 w, RK_S32 h);
 MPP_RET vepu541_set_roi(void *buf, MppEncROICfg *roi, RK_S32 w, RK_S32 h);
+MPP_RET vepu541_set_roi_diff(void *buf, MppEncROICfg *roi, RK_S32 w, RK_S32 h,
+                             Vepu541RoiPrev *prev);
 MPP_RET vepu541_set_one_roi(void *buf, MppEncROIRegion *region, RK_S32 w, RK_S32 h);
 
+/*
+ * osd function
+ *
+ * Setup osd registers from osd_data / osd_data2 in cfg. The osd data is
+ * compiled into cfg->blk only when it differs from the last one and the
+ * register set is filled from the compiled block.
+ */
 MPP_RET vepu541_set_osd(Vepu541OsdCfg *cfg);
 MPP_RET vepu540_set_osd(Vepu541OsdCfg *cfg);
 MPP_RET vepu580_set_osd(Vepu541OsdCfg *cfg);
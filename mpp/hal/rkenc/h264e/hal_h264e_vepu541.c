@@ -75,6 +75,7 @@ typedef struct HalH264eVepu541Ctx_t {
     MppBufferGroup          roi_grp;
     MppBuffer               roi_buf;
     RK_S32                  roi_buf_size;
+    Vepu541RoiPrev          roi_prev;
     MppBuffer               qpmap;
 
     /* osd */
@@ -1066,6 +1067,8 @@ static MPP_RET setup_vepu541_intra_refresh(Vepu541H264eRegSet *regs, HalH264eVep
     regs->reg013.roi_enc = 1;
     regs->reg073.roi_addr = fd;
     vepu541_set_one_roi(buf, region, w, h);
+    /* roi buffer is overwritten by intra refresh */
+    ctx->roi_prev.buf = NULL;
     mpp_free(region);
 RET:
     hal_h264e_dbg_func("leave, ret %d\n", ret);
@@ -1111,6 +1114,7 @@ static void setup_vepu541_roi(Vepu541H264eRegSet *regs, HalH264eVepu541Ctx *ctx)
                     mpp_buffer_get(ctx->roi_grp, &ctx->roi_buf, roi_buf_size);
 
                 ctx->roi_buf_size = roi_buf_size;
+                ctx->roi_prev.buf = NULL;
             }
 
             mpp_assert(ctx->roi_buf);
@@ -1120,7 +1124,7 @@ static void setup_vepu541_roi(Vepu541H264eRegSet *regs, HalH264eVepu541Ctx *ctx)
             regs->reg013.roi_enc = 1;
             regs->reg073.roi_addr = fd;
 
-            vepu541_set_roi(buf, roi, w, h);
+            vepu541_set_roi_diff(buf, roi, w, h, &ctx->roi_prev);
         } else {
             regs->reg013.roi_enc = 0;
             regs->reg073.roi_addr = 0;
@@ -87,6 +87,7 @@ typedef struct H265eV541HalContext_t {
     MppEncROICfg        *roi_data;
     MppEncROICfg2       *roi_data2;
     Vepu541RoiCfg       *roi_buf_tmp;
+    Vepu541RoiPrev      roi_prev;
     MppBufferGroup      roi_grp;
     MppBuffer           roi_buf;
     RK_U32              roi_buf_size;
@@ -798,16 +799,17 @@ vepu541_h265_set_patch_info(MppDev dev, H265eSyntax_new *syn, Vepu541Fmt input_f
     return ret;
 }
 
-MPP_RET vepu541_h265_set_roi(void *dst_buf, void *src_buf, RK_S32 w, RK_S32 h)
+/* convert raster 16x16 roi cfg in ctu rows [ctu_y0, ctu_y1) to ctu scan order */
+static void vepu541_h265_set_roi_rows(void *dst_buf, void *src_buf, RK_S32 w,
+                                      RK_S32 ctu_y0, RK_S32 ctu_y1)
 {
     Vepu541RoiCfg *src = (Vepu541RoiCfg *)src_buf;
     Vepu541RoiCfg *dst = (Vepu541RoiCfg *)dst_buf;
     RK_S32 mb_w = MPP_ALIGN(w, 64) / 64;
-    RK_S32 mb_h = MPP_ALIGN(h, 64) / 64;
     RK_S32 ctu_line = mb_w;
     RK_S32 i, j, cu16cnt;
 
-    for (j = 0; j < mb_h; j++) {
+    for (j = ctu_y0; j < ctu_y1; j++) {
         for ( i = 0; i < mb_w; i++) {
             RK_S32 ctu_addr = j * ctu_line + i;
             RK_S32 cu16_num_line = ctu_line * 4;
@@ -824,6 +826,11 @@ MPP_RET vepu541_h265_set_roi(void *dst_buf, void *src_buf, RK_S32 w, RK_S32 h)
             }
         }
     }
+}
+
+MPP_RET vepu541_h265_set_roi(void *dst_buf, void *src_buf, RK_S32 w, RK_S32 h)
+{
+    vepu541_h265_set_roi_rows(dst_buf, src_buf, w, 0, MPP_ALIGN(h, 64) / 64);
     return MPP_OK;
 }
 
@@ -915,6 +922,8 @@ static MPP_RET setup_vepu541_intra_refresh(H265eV541RegSet *regs, H265eV541HalCo
     regs->roi_addr_hevc = fd;
     vepu541_set_one_roi(buf, region, w, h);
     vepu541_h265_set_roi(dst_buf, buf, w, h);
+    /* roi buffers are overwritten by intra refresh */
+    ctx->roi_prev.buf = NULL;
     mpp_free(region);
 RET:
     hal_h265e_dbg_func("leave, ret %d\n", ret);
@@ -963,13 +972,18 @@ vepu541_h265_set_roi_regs(H265eV541HalContext *ctx, H265eV541RegSet *regs)
                     ctx->roi_buf_tmp = (Vepu541RoiCfg*)mpp_malloc(RK_U8, roi_buf_size);
 
                 ctx->roi_buf_size = roi_buf_size;
+                ctx->roi_prev.buf = NULL;
             }
 
             regs->enc_pic.roi_en = 1;
             regs->roi_addr_hevc = mpp_buffer_get_fd(ctx->roi_buf);
             roi_base = (RK_U8 *)mpp_buffer_get_ptr(ctx->roi_buf);
-            vepu541_set_roi(ctx->roi_buf_tmp, cfg, w, h);
-            vepu541_h265_set_roi(roi_base, ctx->roi_buf_tmp, w, h);
+            /* only the ctu rows covering changed regions are converted */
+            vepu541_set_roi_diff(ctx->roi_buf_tmp, cfg, w, h, &ctx->roi_prev);
+            if (ctx->roi_prev.row_end > ctx->roi_prev.row_start)
+                vepu541_h265_set_roi_rows(roi_base, ctx->roi_buf_tmp, w,
+                                          ctx->roi_prev.row_start / 4,
+                                          MPP_ALIGN(ctx->roi_prev.row_end, 4) / 4);
         }
     }
 
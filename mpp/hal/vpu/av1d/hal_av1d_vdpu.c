@@ -44,6 +44,7 @@
 #define GLOBAL_MODEL_TOTAL_SIZE (6 * 4 + 4 * 2)
 #define GLOBAL_MODEL_SIZE GM_GLOBAL_MODELS_PER_FRAME * GLOBAL_MODEL_TOTAL_SIZE
 #define MaxTiles 128
+#define AV1_PROB_TBL_SIZE MPP_ALIGN(sizeof(AV1CDFs), 2048)
 
 #define DUMP_AV1_DATAS 0
 
@@ -71,6 +72,11 @@ typedef struct VdpuAv1dRegCtx_t {
     av1dVdpuBuf     reg_buf[VDPU_FAST_REG_SET_CNT];
     MppBuffer       prob_tbl_base;
     MppBuffer       prob_tbl_out_base;
+    /* default cdf images per q context, filled once on first use */
+    MppBuffer       prob_tbl_default;
+    RK_U32          prob_tbl_default_valid;
+    /* cpu address of the probability table used by the current frame */
+    RK_U32          *prob_tbl_in;
     MppBuffer       tile_info;
     MppBuffer       film_grain_mem;
     MppBuffer       global_model;
@@ -78,12 +84,6 @@ typedef struct VdpuAv1dRegCtx_t {
     MppBuffer       tile_buf;
     filtInfo        filt_info[FILT_TYPE_BUT];
 
-    AV1CDFs         *cdfs;
-    MvCDFs          *cdfs_ndvc;
-    AV1CDFs         default_cdfs;
-    MvCDFs          default_cdfs_ndvc;
-    AV1CDFs         cdfs_last[NUM_REF_FRAMES];
-    MvCDFs          cdfs_last_ndvc[NUM_REF_FRAMES];
     RK_U32          refresh_frame_flags;
 
     RK_U32          width;
@@ -152,6 +152,7 @@ static MPP_RET hal_av1d_alloc_res(void *hal)
 
     BUF_CHECK(ret, mpp_buffer_get(p_hal->buf_group, &reg_ctx->prob_tbl_base, MPP_ALIGN(sizeof(AV1CDFs), 2048)));
     BUF_CHECK(ret, mpp_buffer_get(p_hal->buf_group, &reg_ctx->prob_tbl_out_base, MPP_ALIGN(sizeof(AV1CDFs), 2048)));
+    BUF_CHECK(ret, mpp_buffer_get(p_hal->buf_group, &reg_ctx->prob_tbl_default, AV1_PROB_TBL_SIZE * TOKEN_CDF_Q_CTXS));
     BUF_CHECK(ret, mpp_buffer_get(p_hal->buf_group, &reg_ctx->tile_info, AV1_TILE_INFO_SIZE));
     BUF_CHECK(ret, mpp_buffer_get(p_hal->buf_group, &reg_ctx->film_grain_mem, MPP_ALIGN(sizeof(AV1FilmGrainMemory), 2048)));
     BUF_CHECK(ret, mpp_buffer_get(p_hal->buf_group, &reg_ctx->global_model, MPP_ALIGN(GLOBAL_MODEL_SIZE, 2048)));
@@ -242,6 +243,7 @@ static void hal_av1d_release_res(void *hal)
 
     BUF_PUT(reg_ctx->prob_tbl_base);
     BUF_PUT(reg_ctx->prob_tbl_out_base);
+    BUF_PUT(reg_ctx->prob_tbl_default);
     BUF_PUT(reg_ctx->tile_info);
     BUF_PUT(reg_ctx->film_grain_mem);
     BUF_PUT(reg_ctx->global_model);
@@ -270,8 +272,6 @@ MPP_RET vdpu_av1d_init(void *hal, MppHalCfg *cfg)
     {
         VdpuAv1dRegCtx *reg_ctx = (VdpuAv1dRegCtx *)p_hal->reg_ctx;
 
-        reg_ctx->cdfs = &reg_ctx->default_cdfs;
-        reg_ctx->cdfs_ndvc = &reg_ctx->default_cdfs_ndvc;
         reg_ctx->tile_transpose = 1;
     }
 
@@ -761,8 +761,31 @@ void vdpu_av1d_set_prob(Av1dHalCtx *p_hal, DXVA_PicParams_AV1 *dxva)
 {
     VdpuAv1dRegCtx *reg_ctx = (VdpuAv1dRegCtx *)p_hal->reg_ctx;
     const int mv_cdf_offset = offsetof(AV1CDFs, mv_cdf);
-    void* prob_base = mpp_buffer_get_ptr(reg_ctx->prob_tbl_base);
+    RK_U8 *prob_base = mpp_buffer_get_ptr(reg_ctx->prob_tbl_base);
     VdpuAv1dRegSet *regs = reg_ctx->regs;
+    RK_S32 idx = dxva->cdfs_default_idx;
+
+    regs->addr_cfg.swreg171.sw_prob_tab_out_base_lsb    = mpp_buffer_get_fd(reg_ctx->prob_tbl_out_base);
+
+    /*
+     * Frames resetting to the default cdfs point the hardware at a prebuilt
+     * image. The default intrabc mv cdfs equal the default mv cdfs so no mv
+     * area overwrite is needed for key and intra only frames.
+     */
+    if (idx >= 0 && idx < TOKEN_CDF_Q_CTXS) {
+        RK_U32 offset = idx * AV1_PROB_TBL_SIZE;
+        RK_U8 *img = (RK_U8 *)mpp_buffer_get_ptr(reg_ctx->prob_tbl_default) + offset;
+
+        if (!(reg_ctx->prob_tbl_default_valid & (1 << idx))) {
+            memcpy(img, dxva->cdfs, sizeof(AV1CDFs));
+            reg_ctx->prob_tbl_default_valid |= 1 << idx;
+        }
+
+        reg_ctx->prob_tbl_in = (RK_U32 *)img;
+        regs->addr_cfg.swreg173.sw_prob_tab_base_lsb    = mpp_buffer_get_fd(reg_ctx->prob_tbl_default);
+        mpp_dev_set_reg_offset(p_hal->dev, 173, offset);
+        return;
+    }
 
     memcpy(prob_base, dxva->cdfs, sizeof(AV1CDFs));
     if (dxva->format.frame_type == AV1_FRAME_INTRA_ONLY ||
@@ -771,7 +794,7 @@ void vdpu_av1d_set_prob(Av1dHalCtx *p_hal, DXVA_PicParams_AV1 *dxva)
         memcpy(prob_base + mv_cdf_offset, dxva->cdfs_ndvc, sizeof(MvCDFs));
     }
 
-    regs->addr_cfg.swreg171.sw_prob_tab_out_base_lsb    = mpp_buffer_get_fd(reg_ctx->prob_tbl_out_base);
+    reg_ctx->prob_tbl_in = (RK_U32 *)prob_base;
     regs->addr_cfg.swreg173.sw_prob_tab_base_lsb        = mpp_buffer_get_fd(reg_ctx->prob_tbl_base);
 }
 
@@ -1994,7 +2017,7 @@ MPP_RET vdpu_av1d_gen_regs(void *hal, HalTaskInfo *task)
         fflush(fp);
         fclose(fp);
 
-        data = mpp_buffer_get_ptr(ctx->prob_tbl_base);
+        data = ctx->prob_tbl_in;
         size = MPP_ALIGN(sizeof(AV1CDFs), 2048);
         memset(name, 0, sizeof(name));
         sprintf(name, "%s/prob_tbl_%d.txt", path, g_frame_num);
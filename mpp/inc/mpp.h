@@ -121,6 +121,12 @@ public:
     MPP_RET put_frame(MppFrame frame);
     MPP_RET get_packet(MppPacket *packet);
 
+    /* batch io, move up to count objects with one lock and one notify */
+    MPP_RET put_packets(MppPacket *packets, RK_S32 count, RK_S32 *done);
+    MPP_RET get_frames(MppFrame *frames, RK_S32 count, RK_S32 *done);
+    MPP_RET put_frames(MppFrame *frames, RK_S32 count, RK_S32 *done);
+    MPP_RET get_packets(MppPacket *packets, RK_S32 count, RK_S32 *done);
+
     MPP_RET poll(MppPortType type, MppPollType timeout);
     MPP_RET dequeue(MppPortType type, MppTask *task);
     MPP_RET enqueue(MppPortType type, MppTask task);
@@ -133,6 +139,9 @@ public:
     MPP_RET notify(RK_U32 flag);
     MPP_RET notify(MppBufferGroup group);
 
+    /* set MPP_EVENT_XXX flags and wake up user eventfd */
+    void signal_event(RK_U32 event);
+
     mpp_list        *mPktIn;
     mpp_list        *mPktOut;
     mpp_list        *mFrmIn;
@@ -197,6 +206,18 @@ public:
     /* dump info for debug */
     MppDump         mDump;
 
+    /* user event notification, eventfd is created on MPP_GET_EVENT_FD */
+    Mutex           mEventLock;
+    RK_S32          mEventFd;
+    RK_U32          mEventFlags;
+
+    /*
+     * user task io notify merged during batch io, indexed by MppPortType
+     * only the notify of the port held by a batch call is deferred
+     */
+    RK_U32          mNotifyHold[MPP_PORT_BUTT];
+    RK_U32          mNotifyPending[MPP_PORT_BUTT];
+
 private:
     void clear();
 
@@ -228,6 +249,12 @@ private:
     MPP_RET get_packet_async(MppPacket *packet);
 
     void set_io_mode(MppIoMode mode);
+    MPP_RET setup_frame_task(MppTask task, MppFrame frame);
+
+    MPP_RET notify_io(MppPortType type, RK_U32 flag);
+    void notify_hold(MppPortType type);
+    void notify_release(MppPortType type);
+    void notify_flush(MppPortType type);
 
     Mpp(const Mpp &);
     Mpp &operator=(const Mpp &);
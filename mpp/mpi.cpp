@@ -389,6 +389,102 @@ static MPP_RET mpi_control(MppCtx ctx, MpiCmd cmd, MppParam param)
     return ret;
 }
 
+static MPP_RET mpi_decode_put_packets(MppCtx ctx, MppPacket *packets, RK_S32 count, RK_S32 *done)
+{
+    MPP_RET ret = MPP_NOK;
+    MpiImpl *p = (MpiImpl *)ctx;
+
+    mpi_dbg_func("enter ctx %p packets %p count %d\n", ctx, packets, count);
+    do {
+        ret = check_mpp_ctx(p);
+        if (ret)
+            break;
+
+        if (NULL == packets || NULL == done || count <= 0) {
+            mpp_err_f("invalid packets %p count %d done %p\n", packets, count, done);
+            ret = MPP_ERR_NULL_PTR;
+            break;
+        }
+
+        ret = p->ctx->put_packets(packets, count, done);
+    } while (0);
+
+    mpi_dbg_func("leave ctx %p ret %d\n", ctx, ret);
+    return ret;
+}
+
+static MPP_RET mpi_decode_get_frames(MppCtx ctx, MppFrame *frames, RK_S32 count, RK_S32 *done)
+{
+    MPP_RET ret = MPP_NOK;
+    MpiImpl *p = (MpiImpl *)ctx;
+
+    mpi_dbg_func("enter ctx %p frames %p count %d\n", ctx, frames, count);
+    do {
+        ret = check_mpp_ctx(p);
+        if (ret)
+            break;
+
+        if (NULL == frames || NULL == done || count <= 0) {
+            mpp_err_f("invalid frames %p count %d done %p\n", frames, count, done);
+            ret = MPP_ERR_NULL_PTR;
+            break;
+        }
+
+        ret = p->ctx->get_frames(frames, count, done);
+    } while (0);
+
+    mpi_dbg_func("leave ctx %p ret %d\n", ctx, ret);
+    return ret;
+}
+
+static MPP_RET mpi_encode_put_frames(MppCtx ctx, MppFrame *frames, RK_S32 count, RK_S32 *done)
+{
+    MPP_RET ret = MPP_NOK;
+    MpiImpl *p = (MpiImpl *)ctx;
+
+    mpi_dbg_func("enter ctx %p frames %p count %d\n", ctx, frames, count);
+    do {
+        ret = check_mpp_ctx(p);
+        if (ret)
+            break;
+
+        if (NULL == frames || NULL == done || count <= 0) {
+            mpp_err_f("invalid frames %p count %d done %p\n", frames, count, done);
+            ret = MPP_ERR_NULL_PTR;
+            break;
+        }
+
+        ret = p->ctx->put_frames(frames, count, done);
+    } while (0);
+
+    mpi_dbg_func("leave ctx %p ret %d\n", ctx, ret);
+    return ret;
+}
+
+static MPP_RET mpi_encode_get_packets(MppCtx ctx, MppPacket *packets, RK_S32 count, RK_S32 *done)
+{
+    MPP_RET ret = MPP_NOK;
+    MpiImpl *p = (MpiImpl *)ctx;
+
+    mpi_dbg_func("enter ctx %p packets %p count %d\n", ctx, packets, count);
+    do {
+        ret = check_mpp_ctx(p);
+        if (ret)
+            break;
+
+        if (NULL == packets || NULL == done || count <= 0) {
+            mpp_err_f("invalid packets %p count %d done %p\n", packets, count, done);
+            ret = MPP_ERR_NULL_PTR;
+            break;
+        }
+
+        ret = p->ctx->get_packets(packets, count, done);
+    } while (0);
+
+    mpi_dbg_func("leave ctx %p ret %d\n", ctx, ret);
+    return ret;
+}
+
 static MppApi mpp_api = {
     sizeof(mpp_api),
     0,
@@ -406,6 +502,10 @@ static MppApi mpp_api = {
     mpi_enqueue,
     mpi_reset,
     mpi_control,
+    mpi_decode_put_packets,
+    mpi_decode_get_frames,
+    mpi_encode_put_frames,
+    mpi_encode_get_packets,
     {0},
 };
 
@@ -23,10 +23,13 @@
 
 #include "mpp_mem.h"
 #include "mpp_env.h"
+#include "mpp_lock.h"
 #include "mpp_time.h"
 #include "mpp_impl.h"
 #include "mpp_2str.h"
 #include "mpp_debug.h"
+#include "mpp_trace.h"
+#include "mpp_eventfd.h"
 
 #include "mpp.h"
 #include "mpp_hal.h"
@@ -41,6 +44,9 @@
 #define MPP_TEST_FRAME_SIZE     SZ_1M
 #define MPP_TEST_PACKET_SIZE    SZ_512K
 
+/* max task count moved by one batch io round */
+#define MPP_IO_BATCH_MAX        16
+
 static void mpp_notify_by_buffer_group(void *arg, void *group)
 {
     Mpp *mpp = (Mpp *)arg;
@@ -60,6 +66,32 @@ static void *list_wraper_frame(void *arg)
     return NULL;
 }
 
+static MPP_RET mpp_notify_by_port(const char *caller, void *ctx, RK_S32 cmd, void *param)
+{
+    Mpp *mpp = (Mpp *)ctx;
+    (void) caller;
+    (void) param;
+
+    mpp->signal_event(cmd);
+    return MPP_OK;
+}
+
+static void mpp_setup_port_notify(Mpp *mpp)
+{
+    MppCbCtx cb;
+
+    cb.callBack = mpp_notify_by_port;
+    cb.ctx = mpp;
+
+    /* task enqueued back to user input port frees one input slot */
+    cb.cmd = MPP_EVENT_INPUT_SPACE;
+    mpp_port_set_notify(mpp->mMppInPort, &cb);
+
+    /* task enqueued to user output port means output ready */
+    cb.cmd = MPP_EVENT_OUTPUT_READY;
+    mpp_port_set_notify(mpp->mMppOutPort, &cb);
+}
+
 static RK_S32 check_frm_task_cnt_cap(MppCodingType coding)
 {
     if (strstr(mpp_get_soc_name(), "rk3588")) {
@@ -107,6 +139,8 @@ Mpp::Mpp(MppCtx ctx)
       mIoMode(MPP_IO_MODE_DEFAULT),
       mDisableThread(0),
       mDump(NULL),
+      mEventFd(-1),
+      mEventFlags(0),
       mType(MPP_CTX_BUTT),
       mCoding(MPP_VIDEO_CodingUnused),
       mInitDone(0),
@@ -115,6 +149,8 @@ Mpp::Mpp(MppCtx ctx)
 {
     mpp_env_get_u32("mpp_debug", &mpp_debug, 0);
 
+    memset(mNotifyHold, 0, sizeof(mNotifyHold));
+    memset(mNotifyPending, 0, sizeof(mNotifyPending));
     memset(&mDecInitcfg, 0, sizeof(mDecInitcfg));
     mpp_dec_cfg_set_default(&mDecInitcfg);
     mDecInitcfg.base.enable_vproc = MPP_VPROC_MODE_DEINTELACE;
@@ -174,6 +210,7 @@ MPP_RET Mpp::init(MppCtxType type, MppCodingType coding)
         mUsrOutPort = mpp_task_queue_get_port(mOutputTaskQueue, MPP_PORT_OUTPUT);
         mMppInPort  = mpp_task_queue_get_port(mInputTaskQueue,  MPP_PORT_OUTPUT);
         mMppOutPort = mpp_task_queue_get_port(mOutputTaskQueue, MPP_PORT_INPUT);
+        mpp_setup_port_notify(this);
 
         mDecInitcfg.base.disable_thread = mDisableThread;
         mDecInitcfg.base.change |= MPP_DEC_CFG_CHANGE_DISABLE_THREAD;
@@ -224,6 +261,7 @@ MPP_RET Mpp::init(MppCtxType type, MppCodingType coding)
         mUsrOutPort = mpp_task_queue_get_port(mOutputTaskQueue, MPP_PORT_OUTPUT);
         mMppInPort  = mpp_task_queue_get_port(mInputTaskQueue,  MPP_PORT_OUTPUT);
         mMppOutPort = mpp_task_queue_get_port(mOutputTaskQueue, MPP_PORT_INPUT);
+        mpp_setup_port_notify(this);
 
         MppEncInitCfg cfg = {
             coding,
@@ -333,6 +371,18 @@ void Mpp::clear()
     }
 
     mpp_dump_deinit(&mDump);
+
+    /* write out the trace file on each context quit */
+    mpp_trace_flush();
+
+    {
+        AutoMutex auto_lock(&mEventLock);
+
+        if (mEventFd >= 0) {
+            mpp_eventfd_put(mEventFd);
+            mEventFd = -1;
+        }
+    }
 }
 
 MPP_RET Mpp::start()
@@ -363,7 +413,7 @@ MPP_RET Mpp::put_packet(MppPacket packet)
     MPP_RET ret = MPP_NOK;
     MppPollType timeout = mInputTimeout;
     MppTask task_dequeue = NULL;
-    RK_U32 pkt_copy = 0;
+    MppPacket pkt_in = NULL;
 
     if (mDisableThread) {
         mpp_err_f("no thread decoding case MUST use mpi_decode interface\n");
@@ -419,20 +469,14 @@ MPP_RET Mpp::put_packet(MppPacket packet)
         }
     }
 
-    if (NULL == mpp_packet_get_buffer(packet)) {
-        /* packet copy path */
-        MppPacket pkt_in = NULL;
-
-        mpp_packet_copy_init(&pkt_in, packet);
-        mpp_packet_set_length(packet, 0);
-        pkt_copy = 1;
-        packet = pkt_in;
-        ret = MPP_OK;
-    } else {
-        /* packet zero copy path */
-        mpp_log_f("not support zero copy path\n");
-        timeout = MPP_POLL_BLOCK;
-    }
+    /*
+     * When packet has MppBuffer (zero copy path) only a new reference of the
+     * buffer is taken without copying stream data. The buffer is returned to
+     * caller after both parser and hal have released it.
+     */
+    mpp_packet_copy_init(&pkt_in, packet);
+    mpp_packet_set_length(packet, 0);
+    packet = pkt_in;
 
     /* setup task */
     ret = mpp_task_meta_set_packet(task_dequeue, KEY_INPUT_PACKET, packet);
@@ -444,6 +488,7 @@ MPP_RET Mpp::put_packet(MppPacket packet)
     }
 
     mpp_ops_dec_put_pkt(mDump, packet);
+    mpp_trace_point("put_packet", this, mpp_packet_get_pts(packet));
 
     /* enqueue valid task to decoder */
     ret = enqueue(MPP_PORT_INPUT, task_dequeue);
@@ -454,9 +499,6 @@ MPP_RET Mpp::put_packet(MppPacket packet)
 
     mPacketPutCount++;
 
-    if (timeout && !pkt_copy)
-        ret = poll(MPP_PORT_INPUT, timeout);
-
 RET:
     /* wait enqueued task finished */
     if (NULL == mInputTask) {
@@ -522,6 +564,209 @@ MPP_RET Mpp::get_frame(MppFrame *frame)
 
     // dump output
     mpp_ops_dec_get_frm(mDump, frm);
+    if (frm)
+        mpp_trace_point("get_frame", this, mpp_frame_get_pts(frm));
+
+    return MPP_OK;
+}
+
+MPP_RET Mpp::put_packets(MppPacket *packets, RK_S32 count, RK_S32 *done)
+{
+    MppTask tasks[MPP_IO_BATCH_MAX];
+    MPP_RET ret = MPP_OK;
+    RK_S32 i = 0;
+
+    if (!mInitDone)
+        return MPP_ERR_INIT;
+
+    *done = 0;
+
+    if (mDisableThread) {
+        mpp_err_f("no thread decoding case MUST use mpi_decode interface\n");
+        return MPP_NOK;
+    }
+
+    if (mExtraPacket) {
+        MppPacket extra = mExtraPacket;
+
+        mExtraPacket = NULL;
+        put_packet(extra);
+    }
+
+    set_io_mode(MPP_IO_MODE_TASK);
+
+    /*
+     * Each round takes the packets up to the next eos and sends them with one
+     * dequeue and one enqueue on the user input port. The decoder is notified
+     * at the end of each round so no notify is pending on the blocking poll.
+     */
+    while (i < count) {
+        RK_S32 num = 0;
+        RK_S32 cnt = 0;
+        RK_S32 eos = 0;
+        RK_S32 j;
+
+        /* handle eos packet on block mode */
+        if (!mEosTask) {
+            ret = mpp_port_poll(mUsrInPort, MPP_POLL_BLOCK);
+            if (ret < 0)
+                break;
+
+            mpp_port_dequeue(mUsrInPort, &mEosTask);
+            if (NULL == mEosTask) {
+                mpp_err_f("fail to reserve eos task\n");
+                ret = MPP_NOK;
+                break;
+            }
+        }
+
+        while (num < MPP_IO_BATCH_MAX && i + num < count) {
+            eos = mpp_packet_get_eos(packets[i + num++]);
+            if (eos)
+                break;
+        }
+
+        /* the eos packet takes the reserved eos task */
+        if (eos)
+            num--;
+
+        if (num && mInputTask) {
+            tasks[cnt++] = mInputTask;
+            mInputTask = NULL;
+        }
+
+        if (cnt < num) {
+            RK_S32 got = 0;
+
+            if (!cnt && mpp_port_poll(mUsrInPort, MPP_POLL_NON_BLOCK) < 0 &&
+                mpp_port_poll(mUsrInPort, mInputTimeout) < 0) {
+                ret = MPP_ERR_BUFFER_FULL;
+                break;
+            }
+
+            mpp_port_dequeue_batch(mUsrInPort, tasks + cnt, num - cnt, &got);
+            cnt += got;
+        }
+
+        if (cnt == num && eos) {
+            tasks[cnt++] = mEosTask;
+            mEosTask = NULL;
+            num++;
+        } else {
+            num = cnt;
+        }
+
+        if (!num) {
+            ret = MPP_ERR_BUFFER_FULL;
+            break;
+        }
+
+        for (j = 0; j < num; j++) {
+            MppPacket pkt_in = NULL;
+
+            mpp_packet_copy_init(&pkt_in, packets[i + j]);
+            ret = mpp_task_meta_set_packet(tasks[j], KEY_INPUT_PACKET, pkt_in);
+            if (ret) {
+                mpp_err_f("set input packet to task ret %d\n", ret);
+                mpp_packet_deinit(&pkt_in);
+                break;
+            }
+
+            mpp_packet_set_length(packets[i + j], 0);
+            mpp_ops_dec_put_pkt(mDump, pkt_in);
+            mpp_trace_point("put_packet", this, mpp_packet_get_pts(pkt_in));
+        }
+
+        /* return the tasks not filled to the user input port */
+        for (cnt = j; cnt < num; cnt++) {
+            if (!mEosTask)
+                mEosTask = tasks[cnt];
+            else if (!mInputTask)
+                mInputTask = tasks[cnt];
+            else
+                mpp_port_move(mUsrInPort, tasks[cnt], MPP_INPUT_PORT);
+        }
+
+        if (j) {
+            mpp_port_enqueue_batch(mUsrInPort, tasks, j);
+            mPacketPutCount += j;
+            i += j;
+            notify(MPP_INPUT_DEQUEUE | MPP_INPUT_ENQUEUE);
+        }
+
+        if (ret)
+            break;
+
+        ret = MPP_OK;
+    }
+
+    /* reserve one task for eos block mode */
+    if (NULL == mInputTask && mpp_port_poll(mUsrInPort, MPP_POLL_NON_BLOCK) >= 0) {
+        dequeue(MPP_PORT_INPUT, &mInputTask);
+        mpp_assert(mInputTask);
+    }
+
+    *done = i;
+
+    /* partial done is success and the caller retries the rest later */
+    return (i && ret == MPP_ERR_BUFFER_FULL) ? MPP_OK : ret;
+}
+
+MPP_RET Mpp::get_frames(MppFrame *frames, RK_S32 count, RK_S32 *done)
+{
+    RK_S32 cnt = 0;
+
+    if (!mInitDone)
+        return MPP_ERR_INIT;
+
+    *done = 0;
+
+    {
+        AutoMutex autoFrameLock(mFrmOut->mutex());
+
+        if (0 == mFrmOut->list_size() && mOutputTimeout) {
+            if (mOutputTimeout < 0) {
+                mFrmOut->wait();
+            } else {
+                RK_S32 ret = mFrmOut->wait(mOutputTimeout);
+
+                if (ret)
+                    return (ret == ETIMEDOUT) ? MPP_ERR_TIMEOUT : MPP_NOK;
+            }
+        }
+
+        while (cnt < count && mFrmOut->list_size()) {
+            MppFrame frm = NULL;
+            MppBuffer buffer;
+
+            mFrmOut->del_at_head(&frm, sizeof(frm));
+            mFrameGetCount++;
+
+            buffer = mpp_frame_get_buffer(frm);
+            if (buffer)
+                mpp_buffer_sync_ro_begin(buffer);
+
+            frames[cnt++] = frm;
+        }
+
+        if (cnt)
+            notify(MPP_OUTPUT_DEQUEUE);
+    }
+
+    if (!cnt) {
+        /* same as get_frame for parser waiting on info change */
+        AutoMutex autoPacketLock(mPktIn->mutex());
+
+        if (mPktIn->list_size())
+            notify(MPP_INPUT_ENQUEUE);
+    }
+
+    *done = cnt;
+    while (cnt--) {
+        mpp_ops_dec_get_frm(mDump, *frames);
+        mpp_trace_point("get_frame", this, mpp_frame_get_pts(*frames));
+        frames++;
+    }
 
     return MPP_OK;
 }
@@ -615,6 +860,46 @@ MPP_RET Mpp::decode(MppPacket packet, MppFrame *frame)
     return ret;
 }
 
+MPP_RET Mpp::setup_frame_task(MppTask task, MppFrame frame)
+{
+    MPP_RET ret = mpp_task_meta_set_frame(task, KEY_INPUT_FRAME, frame);
+
+    if (ret) {
+        mpp_log_f("set input frame to task ret %d\n", ret);
+        return ret;
+    }
+
+    if (mpp_frame_has_meta(frame)) {
+        MppMeta meta = mpp_frame_get_meta(frame);
+        MppPacket packet = NULL;
+        MppBuffer md_info_buf = NULL;
+
+        mpp_meta_get_packet(meta, KEY_OUTPUT_PACKET, &packet);
+        if (packet) {
+            ret = mpp_task_meta_set_packet(task, KEY_OUTPUT_PACKET, packet);
+            if (ret) {
+                mpp_log_f("set output packet to task ret %d\n", ret);
+                return ret;
+            }
+        }
+
+        mpp_meta_get_buffer(meta, KEY_MOTION_INFO, &md_info_buf);
+        if (md_info_buf) {
+            ret = mpp_task_meta_set_buffer(task, KEY_MOTION_INFO, md_info_buf);
+            if (ret) {
+                mpp_log_f("set output motion dection info ret %d\n", ret);
+                return ret;
+            }
+        }
+    }
+
+    // dump input
+    mpp_ops_enc_put_frm(mDump, frame);
+    mpp_trace_point("put_frame", this, mpp_frame_get_pts(frame));
+
+    return MPP_OK;
+}
+
 MPP_RET Mpp::put_frame(MppFrame frame)
 {
     if (!mInitDone)
@@ -658,38 +943,9 @@ MPP_RET Mpp::put_frame(MppFrame frame)
     mpp_assert(mInputTask);
 
     /* setup task */
-    ret = mpp_task_meta_set_frame(mInputTask, KEY_INPUT_FRAME, frame);
-    if (ret) {
-        mpp_log_f("set input frame to task ret %d\n", ret);
+    ret = setup_frame_task(mInputTask, frame);
+    if (ret)
         goto RET;
-    }
-
-    if (mpp_frame_has_meta(frame)) {
-        MppMeta meta = mpp_frame_get_meta(frame);
-        MppPacket packet = NULL;
-        MppBuffer md_info_buf = NULL;
-
-        mpp_meta_get_packet(meta, KEY_OUTPUT_PACKET, &packet);
-        if (packet) {
-            ret = mpp_task_meta_set_packet(mInputTask, KEY_OUTPUT_PACKET, packet);
-            if (ret) {
-                mpp_log_f("set output packet to task ret %d\n", ret);
-                goto RET;
-            }
-        }
-
-        mpp_meta_get_buffer(meta, KEY_MOTION_INFO, &md_info_buf);
-        if (md_info_buf) {
-            ret = mpp_task_meta_set_buffer(mInputTask, KEY_MOTION_INFO, md_info_buf);
-            if (ret) {
-                mpp_log_f("set output motion dection info ret %d\n", ret);
-                goto RET;
-            }
-        }
-    }
-
-    // dump input
-    mpp_ops_enc_put_frm(mDump, frame);
 
     /* enqueue valid task to encoder */
     mpp_stopwatch_record(stopwatch, "input port user enqueue");
@@ -783,6 +1039,7 @@ MPP_RET Mpp::get_packet(MppPacket *packet)
 
     // dump output
     mpp_ops_enc_get_pkt(mDump, pkt);
+    mpp_trace_point("get_packet", this, mpp_packet_get_pts(pkt));
 
     ret = enqueue(MPP_PORT_OUTPUT, task);
     if (ret)
@@ -792,6 +1049,173 @@ RET:
     return ret;
 }
 
+MPP_RET Mpp::put_frames(MppFrame *frames, RK_S32 count, RK_S32 *done)
+{
+    MPP_RET ret = MPP_OK;
+    RK_S32 i = 0;
+
+    if (!mInitDone)
+        return MPP_ERR_INIT;
+
+    *done = 0;
+
+    if (mInputTimeout == MPP_POLL_NON_BLOCK) {
+        set_io_mode(MPP_IO_MODE_NORMAL);
+
+        if (NULL == mFrmIn || mFrmIn->trylock())
+            return MPP_NOK;
+
+        /* keep the same input queue limit as put_frame_async */
+        if (mFrmIn->wait_le(10, 1)) {
+            mFrmIn->unlock();
+            return MPP_NOK;
+        }
+
+        for (i = 0; i < count && mFrmIn->list_size() <= 1; i++) {
+            mFrmIn->add_at_tail(&frames[i], sizeof(frames[i]));
+            mFramePutCount++;
+            mpp_trace_point("put_frame", this, mpp_frame_get_pts(frames[i]));
+        }
+
+        notify(MPP_INPUT_ENQUEUE);
+        mFrmIn->unlock();
+    } else {
+        MppTask tasks[MPP_IO_BATCH_MAX];
+
+        set_io_mode(MPP_IO_MODE_TASK);
+
+        /*
+         * block mode sends all free tasks with one enqueue and waits for all
+         * of them to be taken by encoder before return like put_frame does
+         */
+        while (i < count) {
+            RK_S32 num = MPP_MIN(count - i, MPP_IO_BATCH_MAX);
+            RK_S32 cnt = 0;
+            RK_S32 back = 0;
+            RK_S32 j;
+
+            if (mInputTask) {
+                tasks[cnt++] = mInputTask;
+                mInputTask = NULL;
+            }
+
+            if (cnt < num) {
+                RK_S32 got = 0;
+
+                if (!cnt && mpp_port_poll(mUsrInPort, mInputTimeout) < 0) {
+                    ret = MPP_NOK;
+                    break;
+                }
+
+                mpp_port_dequeue_batch(mUsrInPort, tasks + cnt, num - cnt, &got);
+                cnt += got;
+            }
+
+            for (j = 0; j < cnt; j++) {
+                ret = setup_frame_task(tasks[j], frames[i + j]);
+                if (ret)
+                    break;
+            }
+
+            if (j)
+                mpp_port_enqueue_batch(mUsrInPort, tasks, j);
+
+            /* keep one unused task for next put and return the others */
+            for (back = j; back < cnt; back++) {
+                if (!mInputTask)
+                    mInputTask = tasks[back];
+                else
+                    mpp_port_move(mUsrInPort, tasks[back], MPP_INPUT_PORT);
+            }
+
+            if (!j)
+                break;
+
+            notify(MPP_INPUT_DEQUEUE | MPP_INPUT_ENQUEUE);
+
+            /* wait enqueued tasks finished */
+            for (back = 0; back < j; back++) {
+                MppTask task = NULL;
+
+                if (mpp_port_poll(mUsrInPort, mInputTimeout) < 0 ||
+                    mpp_port_dequeue(mUsrInPort, &task) || NULL == task) {
+                    mpp_log_f("wait task back failed on timeout %d\n", mInputTimeout);
+                    ret = MPP_NOK;
+                    break;
+                }
+
+                if (!mInputTask)
+                    mInputTask = task;
+                else
+                    mpp_port_move(mUsrInPort, task, MPP_INPUT_PORT);
+            }
+
+            i += j;
+
+            if (ret)
+                break;
+        }
+    }
+
+    *done = i;
+
+    return i ? MPP_OK : ret;
+}
+
+MPP_RET Mpp::get_packets(MppPacket *packets, RK_S32 count, RK_S32 *done)
+{
+    MPP_RET ret = MPP_OK;
+    RK_S32 cnt = 0;
+
+    if (!mInitDone)
+        return MPP_ERR_INIT;
+
+    *done = 0;
+
+    if (mInputTimeout == MPP_POLL_NON_BLOCK) {
+        set_io_mode(MPP_IO_MODE_NORMAL);
+
+        ret = get_packet_async(&packets[0]);
+        if (ret || NULL == packets[0])
+            return ret;
+
+        cnt = 1;
+        {
+            AutoMutex autoPacketLock(mPktOut->mutex());
+
+            while (cnt < count && mPktOut->list_size()) {
+                mPktOut->del_at_head(&packets[cnt], sizeof(packets[cnt]));
+                mPacketGetCount++;
+                mpp_trace_point("get_packet", this, mpp_packet_get_pts(packets[cnt]));
+                cnt++;
+            }
+
+            if (cnt > 1)
+                notify(MPP_OUTPUT_DEQUEUE);
+        }
+    } else {
+        notify_hold(MPP_PORT_OUTPUT);
+
+        while (cnt < count) {
+            /* only the first packet waits for output timeout */
+            if (cnt && mpp_port_poll(mUsrOutPort, MPP_POLL_NON_BLOCK) < 0)
+                break;
+
+            ret = get_packet(&packets[cnt]);
+            if (ret || NULL == packets[cnt])
+                break;
+
+            cnt++;
+        }
+
+        notify_release(MPP_PORT_OUTPUT);
+    }
+
+    *done = cnt;
+
+    return cnt ? MPP_OK : ret;
+}
+
 MPP_RET Mpp::put_frame_async(MppFrame frame)
 {
     if (NULL == mFrmIn)
@@ -808,6 +1232,7 @@ MPP_RET Mpp::put_frame_async(MppFrame frame)
 
     mFrmIn->add_at_tail(&frame, sizeof(frame));
     mFramePutCount++;
+    mpp_trace_point("put_frame", this, mpp_frame_get_pts(frame));
 
     notify(MPP_INPUT_ENQUEUE);
     mFrmIn->unlock();
@@ -846,6 +1271,7 @@ MPP_RET Mpp::get_packet_async(MppPacket *packet)
         mPktOut->del_at_head(&pkt, sizeof(pkt));
         mPacketGetCount++;
         notify(MPP_OUTPUT_DEQUEUE);
+        mpp_trace_point("get_packet", this, mpp_packet_get_pts(pkt));
 
         *packet = pkt;
     } else {
@@ -914,7 +1340,7 @@ MPP_RET Mpp::dequeue(MppPortType type, MppTask *task)
     if (port) {
         ret = mpp_port_dequeue(port, task);
         if (MPP_OK == ret)
-            notify(notify_flag);
+            notify_io(type, notify_flag);
     }
 
     return ret;
@@ -948,12 +1374,48 @@ MPP_RET Mpp::enqueue(MppPortType type, MppTask task)
         ret = mpp_port_enqueue(port, task);
         // if enqueue success wait up thread
         if (MPP_OK == ret)
-            notify(notify_flag);
+            notify_io(type, notify_flag);
     }
 
     return ret;
 }
 
+MPP_RET Mpp::notify_io(MppPortType type, RK_U32 flag)
+{
+    if (mNotifyHold[type]) {
+        MPP_FETCH_OR(&mNotifyPending[type], flag);
+
+        /* the batch may be released between the check and the or */
+        if (mNotifyHold[type])
+            return MPP_OK;
+
+        flag = MPP_FETCH_AND(&mNotifyPending[type], 0);
+        if (!flag)
+            return MPP_OK;
+    }
+
+    return notify(flag);
+}
+
+void Mpp::notify_hold(MppPortType type)
+{
+    MPP_FETCH_ADD(&mNotifyHold[type], 1);
+}
+
+void Mpp::notify_release(MppPortType type)
+{
+    MPP_FETCH_SUB(&mNotifyHold[type], 1);
+    notify_flush(type);
+}
+
+void Mpp::notify_flush(MppPortType type)
+{
+    RK_U32 flag = MPP_FETCH_AND(&mNotifyPending[type], 0);
+
+    if (flag)
+        notify(flag);
+}
+
 void Mpp::set_io_mode(MppIoMode mode)
 {
     mpp_assert(mode == MPP_IO_MODE_NORMAL || mode == MPP_IO_MODE_TASK);
@@ -1122,6 +1584,48 @@ MPP_RET Mpp::control_mpp(MpiCmd cmd, MppParam param)
             mOutputTimeout = timeout;
     } break;
 
+    case MPP_GET_EVENT_FD : {
+        if (NULL == param) {
+            ret = MPP_ERR_NULL_PTR;
+            break;
+        }
+
+        AutoMutex auto_lock(&mEventLock);
+
+        if (mEventFd < 0) {
+            RK_S32 fd = mpp_eventfd_get(0);
+
+            if (fd < 0) {
+                mpp_err("failed to create eventfd ret %d\n", fd);
+                ret = MPP_NOK;
+                break;
+            }
+
+            mEventFd = fd;
+            /* let user try io once as events before this point are lost */
+            signal_event(MPP_EVENT_OUTPUT_READY | MPP_EVENT_INPUT_SPACE);
+        }
+
+        *((RK_S32 *)param) = mEventFd;
+    } break;
+    case MPP_GET_EVENT : {
+        if (NULL == param) {
+            ret = MPP_ERR_NULL_PTR;
+            break;
+        }
+
+        /*
+         * clear eventfd before flags. The event set after the flags are
+         * cleared will write eventfd again.
+         */
+        AutoMutex auto_lock(&mEventLock);
+
+        if (mEventFd >= 0)
+            mpp_eventfd_read(mEventFd, NULL, 0);
+
+        *((RK_U32 *)param) = MPP_FETCH_AND(&mEventFlags, 0);
+    } break;
+
     case MPP_START : {
         start();
     } break;
@@ -1324,6 +1828,15 @@ MPP_RET Mpp::notify(RK_U32 flag)
     return MPP_NOK;
 }
 
+void Mpp::signal_event(RK_U32 event)
+{
+    AutoMutex auto_lock(&mEventLock);
+
+    /* only the first flag set after clear needs to wake up user */
+    if (mEventFd >= 0 && !MPP_FETCH_OR(&mEventFlags, event))
+        mpp_eventfd_write(mEventFd, 1);
+}
+
 MPP_RET Mpp::notify(MppBufferGroup group)
 {
     MPP_RET ret = MPP_NOK;
@@ -0,0 +1,33 @@
+/*
+ * Copyright 2010 Rockchip Electronics S.LSI Co. LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __VERSION_H__
+#define __VERSION_H__
+
+#define	MPP_VERSION             "9f1af9c author: agent          2026-10-16 [user-012] fix: release the vp9 async adapt wait on skip and error paths"
+#define	MPP_VER_HIST_CNT        10
+#define	MPP_VER_HIST_0          "9f1af9c author: agent          2026-10-16 [user-012] fix: release the vp9 async adapt wait on skip and error paths  (HEAD -> master)"
+#define	MPP_VER_HIST_1          "269d9ca author: agent          2026-10-16 [user-023] fix: test the incremental roi write against a full write"
+#define	MPP_VER_HIST_2          "7cc5004 author: agent          2026-10-16 [user-017] fix: signal input space on enqueue only and lock the event fd"
+#define	MPP_VER_HIST_3          "b491f55 author: agent          2026-10-16 [user-006] fix: export the buffer group trim control"
+#define	MPP_VER_HIST_4          "5318622 author: agent          2026-10-16 [user-007] fix: delete the mem pool thread cache key with the service"
+#define	MPP_VER_HIST_5          "47f0219 author: agent          2026-10-16 [user-003] fix: release the zero copy packet buffer on parser thread exit"
+#define	MPP_VER_HIST_6          "986d85d author: agent          2026-10-16 [user-005] fix: use unsigned class mask shifts and recheck ref_count on release"
+#define	MPP_VER_HIST_7          "d26067e author: agent          2026-10-16 [user-002] fix: drop the nalu span when the eos nalu is stored"
+#define	MPP_VER_HIST_8          "0c90d31 author: agent          2026-10-16 [user-001] fix: restore parser prepare throughput benchmark for all split paths"
+#define	MPP_VER_HIST_9          "7bec756 author: agent          2026-10-16 [user-016] fix: use a generated const flat trie for the cfg services"
+
+#endif /*__VERSION_H__*/
@@ -20,6 +20,7 @@
 
 #include "mpp_env.h"
 #include "mpp_mem.h"
+#include "mpp_trace.h"
 #include "mpp_common.h"
 
 #include "mpp_dec_impl.h"
@@ -119,11 +120,14 @@ static void dec_vproc_put_frame(Mpp *mpp, MppFrame frame, MppBuffer buf, RK_S64
     list->add_at_tail(&out, sizeof(out));
 
     mpp_dbg_pts("output frame pts %lld\n", mpp_frame_get_pts(out));
+    mpp_trace_point("display", mpp, mpp_frame_get_pts(out));
 
     mpp->mFramePutCount++;
     list->signal();
     list->unlock();
 
+    mpp->signal_event(MPP_EVENT_OUTPUT_READY | (err ? MPP_EVENT_ERROR : 0));
+
     if (mpp->mDec)
         mpp_dec_callback(mpp->mDec, MPP_DEC_EVENT_ON_FRM_READY, out);
 }
@@ -19,13 +19,21 @@
 #include "os_mem.h"
 #include "mpp_mem.h"
 #include "mpp_debug.h"
+#include "mpp_loopback_api.h"
 
 #include "allocator_std.h"
 
+/*
+ * dummy fd for cpu memory buffer. Start above the kernel fs.nr_open limit so
+ * that it never matches a real file descriptor of the process.
+ */
+#define STD_FD_BASE         (0x40000000)
+#define STD_FD_MASK         (0x3fffffff)
+
 typedef struct {
     size_t              alignment;
     MppAllocFlagType    flags;
-    RK_S32              fd_count;
+    RK_U32              fd_count;
 } allocator_ctx;
 
 static MPP_RET allocator_std_open(void **ctx, size_t alignment, MppAllocFlagType flags)
@@ -57,10 +65,25 @@ static MPP_RET allocator_std_alloc(void *ctx, MppBufferInfo *info)
         return MPP_ERR_NULL_PTR;
     }
 
-    mpp_err_f("Warning: std allocator should be used on simulation mode only\n");
-    (void)info;
+    allocator_ctx *p = (allocator_ctx *)ctx;
+    void *ptr = NULL;
+
+    /* only loopback device can work on cpu memory without real fd */
+    if (!mpp_loopback_enabled()) {
+        mpp_err_f("Warning: std allocator should be used on simulation mode only\n");
+        return MPP_NOK;
+    }
+
+    if (os_malloc(&ptr, p->alignment, info->size) || NULL == ptr) {
+        mpp_err_f("failed to malloc size %d\n", (RK_S32)info->size);
+        return MPP_ERR_MALLOC;
+    }
 
-    return MPP_NOK;
+    info->ptr   = ptr;
+    info->hnd   = NULL;
+    info->fd    = STD_FD_BASE + (p->fd_count++ & STD_FD_MASK);
+
+    return MPP_OK;
 }
 
 static MPP_RET allocator_std_free(void *ctx, MppBufferInfo *info)
@@ -78,7 +101,7 @@ static MPP_RET allocator_std_import(void *ctx, MppBufferInfo *info)
     mpp_assert(info->ptr);
     mpp_assert(info->size);
     info->hnd   = NULL;
-    info->fd    = p->fd_count++;
+    info->fd    = STD_FD_BASE + (p->fd_count++ & STD_FD_MASK);
     return MPP_OK;
 }
 
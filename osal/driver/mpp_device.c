@@ -25,6 +25,7 @@
 #include "mpp_platform.h"
 #include "mpp_device_debug.h"
 #include "mpp_service_api.h"
+#include "mpp_loopback_api.h"
 #include "vcodec_service_api.h"
 
 typedef struct MppDevImpl_t {
@@ -47,29 +48,37 @@ MPP_RET mpp_dev_init(MppDev *ctx, MppClientType type)
 
     *ctx = NULL;
 
-    RK_U32 codec_type = mpp_get_vcodec_type();
-    if (!(codec_type & (1 << type))) {
-        mpp_err_f("found unsupported client type %d in platform %x\n",
-                  type, codec_type);
-        return MPP_ERR_VALUE;
-    }
-
-    MppIoctlVersion ioctl_version = mpp_get_ioctl_version();
     const MppDevApi *api = NULL;
 
-    switch (ioctl_version) {
-    case IOCTL_VCODEC_SERVICE : {
-        api = &vcodec_service_api;
-    } break;
-    case IOCTL_MPP_SERVICE_V1 : {
-        api = &mpp_service_api;
-    } break;
-    default : {
-        mpp_err_f("invalid ioctl verstion %d\n", ioctl_version);
-        return MPP_NOK;
-    } break;
+    if (mpp_loopback_enabled()) {
+        /* loopback device accepts any client without kernel driver */
+        api = &mpp_loopback_api;
+    } else {
+        RK_U32 codec_type = mpp_get_vcodec_type();
+        if (!(codec_type & (1 << type))) {
+            mpp_err_f("found unsupported client type %d in platform %x\n",
+                      type, codec_type);
+            return MPP_ERR_VALUE;
+        }
+
+        MppIoctlVersion ioctl_version = mpp_get_ioctl_version();
+
+        switch (ioctl_version) {
+        case IOCTL_VCODEC_SERVICE : {
+            api = &vcodec_service_api;
+        } break;
+        case IOCTL_MPP_SERVICE_V1 : {
+            api = &mpp_service_api;
+        } break;
+        default : {
+            mpp_err_f("invalid ioctl verstion %d\n", ioctl_version);
+            return MPP_NOK;
+        } break;
+        }
     }
 
+    mpp_dev_dbg_probe("client %d use %s device\n", type, api->name);
+
     MppDevImpl *impl = mpp_calloc(MppDevImpl, 1);
     void *impl_ctx = mpp_calloc_size(void, api->ctx_size);
     if (NULL == impl || NULL == impl_ctx) {
@@ -182,6 +191,16 @@ MPP_RET mpp_dev_ioctl(MppDev ctx, RK_S32 cmd, void *param)
     return ret;
 }
 
+MPP_RET mpp_dev_loopback_stat(MppDev ctx, MppDevLoopbackStat *stat)
+{
+    MppDevImpl *p = (MppDevImpl *)ctx;
+
+    if (NULL == p || p->api != &mpp_loopback_api)
+        return MPP_NOK;
+
+    return mpp_loopback_stat(p->ctx, stat);
+}
+
 MPP_RET mpp_dev_set_reg_offset(MppDev dev, RK_S32 index, RK_U32 offset)
 {
     MppDevRegOffsetCfg trans_cfg;
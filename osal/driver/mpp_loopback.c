@@ -0,0 +1,344 @@
+/*
+ * Copyright 2024 Rockchip Electronics Co. LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#define MODULE_TAG "mpp_loopback"
+
+#include <string.h>
+
+#include "mpp_env.h"
+#include "mpp_mem.h"
+#include "mpp_time.h"
+#include "mpp_debug.h"
+#include "mpp_common.h"
+
+#include "mpp_device_debug.h"
+#include "mpp_loopback_api.h"
+
+#define LOOPBACK_REG_SIZE_INIT      (4096)
+#define LOOPBACK_TASK_MAX           (16)
+
+typedef struct MppDevLoopback_t {
+    MppClientType   type;
+    MppCbCtx        *dev_cb;
+
+    /* register image updated by reg_wr and read back by reg_rd */
+    RK_U8           *regs;
+    RK_U32          reg_size;
+    RK_U32          reg_end;
+
+    /* config recorded for current task, reset on cmd_send */
+    RK_U32          reg_offset_count;
+    RK_U32          rcb_count;
+    RK_U32          info_count;
+
+    /* send time of tasks waiting for poll */
+    RK_S64          task_time[LOOPBACK_TASK_MAX];
+    RK_U32          task_rd;
+    RK_U32          task_wr;
+
+    RK_U32          latency;
+    RK_U32          err_interval;
+
+    MppDevLoopbackStat stat;
+} MppDevLoopback;
+
+RK_U32 mpp_loopback_enabled(void)
+{
+    static RK_S32 enabled = -1;
+
+    if (enabled < 0) {
+        RK_U32 val = 0;
+
+        mpp_env_get_u32("mpp_dev_loopback", &val, 0);
+        enabled = val ? 1 : 0;
+    }
+
+    return enabled;
+}
+
+static MPP_RET loopback_reg_check(MppDevLoopback *p, RK_U32 end)
+{
+    RK_U8 *regs;
+    RK_U32 size;
+
+    if (end <= p->reg_size)
+        return MPP_OK;
+
+    size = MPP_ALIGN(end, LOOPBACK_REG_SIZE_INIT);
+    regs = mpp_realloc(p->regs, RK_U8, size);
+    if (NULL == regs) {
+        mpp_err_f("failed to enlarge register image %d -> %d\n",
+                  p->reg_size, size);
+        return MPP_ERR_MALLOC;
+    }
+
+    memset(regs + p->reg_size, 0, size - p->reg_size);
+    p->regs = regs;
+    p->reg_size = size;
+
+    return MPP_OK;
+}
+
+MPP_RET mpp_loopback_init(void *ctx, MppClientType type)
+{
+    MppDevLoopback *p = (MppDevLoopback *)ctx;
+
+    p->type = type;
+    p->regs = mpp_calloc(RK_U8, LOOPBACK_REG_SIZE_INIT);
+    if (NULL == p->regs) {
+        mpp_err_f("failed to malloc register image\n");
+        return MPP_ERR_MALLOC;
+    }
+    p->reg_size = LOOPBACK_REG_SIZE_INIT;
+
+    mpp_env_get_u32("mpp_dev_loopback_latency", &p->latency, 0);
+    mpp_env_get_u32("mpp_dev_loopback_err", &p->err_interval, 0);
+
+    mpp_dev_dbg_probe("loopback client %d latency %d us error interval %d\n",
+                      type, p->latency, p->err_interval);
+
+    return MPP_OK;
+}
+
+MPP_RET mpp_loopback_deinit(void *ctx)
+{
+    MppDevLoopback *p = (MppDevLoopback *)ctx;
+    MppDevLoopbackStat *stat = &p->stat;
+
+    mpp_dev_dbg_probe("loopback client %d send %d poll %d err %d reg wr %d bytes %d\n",
+                      p->type, stat->send_cnt, stat->poll_cnt, stat->err_cnt,
+                      stat->reg_wr_cnt, stat->reg_wr_bytes);
+
+    if (p->task_wr != p->task_rd)
+        mpp_log_f("loopback client %d deinit with %d task not polled\n",
+                  p->type, p->task_wr - p->task_rd);
+
+    MPP_FREE(p->regs);
+
+    return MPP_OK;
+}
+
+MPP_RET mpp_loopback_attach(void *ctx)
+{
+    (void)ctx;
+    return MPP_OK;
+}
+
+MPP_RET mpp_loopback_detach(void *ctx)
+{
+    (void)ctx;
+    return MPP_OK;
+}
+
+MPP_RET mpp_loopback_delimit(void *ctx)
+{
+    (void)ctx;
+    return MPP_OK;
+}
+
+MPP_RET mpp_loopback_set_cb_ctx(void *ctx, MppCbCtx *cb)
+{
+    MppDevLoopback *p = (MppDevLoopback *)ctx;
+
+    p->dev_cb = cb;
+
+    return MPP_OK;
+}
+
+MPP_RET mpp_loopback_reg_wr(void *ctx, MppDevRegWrCfg *cfg)
+{
+    MppDevLoopback *p = (MppDevLoopback *)ctx;
+    RK_U32 end = cfg->offset + cfg->size;
+
+    if (loopback_reg_check(p, end))
+        return MPP_ERR_MALLOC;
+
+    memcpy(p->regs + cfg->offset, cfg->reg, cfg->size);
+    p->reg_end = MPP_MAX(p->reg_end, end);
+    p->stat.reg_wr_cnt++;
+    p->stat.reg_wr_bytes += cfg->size;
+
+    mpp_dev_dbg_reg("reg wr offset %08x size %d\n", cfg->offset, cfg->size);
+
+    return MPP_OK;
+}
+
+MPP_RET mpp_loopback_reg_rd(void *ctx, MppDevRegRdCfg *cfg)
+{
+    MppDevLoopback *p = (MppDevLoopback *)ctx;
+    RK_U32 end = cfg->offset + cfg->size;
+
+    if (loopback_reg_check(p, end))
+        return MPP_ERR_MALLOC;
+
+    memcpy(cfg->reg, p->regs + cfg->offset, cfg->size);
+
+    mpp_dev_dbg_reg("reg rd offset %08x size %d\n", cfg->offset, cfg->size);
+
+    return MPP_OK;
+}
+
+MPP_RET mpp_loopback_reg_offset(void *ctx, MppDevRegOffsetCfg *cfg)
+{
+    MppDevLoopback *p = (MppDevLoopback *)ctx;
+
+    if (!cfg->offset)
+        return MPP_OK;
+
+    mpp_dev_dbg_reg("reg offset %d : %08x\n", cfg->reg_idx, cfg->offset);
+    p->reg_offset_count++;
+    p->stat.reg_offset_cnt++;
+
+    return MPP_OK;
+}
+
+MPP_RET mpp_loopback_reg_offsets(void *ctx, MppDevRegOffCfgs *cfgs)
+{
+    MPP_RET ret = MPP_OK;
+    RK_S32 i;
+
+    for (i = 0; i < cfgs->count && !ret; i++)
+        ret = mpp_loopback_reg_offset(ctx, &cfgs->cfgs[i]);
+
+    return ret;
+}
+
+MPP_RET mpp_loopback_rcb_info(void *ctx, MppDevRcbInfoCfg *cfg)
+{
+    MppDevLoopback *p = (MppDevLoopback *)ctx;
+
+    if (!cfg->size)
+        return MPP_OK;
+
+    mpp_dev_dbg_reg("rcb info %d : %d\n", cfg->reg_idx, cfg->size);
+    p->rcb_count++;
+    p->stat.rcb_cnt++;
+
+    return MPP_OK;
+}
+
+MPP_RET mpp_loopback_set_info(void *ctx, MppDevInfoCfg *cfg)
+{
+    MppDevLoopback *p = (MppDevLoopback *)ctx;
+
+    mpp_dev_dbg_msg("set info type %d flag %d data %llx\n",
+                    cfg->type, cfg->flag, cfg->data);
+    p->info_count++;
+    p->stat.info_cnt++;
+
+    return MPP_OK;
+}
+
+MPP_RET mpp_loopback_set_err_ref_hack(void *ctx, RK_U32 *enable)
+{
+    (void)ctx;
+    (void)enable;
+    return MPP_OK;
+}
+
+MPP_RET mpp_loopback_cmd_send(void *ctx)
+{
+    MppDevLoopback *p = (MppDevLoopback *)ctx;
+
+    if (p->task_wr - p->task_rd >= LOOPBACK_TASK_MAX) {
+        mpp_err_f("ctx %p too many task waiting for poll\n", ctx);
+        return MPP_NOK;
+    }
+
+    mpp_dev_dbg_msg("send task %d regs %d offset %d rcb %d info %d\n",
+                    p->stat.send_cnt, p->reg_end, p->reg_offset_count,
+                    p->rcb_count, p->info_count);
+
+    p->task_time[p->task_wr % LOOPBACK_TASK_MAX] = mpp_time();
+    p->task_wr++;
+    p->stat.send_cnt++;
+
+    p->reg_offset_count = 0;
+    p->rcb_count = 0;
+    p->info_count = 0;
+
+    return MPP_OK;
+}
+
+MPP_RET mpp_loopback_cmd_poll(void *ctx, MppDevPollCfg *cfg)
+{
+    MppDevLoopback *p = (MppDevLoopback *)ctx;
+    MPP_RET ret = MPP_OK;
+    RK_S64 done;
+    RK_S64 now;
+
+    if (p->task_wr == p->task_rd) {
+        mpp_err_f("ctx %p poll without task\n", ctx);
+        return MPP_NOK;
+    }
+
+    done = p->task_time[p->task_rd % LOOPBACK_TASK_MAX] + p->latency;
+    p->task_rd++;
+
+    now = mpp_time();
+    if (now < done)
+        usleep(done - now);
+
+    p->stat.poll_cnt++;
+    if (p->err_interval && !(p->stat.poll_cnt % p->err_interval)) {
+        mpp_dev_dbg_msg("inject error on poll %d\n", p->stat.poll_cnt);
+        p->stat.err_cnt++;
+        ret = MPP_NOK;
+    }
+
+    if (cfg) {
+        mpp_assert(cfg->count_max);
+        if (cfg->count_max) {
+            cfg->count_ret = 1;
+            cfg->slice_info[0].val = 0;
+            cfg->slice_info[0].last = 1;
+        }
+    }
+
+    return ret;
+}
+
+MPP_RET mpp_loopback_stat(void *ctx, MppDevLoopbackStat *stat)
+{
+    MppDevLoopback *p = (MppDevLoopback *)ctx;
+
+    if (NULL == p || NULL == stat)
+        return MPP_ERR_NULL_PTR;
+
+    *stat = p->stat;
+
+    return MPP_OK;
+}
+
+const MppDevApi mpp_loopback_api = {
+    "mpp_loopback",
+    sizeof(MppDevLoopback),
+    mpp_loopback_init,
+    mpp_loopback_deinit,
+    mpp_loopback_attach,
+    mpp_loopback_detach,
+    mpp_loopback_delimit,
+    mpp_loopback_set_cb_ctx,
+    mpp_loopback_reg_wr,
+    mpp_loopback_reg_rd,
+    mpp_loopback_reg_offset,
+    mpp_loopback_reg_offsets,
+    mpp_loopback_rcb_info,
+    mpp_loopback_set_info,
+    mpp_loopback_set_err_ref_hack,
+    mpp_loopback_cmd_send,
+    mpp_loopback_cmd_poll,
+};
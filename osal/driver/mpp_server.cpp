@@ -37,7 +37,14 @@
 #define MAX_REQ_SEND_CNT    MAX_REQ_NUM
 #define MAX_REQ_WAIT_CNT    2
 
+/* default batch fill timeout in ms and adaptive latency target in us */
+#define BATCH_TIMEOUT       10
+#define BATCH_LATENCY       20000
+/* adaptive adjustment is done once every ADAPT_PERIOD process */
+#define ADAPT_PERIOD        32
+
 #define MPP_SERVER_DBG_FLOW             (0x00000001)
+#define MPP_SERVER_DBG_STAT             (0x00000002)
 
 #define mpp_serv_dbg(flag, fmt, ...)    _mpp_dbg(mpp_server_debug, flag, fmt, ## __VA_ARGS__)
 #define mpp_serv_dbg_f(flag, fmt, ...)  _mpp_dbg_f(mpp_server_debug, flag, fmt, ## __VA_ARGS__)
@@ -85,6 +92,9 @@ struct MppDevTask_t {
 
     MppReqV1            *req;
     RK_S32              req_cnt;
+
+    /* time of send_task for wait time and latency */
+    RK_S64              time_send;
 };
 
 struct MppDevBatTask_t {
@@ -130,6 +140,9 @@ struct MppDevSession_t {
     RK_S32              task_wait;
     RK_S32              task_done;
 
+    /* update by server process */
+    MppServerSessionStat stat;
+
     MppDevTask          tasks[MAX_SESSION_TASK];
 };
 
@@ -160,6 +173,21 @@ struct MppDevBatServ_t {
     /* link to all pending tasks */
     struct list_head    pending_task;
     RK_S32              pending_count;
+
+    /* config and current batch size / timeout */
+    MppServerCfg        cfg;
+    RK_S32              batch_size;
+    RK_S32              timeout;
+
+    /* adaptive state, queue depth average in 1/16 unit */
+    RK_S32              depth_avg;
+    RK_S32              adapt_cnt;
+    RK_S32              adapt_task_cnt;
+    RK_S64              adapt_latency;
+
+    /* statistic, fill_sum is the sum of batch size on send */
+    MppServerStat       stat;
+    RK_U32              fill_sum;
 };
 
 RK_U32 mpp_server_debug = 0;
@@ -214,12 +242,95 @@ void batch_del(MppDevBatServ *server, MppDevBatTask *batch)
     mpp_serv_dbg_flow("batch del free count %d:%d\n", server->batch_run, server->batch_free);
 }
 
+static void server_stat_send(MppDevBatServ *server, MppDevBatTask *batch)
+{
+    MppServerStat *stat = &server->stat;
+    RK_S64 now = mpp_time();
+    MppDevTask *task;
+
+    list_for_each_entry(task, &batch->link_tasks, MppDevTask, link_batch) {
+        RK_S64 wait = now - task->time_send;
+
+        stat->wait_time += wait;
+        if (wait > stat->wait_time_max)
+            stat->wait_time_max = wait;
+    }
+
+    stat->batch_cnt++;
+    stat->task_cnt += batch->fill_cnt;
+    if (batch->fill_full)
+        stat->batch_full_cnt++;
+    server->fill_sum += server->batch_size;
+}
+
+static void server_stat_done(MppDevBatServ *server, MppDevTask *task)
+{
+    MppServerSessionStat *stat = &task->session->stat;
+    RK_S64 latency = mpp_time() - task->time_send;
+    RK_U32 ms = (RK_U32)MPP_MIN(latency / 1000, 1024);
+    RK_S32 bin = 0;
+
+    if (ms)
+        bin = MPP_MIN(1 + mpp_log2(ms), MPP_SERVER_HIST_CNT - 1);
+
+    stat->task_cnt++;
+    stat->latency += latency;
+    if (latency > stat->latency_max)
+        stat->latency_max = latency;
+    stat->hist[bin]++;
+
+    server->adapt_task_cnt++;
+    server->adapt_latency += latency;
+}
+
+/*
+ * Adaptive mode runs on each process with the pending task count:
+ * batch size follows the average queue depth and the timeout is halved when
+ * the average task latency is over target and doubled back up to the config
+ * timeout when the latency is well below target.
+ */
+static void server_adapt(MppDevBatServ *server, RK_S32 pending)
+{
+    MppServerCfg *cfg = &server->cfg;
+    RK_S32 timeout = server->timeout;
+    RK_S64 latency;
+
+    server->depth_avg += (pending * 16 - server->depth_avg) / 8;
+
+    if (++server->adapt_cnt < ADAPT_PERIOD)
+        return;
+
+    server->batch_size = MPP_CLIP3(1, cfg->batch_size, (server->depth_avg + 15) / 16);
+
+    if (server->adapt_task_cnt) {
+        latency = server->adapt_latency / server->adapt_task_cnt;
+
+        if (latency > cfg->latency && timeout > 1)
+            timeout /= 2;
+        else if (latency < cfg->latency / 2 && timeout < cfg->timeout)
+            timeout = MPP_MIN(timeout * 2, cfg->timeout);
+
+        if (timeout != server->timeout) {
+            mpp_serv_dbg_flow("adapt latency %lld timeout %d -> %d batch %d\n",
+                              latency, server->timeout, timeout, server->batch_size);
+            server->timeout = timeout;
+            mpp_timer_set_timing(server->timer, timeout, timeout);
+        }
+    }
+
+    server->adapt_cnt = 0;
+    server->adapt_task_cnt = 0;
+    server->adapt_latency = 0;
+}
+
 void batch_send(MppDevBatServ *server, MppDevBatTask *batch)
 {
     RK_S32 ret = 0;
 
     mpp_assert(batch->send_req_cnt);
 
+    server_stat_send(server, batch);
+
     ret = mpp_service_ioctl_request(server->server_fd, batch->send_reqs);
     if (ret) {
         mpp_err_f("ioctl batch cmd failed ret %d errno %d %s\n",
@@ -284,6 +395,7 @@ void process_task(void *p)
 
                     mpp_serv_dbg_flow("batch %d:%d session %d ready and remove\n",
                                       batch->batch_id, task->batch_slot_id, session->client);
+                    server_stat_done(server, task);
                     session->cond->lock();
                     session->task_done++;
                     session->cond->signal();
@@ -326,6 +438,8 @@ void process_task(void *p)
         mpp_timer_set_enable(server->timer, 0);
         mpp_serv_dbg_flow("stop timer\n");
     }
+    if (server->cfg.adaptive)
+        server_adapt(server, pending);
     lock->unlock();
 
     mpp_serv_dbg_flow("pending %d running %d free %d max %d process start\n",
@@ -394,7 +508,7 @@ try_proc_pending_task:
     task->batch_slot_id = batch->fill_cnt++;
     mpp_assert(task->batch_slot_id < server->max_task_in_batch);
     list_add_tail(&task->link_batch, &batch->link_tasks);
-    if (batch->fill_cnt >= server->max_task_in_batch)
+    if (batch->fill_cnt >= server->batch_size)
         batch->fill_full = 1;
 
     session = task->session;
@@ -480,6 +594,7 @@ MPP_RET send_task(MppDevMppService *ctx)
 
     task->req = ctx->reqs;
     task->req_cnt = ctx->req_cnt;
+    task->time_send = mpp_time();
 
     list_del_init(&task->link_session);
     list_add_tail(&task->link_session, &session->list_wait);
@@ -551,6 +666,7 @@ private:
     RK_U32              mEnable;
 
     MppDevBatServ       *mBatServer[VPU_CLIENT_BUTT];
+    MppServerCfg        mCfg[VPU_CLIENT_BUTT];
 
     MppMemPool          mSessionPool;
     MppMemPool          mBatchPool;
@@ -571,6 +687,10 @@ public:
     MPP_RET attach(MppDevMppService *ctx);
     MPP_RET detach(MppDevMppService *ctx);
 
+    MPP_RET set_cfg(MppClientType client_type, MppServerCfg *cfg);
+    MPP_RET get_cfg(MppClientType client_type, MppServerCfg *cfg);
+    MPP_RET get_stat(MppClientType client_type, MppServerStat *stat);
+
     MPP_RET check_status(void);
 };
 
@@ -585,13 +705,24 @@ MppDevServer::MppDevServer() :
     mCmdCap(NULL)
 {
     RK_S32 batch_task_size = 0;
+    MppServerCfg cfg;
+    RK_S32 i;
 
     mpp_env_get_u32("mpp_server_debug", &mpp_server_debug, 0);
     mpp_env_get_u32("mpp_server_enable", &mEnable, 1);
     mpp_env_get_u32("mpp_server_batch_task", (RK_U32 *)&mMaxTaskInBatch,
                     MAX_BATCH_TASK);
+    mpp_env_get_u32("mpp_server_batch_timeout", (RK_U32 *)&cfg.timeout, BATCH_TIMEOUT);
+    mpp_env_get_u32("mpp_server_batch_adaptive", (RK_U32 *)&cfg.adaptive, 0);
+    mpp_env_get_u32("mpp_server_batch_latency", (RK_U32 *)&cfg.latency, BATCH_LATENCY);
 
     mpp_assert(mMaxTaskInBatch >= 1 && mMaxTaskInBatch <= 32);
+
+    /* default config for all client type */
+    cfg.batch_size = mMaxTaskInBatch;
+    cfg.timeout = MPP_MAX(cfg.timeout, 1);
+    for (i = 0; i < VPU_CLIENT_BUTT; i++)
+        mCfg[i] = cfg;
     batch_task_size = sizeof(MppDevBatTask) + mMaxTaskInBatch *
                       (sizeof(MppReqV1) * (MAX_REQ_SEND_CNT + MAX_REQ_WAIT_CNT) +
                        sizeof(MppDevBatCmd));
@@ -696,9 +827,13 @@ MppDevBatServ *MppDevServer::bat_server_get(MppClientType client_type)
         goto failed;
     }
 
+    server->cfg = mCfg[client_type];
+    server->batch_size = server->cfg.batch_size;
+    server->timeout = server->cfg.timeout;
+
     mpp_timer_set_callback(server->timer, mpp_server_thread, server);
-    /* 10ms */
-    mpp_timer_set_timing(server->timer, 10, 10);
+    /* 10ms by default */
+    mpp_timer_set_timing(server->timer, server->timeout, server->timeout);
 
     INIT_LIST_HEAD(&server->session_list);
     INIT_LIST_HEAD(&server->list_batch);
@@ -743,6 +878,15 @@ MPP_RET MppDevServer::bat_server_put(MppClientType client_type)
     server = mBatServer[client_type];
     mBatServer[client_type] = NULL;
 
+    if (server->stat.batch_cnt) {
+        MppServerStat *stat = &server->stat;
+
+        mpp_serv_dbg(MPP_SERVER_DBG_STAT, "%s batch %d full %d task %d fill %d%% wait avg %lld max %lld us\n",
+                     strof_client_type(client_type), stat->batch_cnt, stat->batch_full_cnt,
+                     stat->task_cnt, stat->task_cnt * 100 / MPP_MAX(server->fill_sum, 1),
+                     stat->wait_time / MPP_MAX(stat->task_cnt, 1), stat->wait_time_max);
+    }
+
     mpp_assert(server->batch_run == 0);
     mpp_assert(list_empty(&server->list_batch));
     mpp_assert(server->pending_count == 0);
@@ -885,6 +1029,85 @@ MPP_RET MppDevServer::detach(MppDevMppService *ctx)
     return MPP_OK;
 }
 
+MPP_RET MppDevServer::set_cfg(MppClientType client_type, MppServerCfg *cfg)
+{
+    MppServerCfg *dst = NULL;
+    MppDevBatServ *server = NULL;
+
+    if (client_type < 0 || client_type >= VPU_CLIENT_BUTT || NULL == cfg) {
+        mpp_err_f("invalid client type %d cfg %p\n", client_type, cfg);
+        return MPP_NOK;
+    }
+
+    if (cfg->batch_size < 1 || cfg->batch_size > mMaxTaskInBatch ||
+        cfg->timeout < 1 || cfg->latency < 0) {
+        mpp_err_f("invalid batch size %d (max %d) timeout %d latency %d\n",
+                  cfg->batch_size, mMaxTaskInBatch, cfg->timeout, cfg->latency);
+        return MPP_NOK;
+    }
+
+    AutoMutex auto_lock(this);
+
+    dst = &mCfg[client_type];
+    *dst = *cfg;
+
+    server = mBatServer[client_type];
+    if (server) {
+        AutoMutex auto_lock_server(server->lock);
+
+        server->cfg = *dst;
+        server->batch_size = dst->batch_size;
+        server->depth_avg = 0;
+        server->adapt_cnt = 0;
+        server->adapt_task_cnt = 0;
+        server->adapt_latency = 0;
+        if (server->timeout != dst->timeout) {
+            server->timeout = dst->timeout;
+            mpp_timer_set_timing(server->timer, server->timeout, server->timeout);
+        }
+    }
+
+    return MPP_OK;
+}
+
+MPP_RET MppDevServer::get_cfg(MppClientType client_type, MppServerCfg *cfg)
+{
+    if (client_type < 0 || client_type >= VPU_CLIENT_BUTT || NULL == cfg) {
+        mpp_err_f("invalid client type %d cfg %p\n", client_type, cfg);
+        return MPP_NOK;
+    }
+
+    AutoMutex auto_lock(this);
+
+    *cfg = mCfg[client_type];
+    return MPP_OK;
+}
+
+MPP_RET MppDevServer::get_stat(MppClientType client_type, MppServerStat *stat)
+{
+    MppDevBatServ *server = NULL;
+
+    if (client_type < 0 || client_type >= VPU_CLIENT_BUTT || NULL == stat) {
+        mpp_err_f("invalid client type %d stat %p\n", client_type, stat);
+        return MPP_NOK;
+    }
+
+    AutoMutex auto_lock(this);
+
+    memset(stat, 0, sizeof(*stat));
+    server = mBatServer[client_type];
+    if (server) {
+        AutoMutex auto_lock_server(server->lock);
+
+        *stat = server->stat;
+        stat->fill_ratio = stat->task_cnt * 100 / MPP_MAX(server->fill_sum, 1);
+        stat->batch_size = server->batch_size;
+        stat->timeout = server->timeout;
+    }
+
+    return MPP_OK;
+}
+
 MPP_RET MppDevServer::check_status(void)
 {
     if (!mInited) {
@@ -926,3 +1149,44 @@ MPP_RET mpp_server_wait_task(MppDev ctx, RK_S64 timeout)
 
     return ret;
 }
+
+MPP_RET mpp_server_set_cfg(MppClientType type, MppServerCfg *cfg)
+{
+    MPP_RET ret = MppDevServer::get_inst()->check_status();
+    if (!ret)
+        ret = MppDevServer::get_inst()->set_cfg(type, cfg);
+
+    return ret;
+}
+
+MPP_RET mpp_server_get_cfg(MppClientType type, MppServerCfg *cfg)
+{
+    MPP_RET ret = MppDevServer::get_inst()->check_status();
+    if (!ret)
+        ret = MppDevServer::get_inst()->get_cfg(type, cfg);
+
+    return ret;
+}
+
+MPP_RET mpp_server_get_stat(MppClientType type, MppServerStat *stat)
+{
+    MPP_RET ret = MppDevServer::get_inst()->check_status();
+    if (!ret)
+        ret = MppDevServer::get_inst()->get_stat(type, stat);
+
+    return ret;
+}
+
+MPP_RET mpp_server_get_session_stat(MppDev ctx, MppServerSessionStat *stat)
+{
+    MppDevMppService *dev = (MppDevMppService *)ctx;
+    MppDevSession *session = dev ? (MppDevSession *)dev->serv_ctx : NULL;
+
+    if (NULL == session || NULL == stat) {
+        mpp_err_f("invalid ctx %p session %p stat %p\n", ctx, session, stat);
+        return MPP_NOK;
+    }
+
+    *stat = session->stat;
+    return MPP_OK;
+}
@@ -216,6 +216,8 @@ RK_U32 mpp_align_64(RK_U32 val);
 RK_U32 mpp_align_128(RK_U32 val);
 RK_U32 mpp_align_256_odd(RK_U32 val);
 
+void mpp_fill_pattern(void *dst, const void *pattern, RK_U32 size, RK_S32 count);
+
 #ifdef __cplusplus
 }
 #endif
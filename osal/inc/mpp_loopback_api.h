@@ -0,0 +1,59 @@
+/*
+ * Copyright 2024 Rockchip Electronics Co. LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __MPP_LOOPBACK_API_H__
+#define __MPP_LOOPBACK_API_H__
+
+#include "mpp_device.h"
+
+/*
+ * Userspace loopback device for running the pipeline without kernel driver.
+ *
+ * Enabled by env mpp_dev_loopback=1. Registers written by reg_wr are kept in
+ * a per-device register image and returned by reg_rd. Each cmd_send queues a
+ * task which cmd_poll completes after the configured latency.
+ *
+ * mpp_dev_loopback_latency    - task latency in us from send to poll done
+ * mpp_dev_loopback_err        - return error on every N-th poll, 0 disable
+ */
+typedef struct MppDevLoopbackStat_t {
+    RK_U32  send_cnt;
+    RK_U32  poll_cnt;
+    RK_U32  err_cnt;
+    RK_U32  reg_wr_cnt;
+    RK_U32  reg_wr_bytes;
+    RK_U32  reg_offset_cnt;
+    RK_U32  rcb_cnt;
+    RK_U32  info_cnt;
+} MppDevLoopbackStat;
+
+#ifdef  __cplusplus
+extern "C" {
+#endif
+
+extern const MppDevApi mpp_loopback_api;
+
+RK_U32 mpp_loopback_enabled(void);
+MPP_RET mpp_loopback_stat(void *ctx, MppDevLoopbackStat *stat);
+
+/* query loopback statistic from a device created by mpp_dev_init */
+MPP_RET mpp_dev_loopback_stat(MppDev dev, MppDevLoopbackStat *stat);
+
+#ifdef  __cplusplus
+}
+#endif
+
+#endif /* __MPP_LOOPBACK_API_H__ */
@@ -19,6 +19,46 @@
 
 #include "mpp_device.h"
 
+#define MPP_SERVER_HIST_CNT     8
+
+/*
+ * batch server config of one client type
+ * batch_size   - max task count in one batch, limited by mpp_server_batch_task
+ * timeout      - batch fill timeout in ms, the period of server process
+ * adaptive     - size batch from queue depth and adjust timeout for latency
+ * latency      - adaptive mode target of task latency in us
+ */
+typedef struct MppServerCfg_t {
+    RK_S32  batch_size;
+    RK_S32  timeout;
+    RK_S32  adaptive;
+    RK_S32  latency;
+} MppServerCfg;
+
+typedef struct MppServerStat_t {
+    RK_U32  batch_cnt;
+    /* batch sent on full */
+    RK_U32  batch_full_cnt;
+    RK_U32  task_cnt;
+    /* average task count over batch size in percent */
+    RK_U32  fill_ratio;
+    /* time from task send to batch send in us */
+    RK_S64  wait_time;
+    RK_S64  wait_time_max;
+    /* current batch size and timeout in adaptive mode */
+    RK_S32  batch_size;
+    RK_S32  timeout;
+} MppServerStat;
+
+typedef struct MppServerSessionStat_t {
+    RK_U32  task_cnt;
+    /* time from task send to task done in us */
+    RK_S64  latency;
+    RK_S64  latency_max;
+    /* latency histogram in [0, 1) [1, 2) [2, 4) ... [64, inf) ms */
+    RK_U32  hist[MPP_SERVER_HIST_CNT];
+} MppServerSessionStat;
+
 #ifdef  __cplusplus
 extern "C" {
 #endif
@@ -29,6 +69,11 @@ MPP_RET mpp_server_detach(MppDev ctx);
 MPP_RET mpp_server_send_task(MppDev ctx);
 MPP_RET mpp_server_wait_task(MppDev ctx, RK_S64 timeout);
 
+MPP_RET mpp_server_set_cfg(MppClientType type, MppServerCfg *cfg);
+MPP_RET mpp_server_get_cfg(MppClientType type, MppServerCfg *cfg);
+MPP_RET mpp_server_get_stat(MppClientType type, MppServerStat *stat);
+MPP_RET mpp_server_get_session_stat(MppDev ctx, MppServerSessionStat *stat);
+
 #ifdef  __cplusplus
 }
 #endif
@@ -19,6 +19,40 @@
 
 #include "rk_type.h"
 
+/*
+ * Built-in pipeline trace recorder
+ *
+ * Enabled by env mpp_trace_file with the output file path. Events are kept
+ * in a ring buffer of mpp_trace_size entries (default 65536) and the latest
+ * entries are written to the file on mpp_trace_flush and at process exit.
+ * A file name ending with .json is written as Chrome / Perfetto trace event
+ * json, otherwise as MppTraceHead followed by MppTraceEvent records.
+ *
+ * span  - a stage begins at start (from mpp_trace_time) and ends now
+ * point - a single timestamp like api call or display enqueue
+ * id    - the frame pts, so one frame can be followed through the stages
+ */
+#define MPP_TRACE_MAGIC         (0x5450504d)    /* "MPPT" */
+#define MPP_TRACE_NAME_LEN      24
+
+typedef struct MppTraceHead_t {
+    RK_U32      magic;
+    RK_U32      version;
+    RK_U32      event_size;
+    RK_U32      count;
+} MppTraceHead;
+
+typedef struct MppTraceEvent_t {
+    RK_U32      seq;
+    RK_S32      tid;
+    RK_S64      ts;
+    /* negative duration for point event */
+    RK_S64      dur;
+    RK_S64      id;
+    RK_U64      ctx;
+    char        name[MPP_TRACE_NAME_LEN];
+} MppTraceEvent;
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -30,6 +64,13 @@ void mpp_trace_async_end(const char* name, RK_S32 cookie);
 void mpp_trace_int32(const char* name, RK_S32 value);
 void mpp_trace_int64(const char* name, RK_S64 value);
 
+RK_U32 mpp_trace_enabled(void);
+/* return current time when the recorder is enabled otherwise zero */
+RK_S64 mpp_trace_time(void);
+void mpp_trace_span(const char *name, void *ctx, RK_S64 id, RK_S64 start);
+void mpp_trace_point(const char *name, void *ctx, RK_S64 id);
+void mpp_trace_flush(void);
+
 #ifdef __cplusplus
 }
 #endif
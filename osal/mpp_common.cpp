@@ -14,6 +14,8 @@
  * limitations under the License.
  */
 
+#include <string.h>
+
 #include "mpp_common.h"
 
 static const RK_U8 log2_tab[256] = {
@@ -126,3 +128,24 @@ RK_U32 mpp_align_256_odd(RK_U32 val)
 {
     return MPP_ALIGN(val, 256) | 256;
 }
+
+/*
+ * fill count elements of size bytes with the pattern by doubling memcpy
+ * which is vectorized in libc
+ */
+void mpp_fill_pattern(void *dst, const void *pattern, RK_U32 size, RK_S32 count)
+{
+    RK_U8 *p = (RK_U8 *)dst;
+    RK_S32 filled = 1;
+
+    if (count <= 0)
+        return;
+
+    memcpy(p, pattern, size);
+    while (filled < count) {
+        RK_S32 n = MPP_MIN(filled, count - filled);
+
+        memcpy(p + (size_t)filled * size, p, (size_t)n * size);
+        filled += n;
+    }
+}
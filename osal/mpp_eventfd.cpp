@@ -26,7 +26,7 @@ RK_S32 mpp_eventfd_get(RK_U32 init)
     RK_S32 fd = eventfd(init, 0);
 
     if (fd < 0)
-        fd = errno;
+        fd = -errno;
 
     return fd;
 }
@@ -22,22 +22,33 @@
 #include "mpp_env.h"
 #include "mpp_mem.h"
 #include "mpp_list.h"
+#include "mpp_lock.h"
 #include "mpp_debug.h"
 
 #include "mpp_mem_pool.h"
 
 #define MPP_MEM_POOL_DBG_FLOW           (0x00000001)
+#define MPP_MEM_POOL_DBG_NO_CACHE       (0x00000002)
 
 #define mem_pool_dbg(flag, fmt, ...)    _mpp_dbg(mpp_mem_pool_debug, flag, fmt, ## __VA_ARGS__)
 #define mem_pool_dbg_f(flag, fmt, ...)  _mpp_dbg_f(mpp_mem_pool_debug, flag, fmt, ## __VA_ARGS__)
 
 #define mem_pool_dbg_flow(fmt, ...)     mem_pool_dbg(MPP_MEM_POOL_DBG_FLOW, fmt, ## __VA_ARGS__)
 
+/* max pool count with thread cache, the others go to the shared list */
+#define MEM_POOL_CACHE_MAX              64
+/* thread cache node count and the batch count for refill / flush */
+#define MEM_POOL_MAG_SIZE               32
+#define MEM_POOL_MAG_BATCH              (MEM_POOL_MAG_SIZE / 2)
+
 RK_U32 mpp_mem_pool_debug = 0;
+/* set when the service is destroyed, thread exit after it must not flush */
+static RK_U32 mem_pool_srv_done = 0;
 
 typedef struct MppMemPoolNode_t {
     void                *check;
     struct list_head    list;
+    struct list_head    all;
     void                *ptr;
     size_t              size;
 } MppMemPoolNode;
@@ -48,15 +59,34 @@ typedef struct MppMemPoolImpl_t {
     pthread_mutex_t     lock;
     struct list_head    service_link;
 
-    struct list_head    used;
+    /* all nodes for release on deinit and unused nodes in shared list */
+    struct list_head    all;
     struct list_head    unused;
-    RK_S32              used_count;
+    RK_S32              node_count;
     RK_S32              unused_count;
+    /* node count returned by get and not put yet */
+    RK_S32              used_count;
+
+    /* thread cache index and unique generation for stale cache detection */
+    RK_S32              index;
+    RK_U32              gen;
 
     /* extra flag for C++ static destruction order error */
     RK_S32              finalized;
 } MppMemPoolImpl;
 
+/* thread local magazine of one pool */
+typedef struct MppMemPoolMag_t {
+    MppMemPoolImpl      *impl;
+    RK_U32              gen;
+    RK_S32              count;
+    MppMemPoolNode      *nodes[MEM_POOL_MAG_SIZE];
+} MppMemPoolMag;
+
+typedef struct MppMemPoolTls_t {
+    MppMemPoolMag       *mags[MEM_POOL_CACHE_MAX];
+} MppMemPoolTls;
+
 class MppMemPoolService
 {
 public:
@@ -72,18 +102,43 @@ public:
 
     MppMemPoolImpl *get_pool(size_t size);
     void put_pool(MppMemPoolImpl *impl);
+    MppMemPoolMag *get_mag(MppMemPoolImpl *impl);
 
 private:
     MppMemPoolService();
     ~MppMemPoolService();
+    static void flush_tls(void *data);
+
     struct list_head    mLink;
+    pthread_key_t       mKey;
+    RK_U32              mKeyValid;
+    RK_U32              mGen;
+    MppMemPoolImpl      *mPools[MEM_POOL_CACHE_MAX];
 };
 
+static void mag_flush(MppMemPoolImpl *impl, MppMemPoolMag *mag, RK_S32 count)
+{
+    pthread_mutex_lock(&impl->lock);
+    while (count-- > 0 && mag->count > 0) {
+        MppMemPoolNode *node = mag->nodes[--mag->count];
+
+        list_add(&node->list, &impl->unused);
+        impl->unused_count++;
+    }
+    pthread_mutex_unlock(&impl->lock);
+}
+
 MppMemPoolService::MppMemPoolService()
+    : mKeyValid(0),
+      mGen(0)
 {
     INIT_LIST_HEAD(&mLink);
+    memset(mPools, 0, sizeof(mPools));
 
     mpp_env_get_u32("mpp_mem_pool_debug", &mpp_mem_pool_debug, 0);
+
+    if (!(mpp_mem_pool_debug & MPP_MEM_POOL_DBG_NO_CACHE))
+        mKeyValid = !pthread_key_create(&mKey, flush_tls);
 }
 
 MppMemPoolService::~MppMemPoolService()
@@ -95,6 +150,81 @@ MppMemPoolService::~MppMemPoolService()
             put_pool(pos);
         }
     }
+
+    AutoMutex auto_lock(get_lock());
+
+    mem_pool_srv_done = 1;
+    if (mKeyValid) {
+        pthread_key_delete(mKey);
+        mKeyValid = 0;
+    }
+}
+
+/* return thread cache nodes to the shared list on thread exit */
+void MppMemPoolService::flush_tls(void *data)
+{
+    MppMemPoolService *srv;
+    MppMemPoolTls *tls = (MppMemPoolTls *)data;
+    RK_S32 i;
+
+    AutoMutex auto_lock(get_lock());
+
+    if (mem_pool_srv_done)
+        return;
+
+    srv = getInstance();
+
+    for (i = 0; i < MEM_POOL_CACHE_MAX; i++) {
+        MppMemPoolMag *mag = tls->mags[i];
+
+        if (!mag)
+            continue;
+
+        /* the nodes of a released pool are already freed */
+        if (mag->count && srv->mPools[i] == mag->impl && mag->impl->gen == mag->gen)
+            mag_flush(mag->impl, mag, mag->count);
+
+        mpp_free(mag);
+    }
+
+    mpp_free(tls);
+}
+
+MppMemPoolMag *MppMemPoolService::get_mag(MppMemPoolImpl *impl)
+{
+    MppMemPoolTls *tls;
+    MppMemPoolMag *mag;
+
+    if (impl->index < 0)
+        return NULL;
+
+    tls = (MppMemPoolTls *)pthread_getspecific(mKey);
+    if (NULL == tls) {
+        tls = mpp_calloc(MppMemPoolTls, 1);
+        if (NULL == tls)
+            return NULL;
+
+        pthread_setspecific(mKey, tls);
+    }
+
+    mag = tls->mags[impl->index];
+    if (NULL == mag) {
+        mag = mpp_malloc(MppMemPoolMag, 1);
+        if (NULL == mag)
+            return NULL;
+
+        mag->impl = NULL;
+        tls->mags[impl->index] = mag;
+    }
+
+    /* drop stale nodes left by a released pool with the same index */
+    if (mag->impl != impl || mag->gen != impl->gen) {
+        mag->impl = impl;
+        mag->gen = impl->gen;
+        mag->count = 0;
+    }
+
+    return mag;
 }
 
 MppMemPoolImpl *MppMemPoolService::get_pool(size_t size)
@@ -111,16 +241,31 @@ MppMemPoolImpl *MppMemPoolService::get_pool(size_t size)
 
     pool->check = pool;
     pool->size = size;
-    pool->used_count = 0;
+    pool->node_count = 0;
     pool->unused_count = 0;
+    pool->used_count = 0;
+    pool->index = -1;
     pool->finalized = 0;
 
-    INIT_LIST_HEAD(&pool->used);
+    INIT_LIST_HEAD(&pool->all);
     INIT_LIST_HEAD(&pool->unused);
     INIT_LIST_HEAD(&pool->service_link);
     AutoMutex auto_lock(get_lock());
     list_add_tail(&pool->service_link, &mLink);
 
+    pool->gen = ++mGen;
+    if (mKeyValid) {
+        RK_S32 i;
+
+        for (i = 0; i < MEM_POOL_CACHE_MAX; i++) {
+            if (NULL == mPools[i]) {
+                mPools[i] = pool;
+                pool->index = i;
+                break;
+            }
+        }
+    }
+
     return pool;
 }
 
@@ -136,36 +281,27 @@ void MppMemPoolService::put_pool(MppMemPoolImpl *impl)
     if (impl->finalized)
         return;
 
-    pthread_mutex_lock(&impl->lock);
-
-    if (!list_empty(&impl->unused)) {
-        list_for_each_entry_safe(node, m, &impl->unused, MppMemPoolNode, list) {
-            MPP_FREE(node);
-            impl->unused_count--;
-        }
+    {
+        AutoMutex auto_lock(get_lock());
+        list_del_init(&impl->service_link);
+        if (impl->index >= 0)
+            mPools[impl->index] = NULL;
     }
 
-    if (!list_empty(&impl->used)) {
-        mpp_err_f("found %d used buffer size %d\n",
-                  impl->used_count, impl->size);
+    pthread_mutex_lock(&impl->lock);
 
-        list_for_each_entry_safe(node, m, &impl->used, MppMemPoolNode, list) {
-            MPP_FREE(node);
-            impl->used_count--;
-        }
-    }
+    if (impl->used_count)
+        mpp_err_f("pool size %d found leaked buffer used:unused [%d:%d] total %d\n",
+                  impl->size, impl->used_count, impl->unused_count,
+                  impl->node_count);
 
-    if (impl->used_count || impl->unused_count)
-        mpp_err_f("pool size %d found leaked buffer used:unused [%d:%d]\n",
-                  impl->size, impl->used_count, impl->unused_count);
+    /* free nodes in shared list, thread caches and the leaked ones */
+    list_for_each_entry_safe(node, m, &impl->all, MppMemPoolNode, all) {
+        MPP_FREE(node);
+    }
 
     pthread_mutex_unlock(&impl->lock);
 
-    {
-        AutoMutex auto_lock(get_lock());
-        list_del_init(&impl->service_link);
-    }
-
     impl->finalized = 1;
     mpp_free(impl);
 }
@@ -188,10 +324,29 @@ void mpp_mem_pool_deinit_f(const char *caller, MppMemPool pool)
 
 void *mpp_mem_pool_get_f(const char *caller, MppMemPool pool)
 {
+    static MppMemPoolService *srv = MppMemPoolService::getInstance();
     MppMemPoolImpl *impl = (MppMemPoolImpl *)pool;
+    MppMemPoolMag *mag = srv->get_mag(impl);
     MppMemPoolNode *node = NULL;
-    void* ptr = NULL;
 
+    if (mag && !mag->count) {
+        /* refill a batch from the shared list */
+        pthread_mutex_lock(&impl->lock);
+        while (mag->count < MEM_POOL_MAG_BATCH && !list_empty(&impl->unused)) {
+            node = list_first_entry(&impl->unused, MppMemPoolNode, list);
+            list_del_init(&node->list);
+            impl->unused_count--;
+            mag->nodes[mag->count++] = node;
+        }
+        pthread_mutex_unlock(&impl->lock);
+    }
+
+    if (mag && mag->count) {
+        node = mag->nodes[--mag->count];
+        goto DONE;
+    }
+
+    node = NULL;
     pthread_mutex_lock(&impl->lock);
 
     mem_pool_dbg_flow("pool %d get used:unused [%d:%d] from %s", impl->size,
@@ -199,42 +354,42 @@ void *mpp_mem_pool_get_f(const char *caller, MppMemPool pool)
 
     if (!list_empty(&impl->unused)) {
         node = list_first_entry(&impl->unused, MppMemPoolNode, list);
-        if (node) {
-            list_del_init(&node->list);
-            list_add_tail(&node->list, &impl->used);
-            impl->unused_count--;
-            impl->used_count++;
-            ptr = node->ptr;
-            node->check = node;
-            goto DONE;
-        }
+        list_del_init(&node->list);
+        impl->unused_count--;
     }
+    pthread_mutex_unlock(&impl->lock);
+
+    if (node)
+        goto DONE;
 
     node = mpp_malloc_size(MppMemPoolNode, sizeof(MppMemPoolNode) + impl->size);
     if (NULL == node) {
         mpp_err_f("failed to create node from size %d pool\n", impl->size);
-        goto DONE;
+        return NULL;
     }
 
-    node->check = node;
     node->ptr = (void *)(node + 1);
     node->size = impl->size;
     INIT_LIST_HEAD(&node->list);
-    list_add_tail(&node->list, &impl->used);
-    impl->used_count++;
-    ptr = node->ptr;
 
-DONE:
+    pthread_mutex_lock(&impl->lock);
+    list_add_tail(&node->all, &impl->all);
+    impl->node_count++;
     pthread_mutex_unlock(&impl->lock);
-    if (node)
-        memset(node->ptr, 0 , node->size);
-    return ptr;
+
+DONE:
+    MPP_ADD_FETCH(&impl->used_count, 1);
+    node->check = node;
+    memset(node->ptr, 0, node->size);
+    return node->ptr;
 }
 
 void mpp_mem_pool_put_f(const char *caller, MppMemPool pool, void *p)
 {
+    static MppMemPoolService *srv = MppMemPoolService::getInstance();
     MppMemPoolImpl *impl = (MppMemPoolImpl *)pool;
     MppMemPoolNode *node = (MppMemPoolNode *)((RK_U8 *)p - sizeof(MppMemPoolNode));
+    MppMemPoolMag *mag;
 
     if (impl != impl->check) {
         mpp_err_f("invalid mem pool %p check %p\n", impl, impl->check);
@@ -247,16 +402,26 @@ void mpp_mem_pool_put_f(const char *caller, MppMemPool pool, void *p)
         return ;
     }
 
+    node->check = NULL;
+    MPP_SUB_FETCH(&impl->used_count, 1);
+
+    mag = srv->get_mag(impl);
+    if (mag) {
+        /* flush a batch to the shared list when the thread cache is full */
+        if (mag->count >= MEM_POOL_MAG_SIZE)
+            mag_flush(impl, mag, MEM_POOL_MAG_BATCH);
+
+        mag->nodes[mag->count++] = node;
+        return;
+    }
+
     pthread_mutex_lock(&impl->lock);
 
     mem_pool_dbg_flow("pool %d put used:unused [%d:%d] from %s", impl->size,
                       impl->used_count, impl->unused_count, caller);
 
-    list_del_init(&node->list);
     list_add(&node->list, &impl->unused);
-    impl->used_count--;
     impl->unused_count++;
-    node->check = NULL;
 
     pthread_mutex_unlock(&impl->lock);
 }
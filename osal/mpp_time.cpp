@@ -227,27 +227,34 @@ MPP_RET check_is_mpp_timer(void *timer)
     return MPP_NOK;
 }
 
-static void *mpp_timer_thread(void *ctx)
+static RK_S32 timer_set_timerfd(MppTimerImpl *impl)
 {
     struct itimerspec ts;
-    RK_S32 ret = 0;
-    MppTimerImpl *impl = (MppTimerImpl *)ctx;
-    MppThread *thd = impl->thd;
-    RK_S32 timer_fd = impl->timer_fd;
+    RK_S32 ret;
 
     // first expire time
     ts.it_value.tv_sec = impl->initial / 1000;
-    ts.it_value.tv_nsec = (impl->initial % 1000) * 1000;
+    ts.it_value.tv_nsec = (impl->initial % 1000) * 1000 * 1000;
 
     // last expire time
     ts.it_interval.tv_sec = impl->interval / 1000;
     ts.it_interval.tv_nsec = (impl->interval % 1000) * 1000 * 1000;
 
-    ret = timerfd_settime(timer_fd, 0, &ts, NULL);
-    if (ret < 0) {
+    ret = timerfd_settime(impl->timer_fd, 0, &ts, NULL);
+    if (ret < 0)
         mpp_err("timerfd_settime error, Error:[%d:%s]", errno, strerror(errno));
+
+    return ret;
+}
+
+static void *mpp_timer_thread(void *ctx)
+{
+    MppTimerImpl *impl = (MppTimerImpl *)ctx;
+    MppThread *thd = impl->thd;
+    RK_S32 timer_fd = impl->timer_fd;
+
+    if (timer_set_timerfd(impl) < 0)
         return NULL;
-    }
 
     while (1) {
         if (MPP_THREAD_RUNNING != thd->get_status())
@@ -359,6 +366,10 @@ void mpp_timer_set_timing(MppTimer timer, RK_S32 initial, RK_S32 interval)
     MppTimerImpl *impl = (MppTimerImpl *)timer;
     impl->initial = initial;
     impl->interval = interval;
+
+    /* apply new timing on running timer */
+    if (impl->enabled)
+        timer_set_timerfd(impl);
 }
 
 void mpp_timer_set_enable(MppTimer timer, RK_S32 enable)
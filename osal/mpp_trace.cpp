@@ -18,11 +18,20 @@
 
 #include <fcntl.h>
 #include <stdarg.h>
-
+#include <string.h>
+#include <sys/syscall.h>
+
+#include "mpp_env.h"
+#include "mpp_mem.h"
+#include "mpp_lock.h"
+#include "mpp_time.h"
+#include "mpp_debug.h"
 #include "mpp_common.h"
+#include "mpp_thread.h"
 #include "mpp_trace.h"
 
 #define ATRACE_MESSAGE_LENGTH 256
+#define TRACE_RING_SIZE_DEF   (65536)
 
 class MppTraceService
 {
@@ -34,9 +43,19 @@ private:
     MppTraceService &operator=(const MppTraceService &);
 
     void trace_write(const char *fmt, ...);
+    void record(const char *name, void *ctx, RK_S64 id, RK_S64 ts, RK_S64 dur);
+    void dump_json(FILE *fp, RK_U32 start, RK_U32 end);
+    void dump_bin(FILE *fp, RK_U32 start, RK_U32 end);
 
     RK_S32 mTraceFd;
 
+    /* recorder ring buffer */
+    Mutex mLock;
+    const char *mFile;
+    MppTraceEvent *mRing;
+    RK_U32 mRingMask;
+    RK_U32 mWrIdx;
+
 public:
     static MppTraceService *get_inst() {
         static MppTraceService inst;
@@ -49,9 +68,19 @@ public:
     void trace_async_end(const char* name, RK_S32 cookie);
     void trace_int32(const char* name, RK_S32 val);
     void trace_int64(const char* name, RK_S64 val);
+
+    RK_U32 enabled() { return mRing != NULL; }
+    void span(const char *name, void *ctx, RK_S64 id, RK_S64 start);
+    void point(const char *name, void *ctx, RK_S64 id);
+    void flush();
 };
 
 MppTraceService::MppTraceService()
+    : mTraceFd(-1),
+      mFile(NULL),
+      mRing(NULL),
+      mRingMask(0),
+      mWrIdx(0)
 {
     static const char *ftrace_paths[] = {
         "/sys/kernel/debug/tracing/trace_marker",
@@ -68,10 +97,34 @@ MppTraceService::MppTraceService()
                 break;
         }
     }
+
+    mpp_env_get_str("mpp_trace_file", &mFile, NULL);
+    if (mFile && mFile[0]) {
+        RK_U32 size = 0;
+        RK_U32 ring = 1;
+
+        mpp_env_get_u32("mpp_trace_size", &size, TRACE_RING_SIZE_DEF);
+        /* round up to power of two for index masking */
+        while (ring < size && ring < (1u << 24))
+            ring <<= 1;
+
+        mRing = mpp_calloc(MppTraceEvent, ring);
+        if (mRing) {
+            mRingMask = ring - 1;
+            mpp_log("trace recorder %d events to %s\n", ring, mFile);
+        } else {
+            mpp_err("trace recorder failed to alloc %d events\n", ring);
+        }
+    }
 }
 
 MppTraceService::~MppTraceService()
 {
+    if (mRing) {
+        flush();
+        MPP_FREE(mRing);
+    }
+
     if (mTraceFd >= 0) {
         close(mTraceFd);
         mTraceFd = -1;
@@ -139,6 +192,117 @@ void MppTraceService::trace_int64(const char* name, RK_S64 value)
     trace_write("C|%d|%s|%lld", getpid(), name, value);
 }
 
+void MppTraceService::record(const char *name, void *ctx, RK_S64 id, RK_S64 ts, RK_S64 dur)
+{
+    RK_U32 idx = MPP_FETCH_ADD(&mWrIdx, 1);
+    MppTraceEvent *ev = &mRing[idx & mRingMask];
+
+    /* invalidate first so that flush skips the half written entry */
+    ev->seq = 0;
+    MPP_SYNC();
+
+    ev->tid = (RK_S32)syscall(SYS_gettid);
+    ev->ts  = ts;
+    ev->dur = dur;
+    ev->id  = id;
+    ev->ctx = (RK_U64)(intptr_t)ctx;
+    strncpy(ev->name, name, sizeof(ev->name) - 1);
+    ev->name[sizeof(ev->name) - 1] = '\0';
+
+    MPP_SYNC();
+    ev->seq = idx + 1;
+}
+
+void MppTraceService::span(const char *name, void *ctx, RK_S64 id, RK_S64 start)
+{
+    if (!mRing || !start)
+        return;
+
+    record(name, ctx, id, start, mpp_time() - start);
+}
+
+void MppTraceService::point(const char *name, void *ctx, RK_S64 id)
+{
+    if (!mRing)
+        return;
+
+    record(name, ctx, id, mpp_time(), -1);
+}
+
+void MppTraceService::dump_json(FILE *fp, RK_U32 start, RK_U32 end)
+{
+    RK_S32 pid = getpid();
+    RK_U32 first = 1;
+    RK_U32 i;
+
+    fprintf(fp, "{\"traceEvents\":[\n");
+
+    for (i = start; i != end; i++) {
+        MppTraceEvent *ev = &mRing[i & mRingMask];
+
+        if (ev->seq != i + 1)
+            continue;
+
+        fprintf(fp, "%s{\"name\":\"%s\",\"cat\":\"mpp\",\"pid\":%d,\"tid\":%d,\"ts\":%lld,",
+                first ? "" : ",\n", ev->name, pid, ev->tid, ev->ts);
+        if (ev->dur >= 0)
+            fprintf(fp, "\"ph\":\"X\",\"dur\":%lld,", ev->dur);
+        else
+            fprintf(fp, "\"ph\":\"i\",\"s\":\"t\",");
+        fprintf(fp, "\"args\":{\"ctx\":\"0x%llx\",\"id\":%lld}}", ev->ctx, ev->id);
+        first = 0;
+    }
+
+    fprintf(fp, "\n],\"displayTimeUnit\":\"ms\"}\n");
+}
+
+void MppTraceService::dump_bin(FILE *fp, RK_U32 start, RK_U32 end)
+{
+    MppTraceHead head;
+    RK_U32 i;
+
+    head.magic = MPP_TRACE_MAGIC;
+    head.version = 1;
+    head.event_size = sizeof(MppTraceEvent);
+    head.count = 0;
+
+    for (i = start; i != end; i++)
+        head.count += (mRing[i & mRingMask].seq == i + 1);
+
+    fwrite(&head, sizeof(head), 1, fp);
+
+    for (i = start; i != end; i++) {
+        MppTraceEvent *ev = &mRing[i & mRingMask];
+
+        if (ev->seq == i + 1)
+            fwrite(ev, sizeof(*ev), 1, fp);
+    }
+}
+
+void MppTraceService::flush()
+{
+    if (!mRing)
+        return;
+
+    AutoMutex auto_lock(&mLock);
+    RK_U32 end = mWrIdx;
+    RK_U32 start = (end > mRingMask + 1) ? (end - mRingMask - 1) : (0);
+    RK_U32 len = strlen(mFile);
+    FILE *fp = fopen(mFile, "wb");
+
+    if (!fp) {
+        mpp_err("failed to open trace file %s\n", mFile);
+        return;
+    }
+
+    if (len > 5 && !strcmp(mFile + len - 5, ".json"))
+        dump_json(fp, start, end);
+    else
+        dump_bin(fp, start, end);
+
+    fclose(fp);
+}
+
 void mpp_trace_begin(const char* name)
 {
     MppTraceService::get_inst()->trace_begin(name);
@@ -168,3 +332,28 @@ void mpp_trace_int64(const char* name, RK_S64 value)
 {
     MppTraceService::get_inst()->trace_int64(name, value);
 }
+
+RK_U32 mpp_trace_enabled(void)
+{
+    return MppTraceService::get_inst()->enabled();
+}
+
+RK_S64 mpp_trace_time(void)
+{
+    return MppTraceService::get_inst()->enabled() ? mpp_time() : 0;
+}
+
+void mpp_trace_span(const char *name, void *ctx, RK_S64 id, RK_S64 start)
+{
+    MppTraceService::get_inst()->span(name, ctx, id, start);
+}
+
+void mpp_trace_point(const char *name, void *ctx, RK_S64 id)
+{
+    MppTraceService::get_inst()->point(name, ctx, id);
+}
+
+void mpp_trace_flush(void)
+{
+    MppTraceService::get_inst()->flush();
+}
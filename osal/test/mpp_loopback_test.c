@@ -0,0 +1,137 @@
+/*
+ * Copyright 2024 Rockchip Electronics Co. LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#define MODULE_TAG "mpp_loopback_test"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "mpp_log.h"
+#include "mpp_time.h"
+#include "mpp_loopback_api.h"
+
+#define LOOPBACK_TEST_REG_COUNT     256
+#define LOOPBACK_TEST_TASK_COUNT    8
+#define LOOPBACK_TEST_LATENCY       2000
+#define LOOPBACK_TEST_ERR_INTERVAL  4
+
+int main()
+{
+    MppDev dev = NULL;
+    MppDevLoopbackStat stat;
+    RK_U32 regs[LOOPBACK_TEST_REG_COUNT];
+    RK_U32 regs_rd[LOOPBACK_TEST_REG_COUNT];
+    RK_U32 err_cnt = 0;
+    RK_S64 start;
+    RK_S64 time;
+    RK_U32 i;
+    MPP_RET ret = MPP_NOK;
+
+    mpp_log("mpp_loopback_test start\n");
+
+    setenv("mpp_dev_loopback", "1", 1);
+    setenv("mpp_dev_loopback_latency", "2000", 1);
+    setenv("mpp_dev_loopback_err", "4", 1);
+
+    if (mpp_dev_init(&dev, VPU_CLIENT_RKVDEC)) {
+        mpp_err("mpp_loopback_test mpp_dev_init failed\n");
+        goto DONE;
+    }
+
+    for (i = 0; i < LOOPBACK_TEST_REG_COUNT; i++)
+        regs[i] = i * 0x01010101;
+
+    start = mpp_time();
+    for (i = 0; i < LOOPBACK_TEST_TASK_COUNT; i++) {
+        MppDevRegWrCfg wr_cfg;
+        MppDevRegRdCfg rd_cfg;
+        MppDevRcbInfoCfg rcb_cfg;
+
+        regs[0] = i;
+
+        /* write registers in two segments like the hal does */
+        wr_cfg.reg = regs;
+        wr_cfg.size = sizeof(regs) / 2;
+        wr_cfg.offset = 0;
+        mpp_dev_ioctl(dev, MPP_DEV_REG_WR, &wr_cfg);
+
+        wr_cfg.reg = regs + LOOPBACK_TEST_REG_COUNT / 2;
+        wr_cfg.offset = sizeof(regs) / 2;
+        mpp_dev_ioctl(dev, MPP_DEV_REG_WR, &wr_cfg);
+
+        mpp_dev_set_reg_offset(dev, 4, 0x100);
+
+        rcb_cfg.reg_idx = 8;
+        rcb_cfg.size = 0x1000;
+        mpp_dev_ioctl(dev, MPP_DEV_RCB_INFO, &rcb_cfg);
+
+        if (mpp_dev_ioctl(dev, MPP_DEV_CMD_SEND, NULL)) {
+            mpp_err("mpp_loopback_test send task %d failed\n", i);
+            goto DONE;
+        }
+
+        if (mpp_dev_ioctl(dev, MPP_DEV_CMD_POLL, NULL))
+            err_cnt++;
+
+        rd_cfg.reg = regs_rd;
+        rd_cfg.size = sizeof(regs_rd);
+        rd_cfg.offset = 0;
+        mpp_dev_ioctl(dev, MPP_DEV_REG_RD, &rd_cfg);
+
+        if (memcmp(regs, regs_rd, sizeof(regs))) {
+            mpp_err("mpp_loopback_test register read back mismatch\n");
+            goto DONE;
+        }
+    }
+    time = mpp_time() - start;
+
+    /* poll without pending task must fail */
+    if (!mpp_dev_ioctl(dev, MPP_DEV_CMD_POLL, NULL)) {
+        mpp_err("mpp_loopback_test poll without task success\n");
+        goto DONE;
+    }
+
+    mpp_dev_loopback_stat(dev, &stat);
+    mpp_log("send %d poll %d err %d reg wr %d bytes %d offset %d rcb %d time %lld us\n",
+            stat.send_cnt, stat.poll_cnt, stat.err_cnt, stat.reg_wr_cnt,
+            stat.reg_wr_bytes, stat.reg_offset_cnt, stat.rcb_cnt, time);
+
+    if (stat.send_cnt != LOOPBACK_TEST_TASK_COUNT ||
+        stat.reg_wr_cnt != LOOPBACK_TEST_TASK_COUNT * 2 ||
+        stat.reg_offset_cnt != LOOPBACK_TEST_TASK_COUNT ||
+        stat.rcb_cnt != LOOPBACK_TEST_TASK_COUNT) {
+        mpp_err("mpp_loopback_test stat mismatch\n");
+        goto DONE;
+    }
+
+    if (err_cnt != LOOPBACK_TEST_TASK_COUNT / LOOPBACK_TEST_ERR_INTERVAL) {
+        mpp_err("mpp_loopback_test injected error %d mismatch\n", err_cnt);
+        goto DONE;
+    }
+
+    if (time < LOOPBACK_TEST_TASK_COUNT * LOOPBACK_TEST_LATENCY) {
+        mpp_err("mpp_loopback_test latency %lld us too short\n", time);
+        goto DONE;
+    }
+
+    ret = MPP_OK;
+DONE:
+    if (dev)
+        mpp_dev_deinit(dev);
+
+    mpp_log("mpp_loopback_test %s\n", ret ? "failed" : "success");
+    return ret;
+}
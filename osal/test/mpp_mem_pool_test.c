@@ -17,12 +17,84 @@
 #define MODULE_TAG "mpp_mem_pool_test"
 
 #include <stdlib.h>
+#include <string.h>
 
 #include "mpp_log.h"
+#include "mpp_time.h"
+#include "mpp_thread.h"
 #include "mpp_mem_pool.h"
 
 #define MPP_MEM_POOL_TEST_SIZE      1024
 #define MPP_MEM_POOL_TEST_COUNT     20
+#define MPP_MEM_POOL_TEST_THREADS   4
+#define MPP_MEM_POOL_TEST_LOOP      100000
+#define MPP_MEM_POOL_TEST_HOLD      48
+
+typedef struct MemPoolThreadCtx_t {
+    MppMemPool  pool;
+    RK_S32      ret;
+} MemPoolThreadCtx;
+
+/* get / put with some nodes held across the thread cache size */
+static void *mem_pool_thread(void *arg)
+{
+    MemPoolThreadCtx *ctx = (MemPoolThreadCtx *)arg;
+    void *hold[MPP_MEM_POOL_TEST_HOLD];
+    RK_U32 i;
+
+    memset(hold, 0, sizeof(hold));
+
+    for (i = 0; i < MPP_MEM_POOL_TEST_LOOP; i++) {
+        RK_U32 idx = i % MPP_MEM_POOL_TEST_HOLD;
+        RK_U8 *p;
+
+        if (hold[idx])
+            mpp_mem_pool_put(ctx->pool, hold[idx]);
+
+        p = (RK_U8 *)mpp_mem_pool_get(ctx->pool);
+        if (!p || p[0] || p[MPP_MEM_POOL_TEST_SIZE - 1]) {
+            ctx->ret = MPP_NOK;
+            break;
+        }
+
+        memset(p, 0xff, MPP_MEM_POOL_TEST_SIZE);
+        hold[idx] = p;
+    }
+
+    for (i = 0; i < MPP_MEM_POOL_TEST_HOLD; i++) {
+        if (hold[i])
+            mpp_mem_pool_put(ctx->pool, hold[i]);
+    }
+
+    return NULL;
+}
+
+static RK_S32 mem_pool_thread_test(MppMemPool pool)
+{
+    pthread_t thds[MPP_MEM_POOL_TEST_THREADS];
+    MemPoolThreadCtx ctxs[MPP_MEM_POOL_TEST_THREADS];
+    RK_S64 start = mpp_time();
+    RK_S32 ret = MPP_OK;
+    RK_U32 i;
+
+    for (i = 0; i < MPP_MEM_POOL_TEST_THREADS; i++) {
+        ctxs[i].pool = pool;
+        ctxs[i].ret = MPP_OK;
+        pthread_create(&thds[i], NULL, mem_pool_thread, &ctxs[i]);
+    }
+
+    for (i = 0; i < MPP_MEM_POOL_TEST_THREADS; i++) {
+        pthread_join(thds[i], NULL);
+        if (ctxs[i].ret)
+            ret = MPP_NOK;
+    }
+
+    mpp_log("%d threads get / put %d times cost %lld us\n",
+            MPP_MEM_POOL_TEST_THREADS, MPP_MEM_POOL_TEST_LOOP,
+            mpp_time() - start);
+
+    return ret;
+}
 
 int main()
 {
@@ -69,6 +141,13 @@ int main()
         }
     }
 
+    if (mem_pool_thread_test(pool)) {
+        mpp_err("mpp_mem_pool_test multi-thread get / put failed\n");
+        goto mpp_mem_pool_test_failed;
+    }
+
+    mpp_mem_pool_deinit(pool);
+
     mpp_log("mpp_mem_pool_test success\n");
     return MPP_OK;
 
@@ -0,0 +1,654 @@
+/*
+ * Copyright 2024 Rockchip Electronics Co. LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#define MODULE_TAG "mpi_dec_bench_test"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <sys/resource.h>
+
+#include "rk_mpi.h"
+
+#include "mpp_mem.h"
+#include "mpp_env.h"
+#include "mpp_time.h"
+#include "mpp_common.h"
+
+#include "mpp_opt.h"
+#include "mpi_dec_utils.h"
+
+#define BENCH_MAX_INPUT     8
+
+/*
+ * Usage: mpi_dec_bench_test -i stream0 [-i stream1 ...] [-s instances]
+ *                           [-n frames] [-t type] [-l]
+ *
+ * Decoder throughput benchmark. Each instance runs in its own thread and
+ * decodes input (instance index % input count) in simple put / get mode.
+ * When frame number is set the stream is looped until that many frames are
+ * output, otherwise each stream is decoded once until eos.
+ *
+ * The report contains:
+ * stage  - parser / hal stage time from the decoder timing clocks, summed up
+ *          over all instances and divided by the output frame count
+ * cpu    - process user + system time per output frame
+ * api    - time the caller is blocked in decode_put_packet / decode_get_frame
+ *          which includes the mpp port and task queue lock wait
+ * copy   - stream bytes copied on the packet copy path of decode_put_packet
+ * delay  - packet put to frame output latency percentiles
+ *
+ * With -l the loopback device is used instead of the kernel driver so the
+ * software cost can be measured on machines without decoder hardware.
+ */
+
+typedef struct {
+    char            *input[BENCH_MAX_INPUT];
+    FileReader      reader[BENCH_MAX_INPUT];
+    RK_S32          input_cnt;
+
+    MppCodingType   type;
+    RK_S32          nthreads;
+    RK_S32          frame_num;
+    RK_U32          loopback;
+    RK_U32          quiet;
+} DecBenchCmd;
+
+typedef struct {
+    DecBenchCmd     *cmd;
+    RK_S32          chn;
+    pthread_t       thd;
+
+    FileReader      reader;
+    MppCodingType   type;
+    MppCtx          ctx;
+    MppApi          *mpi;
+    DecBufMgr       buf_mgr;
+    MppPacket       packet;
+
+    RK_S32          packet_idx;
+    RK_S32          frame_count;
+    RK_S32          pass_frame;
+    RK_U32          loop_end;
+
+    /* statistic */
+    RK_S64          elapsed;
+    RK_S64          api_time;
+    RK_S64          copy_bytes;
+    RK_S64          *delay;
+    RK_S32          delay_cnt;
+    RK_S32          delay_max;
+    MppDecQueryCfg  query;
+} DecBenchCtx;
+
+static RK_S32 bench_opt_i(void *ctx, const char *next)
+{
+    DecBenchCmd *cmd = (DecBenchCmd *)ctx;
+
+    if (!next) {
+        mpp_err("input file is invalid\n");
+        return -1;
+    }
+
+    if (cmd->input_cnt >= BENCH_MAX_INPUT) {
+        mpp_err("too many input files max %d\n", BENCH_MAX_INPUT);
+        return -1;
+    }
+
+    cmd->input[cmd->input_cnt++] = (char *)next;
+    if (!cmd->type)
+        name_to_coding_type(next, &cmd->type);
+
+    return 1;
+}
+
+static RK_S32 bench_opt_t(void *ctx, const char *next)
+{
+    DecBenchCmd *cmd = (DecBenchCmd *)ctx;
+
+    if (next) {
+        cmd->type = (MppCodingType)atoi(next);
+        if (!mpp_check_support_format(MPP_CTX_DEC, cmd->type))
+            return 1;
+    }
+
+    mpp_err("invalid input coding type\n");
+    return -1;
+}
+
+static RK_S32 bench_opt_n(void *ctx, const char *next)
+{
+    DecBenchCmd *cmd = (DecBenchCmd *)ctx;
+
+    if (next) {
+        cmd->frame_num = atoi(next);
+        return 1;
+    }
+
+    mpp_err("invalid frame number\n");
+    return -1;
+}
+
+static RK_S32 bench_opt_s(void *ctx, const char *next)
+{
+    DecBenchCmd *cmd = (DecBenchCmd *)ctx;
+
+    if (next) {
+        cmd->nthreads = atoi(next);
+        if (cmd->nthreads > 0)
+            return 1;
+    }
+
+    mpp_err("invalid instance number\n");
+    return -1;
+}
+
+static RK_S32 bench_opt_l(void *ctx, const char *next)
+{
+    DecBenchCmd *cmd = (DecBenchCmd *)ctx;
+
+    (void)next;
+    cmd->loopback = 1;
+    return 0;
+}
+
+static RK_S32 bench_opt_v(void *ctx, const char *next)
+{
+    DecBenchCmd *cmd = (DecBenchCmd *)ctx;
+
+    (void)next;
+    cmd->quiet = 0;
+    return 0;
+}
+
+static RK_S32 bench_opt_help(void *ctx, const char *next)
+{
+    (void)ctx;
+    (void)next;
+    return -1;
+}
+
+static MppOptInfo bench_opts[] = {
+    {"i",       "input_file",   "input bitstream file, can be set multiple times", bench_opt_i},
+    {"t",       "type",         "input stream coding type",                 bench_opt_t},
+    {"n",       "frame_number", "output frame number per instance",         bench_opt_n},
+    {"s",       "instance_nb",  "number of instances",                      bench_opt_s},
+    {"l",       "loopback",     "use loopback device instead of hardware",  bench_opt_l},
+    {"v",       "verbose",      "show per frame log",                       bench_opt_v},
+    {"help",    "help",         "show help",                                bench_opt_help},
+};
+
+static RK_S32 bench_show_help(const char *name)
+{
+    RK_U32 i;
+
+    mpp_log("usage: %s [options]\n", name);
+    for (i = 0; i < MPP_ARRAY_ELEMS(bench_opts); i++)
+        mpp_log("-%-5s %-14s %s\n", bench_opts[i].name,
+                bench_opts[i].full_name, bench_opts[i].help);
+
+    mpp_show_support_format();
+    return -1;
+}
+
+static RK_S32 bench_cmd_init(DecBenchCmd *cmd, int argc, char **argv)
+{
+    MppOpt opts = NULL;
+    RK_S32 ret = -1;
+    RK_U32 i;
+
+    if (argc < 2)
+        goto DONE;
+
+    mpp_opt_init(&opts);
+    mpp_opt_setup(opts, cmd, 40, MPP_ARRAY_ELEMS(bench_opts));
+
+    for (i = 0; i < MPP_ARRAY_ELEMS(bench_opts); i++)
+        mpp_opt_add(opts, &bench_opts[i]);
+
+    mpp_opt_add(opts, NULL);
+
+    ret = mpp_opt_parse(opts, argc, argv);
+    if (ret)
+        goto DONE;
+
+    if (!cmd->input_cnt) {
+        mpp_err("no input file\n");
+        ret = -1;
+        goto DONE;
+    }
+
+    for (i = 0; i < (RK_U32)cmd->input_cnt; i++) {
+        reader_init(&cmd->reader[i], cmd->input[i], cmd->type);
+        if (!cmd->reader[i]) {
+            ret = -1;
+            goto DONE;
+        }
+
+        mpp_log("input %d %s size %ld\n", i, cmd->input[i],
+                reader_size(cmd->reader[i]));
+    }
+
+DONE:
+    if (opts)
+        mpp_opt_deinit(opts);
+
+    if (ret)
+        bench_show_help(argv[0]);
+
+    return ret;
+}
+
+static void bench_cmd_deinit(DecBenchCmd *cmd)
+{
+    RK_S32 i;
+
+    for (i = 0; i < cmd->input_cnt; i++) {
+        if (cmd->reader[i]) {
+            reader_deinit(cmd->reader[i]);
+            cmd->reader[i] = NULL;
+        }
+    }
+}
+
+static void bench_add_delay(DecBenchCtx *data, RK_S64 delay)
+{
+    if (data->delay_cnt >= data->delay_max) {
+        RK_S32 max = data->delay_max ? data->delay_max * 2 : 1024;
+        RK_S64 *buf = mpp_realloc(data->delay, RK_S64, max);
+
+        if (!buf)
+            return;
+
+        data->delay = buf;
+        data->delay_max = max;
+    }
+
+    data->delay[data->delay_cnt++] = delay;
+}
+
+static MPP_RET bench_info_change(DecBenchCtx *data, MppFrame frame)
+{
+    MppCtx ctx = data->ctx;
+    MppApi *mpi = data->mpi;
+    MppBufferGroup grp;
+    MPP_RET ret;
+
+    mpp_log_q(data->cmd->quiet, "%p info change w:h [%d:%d] stride [%d:%d] buf_size %d\n",
+              ctx, mpp_frame_get_width(frame), mpp_frame_get_height(frame),
+              mpp_frame_get_hor_stride(frame), mpp_frame_get_ver_stride(frame),
+              mpp_frame_get_buf_size(frame));
+
+    grp = dec_buf_mgr_setup(data->buf_mgr, mpp_frame_get_buf_size(frame), 24,
+                            MPP_DEC_BUF_HALF_INT);
+    ret = mpi->control(ctx, MPP_DEC_SET_EXT_BUF_GROUP, grp);
+    if (ret) {
+        mpp_err("%p set buffer group failed ret %d\n", ctx, ret);
+        return ret;
+    }
+
+    ret = mpi->control(ctx, MPP_DEC_SET_INFO_CHANGE_READY, NULL);
+    if (ret)
+        mpp_err("%p info change ready failed ret %d\n", ctx, ret);
+
+    return ret;
+}
+
+/* return 1 when some frame is output */
+static RK_S32 bench_get_frames(DecBenchCtx *data)
+{
+    MppCtx ctx = data->ctx;
+    MppApi *mpi = data->mpi;
+    RK_S32 got = 0;
+
+    while (!data->loop_end) {
+        MppFrame frame = NULL;
+        RK_S64 start = mpp_time();
+        MPP_RET ret = mpi->decode_get_frame(ctx, &frame);
+
+        data->api_time += mpp_time() - start;
+
+        if (ret || !frame)
+            break;
+
+        got = 1;
+
+        if (mpp_frame_get_info_change(frame)) {
+            if (bench_info_change(data, frame))
+                data->loop_end = 1;
+        } else if (mpp_frame_get_buffer(frame)) {
+            bench_add_delay(data, mpp_time() - mpp_frame_get_pts(frame));
+
+            mpp_log_q(data->cmd->quiet, "%p get frame %d\n", ctx, data->frame_count);
+            data->frame_count++;
+            data->pass_frame++;
+        }
+
+        if (mpp_frame_get_eos(frame))
+            data->loop_end = 1;
+
+        mpp_frame_deinit(&frame);
+
+        if (data->cmd->frame_num > 0 && data->frame_count >= data->cmd->frame_num)
+            data->loop_end = 1;
+    }
+
+    return got;
+}
+
+static void bench_decode(DecBenchCtx *data)
+{
+    DecBenchCmd *cmd = data->cmd;
+    MppCtx ctx = data->ctx;
+    MppApi *mpi = data->mpi;
+    MppPacket packet = data->packet;
+    FileBufSlot *slot = NULL;
+    RK_U32 pkt_eos = 0;
+    RK_U32 pkt_done = 0;
+
+    if (reader_index_read(data->reader, data->packet_idx++, &slot)) {
+        data->loop_end = 1;
+        return;
+    }
+
+    pkt_eos = slot->eos;
+    if (pkt_eos) {
+        /* loop the stream only when last pass did output frames */
+        if (cmd->frame_num > 0 && data->frame_count < cmd->frame_num &&
+            data->pass_frame) {
+            data->packet_idx = 0;
+            data->pass_frame = 0;
+            pkt_eos = 0;
+        }
+    }
+
+    mpp_packet_set_data(packet, slot->data);
+    mpp_packet_set_size(packet, slot->size);
+    mpp_packet_set_pos(packet, slot->data);
+    mpp_packet_set_length(packet, slot->size);
+    mpp_packet_set_pts(packet, mpp_time());
+    if (pkt_eos)
+        mpp_packet_set_eos(packet);
+    else
+        mpp_packet_clr_eos(packet);
+
+    do {
+        if (!pkt_done) {
+            RK_S64 start = mpp_time();
+            MPP_RET ret = mpi->decode_put_packet(ctx, packet);
+
+            data->api_time += mpp_time() - start;
+            if (MPP_OK == ret) {
+                /* packet without buffer is copied into mpp internal buffer */
+                if (!slot->buf)
+                    data->copy_bytes += slot->size;
+                pkt_done = 1;
+            }
+        }
+
+        if (!bench_get_frames(data)) {
+            if (pkt_done && !pkt_eos)
+                break;
+
+            msleep(1);
+        }
+    } while (!data->loop_end);
+}
+
+static void *bench_thread(void *arg)
+{
+    DecBenchCtx *data = (DecBenchCtx *)arg;
+    MppDecCfg cfg = NULL;
+    RK_S64 start;
+    MPP_RET ret;
+
+    ret = dec_buf_mgr_init(&data->buf_mgr);
+    if (ret) {
+        mpp_err("dec_buf_mgr_init failed\n");
+        goto DONE;
+    }
+
+    ret = mpp_packet_init(&data->packet, NULL, 0);
+    if (ret) {
+        mpp_err("mpp_packet_init failed\n");
+        goto DONE;
+    }
+
+    ret = mpp_create(&data->ctx, &data->mpi);
+    if (ret) {
+        mpp_err("mpp_create failed\n");
+        goto DONE;
+    }
+
+    ret = mpp_init(data->ctx, MPP_CTX_DEC, data->type);
+    if (ret) {
+        mpp_err("%p mpp_init failed\n", data->ctx);
+        goto DONE;
+    }
+
+    mpp_dec_cfg_init(&cfg);
+    data->mpi->control(data->ctx, MPP_DEC_GET_CFG, cfg);
+    mpp_dec_cfg_set_u32(cfg, "base:split_parse", 1);
+    ret = data->mpi->control(data->ctx, MPP_DEC_SET_CFG, cfg);
+    if (ret) {
+        mpp_err("%p failed to set cfg ret %d\n", data->ctx, ret);
+        goto DONE;
+    }
+
+    start = mpp_time();
+    while (!data->loop_end)
+        bench_decode(data);
+    data->elapsed = mpp_time() - start;
+
+    data->query.query_flag = MPP_DEC_QUERY_DEC_WORK | MPP_DEC_QUERY_TIMING;
+    data->mpi->control(data->ctx, MPP_DEC_QUERY, &data->query);
+
+    data->mpi->reset(data->ctx);
+
+DONE:
+    if (data->ctx) {
+        mpp_destroy(data->ctx);
+        data->ctx = NULL;
+    }
+
+    if (data->packet) {
+        mpp_packet_deinit(&data->packet);
+        data->packet = NULL;
+    }
+
+    if (data->buf_mgr) {
+        dec_buf_mgr_deinit(data->buf_mgr);
+        data->buf_mgr = NULL;
+    }
+
+    if (cfg)
+        mpp_dec_cfg_deinit(cfg);
+
+    return NULL;
+}
+
+static int cmp_delay(const void *a, const void *b)
+{
+    RK_S64 x = *(const RK_S64 *)a;
+    RK_S64 y = *(const RK_S64 *)b;
+
+    return (x > y) - (x < y);
+}
+
+static RK_S64 get_cpu_time(void)
+{
+    struct rusage usage;
+
+    getrusage(RUSAGE_SELF, &usage);
+
+    return (RK_S64)usage.ru_utime.tv_sec * 1000000 + usage.ru_utime.tv_usec +
+           (RK_S64)usage.ru_stime.tv_sec * 1000000 + usage.ru_stime.tv_usec;
+}
+
+static void bench_report(DecBenchCtx *ctxs, RK_S32 count, RK_S64 elapsed, RK_S64 cpu)
+{
+    MppDecQueryCfg sum;
+    RK_S64 *delay = NULL;
+    RK_S64 api_time = 0;
+    RK_S64 copy_bytes = 0;
+    RK_S32 delay_cnt = 0;
+    RK_S32 frames = 0;
+    RK_S32 hw_run = 0;
+    double div;
+    RK_S32 i;
+
+    memset(&sum, 0, sizeof(sum));
+
+    for (i = 0; i < count; i++) {
+        DecBenchCtx *p = &ctxs[i];
+        MppDecQueryCfg *q = &p->query;
+
+        mpp_log("chn %2d frames %5d time %6lld ms fps %7.2f\n", i, p->frame_count,
+                p->elapsed / 1000, p->frame_count * 1000000.0 / MPP_MAX(p->elapsed, 1));
+
+        frames      += p->frame_count;
+        hw_run      += q->dec_hw_run_cnt;
+        api_time    += p->api_time;
+        copy_bytes  += p->copy_bytes;
+        delay_cnt   += p->delay_cnt;
+
+        sum.prs_total   += q->prs_total;
+        sum.prs_wait    += q->prs_wait;
+        sum.prs_proc    += q->prs_proc;
+        sum.prs_prepare += q->prs_prepare;
+        sum.prs_parse   += q->prs_parse;
+        sum.hal_gen_reg += q->hal_gen_reg;
+        sum.hw_start    += q->hw_start;
+        sum.hal_total   += q->hal_total;
+        sum.hal_wait    += q->hal_wait;
+        sum.hal_proc    += q->hal_proc;
+        sum.hw_wait     += q->hw_wait;
+    }
+
+    mpp_log("total frames %d hw run %d time %lld ms fps %.2f\n", frames, hw_run,
+            elapsed / 1000, frames * 1000000.0 / MPP_MAX(elapsed, 1));
+
+    if (!frames)
+        return;
+
+    div = (double)frames;
+
+    mpp_log("cpu    %8.1f us/frame (%.1f%% of one core)\n", cpu / div,
+            cpu * 100.0 / MPP_MAX(elapsed, 1));
+    mpp_log("api    %8.1f us/frame blocked in put / get\n", api_time / div);
+    mpp_log("copy   %8.1f bytes/frame total %lld bytes\n", copy_bytes / div, copy_bytes);
+
+    if (sum.prs_proc || sum.hal_proc) {
+        mpp_log("stage time in us/frame:\n");
+        mpp_log("parser  wait %8.1f proc %8.1f\n", sum.prs_wait / div, sum.prs_proc / div);
+        mpp_log("  prepare %8.1f parse %8.1f gen_reg %8.1f hw_start %8.1f\n",
+                sum.prs_prepare / div, sum.prs_parse / div,
+                sum.hal_gen_reg / div, sum.hw_start / div);
+        mpp_log("hal     wait %8.1f proc %8.1f hw_wait %8.1f\n",
+                sum.hal_wait / div, sum.hal_proc / div, sum.hw_wait / div);
+    }
+
+    if (delay_cnt)
+        delay = mpp_malloc(RK_S64, delay_cnt);
+
+    if (delay) {
+        RK_S32 pos = 0;
+
+        for (i = 0; i < count; i++) {
+            if (ctxs[i].delay_cnt)
+                memcpy(delay + pos, ctxs[i].delay, ctxs[i].delay_cnt * sizeof(RK_S64));
+            pos += ctxs[i].delay_cnt;
+        }
+
+        qsort(delay, delay_cnt, sizeof(RK_S64), cmp_delay);
+
+        mpp_log("delay  p50 %lld us p90 %lld us p99 %lld us max %lld us\n",
+                delay[delay_cnt / 2], delay[delay_cnt * 90 / 100],
+                delay[delay_cnt * 99 / 100], delay[delay_cnt - 1]);
+
+        mpp_free(delay);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    DecBenchCmd cmd;
+    DecBenchCtx *ctxs = NULL;
+    RK_U32 dec_debug = 0;
+    RK_S64 start;
+    RK_S64 cpu;
+    RK_S32 ret;
+    RK_S32 i;
+
+    memset(&cmd, 0, sizeof(cmd));
+    cmd.nthreads = 1;
+    cmd.quiet = 1;
+
+    ret = bench_cmd_init(&cmd, argc, argv);
+    if (ret)
+        goto DONE;
+
+    if (cmd.loopback)
+        mpp_env_set_u32("mpp_dev_loopback", 1);
+
+    /* mpp_dec_debug bit 1 enables decoder timing clocks for stage time query */
+    mpp_env_get_u32("mpp_dec_debug", &dec_debug, 0);
+    mpp_env_set_u32("mpp_dec_debug", dec_debug | 0x2);
+
+    ctxs = mpp_calloc(DecBenchCtx, cmd.nthreads);
+    if (!ctxs) {
+        mpp_err("failed to alloc context for instances\n");
+        ret = -1;
+        goto DONE;
+    }
+
+    mpp_log("start %d instances on %d inputs frame number %d%s\n", cmd.nthreads,
+            cmd.input_cnt, cmd.frame_num, cmd.loopback ? " with loopback device" : "");
+
+    cpu = get_cpu_time();
+    start = mpp_time();
+
+    for (i = 0; i < cmd.nthreads; i++) {
+        DecBenchCtx *p = &ctxs[i];
+
+        p->cmd = &cmd;
+        p->chn = i;
+        p->reader = cmd.reader[i % cmd.input_cnt];
+        p->type = cmd.type;
+
+        ret = pthread_create(&p->thd, NULL, bench_thread, p);
+        if (ret) {
+            mpp_err("failed to create thread %d\n", i);
+            cmd.nthreads = i;
+            break;
+        }
+    }
+
+    for (i = 0; i < cmd.nthreads; i++)
+        pthread_join(ctxs[i].thd, NULL);
+
+    bench_report(ctxs, cmd.nthreads, mpp_time() - start, get_cpu_time() - cpu);
+
+    for (i = 0; i < cmd.nthreads; i++)
+        MPP_FREE(ctxs[i].delay);
+
+DONE:
+    MPP_FREE(ctxs);
+    bench_cmd_deinit(&cmd);
+
+    return ret;
+}
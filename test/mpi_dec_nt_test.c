@@ -257,6 +257,7 @@ void *thread_decode(void *arg)
     memset(&data->checkcrc, 0, sizeof(data->checkcrc));
     data->checkcrc.luma.sum = mpp_malloc(RK_ULONG, 512);
     data->checkcrc.chroma.sum = mpp_malloc(RK_ULONG, 512);
+    data->checkcrc.version = data->cmd->slt_ver;
 
     t_s = mpp_time();
 
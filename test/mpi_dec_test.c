@@ -57,8 +57,45 @@ typedef struct {
     RK_S64          delay;
     FILE            *fp_verify;
     FrmCrc          checkcrc;
+    FrmCrcWorker    crc_worker;
+
+    /* golden slt compare */
+    FILE            *fp_golden;
+    FrmCrc          goldcrc;
+    RK_S32          crc_frm_cnt;
+    RK_S32          crc_err_frm;
 } MpiDecLoopData;
 
+static void dec_frame_crc(MpiDecLoopData *data, MppFrame frame)
+{
+    FrmCrc *checkcrc = &data->checkcrc;
+    FrmCrc *goldcrc = &data->goldcrc;
+    RK_S32 idx = data->crc_frm_cnt++;
+
+    /* frame buffer is not reused in simple mode so crc can be done async */
+    if (data->crc_worker) {
+        frm_crc_worker_put(data->crc_worker, frame);
+        return;
+    }
+
+    if (!data->fp_verify && !data->fp_golden)
+        return;
+
+    calc_frm_crc(frame, checkcrc);
+    write_frm_crc(data->fp_verify, checkcrc);
+
+    /* only the first mismatch is reported, later lines may be out of sync */
+    if (!data->fp_golden || data->crc_err_frm >= 0)
+        return;
+
+    goldcrc->luma.sum_cnt = checkcrc->luma.sum_cnt;
+    goldcrc->chroma.sum_cnt = checkcrc->chroma.sum_cnt;
+    if (read_frm_crc(data->fp_golden, goldcrc) || cmp_frm_crc(checkcrc, goldcrc)) {
+        mpp_err("frame %d crc mismatch with golden file\n", idx);
+        data->crc_err_frm = idx;
+    }
+}
+
 static int dec_simple(MpiDecLoopData *data)
 {
     RK_U32 pkt_done = 0;
@@ -70,7 +107,6 @@ static int dec_simple(MpiDecLoopData *data)
     MppPacket packet = data->packet;
     FileBufSlot *slot = NULL;
     RK_U32 quiet = data->quiet;
-    FrmCrc *checkcrc = &data->checkcrc;
 
     // when packet size is valid read the input binary file
     ret = reader_read(cmd->reader, &slot);
@@ -197,10 +233,7 @@ static int dec_simple(MpiDecLoopData *data)
                     if (data->fp_output && !err_info)
                         dump_mpp_frame_to_file(frame, data->fp_output);
 
-                    if (data->fp_verify) {
-                        calc_frm_crc(frame, checkcrc);
-                        write_frm_crc(data->fp_verify, checkcrc);
-                    }
+                    dec_frame_crc(data, frame);
 
                     fps_calc_inc(cmd->fps);
                 }
@@ -269,7 +302,6 @@ static int dec_advanced(MpiDecLoopData *data)
     MppTask task = NULL;
     RK_U32 quiet = data->quiet;
     FileBufSlot *slot = NULL;
-    FrmCrc *checkcrc = &data->checkcrc;
 
     ret = reader_index_read(cmd->reader, 0, &slot);
     mpp_assert(ret == MPP_OK);
@@ -335,10 +367,7 @@ static int dec_advanced(MpiDecLoopData *data)
             if (data->fp_output)
                 dump_mpp_frame_to_file(frame, data->fp_output);
 
-            if (data->fp_verify) {
-                calc_frm_crc(frame, checkcrc);
-                write_frm_crc(data->fp_verify, checkcrc);
-            }
+            dec_frame_crc(data, frame);
 
             mpp_log_q(quiet, "%p decoded frame %d\n", ctx, data->frame_count);
             data->frame_count++;
@@ -407,8 +436,23 @@ void *thread_decode(void *arg)
     RK_S64 t_s, t_e;
 
     memset(&data->checkcrc, 0, sizeof(data->checkcrc));
-    data->checkcrc.luma.sum = mpp_malloc(RK_ULONG, 512);
-    data->checkcrc.chroma.sum = mpp_malloc(RK_ULONG, 512);
+    data->checkcrc.luma.sum = mpp_calloc(RK_ULONG, 512);
+    data->checkcrc.chroma.sum = mpp_calloc(RK_ULONG, 512);
+    data->checkcrc.version = cmd->slt_ver;
+    memset(&data->goldcrc, 0, sizeof(data->goldcrc));
+    data->goldcrc.luma.sum = mpp_calloc(RK_ULONG, 512);
+    data->goldcrc.chroma.sum = mpp_calloc(RK_ULONG, 512);
+    data->crc_worker = NULL;
+    data->crc_frm_cnt = 0;
+    data->crc_err_frm = -1;
+
+    /* golden file decides the layout to compare with */
+    if (data->fp_golden)
+        data->checkcrc.version = get_frm_crc_ver(data->fp_golden);
+
+    /* crc is calculated in place when the worker is not available */
+    if (data->fp_verify && !data->fp_golden && cmd->simple)
+        frm_crc_worker_init(&data->crc_worker, data->fp_verify, data->checkcrc.version);
 
     t_s = mpp_time();
 
@@ -439,8 +483,27 @@ void *thread_decode(void *arg)
             data->frame_count, (RK_S64)(data->elapsed_time / 1000),
             (RK_S32)(data->delay / 1000), data->frame_rate);
 
+    /* flush pending crc before the frame buffers are released */
+    frm_crc_worker_deinit(data->crc_worker);
+    data->crc_worker = NULL;
+
+    if (data->fp_golden) {
+        char c;
+
+        /* golden file with more frames also fails */
+        if (data->crc_err_frm < 0 && fscanf(data->fp_golden, " %c", &c) == 1)
+            data->crc_err_frm = data->crc_frm_cnt;
+
+        if (data->crc_err_frm < 0)
+            mpp_log("crc check %d frames match golden file\n", data->crc_frm_cnt);
+        else
+            mpp_err("crc check failed, first mismatch at frame %d\n", data->crc_err_frm);
+    }
+
     MPP_FREE(data->checkcrc.luma.sum);
     MPP_FREE(data->checkcrc.chroma.sum);
+    MPP_FREE(data->goldcrc.luma.sum);
+    MPP_FREE(data->goldcrc.chroma.sum);
 
     return NULL;
 }
@@ -491,6 +554,15 @@ int dec_decode(MpiDecTestCmd *cmd)
             mpp_err("failed to open verify file %s\n", cmd->file_slt);
     }
 
+    if (cmd->file_slt_ref) {
+        data.fp_golden = fopen(cmd->file_slt_ref, "rt");
+        if (!data.fp_golden) {
+            mpp_err("failed to open golden file %s\n", cmd->file_slt_ref);
+            ret = MPP_NOK;
+            goto MPP_TEST_OUT;
+        }
+    }
+
     ret = dec_buf_mgr_init(&data.buf_mgr);
     if (ret) {
         mpp_err("dec_buf_mgr_init failed\n");
@@ -615,6 +687,9 @@ int dec_decode(MpiDecTestCmd *cmd)
         goto MPP_TEST_OUT;
     }
 
+    if (data.fp_golden && data.crc_err_frm >= 0)
+        ret = MPP_NOK;
+
 MPP_TEST_OUT:
     if (data.packet) {
         mpp_packet_deinit(&data.packet);
@@ -654,6 +729,11 @@ MPP_TEST_OUT:
         data.fp_verify = NULL;
     }
 
+    if (data.fp_golden) {
+        fclose(data.fp_golden);
+        data.fp_golden = NULL;
+    }
+
     if (cfg) {
         mpp_dec_cfg_deinit(cfg);
         cfg = NULL;
@@ -0,0 +1,240 @@
+/*
+ * Copyright 2024 Rockchip Electronics Co. LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#define MODULE_TAG "mpi_enc_batch_test"
+
+#include <string.h>
+
+#include "rk_mpi.h"
+
+#include "mpp_mem.h"
+#include "mpp_log.h"
+#include "mpp_time.h"
+#include "mpp_common.h"
+#include "mpp_thread.h"
+
+#define TEST_WIDTH          320
+#define TEST_HEIGHT         240
+#define TEST_FRAME_COUNT    120
+#define TEST_BATCH          4
+#define TEST_TIMEOUT_MS     10000
+
+/*
+ * Usage: mpi_enc_batch_test
+ *
+ * Feed the encoder with encode_put_frames on one thread and drain it with
+ * block mode encode_get_packets on another thread. The batch get must not
+ * hold the input notify of the put thread, otherwise both threads wait for
+ * each other forever. The test fails when the encode does not finish in
+ * TEST_TIMEOUT_MS.
+ */
+
+typedef struct EncBatchCtx_t {
+    MppCtx          ctx;
+    MppApi          *mpi;
+    MppBufferGroup  group;
+    MppBuffer       bufs[TEST_BATCH];
+
+    RK_S32          frm_put;
+    RK_S32          pkt_got;
+    RK_S32          put_done;
+    RK_S32          get_done;
+    MPP_RET         put_ret;
+    MPP_RET         get_ret;
+} EncBatchCtx;
+
+static void *put_thread(void *arg)
+{
+    EncBatchCtx *p = (EncBatchCtx *)arg;
+    MppApi *mpi = p->mpi;
+
+    while (p->frm_put < TEST_FRAME_COUNT) {
+        MppFrame frames[TEST_BATCH];
+        RK_S32 count = MPP_MIN(TEST_BATCH, TEST_FRAME_COUNT - p->frm_put);
+        RK_S32 done = 0;
+        RK_S32 i;
+
+        for (i = 0; i < count; i++) {
+            mpp_frame_init(&frames[i]);
+            mpp_frame_set_width(frames[i], TEST_WIDTH);
+            mpp_frame_set_height(frames[i], TEST_HEIGHT);
+            mpp_frame_set_hor_stride(frames[i], TEST_WIDTH);
+            mpp_frame_set_ver_stride(frames[i], TEST_HEIGHT);
+            mpp_frame_set_fmt(frames[i], MPP_FMT_YUV420SP);
+            mpp_frame_set_buffer(frames[i], p->bufs[i]);
+            mpp_frame_set_pts(frames[i], p->frm_put + i);
+            if (p->frm_put + i == TEST_FRAME_COUNT - 1)
+                mpp_frame_set_eos(frames[i], 1);
+        }
+
+        p->put_ret = mpi->encode_put_frames(p->ctx, frames, count, &done);
+
+        for (i = 0; i < count; i++)
+            mpp_frame_deinit(&frames[i]);
+
+        if (p->put_ret) {
+            mpp_err("encode_put_frames failed ret %d\n", p->put_ret);
+            break;
+        }
+
+        p->frm_put += done;
+    }
+
+    p->put_done = 1;
+    return NULL;
+}
+
+static void *get_thread(void *arg)
+{
+    EncBatchCtx *p = (EncBatchCtx *)arg;
+    MppApi *mpi = p->mpi;
+    RK_U32 eos = 0;
+
+    while (!eos) {
+        MppPacket packets[TEST_BATCH];
+        RK_S32 done = 0;
+        RK_S32 i;
+
+        p->get_ret = mpi->encode_get_packets(p->ctx, packets, TEST_BATCH, &done);
+        if (p->get_ret) {
+            mpp_err("encode_get_packets failed ret %d\n", p->get_ret);
+            break;
+        }
+
+        for (i = 0; i < done; i++) {
+            eos |= mpp_packet_get_eos(packets[i]);
+            mpp_packet_deinit(&packets[i]);
+        }
+
+        p->pkt_got += done;
+    }
+
+    p->get_done = 1;
+    return NULL;
+}
+
+static MPP_RET enc_setup(EncBatchCtx *p)
+{
+    MppEncCfg cfg = NULL;
+    MppPollType timeout = MPP_POLL_BLOCK;
+    MPP_RET ret = MPP_NOK;
+    RK_S32 i;
+
+    ret = mpp_create(&p->ctx, &p->mpi);
+    if (ret)
+        return ret;
+
+    ret = p->mpi->control(p->ctx, MPP_SET_OUTPUT_TIMEOUT, &timeout);
+    if (ret)
+        return ret;
+
+    ret = mpp_init(p->ctx, MPP_CTX_ENC, MPP_VIDEO_CodingAVC);
+    if (ret)
+        return ret;
+
+    mpp_enc_cfg_init(&cfg);
+    mpp_enc_cfg_set_s32(cfg, "prep:width", TEST_WIDTH);
+    mpp_enc_cfg_set_s32(cfg, "prep:height", TEST_HEIGHT);
+    mpp_enc_cfg_set_s32(cfg, "prep:hor_stride", TEST_WIDTH);
+    mpp_enc_cfg_set_s32(cfg, "prep:ver_stride", TEST_HEIGHT);
+    mpp_enc_cfg_set_s32(cfg, "prep:format", MPP_FMT_YUV420SP);
+    mpp_enc_cfg_set_s32(cfg, "rc:mode", MPP_ENC_RC_MODE_CBR);
+    mpp_enc_cfg_set_s32(cfg, "codec:type", MPP_VIDEO_CodingAVC);
+    ret = p->mpi->control(p->ctx, MPP_ENC_SET_CFG, cfg);
+    mpp_enc_cfg_deinit(cfg);
+    if (ret)
+        return ret;
+
+    ret = mpp_buffer_group_get_internal(&p->group, MPP_BUFFER_TYPE_ION);
+    if (ret)
+        return ret;
+
+    for (i = 0; i < TEST_BATCH; i++) {
+        RK_U32 size = TEST_WIDTH * TEST_HEIGHT * 3 / 2;
+
+        ret = mpp_buffer_get(p->group, &p->bufs[i], size);
+        if (ret)
+            return ret;
+
+        memset(mpp_buffer_get_ptr(p->bufs[i]), i * 32, size);
+    }
+
+    return MPP_OK;
+}
+
+int main()
+{
+    EncBatchCtx ctx;
+    pthread_t put;
+    pthread_t get;
+    RK_S64 start;
+    RK_S32 ret = MPP_NOK;
+    RK_S32 i;
+
+    mpp_log("mpi_enc_batch_test start\n");
+
+    memset(&ctx, 0, sizeof(ctx));
+
+    if (enc_setup(&ctx)) {
+        mpp_err("encoder setup failed\n");
+        goto DONE;
+    }
+
+    start = mpp_time();
+    pthread_create(&put, NULL, put_thread, &ctx);
+    pthread_create(&get, NULL, get_thread, &ctx);
+
+    while (!ctx.put_done || !ctx.get_done) {
+        if (mpp_time() - start > (RK_S64)TEST_TIMEOUT_MS * 1000) {
+            /* threads are stuck in mpp, report and exit without cleanup */
+            mpp_err("deadlock: put %d frames got %d packets in %d ms\n",
+                    ctx.frm_put, ctx.pkt_got, TEST_TIMEOUT_MS);
+            mpp_log("mpi_enc_batch_test failed\n");
+            return MPP_NOK;
+        }
+        msleep(10);
+    }
+
+    pthread_join(put, NULL);
+    pthread_join(get, NULL);
+
+    mpp_log("put %d frames got %d packets in %lld us\n",
+            ctx.frm_put, ctx.pkt_got, mpp_time() - start);
+
+    if (ctx.put_ret || ctx.get_ret || ctx.frm_put != TEST_FRAME_COUNT ||
+        ctx.pkt_got != TEST_FRAME_COUNT) {
+        mpp_err("frame %d packet %d mismatch\n", ctx.frm_put, ctx.pkt_got);
+        goto DONE;
+    }
+
+    ret = MPP_OK;
+DONE:
+    if (ctx.ctx) {
+        ctx.mpi->reset(ctx.ctx);
+        mpp_destroy(ctx.ctx);
+    }
+
+    for (i = 0; i < TEST_BATCH; i++) {
+        if (ctx.bufs[i])
+            mpp_buffer_put(ctx.bufs[i]);
+    }
+
+    if (ctx.group)
+        mpp_buffer_group_put(ctx.group);
+
+    mpp_log("mpi_enc_batch_test %s\n", ret ? "failed" : "success");
+    return ret;
+}
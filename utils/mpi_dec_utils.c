@@ -592,6 +592,39 @@ RK_S32 mpi_dec_opt_slt(void *ctx, const char *next)
     return 0;
 }
 
+RK_S32 mpi_dec_opt_slt_ref(void *ctx, const char *next)
+{
+    MpiDecTestCmd *cmd = (MpiDecTestCmd *)ctx;
+
+    if (next) {
+        size_t len = strnlen(next, MAX_FILE_NAME_LENGTH);
+        if (len) {
+            cmd->file_slt_ref = mpp_calloc(char, len + 1);
+            strncpy(cmd->file_slt_ref, next, len);
+
+            return 1;
+        }
+    }
+
+    mpp_err("input golden slt file is invalid\n");
+    return 0;
+}
+
+RK_S32 mpi_dec_opt_slt_ver(void *ctx, const char *next)
+{
+    MpiDecTestCmd *cmd = (MpiDecTestCmd *)ctx;
+
+    if (next) {
+        cmd->slt_ver = atoi(next);
+        if (cmd->slt_ver <= FRM_CRC_VER_FMT)
+            return 1;
+    }
+
+    mpp_err("invalid slt version, 0 - legacy 1 - by frame format\n");
+    cmd->slt_ver = FRM_CRC_VER_LEGACY;
+    return 0;
+}
+
 RK_S32 mpi_dec_opt_bufmode(void *ctx, const char *next)
 {
     MpiDecTestCmd *cmd = (MpiDecTestCmd *)ctx;
@@ -634,6 +667,8 @@ static MppOptInfo dec_opts[] = {
     {"s",       "instance_nb",  "number of instances",              mpi_dec_opt_s},
     {"v",       "trace option", "q - quiet f - show fps",           mpi_dec_opt_v},
     {"slt",     "slt file",     "slt verify data file",             mpi_dec_opt_slt},
+    {"slt_ref", "golden file",  "compare frame crc with golden slt file", mpi_dec_opt_slt_ref},
+    {"slt_ver", "slt version",  "0 - legacy crc layout (default) 1 - layout by frame format", mpi_dec_opt_slt_ver},
     {"help",    "help",         "show help",                        mpi_dec_opt_help},
     {"bufmode", "buffer mode",  "hi - half internal (default) i -internal e - external", mpi_dec_opt_bufmode},
 };
@@ -740,6 +775,7 @@ RK_S32 mpi_dec_test_cmd_deinit(MpiDecTestCmd* cmd)
     }
 
     MPP_FREE(cmd->file_slt);
+    MPP_FREE(cmd->file_slt_ref);
 
     if (cmd->fps) {
         fps_calc_deinit(cmd->fps);
@@ -763,6 +799,8 @@ void mpi_dec_test_cmd_options(MpiDecTestCmd* cmd)
     mpp_log("max frames : %4d\n", cmd->frame_num);
     if (cmd->file_slt)
         mpp_log("verify     : %s\n", cmd->file_slt);
+    if (cmd->file_slt_ref)
+        mpp_log("golden     : %s\n", cmd->file_slt_ref);
 }
 
 MPP_RET dec_buf_mgr_init(DecBufMgr *mgr)
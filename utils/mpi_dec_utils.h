@@ -133,6 +133,9 @@ typedef struct MpiDecTestCmd_t {
     RK_U32          quiet;
     RK_U32          trace_fps;
     char            *file_slt;
+    /* golden slt file to compare with and the crc layout version */
+    char            *file_slt_ref;
+    RK_U32          slt_ver;
 } MpiDecTestCmd;
 
 RK_S32  mpi_dec_test_cmd_init(MpiDecTestCmd* cmd, int argc, char **argv);
@@ -133,6 +133,10 @@ typedef struct MppEncRoiImpl_t {
     RK_S32              max_count;
     RK_S32              count;
 
+    /* region config of the last generated roi buffer, -1 count for none */
+    RoiRegionCfg        *last_regions;
+    RK_S32              last_count;
+
     /*
      * roi_type is for the different encoder roi config
      *
@@ -241,8 +245,7 @@ static MPP_RET gen_vepu54x_roi(MppEncRoiImpl *ctx, Vepu541RoiCfg *dst)
     cfg.qp_adj_mode = 0;
 
     /* step 1. reset all the config */
-    for (i = 0; i < stride_h * stride_v; i++)
-        memcpy(dst + i, &cfg, sizeof(cfg));
+    mpp_fill_pattern(dst, &cfg, sizeof(cfg), stride_h * stride_v);
 
     if (ctx->w <= 0 || ctx->h <= 0) {
         mpp_err_f("invalid size [%d:%d]\n", ctx->w, ctx->h);
@@ -301,13 +304,10 @@ static MPP_RET gen_vepu54x_roi(MppEncRoiImpl *ctx, Vepu541RoiCfg *dst)
         p += pos_y_init * stride_h + pos_x_init;
         map += pos_y_init * stride_h + pos_x_init;
         for (y = 0; y < roi_height; y++) {
-            for (x = 0; x < roi_width; x++) {
-                memcpy(p + x, &cfg, sizeof(cfg));
-                if (ctx->type == MPP_VIDEO_CodingAVC) {
-                    *(map + x) = 1;
-                }
+            mpp_fill_pattern(p, &cfg, sizeof(cfg), roi_width);
+            if (ctx->type == MPP_VIDEO_CodingAVC)
+                memset(map, 1, roi_width);
 
-            }
             p += stride_h;
             map += stride_h;
         }
@@ -668,6 +668,8 @@ MPP_RET mpp_enc_roi_init(MppEncRoiCtx *ctx, RK_U32 w, RK_U32 h, MppCodingType ty
     impl->roi_type = roi_type;
     impl->max_count = count;
     impl->regions = mpp_calloc(RoiRegionCfg, count);
+    impl->last_regions = mpp_calloc(RoiRegionCfg, count);
+    impl->last_count = -1;
 
     switch (roi_type) {
     case ROI_TYPE_1 : {
@@ -812,6 +814,7 @@ MPP_RET mpp_enc_roi_deinit(MppEncRoiCtx ctx)
     MPP_FREE(impl->cu_map);
     MPP_FREE(impl->legacy_roi_region);
     MPP_FREE(impl->regions);
+    MPP_FREE(impl->last_regions);
     MPP_FREE(impl->tmp);
 
     MPP_FREE(impl);
@@ -833,12 +836,32 @@ MPP_RET mpp_enc_roi_add_region(MppEncRoiCtx ctx, RoiRegionCfg *region)
     return MPP_OK;
 }
 
+/*
+ * The roi buffers are only written here, so they still hold the result of
+ * the last generation when the region list has not changed.
+ */
+static RK_S32 roi_regions_changed(MppEncRoiImpl *impl)
+{
+    if (impl->count == impl->last_count &&
+        !memcmp(impl->regions, impl->last_regions, impl->count * sizeof(*impl->regions)))
+        return 0;
+
+    memcpy(impl->last_regions, impl->regions, impl->count * sizeof(*impl->regions));
+    impl->last_count = impl->count;
+    return 1;
+}
+
 MPP_RET mpp_enc_roi_setup_meta(MppEncRoiCtx ctx, MppMeta meta)
 {
     MppEncRoiImpl *impl = (MppEncRoiImpl *)ctx;
 
     switch (impl->roi_type) {
     case ROI_TYPE_1 : {
+        if (!roi_regions_changed(impl)) {
+            mpp_meta_set_ptr(meta, KEY_ROI_DATA2, (void*)&impl->roi_cfg);
+            break;
+        }
+
         switch (impl->type) {
         case MPP_VIDEO_CodingAVC : {
             gen_vepu54x_roi(impl, impl->dst_base);
@@ -854,6 +877,11 @@ MPP_RET mpp_enc_roi_setup_meta(MppEncRoiCtx ctx, MppMeta meta)
         mpp_meta_set_ptr(meta, KEY_ROI_DATA2, (void*)&impl->roi_cfg);
     } break;
     case ROI_TYPE_2 : {
+        if (!roi_regions_changed(impl)) {
+            mpp_meta_set_ptr(meta, KEY_ROI_DATA2, (void*)&impl->roi_cfg);
+            break;
+        }
+
         gen_vepu54x_roi(impl, impl->tmp);
 
         switch (impl->type) {
@@ -25,9 +25,16 @@
 #include "mpp_log.h"
 #include "mpp_lock.h"
 #include "mpp_time.h"
+#include "mpp_thread.h"
 #include "mpp_common.h"
 #include "utils.h"
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#endif
+
 #define MAX_HALF_WORD_SUM_CNT \
     ((RK_ULONG)((0-1) / ((1UL << ((__SIZEOF_POINTER__ * 8) / 2)) - 1)))
 #define CAL_BYTE (__SIZEOF_POINTER__ >> 1)
@@ -250,56 +257,120 @@ void dump_mpp_frame_to_file(MppFrame frame, FILE *fp)
     }
 }
 
-void wide_bit_sum(RK_U8 *data, RK_U32 len, RK_ULONG *sum)
+/*
+ * Sum and xor of one row in a single pass. The sum adds CAL_BYTE wide words
+ * plus the tail bytes and the xor covers the whole 32bit words of the row.
+ */
+static void crc_row(const RK_U8 *dat, RK_U32 len, RK_ULONG *sum, RK_U32 *vor)
 {
-    RK_U8   *data8 = NULL;
-    RK_U32  loop;
-    data8 = data;
-#if LONG_MAX == INT_MAX
-    RK_U16 *data_rk = NULL;
-    data_rk = (RK_U16 *)data;
-#else
-    RK_U32 *data_rk = NULL;
-    data_rk = (RK_U32 *)data;
+    RK_U32 words = len / 4;
+    RK_ULONG s = 0;
+    RK_U32 x = 0;
+    RK_U32 i = 0;
+
+#if CAL_BYTE == 4
+#if defined(__SSE2__)
+    {
+        const __m128i zero = _mm_setzero_si128();
+        __m128i acc = zero;
+        __m128i vx = zero;
+        RK_U64 s64[2];
+        RK_U32 x32[4];
+
+        for (; i + 4 <= words; i += 4) {
+            __m128i v = _mm_loadu_si128((const __m128i *)(dat + i * 4));
+
+            vx = _mm_xor_si128(vx, v);
+            acc = _mm_add_epi64(acc, _mm_unpacklo_epi32(v, zero));
+            acc = _mm_add_epi64(acc, _mm_unpackhi_epi32(v, zero));
+        }
+
+        _mm_storeu_si128((__m128i *)s64, acc);
+        _mm_storeu_si128((__m128i *)x32, vx);
+        s = s64[0] + s64[1];
+        x = x32[0] ^ x32[1] ^ x32[2] ^ x32[3];
+    }
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+    {
+        uint64x2_t acc = vdupq_n_u64(0);
+        uint32x4_t vx = vdupq_n_u32(0);
+
+        for (; i + 4 <= words; i += 4) {
+            uint32x4_t v = vreinterpretq_u32_u8(vld1q_u8(dat + i * 4));
+
+            vx = veorq_u32(vx, v);
+            acc = vpadalq_u32(acc, v);
+        }
+
+        s = vgetq_lane_u64(acc, 0) + vgetq_lane_u64(acc, 1);
+        x = vgetq_lane_u32(vx, 0) ^ vgetq_lane_u32(vx, 1) ^
+            vgetq_lane_u32(vx, 2) ^ vgetq_lane_u32(vx, 3);
+    }
 #endif
+    for (; i < words; i++) {
+        RK_U32 val;
 
-    for (loop = 0; loop < len / CAL_BYTE; loop++) {
-        *sum += data_rk[loop];
+        memcpy(&val, dat + i * 4, sizeof(val));
+        s += val;
+        x ^= val;
     }
-    for (loop = len / CAL_BYTE * CAL_BYTE; loop < len; loop++) {
-        *sum += data8[loop];
+    for (i = words * 4; i < len; i++)
+        s += dat[i];
+#else
+    for (i = 0; i < len / 2; i++) {
+        RK_U16 val;
+
+        memcpy(&val, dat + i * 2, sizeof(val));
+        s += val;
     }
+    if (len & 1)
+        s += dat[len - 1];
+
+    for (i = 0; i < words; i++) {
+        RK_U32 val;
 
-    return;
+        memcpy(&val, dat + i * 4, sizeof(val));
+        x ^= val;
+    }
+#endif
+
+    *sum += s;
+    *vor ^= x;
 }
 
 void calc_data_crc(RK_U8 *dat, RK_U32 len, DataCrc *crc)
 {
     RK_ULONG data_grp_byte_cnt = MAX_HALF_WORD_SUM_CNT * CAL_BYTE;
-    RK_U32 i = 0, grp_loop = 0;
-    RK_U8 *dat8 = NULL;
-    RK_U32 *dat32 = NULL;
+    RK_U32 grp_loop = 0;
     RK_U32 xor = 0;
+    RK_U32 pos = 0;
 
-    /*calc sum */
     crc->sum_cnt = (len + data_grp_byte_cnt - 1) / data_grp_byte_cnt;
-    for (grp_loop = 0; grp_loop < len / data_grp_byte_cnt; grp_loop++) {
-        wide_bit_sum(&dat[grp_loop * data_grp_byte_cnt], data_grp_byte_cnt, &crc->sum[grp_loop]);
-    }
-    if (len % data_grp_byte_cnt) {
-        wide_bit_sum(&dat[grp_loop * data_grp_byte_cnt], len % data_grp_byte_cnt, &crc->sum[grp_loop]);
+
+    /*
+     * calc sum and xor together when the group size keeps the 32bit words of
+     * the xor aligned, that is always true on 64bit platform
+     */
+    for (grp_loop = 0; pos < len; grp_loop++) {
+        RK_U32 grp_len = MPP_MIN(data_grp_byte_cnt, len - pos);
+        RK_U32 grp_xor = 0;
+
+        crc_row(&dat[pos], grp_len, &crc->sum[grp_loop], &grp_xor);
+        if (!(data_grp_byte_cnt & 3))
+            xor ^= grp_xor;
+        pos += grp_len;
     }
 
-    /*calc xor */
-    dat32 = (RK_U32 *)dat;
-    for (i = 0; i < len / 4; i++)
-        xor ^= dat32[i];
+    if (data_grp_byte_cnt & 3) {
+        RK_ULONG dummy = 0;
+
+        crc_row(dat, len, &dummy, &xor);
+    }
 
     if (len % 4) {
         RK_U32 val = 0;
-        dat8 = (RK_U8 *)&val;
-        for (i = (len / 4) * 4; i < len; i++)
-            dat8[i % 4] = dat[i];
+
+        memcpy(&val, &dat[len / 4 * 4], len % 4);
         xor ^= val;
     }
 
@@ -337,69 +408,220 @@ void read_data_crc(FILE *fp, DataCrc *crc)
     }
 }
 
-void calc_frm_crc(MppFrame frame, FrmCrc *crc)
-{
-    RK_ULONG data_grp_byte_cnt = MAX_HALF_WORD_SUM_CNT * CAL_BYTE;
-    RK_U32 grp_line_cnt = 0;
-    RK_U32 grp_cnt = 0;
-
-    RK_U32 y = 0, x = 0;
-    RK_U8 *dat8 = NULL;
-    RK_U32 *dat32 = NULL;
-    RK_U32 xor = 0;
+typedef struct FrmCrcPlane_t {
+    size_t          offset;
+    RK_U32          row_len;
+    RK_U32          rows;
+    RK_U32          stride;
+} FrmCrcPlane;
 
+/*
+ * Split the frame into planes covering the visible pixels. The first plane
+ * goes to the luma crc and the others go to the chroma crc. For fbc frames
+ * only the header is covered as the payload blocks have undefined padding.
+ * The legacy layout keeps the old 8bit 420SP planes for every format.
+ */
+static RK_S32 get_crc_planes(MppFrame frame, FrmCrcPlane *planes, RK_U32 version)
+{
+    MppFrameFormat fmt = mpp_frame_get_fmt(frame);
     RK_U32 width  = mpp_frame_get_width(frame);
     RK_U32 height = mpp_frame_get_height(frame);
-    RK_U32 stride = mpp_frame_get_hor_stride(frame);
-    RK_U8 *buf = (RK_U8 *)mpp_buffer_get_ptr(mpp_frame_get_buffer(frame));
-
-    grp_line_cnt = data_grp_byte_cnt / ((width + CAL_BYTE - 1) / CAL_BYTE * CAL_BYTE);
+    RK_U32 h_stride = mpp_frame_get_hor_stride(frame);
+    RK_U32 v_stride = mpp_frame_get_ver_stride(frame);
+    size_t luma_size = (size_t)h_stride * v_stride;
+    RK_U32 c_width = MPP_ALIGN(width, 2);
+    RK_U32 c_height = (height + 1) / 2;
+    RK_U32 row_len = width;
+    RK_S32 count = 2;
+
+    if (version == FRM_CRC_VER_LEGACY) {
+        planes[0].offset = 0;
+        planes[0].row_len = width;
+        planes[0].rows = height;
+        planes[0].stride = h_stride;
+        planes[1] = planes[0];
+        planes[1].offset = (size_t)h_stride * height;
+        planes[1].rows = height / 2;
+        return 2;
+    }
 
-    /* luma */
-    grp_cnt = (height + grp_line_cnt - 1) / grp_line_cnt;
-    crc->luma.sum_cnt = grp_cnt;
+    if (MPP_FRAME_FMT_IS_FBC(fmt)) {
+        RK_U32 hdr_stride = mpp_frame_get_fbc_hdr_stride(frame);
+        RK_U32 offset_y = mpp_frame_get_offset_y(frame);
 
-    dat8 = buf;
-    for (y = 0; y <  height / grp_line_cnt * grp_line_cnt; y++) {
-        wide_bit_sum(&dat8[y * stride], width, &crc->luma.sum[y / grp_line_cnt]);
-    }
-    if (height % grp_line_cnt) {
-        for (y = height / grp_line_cnt * grp_line_cnt; y < height; y++) {
-            wide_bit_sum(&dat8[y * stride], width, &crc->luma.sum[y / grp_line_cnt]);
+        if (!hdr_stride) {
+            mpp_err_f("invalid fbc header stride on fmt %x\n", fmt);
+            return 0;
         }
-    }
 
-    dat8 = buf;
-    for (y = 0; y < height; y++) {
-        dat32 = (RK_U32 *)&dat8[y * stride];
-        for (x = 0; x < width / 4; x++)
-            xor ^= dat32[x];
+        planes[0].offset = 0;
+        planes[0].row_len = hdr_stride;
+        planes[0].rows = MPP_ALIGN(offset_y + height, 16) / 16;
+        planes[0].stride = hdr_stride;
+        return 1;
     }
-    crc->luma.len = height * width;
-    crc->luma.vor = xor;
 
-    /* chroma */
-    grp_cnt = (height / 2 + grp_line_cnt - 1) / grp_line_cnt;
-    crc->chroma.sum_cnt = grp_cnt;
+    if (MPP_FRAME_FMT_IS_RGB(fmt) && MPP_FRAME_FMT_IS_LE(fmt))
+        fmt &= MPP_FRAME_FMT_MASK;
 
-    dat8 = buf + height * stride;
-    for (y = 0; y <  height / 2 / grp_line_cnt * grp_line_cnt; y++) {
-        wide_bit_sum(&dat8[y * stride], width, &crc->chroma.sum[y / grp_line_cnt]);
+    switch (fmt & MPP_FRAME_FMT_MASK) {
+    case MPP_FMT_YUV420SP :
+    case MPP_FMT_YUV420SP_VU : {
+        planes[1].row_len = c_width;
+        planes[1].rows = c_height;
+        planes[1].stride = h_stride;
+    } break;
+    case MPP_FMT_YUV420SP_10BIT : {
+        row_len = (width * 10 + 7) / 8;
+        planes[1].row_len = (c_width * 10 + 7) / 8;
+        planes[1].rows = c_height;
+        planes[1].stride = h_stride;
+    } break;
+    case MPP_FMT_YUV422SP :
+    case MPP_FMT_YUV422SP_VU : {
+        planes[1].row_len = c_width;
+        planes[1].rows = height;
+        planes[1].stride = h_stride;
+    } break;
+    case MPP_FMT_YUV422SP_10BIT : {
+        row_len = (width * 10 + 7) / 8;
+        planes[1].row_len = (c_width * 10 + 7) / 8;
+        planes[1].rows = height;
+        planes[1].stride = h_stride;
+    } break;
+    case MPP_FMT_YUV440SP : {
+        planes[1].row_len = width * 2;
+        planes[1].rows = c_height;
+        planes[1].stride = h_stride * 2;
+    } break;
+    case MPP_FMT_YUV411SP : {
+        planes[1].row_len = MPP_ALIGN(width, 4) / 2;
+        planes[1].rows = height;
+        planes[1].stride = h_stride / 2;
+    } break;
+    case MPP_FMT_YUV444SP : {
+        planes[1].row_len = width * 2;
+        planes[1].rows = height;
+        planes[1].stride = h_stride * 2;
+    } break;
+    case MPP_FMT_YUV420P :
+    case MPP_FMT_YUV422P : {
+        RK_U32 rows = ((fmt & MPP_FRAME_FMT_MASK) == MPP_FMT_YUV420P) ? c_height : height;
+        RK_U32 v_rows = ((fmt & MPP_FRAME_FMT_MASK) == MPP_FMT_YUV420P) ? v_stride / 2 : v_stride;
+
+        planes[1].row_len = c_width / 2;
+        planes[1].rows = rows;
+        planes[1].stride = h_stride / 2;
+        planes[2] = planes[1];
+        planes[2].offset = luma_size + (size_t)h_stride / 2 * v_rows;
+        count = 3;
+    } break;
+    case MPP_FMT_YUV444P : {
+        planes[1].row_len = width;
+        planes[1].rows = height;
+        planes[1].stride = h_stride;
+        planes[2] = planes[1];
+        planes[2].offset = luma_size * 2;
+        count = 3;
+    } break;
+    case MPP_FMT_YUV400 : {
+        count = 1;
+    } break;
+    case MPP_FMT_YUV422_YUYV :
+    case MPP_FMT_YUV422_YVYU :
+    case MPP_FMT_YUV422_UYVY :
+    case MPP_FMT_YUV422_VYUY :
+    case MPP_FMT_RGB565 :
+    case MPP_FMT_BGR565 :
+    case MPP_FMT_RGB555 :
+    case MPP_FMT_BGR555 :
+    case MPP_FMT_RGB444 :
+    case MPP_FMT_BGR444 : {
+        row_len = width * 2;
+        count = 1;
+    } break;
+    case MPP_FMT_RGB888 :
+    case MPP_FMT_BGR888 : {
+        row_len = width * 3;
+        count = 1;
+    } break;
+    case MPP_FMT_RGB101010 :
+    case MPP_FMT_BGR101010 :
+    case MPP_FMT_ARGB8888 :
+    case MPP_FMT_ABGR8888 :
+    case MPP_FMT_BGRA8888 :
+    case MPP_FMT_RGBA8888 : {
+        row_len = width * 4;
+        count = 1;
+    } break;
+    default : {
+        mpp_err_f("not supported format %x\n", fmt);
+        return 0;
+    } break;
     }
-    if (height / 2 % grp_line_cnt) {
-        for (y = height / 2 / grp_line_cnt * grp_line_cnt; y < height / 2; y++) {
-            wide_bit_sum(&dat8[y * stride], width, &crc->chroma.sum[y / grp_line_cnt]);
-        }
+
+    planes[0].offset = 0;
+    planes[0].row_len = row_len;
+    planes[0].rows = height;
+    planes[0].stride = h_stride;
+    planes[1].offset = luma_size;
+
+    return count;
+}
+
+static void calc_planes_crc(RK_U8 *buf, FrmCrcPlane *planes, RK_S32 count,
+                            DataCrc *crc, RK_U32 *xor)
+{
+    RK_ULONG data_grp_byte_cnt = MAX_HALF_WORD_SUM_CNT * CAL_BYTE;
+    RK_ULONG grp_line_cnt = 0;
+    RK_U32 max_len = 0;
+    RK_U32 rows = 0;
+    RK_U32 line = 0;
+    RK_S32 i;
+
+    crc->len = 0;
+    for (i = 0; i < count; i++) {
+        max_len = MPP_MAX(max_len, planes[i].row_len);
+        rows += planes[i].rows;
+        crc->len += planes[i].row_len * planes[i].rows;
     }
 
-    dat8 = buf + height * stride;
-    for (y = 0; y < height / 2; y++) {
-        dat32 = (RK_U32 *)&dat8[y * stride];
-        for (x = 0; x < width / 4; x++)
-            xor ^= dat32[x];
+    grp_line_cnt = max_len ? data_grp_byte_cnt / MPP_ALIGN(max_len, CAL_BYTE) : 1;
+    crc->sum_cnt = (rows + grp_line_cnt - 1) / grp_line_cnt;
+
+    for (i = 0; i < count; i++) {
+        RK_U8 *dat8 = buf + planes[i].offset;
+        RK_U32 y;
+
+        for (y = 0; y < planes[i].rows; y++, line++)
+            crc_row(dat8 + (size_t)y * planes[i].stride, planes[i].row_len,
+                    &crc->sum[line / grp_line_cnt], xor);
     }
-    crc->chroma.len = height * width / 2;
-    crc->chroma.vor = xor;
+
+    crc->vor = *xor;
+}
+
+void calc_frm_crc(MppFrame frame, FrmCrc *crc)
+{
+    FrmCrcPlane planes[3];
+    MppBuffer buffer = mpp_frame_get_buffer(frame);
+    RK_U8 *buf = buffer ? (RK_U8 *)mpp_buffer_get_ptr(buffer) : NULL;
+    RK_S32 count = 0;
+    RK_U32 xor = 0;
+
+    memset(planes, 0, sizeof(planes));
+    if (buf)
+        count = get_crc_planes(frame, planes, crc->version);
+    if (!count)
+        return;
+
+    /* chroma xor continues from luma xor */
+    calc_planes_crc(buf, planes, 1, &crc->luma, &xor);
+    calc_planes_crc(buf, planes + 1, count - 1, &crc->chroma, &xor);
+
+    /* legacy chroma length is not rounded down on odd height */
+    if (crc->version == FRM_CRC_VER_LEGACY)
+        crc->chroma.len = planes[0].rows * planes[0].row_len / 2;
 }
 
 void write_frm_crc(FILE *fp, FrmCrc *crc)
@@ -407,6 +629,10 @@ void write_frm_crc(FILE *fp, FrmCrc *crc)
     RK_U32 loop = 0;
 
     if (fp) {
+        // legacy line has no version prefix
+        if (crc->version)
+            fprintf(fp, "v%d, ", crc->version);
+
         // luma
         fprintf(fp, "%d,", crc->luma.len);
         for (loop = 0; loop < crc->luma.sum_cnt; loop++) {
@@ -425,28 +651,229 @@ void write_frm_crc(FILE *fp, FrmCrc *crc)
     }
 }
 
-void read_frm_crc(FILE *fp, FrmCrc *crc)
+static MPP_RET read_crc_sums(FILE *fp, DataCrc *crc)
 {
     RK_U32 loop = 0;
 
+    if (fscanf(fp, " %u,", &crc->len) != 1)
+        return MPP_NOK;
+
+    for (loop = 0; loop < crc->sum_cnt; loop++) {
+        if (fscanf(fp, " %lx,", &crc->sum[loop]) != 1)
+            return MPP_NOK;
+    }
+
+    /* the comma is only there after luma */
+    if (fscanf(fp, " %x,", &crc->vor) != 1)
+        return MPP_NOK;
+
+    return MPP_OK;
+}
+
+MPP_RET read_frm_crc(FILE *fp, FrmCrc *crc)
+{
+    RK_U32 ver = FRM_CRC_VER_LEGACY;
+
+    if (!fp)
+        return MPP_ERR_NULL_PTR;
+
+    // legacy line has no version prefix
+    if (fscanf(fp, " v%u,", &ver) == EOF)
+        return MPP_NOK;
+
+    crc->version = ver;
+
+    if (read_crc_sums(fp, &crc->luma) || read_crc_sums(fp, &crc->chroma)) {
+        mpp_err_f("invalid or truncated frame crc line\n");
+        return MPP_NOK;
+    }
+
+    return MPP_OK;
+}
+
+/* get the layout version from the first line and rewind the file */
+RK_U32 get_frm_crc_ver(FILE *fp)
+{
+    RK_U32 ver = FRM_CRC_VER_LEGACY;
+
     if (fp) {
-        RK_S32 ret = 0;
-        // luma
-        ret = fscanf(fp, "%d", &crc->luma.len);
-        for (loop = 0; loop < crc->luma.sum_cnt; loop++) {
-            ret |= fscanf(fp, "%lx", &crc->luma.sum[loop]);
-        }
-        ret |= fscanf(fp, "%08x", &crc->luma.vor);
+        if (fscanf(fp, " v%u,", &ver) != 1)
+            ver = FRM_CRC_VER_LEGACY;
+        rewind(fp);
+    }
 
-        // chroma
-        ret |= fscanf(fp, "%d", &crc->chroma.len);
-        for (loop = 0; loop < crc->chroma.sum_cnt; loop++) {
-            ret |= fscanf(fp, "%lx", &crc->chroma.sum[loop]);
+    return ver;
+}
+
+MPP_RET cmp_frm_crc(FrmCrc *crc, FrmCrc *ref)
+{
+    DataCrc *a[2] = { &crc->luma, &crc->chroma };
+    DataCrc *b[2] = { &ref->luma, &ref->chroma };
+    RK_U32 i;
+
+    if (crc->version != ref->version)
+        return MPP_NOK;
+
+    for (i = 0; i < 2; i++) {
+        if (a[i]->len != b[i]->len || a[i]->vor != b[i]->vor ||
+            a[i]->sum_cnt != b[i]->sum_cnt ||
+            memcmp(a[i]->sum, b[i]->sum, sizeof(a[i]->sum[0]) * a[i]->sum_cnt))
+            return MPP_NOK;
+    }
+
+    return MPP_OK;
+}
+
+#define FRM_CRC_WORKER_DEPTH    8
+#define FRM_CRC_SUM_CNT         512
+
+typedef struct FrmCrcWorkerImpl_t {
+    FILE            *fp;
+    FrmCrc          crc;
+
+    pthread_t       thd;
+    pthread_mutex_t lock;
+    pthread_cond_t  cond;
+
+    /* frames waiting for crc, wr - rd is the queued count */
+    MppFrame        frames[FRM_CRC_WORKER_DEPTH];
+    RK_U32          rd;
+    RK_U32          wr;
+    RK_U32          quit;
+} FrmCrcWorkerImpl;
+
+static void *frm_crc_worker_thread(void *arg)
+{
+    FrmCrcWorkerImpl *p = (FrmCrcWorkerImpl *)arg;
+
+    while (1) {
+        MppFrame frame = NULL;
+
+        pthread_mutex_lock(&p->lock);
+        while (p->rd == p->wr && !p->quit)
+            pthread_cond_wait(&p->cond, &p->lock);
+
+        /* quit only after all queued frames are done */
+        if (p->rd == p->wr) {
+            pthread_mutex_unlock(&p->lock);
+            break;
         }
-        ret |= fscanf(fp, "%08x", &crc->chroma.vor);
-        if (ret == EOF)
-            mpp_err_f("unexpected EOF found\n");
+
+        frame = p->frames[p->rd % FRM_CRC_WORKER_DEPTH];
+        pthread_mutex_unlock(&p->lock);
+
+        calc_frm_crc(frame, &p->crc);
+        write_frm_crc(p->fp, &p->crc);
+        mpp_frame_deinit(&frame);
+
+        pthread_mutex_lock(&p->lock);
+        p->rd++;
+        pthread_cond_signal(&p->cond);
+        pthread_mutex_unlock(&p->lock);
     }
+
+    return NULL;
+}
+
+MPP_RET frm_crc_worker_init(FrmCrcWorker *worker, FILE *fp, RK_U32 version)
+{
+    FrmCrcWorkerImpl *p = NULL;
+
+    if (!worker || !fp) {
+        mpp_err_f("invalid input worker %p fp %p\n", worker, fp);
+        return MPP_ERR_NULL_PTR;
+    }
+
+    *worker = NULL;
+
+    p = mpp_calloc(FrmCrcWorkerImpl, 1);
+    if (!p)
+        goto FAILED;
+
+    p->crc.luma.sum = mpp_calloc(RK_ULONG, FRM_CRC_SUM_CNT);
+    p->crc.chroma.sum = mpp_calloc(RK_ULONG, FRM_CRC_SUM_CNT);
+    if (!p->crc.luma.sum || !p->crc.chroma.sum)
+        goto FAILED;
+
+    p->fp = fp;
+    p->crc.version = version;
+    pthread_mutex_init(&p->lock, NULL);
+    pthread_cond_init(&p->cond, NULL);
+
+    if (pthread_create(&p->thd, NULL, frm_crc_worker_thread, p)) {
+        pthread_cond_destroy(&p->cond);
+        pthread_mutex_destroy(&p->lock);
+        goto FAILED;
+    }
+
+    *worker = p;
+    return MPP_OK;
+
+FAILED:
+    mpp_err_f("failed to create frame crc worker\n");
+    if (p) {
+        MPP_FREE(p->crc.luma.sum);
+        MPP_FREE(p->crc.chroma.sum);
+        MPP_FREE(p);
+    }
+    return MPP_NOK;
+}
+
+MPP_RET frm_crc_worker_put(FrmCrcWorker worker, MppFrame frame)
+{
+    FrmCrcWorkerImpl *p = (FrmCrcWorkerImpl *)worker;
+    MppFrame dst = NULL;
+
+    if (!p || !frame || !mpp_frame_get_buffer(frame))
+        return MPP_ERR_NULL_PTR;
+
+    /* only take the layout info and a buffer reference */
+    if (mpp_frame_init(&dst))
+        return MPP_NOK;
+
+    mpp_frame_set_width(dst, mpp_frame_get_width(frame));
+    mpp_frame_set_height(dst, mpp_frame_get_height(frame));
+    mpp_frame_set_hor_stride(dst, mpp_frame_get_hor_stride(frame));
+    mpp_frame_set_ver_stride(dst, mpp_frame_get_ver_stride(frame));
+    mpp_frame_set_offset_x(dst, mpp_frame_get_offset_x(frame));
+    mpp_frame_set_offset_y(dst, mpp_frame_get_offset_y(frame));
+    mpp_frame_set_fbc_hdr_stride(dst, mpp_frame_get_fbc_hdr_stride(frame));
+    mpp_frame_set_fmt(dst, mpp_frame_get_fmt(frame));
+    mpp_frame_set_buffer(dst, mpp_frame_get_buffer(frame));
+
+    pthread_mutex_lock(&p->lock);
+    while (p->wr - p->rd >= FRM_CRC_WORKER_DEPTH)
+        pthread_cond_wait(&p->cond, &p->lock);
+
+    p->frames[p->wr % FRM_CRC_WORKER_DEPTH] = dst;
+    p->wr++;
+    pthread_cond_signal(&p->cond);
+    pthread_mutex_unlock(&p->lock);
+
+    return MPP_OK;
+}
+
+MPP_RET frm_crc_worker_deinit(FrmCrcWorker worker)
+{
+    FrmCrcWorkerImpl *p = (FrmCrcWorkerImpl *)worker;
+
+    if (!p)
+        return MPP_OK;
+
+    pthread_mutex_lock(&p->lock);
+    p->quit = 1;
+    pthread_cond_signal(&p->cond);
+    pthread_mutex_unlock(&p->lock);
+
+    pthread_join(p->thd, NULL);
+
+    pthread_cond_destroy(&p->cond);
+    pthread_mutex_destroy(&p->lock);
+    MPP_FREE(p->crc.luma.sum);
+    MPP_FREE(p->crc.chroma.sum);
+    MPP_FREE(p);
+
+    return MPP_OK;
 }
 
 static MPP_RET read_with_pixel_width(RK_U8 *buf, RK_S32 width, RK_S32 height,
@@ -1573,3 +2000,74 @@ MPP_RET str_to_frm_fmt(const char *nptr, long *number)
 RET:
     return ret;
 }
+
+RK_U8 *load_stream(const char *name, RK_U32 *size)
+{
+    FILE *fp = fopen(name, "rb");
+    RK_U8 *buf = NULL;
+    long len;
+
+    *size = 0;
+    if (!fp) {
+        mpp_err("failed to open %s\n", name);
+        return NULL;
+    }
+
+    fseek(fp, 0, SEEK_END);
+    len = ftell(fp);
+    fseek(fp, 0, SEEK_SET);
+
+    if (len > 0)
+        buf = mpp_malloc(RK_U8, len);
+
+    if (buf && fread(buf, 1, len, fp) != (size_t)len)
+        MPP_FREE(buf);
+
+    fclose(fp);
+    *size = buf ? (RK_U32)len : 0;
+
+    return buf;
+}
+
+RK_U8 *gen_stream(RK_U32 size, RK_U32 unit_max, const RK_U8 *hdr,
+                  RK_U32 hdr_size, RK_U32 hdr_cnt)
+{
+    RK_U8 *buf = mpp_malloc(RK_U8, size);
+    RK_U32 seed = 0x12345678;
+    RK_U32 unit = 0;
+    RK_U32 pos = 0;
+
+    if (!buf)
+        return NULL;
+
+    while (pos < size) {
+        RK_U32 end;
+
+        if (pos + 3 + hdr_size <= size) {
+            buf[pos++] = 0;
+            buf[pos++] = 0;
+            buf[pos++] = 1;
+            memcpy(buf + pos, hdr + (unit % hdr_cnt) * hdr_size, hdr_size);
+            pos += hdr_size;
+            unit++;
+        }
+
+        seed = seed * 1103515245 + 12345;
+        end = MPP_MIN(size, pos + (seed >> 8) % unit_max + 8);
+
+        for (; pos < end; pos++) {
+            RK_U32 val;
+
+            seed = seed * 1103515245 + 12345;
+            val = (seed >> 16) & 0xff;
+            /* keep some zero bytes to exercise the start code search */
+            val = (val < 16) ? 0 : val;
+            /* emulation prevention like the encoder does */
+            if (pos >= 2 && !buf[pos - 1] && !buf[pos - 2] && val <= 3)
+                val = 3;
+            buf[pos] = val;
+        }
+    }
+
+    return buf;
+}
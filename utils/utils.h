@@ -35,11 +35,25 @@ typedef struct data_crc_t {
     RK_U32          vor; // value of the xor
 } DataCrc;
 
+/*
+ * frame crc layout version
+ * FRM_CRC_VER_LEGACY - every frame is taken as 8bit 420SP with chroma at
+ *                      hor_stride * height, same as the old slt files
+ * FRM_CRC_VER_FMT    - planes follow the frame format with chroma at
+ *                      hor_stride * ver_stride. The line starts with "v1,"
+ *                      so it never compares equal to a legacy line.
+ */
+#define FRM_CRC_VER_LEGACY      0
+#define FRM_CRC_VER_FMT         1
+
 typedef struct frame_crc_t {
     DataCrc         luma;
     DataCrc         chroma;
+    RK_U32          version;
 } FrmCrc;
 
+typedef void* FrmCrcWorker;
+
 #define show_options(opt) \
     do { \
         _show_options(sizeof(opt)/sizeof(OptionInfo), opt); \
@@ -63,7 +77,19 @@ void read_data_crc(FILE *fp, DataCrc *crc);
 
 void calc_frm_crc(MppFrame frame, FrmCrc *crc);
 void write_frm_crc(FILE *fp, FrmCrc *crc);
-void read_frm_crc(FILE *fp, FrmCrc *crc);
+/* sum_cnt of crc should be set from a calculated crc before reading */
+MPP_RET read_frm_crc(FILE *fp, FrmCrc *crc);
+RK_U32 get_frm_crc_ver(FILE *fp);
+MPP_RET cmp_frm_crc(FrmCrc *crc, FrmCrc *ref);
+
+/*
+ * frame crc worker
+ * Calculate and write frame crc on a separate thread in put order. The
+ * frame buffer is kept referenced until its crc has been written.
+ */
+MPP_RET frm_crc_worker_init(FrmCrcWorker *worker, FILE *fp, RK_U32 version);
+MPP_RET frm_crc_worker_put(FrmCrcWorker worker, MppFrame frame);
+MPP_RET frm_crc_worker_deinit(FrmCrcWorker worker);
 
 MPP_RET read_image(RK_U8 *buf, FILE *fp, RK_U32 width, RK_U32 height,
                    RK_U32 hor_stride, RK_U32 ver_stride,
@@ -94,6 +120,16 @@ MPP_RET fps_calc_inc(FpsCalc ctx);
 
 MPP_RET str_to_frm_fmt(const char *nptr, long *number);
 
+/* load a whole bitstream file into a mpp_malloc buffer */
+RK_U8 *load_stream(const char *name, RK_U32 *size);
+/*
+ * generate a start code stream of size bytes for parser test. Each unit is
+ * 00 00 01, the next one of the hdr_cnt unit headers of hdr_size bytes and a
+ * random payload up to unit_max bytes with emulation prevention.
+ */
+RK_U8 *gen_stream(RK_U32 size, RK_U32 unit_max, const RK_U8 *hdr,
+                  RK_U32 hdr_size, RK_U32 hdr_cnt);
+
 #ifdef __cplusplus
 }
 #endif